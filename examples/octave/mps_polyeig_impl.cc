@@ -17,7 +17,7 @@ DEFUN_DLD(mps_polyeig_impl, args, nargout,
   
   /* Create a mps_monomial_matrix_poly */
   mps_context *ctx = mps_context_new (); 
-  mps_monomial_matrix_poly *mp = mps_monomial_matrix_poly_new (ctx, degree, args(0).rows(), true); 
+  mps_monomial_matrix_poly *mp = mps_monomial_matrix_poly_new (ctx, degree, args(0).rows(), false); 
 
   ComplexColumnVector res(degree * args(0).rows ());
 
@@ -26,6 +26,13 @@ struct mps_approximation {
   cdpe_t dvalue;
   mpc_t mvalue;
 
+  /**
+   * @brief Double-double copy of <code>mvalue</code>, used by the packets
+   * of Aberth iterations of the MP phase that are carried out in
+   * double-double arithmetic. It is meaningful only while they run.
+   */
+  cdd_t ddvalue;
+
   double frad;
   rdpe_t drad;
 
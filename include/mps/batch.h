@@ -0,0 +1,102 @@
+/*
+ * This file is part of MPSolve 3.1.5
+ *
+ * Copyright (C) 2001-2015, Dipartimento di Matematica "L. Tonelli", Pisa.
+ * License: http://www.gnu.org/licenses/gpl.html GPL version 3 or higher
+ *
+ * Authors:
+ *   Leonardo Robol <leonardo.robol@sns.it>
+ */
+
+/**
+ * @file
+ * @brief Solution of many polynomials with a single call, either
+ * independently or as the steps of a continuation.
+ */
+
+#ifndef MPS_BATCH_H_
+#define MPS_BATCH_H_
+
+MPS_BEGIN_DECLS
+
+/**
+ * @brief Options that are used by mps_solve_batch() for all the
+ * polynomials of the batch.
+ */
+struct mps_batch_options {
+  /**
+   * @brief The algorithm used to solve the polynomials.
+   */
+  mps_algorithm algorithm;
+
+  /**
+   * @brief The goal of the computation.
+   */
+  mps_output_goal goal;
+
+  /**
+   * @brief Number of bits of precision required on the output.
+   */
+  long int output_prec;
+};
+
+/**
+ * @brief Output of mps_solve_batch() for a single polynomial.
+ */
+struct mps_batch_result {
+  /**
+   * @brief Array where the approximations of the roots are stored. It
+   * must hold as many elements as the degree of the polynomial. If it
+   * is NULL it is allocated by mps_solve_batch().
+   */
+  cplx_t * roots;
+
+  /**
+   * @brief Array where the inclusion radii are stored, with the same size
+   * of <code>roots</code>. If it is NULL the radii are not returned.
+   */
+  double * radii;
+
+  /**
+   * @brief Number of roots equal to zero. They are deflated from the
+   * polynomial before solving it, and they are not stored in
+   * <code>roots</code>.
+   */
+  int zero_roots;
+
+  /**
+   * @brief This is set to true if the polynomial could not be solved.
+   */
+  mps_boolean error;
+
+  /**
+   * @brief Number of Newton corrections computed to solve the polynomial,
+   * see mps_context_get_newton_corrections().
+   */
+  long int iterations;
+
+  /**
+   * @brief Number of Newton corrections saved by starting from the roots of
+   * the previous step, with respect to the last step that started from
+   * scratch. It is set only by mps_solve_continuation() and mps_solve_sweep(),
+   * and it may be negative.
+   */
+  long int iterations_saved;
+};
+
+void mps_batch_options_init (mps_batch_options * options);
+
+int mps_solve_batch (mps_polynomial ** polys, int n, mps_batch_options * options,
+                     mps_batch_result * results);
+
+int mps_solve_continuation (mps_polynomial ** polys, int n, mps_batch_options * options,
+                            mps_batch_result * results);
+
+int mps_solve_sweep (mps_polynomial ** polys, int n, mps_batch_options * options,
+                     mps_batch_result * results);
+
+void mps_batch_release (void);
+
+MPS_END_DECLS
+
+#endif /* MPS_BATCH_H_ */
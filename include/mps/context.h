@@ -457,6 +457,23 @@ struct mps_context {
    */
   mps_starting_strategy starting_strategy;
 
+  /**
+   * @brief Starting approximations used by
+   * <code>MPS_STARTING_STRATEGY_USER</code>.
+   */
+  mpc_t * starting_points;
+
+  /**
+   * @brief Inclusion radii of <code>starting_points</code>, or NULL
+   * if they are not known.
+   */
+  rdpe_t * starting_radii;
+
+  /**
+   * @brief Number of elements of <code>starting_points</code>.
+   */
+  int n_starting_points;
+
   /**
    * @brief Routine that performs the loop needed to coordinate
    * root finding. It has to be called to do the hard work.
@@ -479,10 +496,17 @@ struct mps_context {
   int n_threads;
 
   /**
-   * @brief The thread pool used for the concurrent part of MPSolve.
+   * @brief The thread pool used for the concurrent part of MPSolve. It may
+   * be shared with other contexts, see mps_context_set_thread_pool().
    */
   mps_thread_pool * pool;
 
+  /**
+   * @brief Number of jobs submitted by this context to <code>pool</code>
+   * that are not completed yet.
+   */
+  volatile int pool_pending;
+
   /**
    * @brief Auxiliary memory used in regeneation to avoid thread-safeness
    * issues.
@@ -495,6 +519,54 @@ struct mps_context {
    */
   mps_boolean jacobi_iterations;
 
+  /**
+   * @brief True if the threaded floating point and DPE iterations should
+   * read the Aberth sums from a double buffered snapshot of the roots
+   * taken at the start of every sweep, instead of using the most recent
+   * positions published by the other threads.
+   */
+  mps_boolean aberth_snapshot;
+
+  /**
+   * @brief Degree starting from which the Jacobi-style floating point and
+   * DPE iterations evaluate the Aberth sums with a <code>mps_fmm_tree</code>
+   * instead of directly. A value of 0 disables the tree.
+   */
+  long int aberth_fmm_degree;
+
+  /**
+   * @brief Relative accuracy requested to the multipole expansions used
+   * by the <code>mps_fmm_tree</code>.
+   */
+  double aberth_fmm_accuracy;
+
+  /**
+   * @brief Degree starting from which the coefficients of the secular
+   * equation are regenerated with a multipoint evaluation of the monomial
+   * polynomial. A value of 0 disables it.
+   */
+  long int multipoint_regeneration_degree;
+
+  /**
+   * @brief True if the floating point iterations on polynomials with real
+   * coefficients should keep the approximations in conjugate pairs and
+   * iterate only on one element of every pair.
+   */
+  mps_boolean conjugate_symmetry;
+
+  /**
+   * @brief Number of consecutive packets of iterations on conjugate pairs
+   * that did not bring any new approximation in the root neighbourhood.
+   */
+  int conjugate_stalls;
+
+  /**
+   * @brief Placement of the threads of the pool on the CPUs. If it is not
+   * <code>MPS_THREAD_AFFINITY_NONE</code> the approximations of the roots are
+   * also allocated by the threads that will iterate on them.
+   */
+  mps_thread_affinity thread_affinity;
+
   /**
    * @brief Char to be intersted after the with statement in the output piped to gnuplot.
    */
@@ -507,8 +579,49 @@ struct mps_context {
   unsigned long int dpe_iteration_time;
   unsigned long int fp_iteration_time;
 
+  /**
+   * @brief Number of Newton corrections computed during the last call
+   * to mps_mpsolve().
+   */
+  long int newton_corrections;
+
+  /**
+   * @brief Number of bytes currently used by the coefficients of the
+   * polynomials created with this context.
+   */
+  mps_long_int_mt memory_in_use;
+
+  /**
+   * @brief Maximum value reached by <code>memory_in_use</code>.
+   */
+  long int memory_high_water;
+
   mps_boolean exit_required;
 
+  /**
+   * @brief Wall clock time, in seconds, that a call to mps_mpsolve() may
+   * take. A non positive value means no limit.
+   */
+  double time_budget;
+
+  /**
+   * @brief Time at which the current call to mps_mpsolve() has to return,
+   * in seconds from an arbitrary point in the past.
+   */
+  double deadline;
+
+  /**
+   * @brief Maximum working precision, in bits, that a call to mps_mpsolve()
+   * may use. A value of 0 means no limit.
+   */
+  long int precision_budget;
+
+  /**
+   * @brief True if the last call to mps_mpsolve() has returned before
+   * reaching the output precision because one of the budgets was exhausted.
+   */
+  mps_boolean budget_exhausted;
+
   long int minimum_gmp_precision;
 
   /**
@@ -555,7 +668,10 @@ void mps_context_select_algorithm (mps_context * s, mps_algorithm algorithm);
 void mps_context_set_degree (mps_context * s, int n);
 
 #ifdef _MPS_PRIVATE
+mps_context * mps_context_new_with_pool (mps_thread_pool * pool);
 void mps_context_allocate_poly_inplace (mps_context * s, int n);
+void mps_context_set_sequential (mps_context * s);
+void mps_context_account_memory (mps_context * s, long int bytes);
 #endif
 
 /* Accessor functions */
@@ -566,21 +682,41 @@ int mps_context_get_roots_d (mps_context * s, cplx_t ** roots, double **radius);
 int mps_context_get_roots_m (mps_context * s, mpc_t ** roots, rdpe_t ** radius);
 int mps_context_get_zero_roots (mps_context * s);
 mps_root_status mps_context_get_root_status (mps_context * ctx, int i);
+mps_boolean mps_context_get_root_accurate (mps_context * ctx, int i);
+mps_boolean mps_context_get_budget_exhausted (mps_context * s);
 mps_boolean mps_context_get_over_max (mps_context * s);
 mps_polynomial * mps_context_get_active_poly (mps_context * ctx);
 mps_approximation** mps_context_get_approximations (mps_context * ctx);
+long int mps_context_get_memory_high_water (mps_context * s);
+long int mps_context_get_newton_corrections (mps_context * s);
 
 /* I/O options and flags */
 void mps_context_set_input_prec (mps_context * s, long int prec);
 void mps_context_set_output_prec (mps_context * s, long int prec);
 void mps_context_set_output_format (mps_context * s, mps_output_format format);
 void mps_context_set_output_goal (mps_context * s, mps_output_goal goal);
+void mps_context_add_search_disk (mps_context * s, double center_re, double center_im, double radius);
+void mps_context_add_search_rectangle (mps_context * s, double re_min, double im_min,
+                                       double re_max, double im_max);
+void mps_context_clear_search_region (mps_context * s);
 void mps_context_set_starting_phase (mps_context * s, mps_phase phase);
 void mps_context_set_log_stream (mps_context * s, FILE * logstr);
 void mps_context_set_jacobi_iterations (mps_context * s, mps_boolean jacobi_iterations);
+void mps_context_set_aberth_snapshot (mps_context * s, mps_boolean aberth_snapshot);
+void mps_context_set_aberth_fmm (mps_context * s, long int degree, double accuracy);
+void mps_context_set_multipoint_regeneration (mps_context * s, long int degree);
+void mps_context_set_conjugate_symmetry (mps_context * s, mps_boolean conjugate_symmetry);
+void mps_context_set_thread_affinity (mps_context * s, mps_thread_affinity affinity);
+void mps_context_set_thread_pool (mps_context * s, mps_thread_pool * pool);
+void mps_context_use_system_thread_pool (mps_context * s);
+mps_thread_pool * mps_context_get_thread_pool (mps_context * s);
 void mps_context_select_starting_strategy (mps_context * s, mps_starting_strategy strategy);
+void mps_context_set_starting_approximations_d (mps_context * s, cplx_t * points, double * radii, int n);
+void mps_context_set_starting_approximations_m (mps_context * s, mpc_t * points, rdpe_t * radii, int n);
 void mps_context_set_avoid_multiprecision (mps_context * s, mps_boolean avoid_multiprecision);
 void mps_context_set_crude_approximation_mode (mps_context * s, mps_boolean crude_approximation_mode);
+void mps_context_set_time_budget (mps_context * s, double seconds);
+void mps_context_set_precision_budget (mps_context * s, long int bits);
 void mps_context_set_regeneration_driver (mps_context * s, mps_regeneration_driver * rd);
 
 /* Debugging */
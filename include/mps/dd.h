@@ -0,0 +1,341 @@
+/*
+ * This file is part of MPSolve 3.1.5
+ *
+ * Copyright (C) 2001-2015, Dipartimento di Matematica "L. Tonelli", Pisa.
+ * License: http://www.gnu.org/licenses/gpl.html GPL version 3 or higher
+ *
+ * Authors:
+ *   Leonardo Robol <leonardo.robol@sns.it>
+ */
+
+/**
+ * @file
+ * @brief Double-double arithmetic, in real and complex versions.
+ *
+ * A double-double number is the unevaluated sum \f$hi + lo\f$ of two
+ * floating point numbers with \f$|lo| \leq \frac 12 ulp(hi)\f$, which
+ * represents about 106 bits of mantissa with the exponent range of the
+ * doubles. The operations are carried out with the error free
+ * transformations of Dekker and Knuth, and have a relative error bounded
+ * by a small multiple of \f$2^{-104}\f$; they are inlined since they are
+ * used in the innermost loops of the evaluation of the polynomials.
+ */
+
+#ifndef MPS_DD_H_
+#define MPS_DD_H_
+
+#include <float.h>
+#include <math.h>
+#include <mps/mt.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Number of bits of the mantissa that can be trusted in the result
+ * of an operation on double-double numbers.
+ */
+#define MPS_DD_PRECISION 104
+
+/***********************************************************
+**              rdd_t type                                **
+***********************************************************/
+
+/*! @cond PRIVATE */
+typedef struct {
+  double hi, lo;
+} __rdd_struct;
+/*! @endcond */
+
+typedef __rdd_struct rdd_t[1];
+
+#define rdd_Hi(X)         ((X)->hi)
+#define rdd_Lo(X)         ((X)->lo)
+
+/* Error free transformations. */
+
+static inline void
+rdd_two_sum (double a, double b, double * s, double * e)
+{
+  double bb;
+
+  *s = a + b;
+  bb = *s - a;
+  *e = (a - (*s - bb)) + (b - bb);
+}
+
+static inline void
+rdd_quick_two_sum (double a, double b, double * s, double * e)
+{
+  *s = a + b;
+  *e = b - (*s - a);
+}
+
+static inline void
+rdd_two_prod (double a, double b, double * p, double * e)
+{
+#ifdef FP_FAST_FMA
+  *p = a * b;
+  *e = fma (a, b, -*p);
+#else
+  /* Dekker's splitting of the factors in 26 bits halves */
+  double t, ah, al, bh, bl;
+
+  t = 134217729.0 * a;
+  ah = t - (t - a);
+  al = a - ah;
+  t = 134217729.0 * b;
+  bh = t - (t - b);
+  bl = b - bh;
+
+  *p = a * b;
+  *e = ((ah * bh - *p) + ah * bl + al * bh) + al * bl;
+#endif
+}
+
+/* Operations on rdd_t. */
+
+static inline void
+rdd_set (rdd_t r, const rdd_t a)
+{
+  r->hi = a->hi;
+  r->lo = a->lo;
+}
+
+static inline void
+rdd_set_d (rdd_t r, double d)
+{
+  r->hi = d;
+  r->lo = 0.0;
+}
+
+static inline double
+rdd_get_d (const rdd_t a)
+{
+  return a->hi + a->lo;
+}
+
+static inline void
+rdd_add (rdd_t r, const rdd_t a, const rdd_t b)
+{
+  double s, e, t, f;
+
+  rdd_two_sum (a->hi, b->hi, &s, &e);
+  rdd_two_sum (a->lo, b->lo, &t, &f);
+  e += t;
+  rdd_quick_two_sum (s, e, &s, &e);
+  e += f;
+  rdd_quick_two_sum (s, e, &r->hi, &r->lo);
+}
+
+static inline void
+rdd_neg (rdd_t r, const rdd_t a)
+{
+  r->hi = -a->hi;
+  r->lo = -a->lo;
+}
+
+static inline void
+rdd_sub (rdd_t r, const rdd_t a, const rdd_t b)
+{
+  rdd_t nb;
+
+  rdd_neg (nb, b);
+  rdd_add (r, a, nb);
+}
+
+static inline void
+rdd_mul (rdd_t r, const rdd_t a, const rdd_t b)
+{
+  double p, e;
+
+  rdd_two_prod (a->hi, b->hi, &p, &e);
+  e += a->hi * b->lo + a->lo * b->hi;
+  rdd_quick_two_sum (p, e, &r->hi, &r->lo);
+}
+
+static inline void
+rdd_mul_d (rdd_t r, const rdd_t a, double d)
+{
+  double p, e;
+
+  rdd_two_prod (a->hi, d, &p, &e);
+  e += a->lo * d;
+  rdd_quick_two_sum (p, e, &r->hi, &r->lo);
+}
+
+/**
+ * @brief Set r to \f$a \cdot 2^e\f$, exactly if no underflow happens.
+ */
+static inline void
+rdd_ldexp (rdd_t r, const rdd_t a, int e)
+{
+  r->hi = ldexp (a->hi, e);
+  r->lo = ldexp (a->lo, e);
+}
+
+static inline void
+rdd_div (rdd_t r, const rdd_t a, const rdd_t b)
+{
+  double q1, q2, q3;
+  rdd_t t, res;
+
+  /* Long division, with three correction steps */
+  q1 = a->hi / b->hi;
+  rdd_mul_d (t, b, q1);
+  rdd_sub (res, a, t);
+
+  q2 = res->hi / b->hi;
+  rdd_mul_d (t, b, q2);
+  rdd_sub (res, res, t);
+
+  q3 = res->hi / b->hi;
+
+  rdd_quick_two_sum (q1, q2, &r->hi, &r->lo);
+  rdd_set_d (t, q3);
+  rdd_add (r, r, t);
+}
+
+/***********************************************************
+**              cdd_t type                                **
+***********************************************************/
+
+/*! @cond PRIVATE */
+typedef struct {
+  rdd_t r, i;
+} __cdd_struct;
+/*! @endcond */
+
+typedef __cdd_struct cdd_t[1];
+
+#define cdd_Re(C)         ((C)->r)
+#define cdd_Im(C)         ((C)->i)
+
+/* Operations on cdd_t. */
+
+static inline void
+cdd_set (cdd_t r, const cdd_t a)
+{
+  rdd_set (r->r, a->r);
+  rdd_set (r->i, a->i);
+}
+
+static inline void
+cdd_set_d (cdd_t r, double re, double im)
+{
+  rdd_set_d (r->r, re);
+  rdd_set_d (r->i, im);
+}
+
+static inline void
+cdd_set_cplx (cdd_t r, const cplx_t x)
+{
+  cdd_set_d (r, cplx_Re (x), cplx_Im (x));
+}
+
+static inline void
+cdd_get_cplx (cplx_t x, const cdd_t a)
+{
+  cplx_set_d (x, rdd_get_d (a->r), rdd_get_d (a->i));
+}
+
+static inline int
+cdd_eq_zero (const cdd_t a)
+{
+  return a->r->hi == 0.0 && a->i->hi == 0.0;
+}
+
+/**
+ * @brief Modulus of a, in double precision.
+ */
+static inline double
+cdd_mod (const cdd_t a)
+{
+  return hypot (rdd_get_d (a->r), rdd_get_d (a->i));
+}
+
+/**
+ * @brief Upper bound to the modulus of a, cheaper to compute than cdd_mod().
+ */
+static inline double
+cdd_mod_bound (const cdd_t a)
+{
+  return (fabs (a->r->hi) + fabs (a->i->hi)) * (1 + DBL_EPSILON);
+}
+
+static inline void
+cdd_add (cdd_t r, const cdd_t a, const cdd_t b)
+{
+  rdd_add (r->r, a->r, b->r);
+  rdd_add (r->i, a->i, b->i);
+}
+
+static inline void
+cdd_sub (cdd_t r, const cdd_t a, const cdd_t b)
+{
+  rdd_sub (r->r, a->r, b->r);
+  rdd_sub (r->i, a->i, b->i);
+}
+
+static inline void
+cdd_mul (cdd_t r, const cdd_t a, const cdd_t b)
+{
+  rdd_t t1, t2, re;
+
+  rdd_mul (t1, a->r, b->r);
+  rdd_mul (t2, a->i, b->i);
+  rdd_sub (re, t1, t2);
+
+  rdd_mul (t1, a->r, b->i);
+  rdd_mul (t2, a->i, b->r);
+  rdd_add (r->i, t1, t2);
+  rdd_set (r->r, re);
+}
+
+static inline void
+cdd_mul_d (cdd_t r, const cdd_t a, double d)
+{
+  rdd_mul_d (r->r, a->r, d);
+  rdd_mul_d (r->i, a->i, d);
+}
+
+static inline void
+cdd_div (cdd_t r, const cdd_t a, const cdd_t b)
+{
+  rdd_t den, t1, t2, re, br, bi;
+  int e;
+
+  /* Scale b to modulus about 1, so that its square does not overflow
+   * or underflow. */
+  frexp (fabs (b->r->hi) > fabs (b->i->hi) ? b->r->hi : b->i->hi, &e);
+  rdd_ldexp (br, b->r, -e);
+  rdd_ldexp (bi, b->i, -e);
+
+  rdd_mul (t1, br, br);
+  rdd_mul (t2, bi, bi);
+  rdd_add (den, t1, t2);
+
+  rdd_mul (t1, a->r, br);
+  rdd_mul (t2, a->i, bi);
+  rdd_add (re, t1, t2);
+
+  rdd_mul (t1, a->i, br);
+  rdd_mul (t2, a->r, bi);
+  rdd_sub (t1, t1, t2);
+
+  rdd_div (re, re, den);
+  rdd_div (t1, t1, den);
+  rdd_ldexp (r->r, re, -e);
+  rdd_ldexp (r->i, t1, -e);
+}
+
+/* vector functions */
+#define cdd_valloc(N)       (cdd_t *) malloc ((N) * sizeof(cdd_t))
+#define cdd_vfree(V)        free (V)
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* MPS_DD_H_ */
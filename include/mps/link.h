@@ -18,6 +18,7 @@
 /* needed header files */
 #include <mps/mt.h>
 #include <mps/mpc.h>
+#include <mps/dd.h>
 
 #ifdef __cplusplus
 extern "C" {
@@ -78,6 +79,28 @@ void mpc_set_cdpe (mpc_t mc, cdpe_t c);
  */
 void mpc_get_cdpe (cdpe_t c, mpc_t mc);
 
+/**
+ * @brief Set the Multiprecision value <code>mc</code> with the double-double
+ * value stored in <code>c</code>.
+ *
+ * The conversion is exact if the precision of <code>mc</code> is at least
+ * 107 bits.
+ *
+ * @param mc The multiprecision complex number to set.
+ * @param c The <code>cdd_t</code> value to set in <code>mc</code>.
+ */
+void mpc_set_cdd (mpc_t mc, cdd_t c);
+
+/**
+ * @brief Get the double-double version of the Multiprecision value <code>mc</code>.
+ *
+ * @param c The <code>cdd_t</code> where the value of <code>mc</code> will be stored.
+ * @param mc The multiprecision complex number to extract the value from.
+ * @return false if <code>mc</code> is out of the range where the double-double
+ * numbers keep their full precision, in which case <code>c</code> is not set.
+ */
+int mpc_get_cdd (cdd_t c, mpc_t mc);
+
 #ifdef __cplusplus
 }
 #endif
@@ -28,10 +28,21 @@ extern "C"
 {
 #endif
 
+/**
+ * @brief Flag for matrix polynomials of degree 1 of the form \f$P_0 + xI\f$,
+ * where \f$P_0\f$ is upper Hessenberg. The reduction to Hessenberg form
+ * is skipped, and the coefficient of degree 1 is never accessed.
+ */
 #define MPS_MONOMIAL_MATRIX_POLY_HESSENBERG 0x0001
 
 #ifdef _MPS_PRIVATE
 
+struct mps_monomial_matrix_poly_double_buffer {
+  char active;
+  mpc_t *mH1;
+  mpc_t *mH2;
+};
+
 /**
  * @brief This is the struct that holds all the data of the matrix
  * polynomial.
@@ -107,6 +118,49 @@ struct mps_monomial_matrix_poly {
    * @seealso mps_monomial_matrix_poly_clear_flags().
    */
   int flags;
+
+  /**
+   * @brief The two buffers used to store the multiprecision Hessenberg matrix,
+   * so that its precision can be raised while other threads are using
+   * the active one.
+   */
+  struct mps_monomial_matrix_poly_double_buffer db;
+
+  /**
+   * @brief Upper Hessenberg matrix similar to the block companion matrix
+   * of the polynomial, whose characteristic polynomial is
+   * \f$\det P(x) / \det P_n\f$.
+   *
+   * This is the active buffer in db.
+   */
+  mpc_t * mH;
+
+  /**
+   * @brief Floating point version of mH.
+   */
+  cplx_t * fH;
+
+  /**
+   * @brief DPE version of mH.
+   */
+  cdpe_t * dH;
+
+  /**
+   * @brief The precision of mH, or 0 if it has not been computed yet.
+   */
+  long int prec;
+
+  /**
+   * @brief True if the leading coefficient has been found singular while
+   * computing mH. The Hessenberg matrices are left to zero, and are not
+   * computed again until a coefficient is changed.
+   */
+  mps_boolean singular;
+
+  /**
+   * @brief Mutex held while the Hessenberg matrix is computed.
+   */
+  pthread_mutex_t regenerating;
 };
 
 
@@ -195,6 +249,36 @@ void mps_monomial_matrix_poly_set_coefficient_q (mps_context * ctx,
                                                  mpq_t * matrix_r,
                                                  mpq_t * matrix_i);
 
+/**
+ * @brief Evaluate a matrix polynomial at a point, in the sense of
+ * evaluating \f$det(P(x))\f$, in floating point.
+ *
+ * The polynomial is normalized to be monic, i.e., the value is
+ * \f$det(P(x)) / det(P_n)\f$.
+ *
+ * @param ctx The current mps_context
+ * @param poly The matrix polynomial to evaluate
+ * @param x The point in which the evaluation is requested
+ * @param value The value of \f$det(P(x))\f$
+ * @param error An upper bound to the absolute error that affects the result.
+ * @return true if the evaluation was successful, false if the value is
+ * not representable as a double.
+ */
+mps_boolean mps_monomial_matrix_poly_feval (mps_context * ctx,
+                                            mps_polynomial * poly,
+                                            cplx_t x,
+                                            cplx_t value,
+                                            double * error);
+
+/**
+ * @brief DPE version of mps_monomial_matrix_poly_feval().
+ */
+mps_boolean mps_monomial_matrix_poly_deval (mps_context * ctx,
+                                            mps_polynomial * poly,
+                                            cdpe_t x,
+                                            cdpe_t value,
+                                            rdpe_t error);
+
 /**
  * @brief Evaluate a matrix polynomial at a point, in the sense of
  * evaluating \f$det(P(x))\f$.
@@ -229,6 +313,37 @@ mps_monomial_matrix_poly_raise_data (mps_context * ctx,
                                      mps_polynomial * p,
                                      long int wp);
 
+/**
+ * @brief Compute the Newton correction of a root of the matrix polynomial,
+ * in floating point, along with its inclusion radius.
+ *
+ * @param ctx The current mps_context.
+ * @param poly The matrix polynomial.
+ * @param root The approximation to correct.
+ * @param corr The storage for the Newton correction.
+ */
+void mps_monomial_matrix_poly_fnewton (mps_context * ctx,
+                                       mps_polynomial * poly,
+                                       mps_approximation * root,
+                                       cplx_t corr);
+
+/**
+ * @brief DPE version of mps_monomial_matrix_poly_fnewton().
+ */
+void mps_monomial_matrix_poly_dnewton (mps_context * ctx,
+                                       mps_polynomial * poly,
+                                       mps_approximation * root,
+                                       cdpe_t corr);
+
+/**
+ * @brief Multiprecision version of mps_monomial_matrix_poly_fnewton().
+ */
+void mps_monomial_matrix_poly_mnewton (mps_context * ctx,
+                                       mps_polynomial * poly,
+                                       mps_approximation * root,
+                                       mpc_t corr,
+                                       long int wp);
+
 #ifdef  __cplusplus
 }
 #endif
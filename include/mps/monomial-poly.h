@@ -30,6 +30,14 @@ MPS_BEGIN_DECLS
 
 #ifdef _MPS_PRIVATE
 
+/**
+ * @brief The two buffers used to raise the precision of the
+ * multiprecision coefficients while other threads are still reading
+ * them.
+ *
+ * <code>mfpc2</code> is allocated, with the new precision, the first
+ * time that the precision is raised.
+ */
 struct mps_monomial_poly_double_buffer {
   char active;
   mpc_t *mfpc1;
@@ -59,35 +67,30 @@ struct mps_monomial_poly {
    */
   mps_boolean *spar;
 
-  /**
-   * @brief Standard real coefficients.
-   */
-  double *fpr;
-
   /**
    * @brief Standard complex coefficients.
    */
   cplx_t *fpc;
 
   /**
-   * @brief Array containing standard complex coefficients
+   * @brief Array containing standard complex coefficients of the
+   * derivatives used by the float phase. It is allocated by
+   * mps_monomial_poly_ensure_fppc() the first time it is needed.
    */
   cplx_t *fppc;
 
-  /**
-   * @brief Dpe real coefficients.
-   */
-  rdpe_t *dpr;
-
   /**
    * @brief Dpe complex coefficients.
    */
   cdpe_t *dpc;
 
   /**
-   * @brief Multiprecision real coefficients.
+   * @brief This is true if the floating point and DPE coefficients are
+   * exactly the ones of the polynomial, up to a scaling by a power of two,
+   * and not rounded versions of them. It is set by mps_setup(), and used
+   * to bound the error of the compensated Horner scheme.
    */
-  mpf_t *mfpr;
+  mps_boolean dpc_exact;
 
   /**
    * @brief Multiprecision complex coefficients.
@@ -101,9 +104,17 @@ struct mps_monomial_poly {
   pthread_mutex_t * mfpc_mutex;
 
   /**
-   * @brief Multiprecision complex coefficients of \f$p'(x)\f$.
+   * @brief Double-double complex coefficients, allocated and computed by
+   * mps_monomial_poly_update_dd_coefficients() when the MP phase starts.
    */
-  mpc_t *mfppc;
+  cdd_t *ddpc;
+
+  /**
+   * @brief This is true if <code>ddpc</code> holds the coefficients of the
+   * polynomial, i.e., if they have been computed and they are in the range
+   * where double-double arithmetic keeps its full accuracy.
+   */
+  mps_boolean ddpc_valid;
 
   /**
    * @brief Array containing moduli of the coefficients as double numbers.
@@ -135,6 +146,12 @@ struct mps_monomial_poly {
    * @brief Precision of the polynomial coefficients.
    */
   long int prec;
+
+  /**
+   * @brief Number of bytes used by the coefficients, as accounted
+   * in the context by mps_context_account_memory().
+   */
+  long int memory_usage;
 };
 #endif /* #ifdef _MPS_PRIVATE */
 
@@ -177,6 +194,8 @@ mps_boolean mps_monomial_poly_deval (mps_context * ctx, mps_polynomial *p, cdpe_
 
 mps_boolean mps_monomial_poly_meval (mps_context * ctx, mps_polynomial *p, mpc_t x, mpc_t value, rdpe_t error);
 
+mps_boolean mps_monomial_poly_ddeval (mps_context * ctx, mps_polynomial *p, cdd_t x, cdd_t value, double * error);
+
 void mps_monomial_poly_fstart (mps_context * ctx, mps_polynomial * p, mps_approximation ** approximations);
 
 void mps_monomial_poly_dstart (mps_context * ctx, mps_polynomial * p, mps_approximation ** approximations);
@@ -189,9 +208,22 @@ void mps_monomial_poly_fnewton (mps_context * ctx, mps_polynomial * p,
 void mps_monomial_poly_dnewton (mps_context * ctx, mps_polynomial * p,
                                 mps_approximation * root, cdpe_t corr);
 
+void mps_monomial_poly_fnewton_block (mps_context * ctx, mps_polynomial * p,
+                                      mps_approximation ** roots, int n, cplx_t * corr);
+
+void mps_monomial_poly_dnewton_block (mps_context * ctx, mps_polynomial * p,
+                                      mps_approximation ** roots, int n, cdpe_t * corr);
+
 void mps_monomial_poly_mnewton (mps_context * ctx, mps_polynomial * p,
                                 mps_approximation * root, mpc_t corr, long int wp);
 
+mps_boolean mps_monomial_poly_ddnewton (mps_context * ctx, mps_polynomial * p,
+                                        mps_approximation * root, cdd_t corr);
+
+void mps_monomial_poly_update_dd_coefficients (mps_context * ctx, mps_monomial_poly * mp);
+
+void mps_monomial_poly_ensure_fppc (mps_context * ctx, mps_monomial_poly * mp);
+
 void mps_monomial_poly_get_leading_coefficient (mps_context * ctx, mps_polynomial * p,
                                                 mpc_t leading_coefficient);
 
@@ -34,6 +34,17 @@ typedef struct {
 /*! @endcond */
 
 typedef __mpc_struct mpc_t[1];
+typedef __mpc_struct * mpc_ptr;
+
+/*! @cond PRIVATE */
+struct mpc_scratch;
+/*! @endcond */
+
+/**
+ * @brief Per-thread pool of temporary mpc_t and mpf_t, which are
+ * handed out and given back in LIFO order.
+ */
+typedef struct mpc_scratch mpc_scratch;
 
 /***********************************************************
 **            macros for fields access                    **
@@ -60,6 +71,12 @@ void mpc_set_prec (mpc_t c, unsigned long int prec);
 unsigned long int mpc_get_prec (const mpc_t c);
 void mpc_set_prec_raw (mpc_t c, unsigned long int prec);
 
+/* scratch arena */
+mpc_scratch * mpc_scratch_get (void);
+mpc_ptr mpc_scratch_push (mpc_scratch * sc, unsigned long int prec);
+mpf_ptr mpf_scratch_push (mpc_scratch * sc, unsigned long int prec);
+void mpc_scratch_pop (mpc_scratch * sc, int n);
+
 /* initializers */
 void mpc_set (mpc_t rc, const mpc_t c);
 void mpc_set_ui (mpc_t c, unsigned long int ir, unsigned long int ii);
@@ -88,6 +105,9 @@ void mpc_inv2 (mpc_t rc, mpc_t c);
 void mpc_sqr (mpc_t rc, mpc_t c);
 void mpc_rot (mpc_t rc, mpc_t c);
 void mpc_flip (mpc_t rc, mpc_t c);
+void mpc_smod_scratch (mpc_scratch * sc, mpf_t f, mpc_t c);
+void mpc_inv_scratch (mpc_scratch * sc, mpc_t rc, mpc_t c);
+void mpc_sqr_scratch (mpc_scratch * sc, mpc_t rc, mpc_t c);
 
 /* binary functions */
 void mpc_add (mpc_t rc, mpc_t c1, mpc_t c2);
@@ -102,10 +122,12 @@ void mpc_sub_ui (mpc_t rc, mpc_t c, unsigned long int r,
 void mpc_ui_sub (mpc_t rc, unsigned long int r, unsigned long int i,
                  mpc_t c);
 void mpc_mul (mpc_t rc, mpc_t c1, mpc_t c2);
+void mpc_mul_scratch (mpc_scratch * sc, mpc_t rc, mpc_t c1, mpc_t c2);
 void mpc_mul_f (mpc_t rc, mpc_t c, mpf_t f);
 void mpc_mul_ui (mpc_t rc, mpc_t c, unsigned long int i);
 void mpc_mul_2exp (mpc_t rc, mpc_t c, unsigned long int i);
 void mpc_div (mpc_t rc, mpc_t c1, mpc_t c2);
+void mpc_div_scratch (mpc_scratch * sc, mpc_t rc, mpc_t c1, mpc_t c2);
 void mpc_div_f (mpc_t rc, mpc_t c, mpf_t f);
 void mpc_f_div (mpc_t rc, mpf_t f, mpc_t c);
 void mpc_div_ui (mpc_t rc, mpc_t c, unsigned long int i);
@@ -114,6 +136,14 @@ void mpc_div_2exp (mpc_t rc, mpc_t c, unsigned long int i);
 void mpc_pow_si (mpc_t rc, mpc_t c, register signed long int i);
 void mpc_swap (mpc_t c1, mpc_t c2);
 
+/* fused functions */
+void mpc_fma (mpc_t rc, mpc_t c1, mpc_t c2, mpc_t c3);
+void mpc_fma_scratch (mpc_scratch * sc, mpc_t rc, mpc_t c1, mpc_t c2,
+                      mpc_t c3);
+void mpc_horner_step (mpc_t v, mpc_t x, mpc_t a);
+void mpc_horner_step_scratch (mpc_scratch * sc, mpc_t v, mpc_t x, mpc_t a);
+int mpc_sum_inv_diff (mpc_t rc, mpc_t x, mpc_t y[], mpc_t a[], int n);
+
 /* op= style operators */
 void mpc_smod_eq (mpc_t c);
 void mpc_mod_eq (mpc_t c);
@@ -64,6 +64,7 @@
 #include <mps/mt.h>
 #include <mps/gmptools.h>
 #include <mps/mpc.h>
+#include <mps/dd.h>
 #include <mps/link.h>
 #include <mps/polynomial.h>
 
@@ -73,6 +74,7 @@
 #include <mps/chebyshev.h>
 #include <mps/monomial-matrix-poly.h>
 #include <mps/monomial-poly.h>
+#include <mps/sparse-monomial-poly.h>
 #include <mps/secular-equation.h>
 #include <mps/nroots-polynomial.h>
 #include <mps/regeneration-driver.h>
@@ -82,6 +84,7 @@
 #include <mps/context.h>
 #include <mps/debug.h>
 #include <mps/interface.h>
+#include <mps/batch.h>
 #include <mps/parser.h>
 
 /* Private inclusions. Please note that these header files may not be distributed with
@@ -98,10 +101,15 @@ MPS_END_DECLS
 #include <mps/private/system/memory-file-stream.h>
 #include <mps/private/aberth.h>
 #include <mps/private/algorithms.h>
+#include <mps/private/budget.h>
 #include <mps/private/cluster.h>
+#include <mps/private/conjugate.h>
 #include <mps/private/convex.h>
 #include <mps/private/data.h>
+#include <mps/private/float-roots.h>
+#include <mps/private/fmm.h>
 #include <mps/private/hessenberg-determinant.h>
+#include <mps/private/hessenberg-reduction.h>
 #include <mps/private/horner.h>
 #include <mps/private/jacobi-aberth.h>
 #include <mps/private/improve.h>
@@ -109,9 +117,11 @@ MPS_END_DECLS
 #include <mps/private/input-output.h>
 #include <mps/private/list.h>
 #include <mps/private/mandelbrot-user.h>
+#include <mps/private/multipoint.h>
 #include <mps/private/newton.h>
 #include <mps/private/options.h>
 #include <mps/private/radii.h>
+#include <mps/private/region.h>
 #include <mps/private/secular-evaluation.h>
 #include <mps/private/solve.h>
 #include <mps/private/sort.h>
@@ -46,6 +46,13 @@ typedef mps_boolean (*mps_polynomial_deval_t)(mps_context * ctx, mps_polynomial
  */
 typedef mps_boolean (*mps_polynomial_meval_t)(mps_context * ctx, mps_polynomial * p, mpc_t x, mpc_t value, rdpe_t error);
 
+/**
+ * @brief The type of a function that evaluates the polynomial (double-double version).
+ * It returns false if the evaluation cannot be carried out in double-double
+ * arithmetic, e.g., because the coefficients are out of the range of the doubles.
+ */
+typedef mps_boolean (*mps_polynomial_ddeval_t)(mps_context * ctx, mps_polynomial * p, cdd_t x, cdd_t value, double * error);
+
 /**
  * @brief Function that will be used to deallocate the polynomial on context destruction.
  */
@@ -89,12 +96,36 @@ typedef void (*mps_polynomial_fnewton_t)(mps_context * ctx, mps_polynomial * p,
 typedef void (*mps_polynomial_dnewton_t)(mps_context * ctx, mps_polynomial * p,
                                          mps_approximation * root, cdpe_t corr);
 
+/**
+ * @brief Function that computes \f$\frac{p}{p'}\f$ at many approximations
+ * at once (floating point version)
+ */
+typedef void (*mps_polynomial_fnewton_block_t)(mps_context * ctx, mps_polynomial * p,
+                                               mps_approximation ** roots, int n,
+                                               cplx_t * corr);
+
+/**
+ * @brief Function that computes \f$\frac{p}{p'}\f$ at many approximations
+ * at once (dpe version)
+ */
+typedef void (*mps_polynomial_dnewton_block_t)(mps_context * ctx, mps_polynomial * p,
+                                               mps_approximation ** roots, int n,
+                                               cdpe_t * corr);
+
 /**
  * @brief Function that computes \f$\frac{p}{p'}\f$ (multiprecision version)
  */
 typedef void (*mps_polynomial_mnewton_t)(mps_context * ctx, mps_polynomial * p,
                                          mps_approximation * root, mpc_t corr, long int wp);
 
+/**
+ * @brief Function that computes \f$\frac{p}{p'}\f$ (double-double version).
+ * It returns false if the correction cannot be computed in double-double
+ * arithmetic, in which case the multiprecision version has to be used.
+ */
+typedef mps_boolean (*mps_polynomial_ddnewton_t)(mps_context * ctx, mps_polynomial * p,
+                                                 mps_approximation * root, cdd_t corr);
+
 /**
  * @brief Function that returns the leading coefficient of the polynomial.
  * This defaults to the function that returns one (i.e. the default polynomial
@@ -164,6 +195,12 @@ struct mps_polynomial {
    */
   mps_polynomial_meval_t meval;
 
+  /**
+   * @brief Method that evaluates the polynomial in double-double
+   * arithmetic. It can be NULL.
+   */
+  mps_polynomial_ddeval_t ddeval;
+
   /**
    * @brief Method that collocate initial starting points.
    */
@@ -205,6 +242,25 @@ struct mps_polynomial {
    */
   mps_polynomial_mnewton_t mnewton;
 
+  /**
+   * @brief Function used to compute the Newton correction in a point
+   * in double-double arithmetic. If it is provided the first precision
+   * level of the MP phase is carried out in double-double arithmetic.
+   */
+  mps_polynomial_ddnewton_t ddnewton;
+
+  /**
+   * @brief Function used to compute the Newton corrections in many points
+   * at once. If it is NULL, fnewton is called on every point.
+   */
+  mps_polynomial_fnewton_block_t fnewton_block;
+
+  /**
+   * @brief Function used to compute the Newton corrections in many points
+   * at once. If it is NULL, dnewton is called on every point.
+   */
+  mps_polynomial_dnewton_block_t dnewton_block;
+
   /**
    * @brief Function used to retrieve the leading coefficient of the
    * polynomial.
@@ -226,6 +282,8 @@ mps_boolean mps_polynomial_deval (mps_context * ctx, mps_polynomial * p, cdpe_t
 
 mps_boolean mps_polynomial_meval (mps_context * ctx, mps_polynomial * p, mpc_t x, mpc_t value, rdpe_t error);
 
+mps_boolean mps_polynomial_ddeval (mps_context * ctx, mps_polynomial * p, cdd_t x, cdd_t value, double * error);
+
 void mps_polynomial_fstart (mps_context * ctx, mps_polynomial * p, mps_approximation ** approximations);
 
 void mps_polynomial_dstart (mps_context * ctx, mps_polynomial * p, mps_approximation ** approximations);
@@ -243,6 +301,15 @@ void mps_polynomial_dnewton (mps_context * ctx, mps_polynomial *p,
 void mps_polynomial_mnewton (mps_context * ctx, mps_polynomial *p,
                              mps_approximation * root, mpc_t corr, long int wp);
 
+mps_boolean mps_polynomial_ddnewton (mps_context * ctx, mps_polynomial *p,
+                                     mps_approximation * root, cdd_t corr);
+
+void mps_polynomial_fnewton_block (mps_context * ctx, mps_polynomial *p,
+                                   mps_approximation ** roots, int n, cplx_t * corr);
+
+void mps_polynomial_dnewton_block (mps_context * ctx, mps_polynomial *p,
+                                   mps_approximation ** roots, int n, cdpe_t * corr);
+
 void mps_polynomial_get_leading_coefficient (mps_context * ctx, mps_polynomial * p, mpc_t lc);
 
 long int mps_polynomial_raise_data (mps_context * ctx, mps_polynomial * p, long int wp);
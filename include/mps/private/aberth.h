@@ -27,11 +27,14 @@ void mps_daberth (mps_context * s, mps_approximation * root, cdpe_t abcorr);
 void mps_maberth (mps_context * s, mps_approximation * root, mpc_t abcorr);
 void mps_faberth_s (mps_context * s, mps_approximation * root, mps_cluster * cluster, cplx_t abcorr);
 void mps_faberth_wl (mps_context * s, int j, cplx_t abcorr, pthread_mutex_t * aberth_mutexes);
+void mps_faberth_snapshot (mps_context * s, int j, cplx_t froot, cplx_t * values, cplx_t abcorr);
 void mps_daberth_s (mps_context * s, mps_approximation * root, mps_cluster * cluster, cdpe_t abcorr);
 void mps_daberth_wl (mps_context * s, int j, cdpe_t abcorr, pthread_mutex_t * aberth_mutexes);
+void mps_daberth_snapshot (mps_context * s, int j, cdpe_t droot, cdpe_t * values, cdpe_t abcorr);
 void mps_maberth_s (mps_context * s, mps_approximation * root, mps_cluster * cluster, mpc_t abcorr);
 void mps_maberth_s_wl (mps_context * s, int j, mps_cluster * cluster, mpc_t abcorr,
                        pthread_mutex_t * aberth_mutex);
+mps_boolean mps_ddaberth_s (mps_context * s, int j, mps_cluster * cluster, cplx_t abcorr);
 void mps_mnewtis (mps_context * s);
 
 #endif /* endif MPS_ABERTH_H_ */
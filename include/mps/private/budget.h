@@ -0,0 +1,38 @@
+/*
+ * This file is part of MPSolve 3.1.5
+ *
+ * Copyright (C) 2001-2015, Dipartimento di Matematica "L. Tonelli", Pisa.
+ * License: http://www.gnu.org/licenses/gpl.html GPL version 3 or higher
+ *
+ * Authors:
+ *   Leonardo Robol <leonardo.robol@sns.it>
+ */
+
+/**
+ * @file
+ *
+ * @brief Time and precision budgets of a call to mps_mpsolve().
+ *
+ * The budgets are checked between two packets of iterations, and before
+ * every increase of the working precision. When one of them is exhausted
+ * the algorithms return the approximations computed so far, with the
+ * inclusion radii and the status given by the last packet, instead of
+ * going on to reach the output precision.
+ */
+
+#ifndef MPS_BUDGET_H_
+#define MPS_BUDGET_H_
+
+#include <mps/mps.h>
+
+MPS_BEGIN_DECLS
+
+void mps_budget_start (mps_context * s);
+
+mps_boolean mps_budget_time_over (mps_context * s);
+
+mps_boolean mps_budget_allows_precision (mps_context * s, long int wp);
+
+MPS_END_DECLS
+
+#endif /* MPS_BUDGET_H_ */
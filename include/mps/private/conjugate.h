@@ -0,0 +1,112 @@
+/*
+ * This file is part of MPSolve 3.1.5
+ *
+ * Copyright (C) 2001-2015, Dipartimento di Matematica "L. Tonelli", Pisa.
+ * License: http://www.gnu.org/licenses/gpl.html GPL version 3 or higher
+ *
+ * Authors:
+ *   Leonardo Robol <leonardo.robol@sns.it>
+ */
+
+/**
+ * @file
+ *
+ * @brief Iterations that exploit the symmetry of the roots of polynomials
+ * with real coefficients.
+ *
+ * The approximations are kept in conjugate pairs, and only one element of
+ * every pair is iterated, while the other one is obtained by conjugation.
+ * The pairing is computed at the start of every packet of iterations, and
+ * the array <code>conjugate</code> of <code>s->n</code> integers that
+ * describes it is not changed until the end of the packet:
+ *  - <code>conjugate[i] == i</code> if the i-th approximation is iterated
+ *    on its own. It is kept on the real axis if it is real;
+ *  - <code>conjugate[i] == j</code>, with <code>j != i</code>, if the i-th
+ *    approximation is iterated and the j-th one is its conjugate;
+ *  - <code>conjugate[i] == -1 - j</code> if the i-th approximation is the
+ *    conjugate of the j-th one, and is not iterated.
+ *
+ * A pair may be split in two real approximations during the packet. This
+ * is recorded in the <code>split</code> flag of the approximation that is
+ * iterated, which is only accessed while holding its lock, and from then on
+ * both the approximations are iterated on their own.
+ */
+
+#ifndef MPS_CONJUGATE_H_
+#define MPS_CONJUGATE_H_
+
+#include <pthread.h>
+#include <mps/mps.h>
+
+MPS_BEGIN_DECLS
+
+/**
+ * @brief Number of consecutive packets of floating point iterations that may
+ * end before all the approximations are in the root neighbourhood, or of
+ * DPE and multiprecision iterations that may end with a pair that touches
+ * the real axis, before the symmetry is abandoned and all the
+ * approximations are iterated.
+ */
+#define MPS_CONJUGATE_MAX_STALLS 2
+
+/**
+ * @brief Relative distance, in units of the machine precision, within which
+ * two floating point approximations are considered conjugate, or an
+ * approximation is considered real.
+ */
+#define MPS_CONJUGATE_TOLERANCE 1024
+
+/**
+ * @brief Pairing of the approximations used during a packet of iterations.
+ */
+struct mps_conjugate_pairs {
+  /**
+   * @brief Number of approximations.
+   */
+  int n;
+
+  /**
+   * @brief Phase of the iterations that use the pairing.
+   */
+  mps_phase phase;
+
+  /**
+   * @brief The pairing of the approximations, as described in conjugate.h.
+   */
+  int * conjugate;
+
+  /**
+   * @brief <code>split[i]</code> is true if the pair of the i-th
+   * approximation has been split during the packet.
+   */
+  mps_boolean * split;
+};
+
+mps_boolean mps_conjugate_symmetry_enabled (mps_context * s);
+
+mps_conjugate_pairs * mps_conjugate_fpairs (mps_context * s);
+
+mps_conjugate_pairs * mps_conjugate_dpairs (mps_context * s);
+
+mps_conjugate_pairs * mps_conjugate_mpairs (mps_context * s);
+
+mps_boolean mps_conjugate_skip (mps_conjugate_pairs * pairs, int i, pthread_mutex_t * roots_mutex);
+
+int mps_conjugate_fupdate (mps_context * s, mps_conjugate_pairs * pairs, int i, cplx_t old_value, cplx_t corr);
+
+int mps_conjugate_dupdate (mps_context * s, mps_conjugate_pairs * pairs, int i, cdpe_t old_value, cdpe_t corr);
+
+int mps_conjugate_mupdate (mps_context * s, mps_conjugate_pairs * pairs, int i, mpc_t old_value,
+                           mpc_t corr, pthread_mutex_t * aberth_mutex);
+
+mps_boolean mps_conjugate_fsplit (mps_context * s, mps_conjugate_pairs * pairs);
+
+void mps_conjugate_abandon (mps_context * s);
+
+void mps_conjugate_packet_done (mps_context * s, mps_conjugate_pairs * pairs, int zeros);
+
+int * mps_conjugate_mnodes (mps_context * s, mpc_t * nodes);
+
+MPS_END_DECLS
+
+#endif /* MPS_CONJUGATE_H_ */
@@ -0,0 +1,89 @@
+/*
+ * This file is part of MPSolve 3.1.5
+ *
+ * Copyright (C) 2001-2015, Dipartimento di Matematica "L. Tonelli", Pisa.
+ * License: http://www.gnu.org/licenses/gpl.html GPL version 3 or higher
+ *
+ * Authors:
+ *   Leonardo Robol <leonardo.robol@sns.it>
+ */
+
+/**
+ * @file
+ *
+ * @brief Structure of arrays copy of the floating point approximations,
+ * used to compute the Aberth sums with vector instructions.
+ */
+
+#ifndef MPS_FLOAT_ROOTS_H_
+#define MPS_FLOAT_ROOTS_H_
+
+#include <mps/mps.h>
+
+MPS_BEGIN_DECLS
+
+/**
+ * @brief Alignment, in bytes, of the arrays of a <code>mps_froot_array</code>.
+ */
+#define MPS_FROOT_ARRAY_ALIGNMENT 64
+
+/**
+ * @brief Signature of the kernels that accumulate
+ * \f$\sum_{i} 1 / (z - z_i)\f$ for <code>begin <= i < end</code>.
+ */
+typedef void (*mps_froot_array_kernel)(const double * re, const double * im,
+                                       int begin, int end, double zr, double zi,
+                                       double * sr, double * si);
+
+/**
+ * @brief The floating point approximations of the roots, with their real
+ * and imaginary parts stored in contiguous aligned arrays.
+ *
+ * The Aberth sums read the positions from here instead of following the
+ * pointers in <code>s->root</code>, so the inner loop runs over consecutive
+ * memory and is carried out with AVX2 or AVX-512 instructions when the CPU
+ * supports them. The kernel is selected at runtime when the array is created.
+ *
+ * The inclusion radii and the flags of the roots stay in the
+ * approximations, since the Newton corrections update them.
+ */
+struct mps_froot_array {
+  /**
+   * @brief Number of approximations.
+   */
+  int n;
+
+  /**
+   * @brief Real parts of the approximations.
+   */
+  double * re;
+
+  /**
+   * @brief Imaginary parts of the approximations.
+   */
+  double * im;
+
+  /**
+   * @brief The kernel used for the Aberth sums.
+   */
+  mps_froot_array_kernel kernel;
+
+  /**
+   * @brief Name of the instruction set used by <code>kernel</code>.
+   */
+  const char * kernel_name;
+};
+
+mps_froot_array * mps_froot_array_new (mps_context * s, int n);
+
+void mps_froot_array_free (mps_froot_array * roots);
+
+void mps_froot_array_load (mps_context * s, mps_froot_array * roots);
+
+void mps_froot_array_set (mps_froot_array * roots, int i, cplx_t value);
+
+void mps_froot_array_aberth (mps_froot_array * roots, int j, cplx_t abcorr);
+
+MPS_END_DECLS
+
+#endif /* endif MPS_FLOAT_ROOTS_H_ */
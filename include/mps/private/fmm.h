@@ -0,0 +1,177 @@
+/*
+ * This file is part of MPSolve 3.1.5
+ *
+ * Copyright (C) 2001-2015, Dipartimento di Matematica "L. Tonelli", Pisa.
+ * License: http://www.gnu.org/licenses/gpl.html GPL version 3 or higher
+ *
+ * Authors:
+ *   Leonardo Robol <leonardo.robol@sns.it>
+ */
+
+/**
+ * @file
+ *
+ * @brief Fast evaluation of the Aberth sums through a hierarchical
+ * (Barnes-Hut) decomposition of the approximations.
+ */
+
+#ifndef MPS_FMM_H_
+#define MPS_FMM_H_
+
+#include <mps/mps.h>
+
+MPS_BEGIN_DECLS
+
+/**
+ * @brief Default degree starting from which the Aberth sums are evaluated
+ * with a <code>mps_fmm_tree</code>, see mps_context_set_aberth_fmm().
+ */
+#define MPS_ABERTH_FMM_DEFAULT_DEGREE 2048
+
+/**
+ * @brief Default relative accuracy of the multipole expansions.
+ */
+#define MPS_ABERTH_FMM_DEFAULT_ACCURACY 1e-13
+
+/**
+ * @brief Maximum number of approximations stored in a leaf of
+ * a <code>mps_fmm_tree</code>.
+ */
+#define MPS_FMM_LEAF_SIZE 32
+
+/**
+ * @brief Maximum depth of a <code>mps_fmm_tree</code>. Leaves at this
+ * depth may contain more than <code>MPS_FMM_LEAF_SIZE</code> points, which
+ * happens only if many of them are (almost) coincident.
+ */
+#define MPS_FMM_MAX_DEPTH 48
+
+/**
+ * @brief Ratio between the radius of a node and the distance of a target
+ * from its center below which the multipole expansion of the node is used.
+ */
+#define MPS_FMM_THETA 0.5
+
+/**
+ * @brief Maximum number of terms in the multipole expansions.
+ */
+#define MPS_FMM_MAX_ORDER 64
+
+/**
+ * @brief A node of a <code>mps_fmm_tree</code>, i.e., a square of the
+ * complex plane with the approximations that it contains.
+ */
+struct mps_fmm_node {
+  /**
+   * @brief Center of the square, used for the expansion.
+   */
+  cplx_t center;
+
+  /**
+   * @brief Maximum distance of the points of the node from the center.
+   */
+  double radius;
+
+  /**
+   * @brief The points of the node are <code>perm[begin]</code>, ...,
+   * <code>perm[end - 1]</code>.
+   */
+  int begin;
+
+  /**
+   * @brief See <code>begin</code>.
+   */
+  int end;
+
+  /**
+   * @brief Indices of the children in the nodes of the tree, or -1.
+   */
+  int child[4];
+};
+
+/**
+ * @brief Quadtree with the multipole expansions needed to evaluate the
+ * Aberth sums \f$\sum_{i \neq j} 1 / (z_j - z_i)\f$ for all the roots in
+ * \f$O(n \log n)\f$ operations.
+ *
+ * The sum over the points of a node with center \f$c\f$ and radius \f$r\f$
+ * is replaced, for a target \f$z\f$ far enough from it, by
+ * \f[
+ *   \frac{1}{z - c} \sum_{k = 0}^{p-1} m_k \left( \frac{r}{z - c} \right)^k,
+ *   \qquad m_k = \sum_{i} \left( \frac{z_i - c}{r} \right)^k.
+ * \f]
+ * The order \f$p\f$ is chosen so that the error of every expansion, relative
+ * to the sum of the moduli of the terms that it replaces, is below the
+ * accuracy requested with mps_context_set_aberth_fmm().
+ *
+ * The roots that belong to a cluster are marked as exact, and their sums are
+ * computed directly by mps_faberth() and mps_daberth().
+ */
+struct mps_fmm_tree {
+  /**
+   * @brief Number of points.
+   */
+  int n;
+
+  /**
+   * @brief Number of terms of the multipole expansions.
+   */
+  int order;
+
+  /**
+   * @brief Positions of the points. In the DPE phase they are scaled by
+   * \f$2^{-e}\f$, where e is <code>exponent</code>.
+   */
+  cplx_t * points;
+
+  /**
+   * @brief Scaling exponent of the points, 0 in the floating point phase.
+   */
+  long int exponent;
+
+  /**
+   * @brief True for the roots whose sums must be computed directly.
+   */
+  mps_boolean * exact;
+
+  /**
+   * @brief Permutation that makes the points of every node contiguous.
+   */
+  int * perm;
+
+  /**
+   * @brief The nodes of the tree; the first one is the root.
+   */
+  mps_fmm_node * nodes;
+
+  /**
+   * @brief Number of nodes of the tree.
+   */
+  int n_nodes;
+
+  /**
+   * @brief Number of nodes allocated in <code>nodes</code>.
+   */
+  int nodes_size;
+
+  /**
+   * @brief Coefficients of the expansions; those of the k-th node are
+   * <code>moments[k * order]</code>, ...,
+   * <code>moments[(k + 1) * order - 1]</code>.
+   */
+  cplx_t * moments;
+};
+
+mps_fmm_tree * mps_fmm_ftree_new (mps_context * s);
+
+mps_fmm_tree * mps_fmm_dtree_new (mps_context * s);
+
+void mps_fmm_tree_free (mps_fmm_tree * tree);
+
+void mps_fmm_faberth (mps_context * s, mps_fmm_tree * tree, int j, cplx_t abcorr);
+
+void mps_fmm_daberth (mps_context * s, mps_fmm_tree * tree, int j, cdpe_t abcorr);
+
+MPS_END_DECLS
+
+#endif /* endif MPS_FMM_H_ */
@@ -26,15 +26,22 @@ void mps_fhessenberg_determinant (mps_context * ctx, cplx_t * hessenberg_matrix,
 void mps_fhessenberg_shifted_determinant (mps_context * ctx, cplx_t * hessenberg_matrix, 
 					  const cplx_t shift, size_t n, cplx_t output, 
 					  long int * exponent);
+void mps_fhessenberg_shifted_newton (mps_context * ctx, cplx_t * hessenberg_matrix, const cplx_t shift,
+                                     size_t n, cplx_t det, cplx_t ddet, double * error,
+                                     long int * exponent);
 
 void mps_dhessenberg_determinant (mps_context * ctx, cdpe_t * hessenberg_matrix, size_t n, cdpe_t output);
 void mps_dhessenberg_shifted_determinant (mps_context * ctx, cdpe_t * hessenberg_matrix, const cdpe_t shift,
                                           size_t n, cdpe_t output);
+void mps_dhessenberg_shifted_newton (mps_context * ctx, cdpe_t * hessenberg_matrix, const cdpe_t shift,
+                                     size_t n, cdpe_t det, cdpe_t ddet, rdpe_t error);
 
 void mps_mhessenberg_determinant (mps_context * ctx, mpc_t * hessenberg_matrix, size_t n,
                                   mpc_t output, rdpe_t error);
 void mps_mhessenberg_shifted_determinant (mps_context * ctx, mpc_t * hessenberg_matrix, mpc_t shift,
                                           size_t n, mpc_t output, rdpe_t error);
+void mps_mhessenberg_shifted_newton (mps_context * ctx, mpc_t * hessenberg_matrix, mpc_t shift,
+                                     size_t n, mpc_t det, mpc_t ddet, rdpe_t error);
 
 MPS_END_DECLS
 
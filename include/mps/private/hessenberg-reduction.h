@@ -0,0 +1,28 @@
+/*
+ * This file is part of MPSolve 3.1.5
+ *
+ * Copyright (C) 2001-2015, Dipartimento di Matematica "L. Tonelli", Pisa.
+ * License: http://www.gnu.org/licenses/gpl.html GPL version 3 or higher
+ *
+ * Authors:
+ *   Leonardo Robol <leonardo.robol@sns.it>
+ */
+
+/**
+ * @file
+ *
+ * @brief Reduction of a matrix to upper Hessenberg form by similarity.
+ */
+
+#ifndef MPS_HESSENBERG_REDUCTION_H_
+#define MPS_HESSENBERG_REDUCTION_H_
+
+#include <mps/mps.h>
+
+MPS_BEGIN_DECLS
+
+void mps_mhessenberg_reduce (mps_context * ctx, mpc_t * matrix, size_t n);
+
+MPS_END_DECLS
+
+#endif /* endif MPS_HESSENBERG_REDUCTION */
@@ -18,6 +18,12 @@
 
 MPS_BEGIN_DECLS
 
+/**
+ * @brief Maximum number of points evaluated at once by mps_fhorner_block()
+ * and mps_dhorner_block().
+ */
+#define MPS_HORNER_BLOCK_SIZE 8
+
 /* These two routines are implemented in newton.c */
 void mps_parhorner (mps_context * st, int n, mpc_t x, mpc_t p[],
                     mps_boolean b[], mpc_t s, int n_thread);
@@ -30,11 +36,22 @@ void mps_fhorner_with_error (mps_context * s, mps_monomial_poly * p, cplx_t x,
                              cplx_t value, double * relative_error);
 void mps_dhorner (mps_context * s, mps_monomial_poly * p, cdpe_t x, cdpe_t value);
 void mps_dhorner_with_error (mps_context * s, mps_monomial_poly * p, cdpe_t x, cdpe_t value, rdpe_t relative_error);
+void mps_fhorner_compensated (mps_context * s, mps_monomial_poly * p, cplx_t x,
+                              mps_boolean reversed, cplx_t value, double * error);
+void mps_dhorner_compensated (mps_context * s, mps_monomial_poly * p, cdpe_t x,
+                              cdpe_t value, rdpe_t error);
+void mps_ddhorner (mps_context * s, mps_monomial_poly * p, cdd_t x, cdd_t value);
+void mps_ddhorner_with_error (mps_context * s, mps_monomial_poly * p, cdd_t x,
+                              cdd_t value, double * relative_error);
 void mps_mhorner (mps_context * s, mps_monomial_poly * p, mpc_t x, mpc_t value);
 void mps_mhorner_with_error (mps_context * s, mps_monomial_poly * p,
                              mpc_t x, mpc_t value, rdpe_t relative_error, long int wp);
 void mps_mhorner_with_error2 (mps_context * s, mps_monomial_poly * p, mpc_t x,
                               mpc_t value, rdpe_t relative_error, long int wp);
+void mps_fhorner_block (mps_context * s, mps_monomial_poly * p, int m, cplx_t * x, double * ax,
+                        mps_boolean reversed, cplx_t * value, cplx_t * derivative, double * apol);
+void mps_dhorner_block (mps_context * s, mps_monomial_poly * p, int m, cdpe_t * x, rdpe_t * ax,
+                        cdpe_t * value, cdpe_t * derivative, rdpe_t * apol);
 
 MPS_END_DECLS
 
@@ -0,0 +1,530 @@
+/*
+ * This file is part of MPSolve 3.1.5
+ *
+ * Copyright (C) 2001-2015, Dipartimento di Matematica "L. Tonelli", Pisa.
+ * License: http://www.gnu.org/licenses/gpl.html GPL version 3 or higher
+ *
+ * Authors:
+ *   Leonardo Robol <leonardo.robol@sns.it>
+ */
+
+/**
+ * @file
+ *
+ * @brief Multiprecision complex kernels with a fixed number of limbs.
+ *
+ * The <code>mpc_t</code> type is made of two <code>mpf_t</code>, and every
+ * operation on it goes through the general <code>mpf_*</code> functions,
+ * which handle arbitrary precisions and the allocation of the results.
+ * The functions in this file work instead on numbers whose mantissa is made
+ * of exactly n limbs, normalized so that the most significant bit is set,
+ * and are built directly on the <code>mpn_*</code> layer of GMP.
+ *
+ * All the functions take the number of limbs n as their first argument and
+ * are always inlined, so that calling them with a constant n yields code
+ * specialized for that number of limbs. The kernels of MPSolve select n
+ * with mps_mpcn_limbs() and then switch on it, with one case for each of
+ * 2, 4 and 8 limbs, i.e., up to 128, 256 and 512 bits.
+ *
+ * The results are truncated, as in the <code>mpf_*</code> functions, and
+ * their relative error is bounded by \f$2^{2 - 64 n}\f$, that is smaller
+ * than the precision of the <code>mpc_t</code> they replace.
+ */
+
+#ifndef MPS_MPCN_H_
+#define MPS_MPCN_H_
+
+#include <limits.h>
+#include <string.h>
+#include <mps/mps.h>
+
+MPS_BEGIN_DECLS
+
+/**
+ * @brief Maximum number of limbs of the mantissa of a <code>mps_mprn_t</code>.
+ */
+#define MPS_MPCN_MAX_LIMBS 8
+
+#if defined(__GNUC__)
+#define MPS_MPCN_INLINE static inline __attribute__ ((always_inline))
+#else
+#define MPS_MPCN_INLINE static inline
+#endif
+
+/*! @cond PRIVATE */
+typedef struct {
+  int sign;
+  long int exp;
+  mp_limb_t d[MPS_MPCN_MAX_LIMBS];
+} __mps_mprn_struct;
+
+typedef struct {
+  __mps_mprn_struct r, i;
+} __mps_mpcn_struct;
+/*! @endcond */
+
+/**
+ * @brief Real number \f$sign \cdot 0.d_{n-1} \dots d_0 \cdot 2^{exp}\f$,
+ * where the top bit of \f$d_{n-1}\f$ is set, or zero if sign is 0.
+ */
+typedef __mps_mprn_struct mps_mprn_t[1];
+
+/**
+ * @brief Complex number with real and imaginary parts of type mps_mprn_t.
+ */
+typedef __mps_mpcn_struct mps_mpcn_t[1];
+
+#define mps_mpcn_Re(C) (&(C)->r)
+#define mps_mpcn_Im(C) (&(C)->i)
+
+/**
+ * @brief Number of limbs of the fixed size kernels that can replace the
+ * operations on <code>mpc_t</code> with precision prec, or 0 if there are
+ * no such kernels.
+ */
+MPS_MPCN_INLINE int
+mps_mpcn_limbs (long int prec)
+{
+#if GMP_NAIL_BITS == 0
+  if (prec < 2 * GMP_NUMB_BITS)
+    return 2;
+  if (prec < 4 * GMP_NUMB_BITS)
+    return 4;
+  if (prec < 8 * GMP_NUMB_BITS)
+    return 8;
+#endif
+  return 0;
+}
+
+MPS_MPCN_INLINE int
+mps_mpcn_clz (mp_limb_t x)
+{
+#if defined(__GNUC__)
+  if (sizeof (mp_limb_t) == sizeof (unsigned long))
+    return __builtin_clzl (x) - (int)(sizeof (unsigned long) * CHAR_BIT - GMP_NUMB_BITS);
+  if (sizeof (mp_limb_t) == sizeof (unsigned long long))
+    return __builtin_clzll (x) - (int)(sizeof (unsigned long long) * CHAR_BIT - GMP_NUMB_BITS);
+#endif
+  {
+    int k = 0;
+    while (!(x & ((mp_limb_t) 1 << (GMP_NUMB_BITS - 1))))
+      {
+        x <<= 1;
+        k++;
+      }
+    return k;
+  }
+}
+
+MPS_MPCN_INLINE void
+mps_mprn_set_zero (mps_mprn_t r)
+{
+  r->sign = 0;
+  r->exp = 0;
+}
+
+/**
+ * @brief Normalize the n + 1 limbs in t, whose value is
+ * \f$0.t_n \dots t_0 \cdot 2^{exp}\f$, and store the top n in r.
+ */
+MPS_MPCN_INLINE void
+mps_mprn_normalize (const int n, mps_mprn_t r, mp_limb_t * t, long int exp, int sign)
+{
+  int k = 0, c;
+
+  while (k <= n && t[n - k] == 0)
+    k++;
+
+  if (k > n)
+    {
+      mps_mprn_set_zero (r);
+      return;
+    }
+
+  if (k > 0)
+    {
+      memmove (t + k, t, (n + 1 - k) * sizeof (mp_limb_t));
+      memset (t, 0, k * sizeof (mp_limb_t));
+      exp -= (long int) k * GMP_NUMB_BITS;
+    }
+
+  c = mps_mpcn_clz (t[n]);
+  if (c > 0)
+    {
+      mpn_lshift (t, t, n + 1, c);
+      exp -= c;
+    }
+
+  memcpy (r->d, t + 1, n * sizeof (mp_limb_t));
+  r->exp = exp;
+  r->sign = sign;
+}
+
+MPS_MPCN_INLINE void
+mps_mprn_set (const int n, mps_mprn_t r, const mps_mprn_t a)
+{
+  r->sign = a->sign;
+  if (a->sign != 0)
+    {
+      r->exp = a->exp;
+      memcpy (r->d, a->d, n * sizeof (mp_limb_t));
+    }
+}
+
+MPS_MPCN_INLINE void
+mps_mprn_neg (const int n, mps_mprn_t r, const mps_mprn_t a)
+{
+  mps_mprn_set (n, r, a);
+  r->sign = -r->sign;
+}
+
+/**
+ * @brief Set r to the value of f, truncated to n limbs.
+ */
+MPS_MPCN_INLINE void
+mps_mprn_set_mpf (const int n, mps_mprn_t r, mpf_srcptr f)
+{
+  mp_limb_t t[MPS_MPCN_MAX_LIMBS + 1];
+  int size = (f->_mp_size >= 0) ? f->_mp_size : -f->_mp_size;
+  int k = MIN (size, n + 1);
+
+  if (size == 0)
+    {
+      mps_mprn_set_zero (r);
+      return;
+    }
+
+  memset (t, 0, (n + 1 - k) * sizeof (mp_limb_t));
+  memcpy (t + n + 1 - k, f->_mp_d + size - k, k * sizeof (mp_limb_t));
+
+  mps_mprn_normalize (n, r, t, (long int) f->_mp_exp * GMP_NUMB_BITS,
+                      f->_mp_size > 0 ? 1 : -1);
+}
+
+/**
+ * @brief Set f to the value of a, rounded to the precision of f.
+ */
+MPS_MPCN_INLINE void
+mps_mprn_get_mpf (const int n, mpf_ptr f, const mps_mprn_t a)
+{
+  __mpf_struct view;
+  int k = 0;
+
+  if (a->sign == 0)
+    {
+      mpf_set_ui (f, 0U);
+      return;
+    }
+
+  /* Drop the trailing zero limbs, and see the mantissa as a mpf_t with
+   * value in [1/2, 1) */
+  while (a->d[k] == 0)
+    k++;
+
+  view._mp_prec = n;
+  view._mp_size = (n - k) * a->sign;
+  view._mp_exp = 0;
+  view._mp_d = (mp_limb_t *) a->d + k;
+
+  if (a->exp >= 0)
+    mpf_mul_2exp (f, &view, a->exp);
+  else
+    mpf_div_2exp (f, &view, -a->exp);
+}
+
+/**
+ * @brief Set r to an approximation of a in the DPE format.
+ */
+MPS_MPCN_INLINE void
+mps_mprn_get_rdpe (const int n, rdpe_t r, const mps_mprn_t a)
+{
+  if (a->sign == 0)
+    rdpe_set (r, rdpe_zero);
+  else
+    rdpe_set_2dl (r, a->sign * (double) a->d[n - 1], a->exp - GMP_NUMB_BITS);
+}
+
+/**
+ * @brief Set r to a + b.
+ */
+MPS_MPCN_INLINE void
+mps_mprn_add (const int n, mps_mprn_t r, const mps_mprn_t a, const mps_mprn_t b)
+{
+  mp_limb_t ta[MPS_MPCN_MAX_LIMBS + 1], tb[MPS_MPCN_MAX_LIMBS + 1];
+  long int shift;
+  int sign;
+
+  if (b->sign == 0)
+    {
+      mps_mprn_set (n, r, a);
+      return;
+    }
+  if (a->sign == 0)
+    {
+      mps_mprn_set (n, r, b);
+      return;
+    }
+
+  /* Make a the operand with the largest exponent */
+  if (a->exp < b->exp)
+    {
+      const __mps_mprn_struct * tmp = a;
+      a = b;
+      b = tmp;
+    }
+
+  shift = a->exp - b->exp;
+  if (shift >= (long int)(n + 1) * GMP_NUMB_BITS)
+    {
+      mps_mprn_set (n, r, a);
+      return;
+    }
+
+  /* Use one guard limb at the bottom, and align b to a */
+  ta[0] = 0;
+  memcpy (ta + 1, a->d, n * sizeof (mp_limb_t));
+
+  tb[0] = 0;
+  memcpy (tb + 1, b->d, n * sizeof (mp_limb_t));
+  if (shift > 0)
+    {
+      int q = shift / GMP_NUMB_BITS, c = shift % GMP_NUMB_BITS;
+
+      if (c > 0)
+        mpn_rshift (tb, tb + q, n + 1 - q, c);
+      else
+        memmove (tb, tb + q, (n + 1 - q) * sizeof (mp_limb_t));
+      memset (tb + n + 1 - q, 0, q * sizeof (mp_limb_t));
+    }
+
+  if (a->sign == b->sign)
+    {
+      sign = a->sign;
+      if (mpn_add_n (ta, ta, tb, n + 1))
+        {
+          mpn_rshift (ta, ta, n + 1, 1);
+          ta[n] |= (mp_limb_t) 1 << (GMP_NUMB_BITS - 1);
+          mps_mprn_normalize (n, r, ta, a->exp + 1, sign);
+          return;
+        }
+    }
+  else
+    {
+      int cmp = mpn_cmp (ta, tb, n + 1);
+
+      if (cmp == 0)
+        {
+          mps_mprn_set_zero (r);
+          return;
+        }
+      else if (cmp > 0)
+        {
+          sign = a->sign;
+          mpn_sub_n (ta, ta, tb, n + 1);
+        }
+      else
+        {
+          sign = b->sign;
+          mpn_sub_n (ta, tb, ta, n + 1);
+        }
+    }
+
+  mps_mprn_normalize (n, r, ta, a->exp, sign);
+}
+
+/**
+ * @brief Set r to a - b.
+ */
+MPS_MPCN_INLINE void
+mps_mprn_sub (const int n, mps_mprn_t r, const mps_mprn_t a, const mps_mprn_t b)
+{
+  mps_mprn_t nb;
+
+  mps_mprn_neg (n, nb, b);
+  mps_mprn_add (n, r, a, nb);
+}
+
+/**
+ * @brief Set r to a * b.
+ */
+MPS_MPCN_INLINE void
+mps_mprn_mul (const int n, mps_mprn_t r, const mps_mprn_t a, const mps_mprn_t b)
+{
+  mp_limb_t t[2 * MPS_MPCN_MAX_LIMBS];
+  long int exp;
+
+  if (a->sign == 0 || b->sign == 0)
+    {
+      mps_mprn_set_zero (r);
+      return;
+    }
+
+  mpn_mul_n (t, a->d, b->d, n);
+  exp = a->exp + b->exp;
+
+  /* The product of the mantissas is in [1/4, 1) */
+  if (!(t[2 * n - 1] >> (GMP_NUMB_BITS - 1)))
+    {
+      mpn_lshift (t + n - 1, t + n - 1, n + 1, 1);
+      exp--;
+    }
+
+  r->sign = a->sign * b->sign;
+  r->exp = exp;
+  memcpy (r->d, t + n, n * sizeof (mp_limb_t));
+}
+
+/**
+ * @brief Set r to a / b, with b different from zero.
+ */
+MPS_MPCN_INLINE void
+mps_mprn_div (const int n, mps_mprn_t r, const mps_mprn_t a, const mps_mprn_t b)
+{
+  mp_limb_t num[2 * MPS_MPCN_MAX_LIMBS], q[MPS_MPCN_MAX_LIMBS + 1], rem[MPS_MPCN_MAX_LIMBS];
+
+  if (a->sign == 0)
+    {
+      mps_mprn_set_zero (r);
+      return;
+    }
+
+  memset (num, 0, n * sizeof (mp_limb_t));
+  memcpy (num + n, a->d, n * sizeof (mp_limb_t));
+  mpn_tdiv_qr (q, rem, 0, num, 2 * n, b->d, n);
+
+  /* The quotient of the mantissas is in (1/2, 2) */
+  r->sign = a->sign * b->sign;
+  if (q[n])
+    {
+      mpn_rshift (q, q, n + 1, 1);
+      r->exp = a->exp - b->exp + 1;
+    }
+  else
+    r->exp = a->exp - b->exp;
+
+  memcpy (r->d, q, n * sizeof (mp_limb_t));
+}
+
+/***********************************************************
+**              complex functions                         **
+***********************************************************/
+
+MPS_MPCN_INLINE void
+mps_mpcn_set (const int n, mps_mpcn_t r, const mps_mpcn_t a)
+{
+  mps_mprn_set (n, &r->r, &a->r);
+  mps_mprn_set (n, &r->i, &a->i);
+}
+
+MPS_MPCN_INLINE void
+mps_mpcn_set_mpc (const int n, mps_mpcn_t r, mpc_t c)
+{
+  mps_mprn_set_mpf (n, &r->r, mpc_Re (c));
+  mps_mprn_set_mpf (n, &r->i, mpc_Im (c));
+}
+
+MPS_MPCN_INLINE void
+mps_mpcn_get_mpc (const int n, mpc_t c, const mps_mpcn_t a)
+{
+  mps_mprn_get_mpf (n, mpc_Re (c), &a->r);
+  mps_mprn_get_mpf (n, mpc_Im (c), &a->i);
+}
+
+MPS_MPCN_INLINE void
+mps_mpcn_get_cdpe (const int n, cdpe_t c, const mps_mpcn_t a)
+{
+  mps_mprn_get_rdpe (n, cdpe_Re (c), &a->r);
+  mps_mprn_get_rdpe (n, cdpe_Im (c), &a->i);
+}
+
+MPS_MPCN_INLINE int
+mps_mpcn_eq_zero (const mps_mpcn_t a)
+{
+  return a->r.sign == 0 && a->i.sign == 0;
+}
+
+MPS_MPCN_INLINE void
+mps_mpcn_add (const int n, mps_mpcn_t r, const mps_mpcn_t a, const mps_mpcn_t b)
+{
+  mps_mprn_add (n, &r->r, &a->r, &b->r);
+  mps_mprn_add (n, &r->i, &a->i, &b->i);
+}
+
+MPS_MPCN_INLINE void
+mps_mpcn_sub (const int n, mps_mpcn_t r, const mps_mpcn_t a, const mps_mpcn_t b)
+{
+  mps_mprn_sub (n, &r->r, &a->r, &b->r);
+  mps_mprn_sub (n, &r->i, &a->i, &b->i);
+}
+
+/**
+ * @brief Set r to a * b + c. The result can overlap with c, but not with
+ * a and b.
+ */
+MPS_MPCN_INLINE void
+mps_mpcn_fma (const int n, mps_mpcn_t r, const mps_mpcn_t a, const mps_mpcn_t b,
+              const mps_mpcn_t c)
+{
+  mps_mprn_t t1, t2;
+
+  mps_mprn_mul (n, t1, &a->r, &b->r);
+  mps_mprn_mul (n, t2, &a->i, &b->i);
+  mps_mprn_sub (n, t1, t1, t2);
+  mps_mprn_add (n, t1, t1, &c->r);
+
+  mps_mprn_mul (n, t2, &a->r, &b->i);
+  mps_mprn_add (n, &r->i, t2, &c->i);
+  mps_mprn_mul (n, t2, &a->i, &b->r);
+  mps_mprn_add (n, &r->i, &r->i, t2);
+
+  mps_mprn_set (n, &r->r, t1);
+}
+
+/**
+ * @brief Set r to a * b.
+ */
+MPS_MPCN_INLINE void
+mps_mpcn_mul (const int n, mps_mpcn_t r, const mps_mpcn_t a, const mps_mpcn_t b)
+{
+  mps_mprn_t t1, t2, t3, t4;
+
+  mps_mprn_mul (n, t1, &a->r, &b->r);
+  mps_mprn_mul (n, t2, &a->i, &b->i);
+  mps_mprn_mul (n, t3, &a->r, &b->i);
+  mps_mprn_mul (n, t4, &a->i, &b->r);
+  mps_mprn_sub (n, &r->r, t1, t2);
+  mps_mprn_add (n, &r->i, t3, t4);
+}
+
+/**
+ * @brief One step of the Horner scheme, i.e., set v to v * x + a.
+ */
+MPS_MPCN_INLINE void
+mps_mpcn_horner_step (const int n, mps_mpcn_t v, const mps_mpcn_t x, const mps_mpcn_t a)
+{
+  mps_mpcn_t t;
+
+  mps_mpcn_set (n, t, v);
+  mps_mpcn_fma (n, v, t, x, a);
+}
+
+/**
+ * @brief Set r to the inverse of a, with a different from zero.
+ */
+MPS_MPCN_INLINE void
+mps_mpcn_inv (const int n, mps_mpcn_t r, const mps_mpcn_t a)
+{
+  mps_mprn_t m, t;
+
+  mps_mprn_mul (n, m, &a->r, &a->r);
+  mps_mprn_mul (n, t, &a->i, &a->i);
+  mps_mprn_add (n, m, m, t);
+
+  mps_mprn_div (n, &r->r, &a->r, m);
+  mps_mprn_div (n, &r->i, &a->i, m);
+  r->i.sign = -r->i.sign;
+}
+
+MPS_END_DECLS
+
+#endif /* MPS_MPCN_H_ */
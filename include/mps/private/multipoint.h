@@ -0,0 +1,136 @@
+/*
+ * This file is part of MPSolve 3.1.5
+ *
+ * Copyright (C) 2001-2015, Dipartimento di Matematica "L. Tonelli", Pisa.
+ * License: http://www.gnu.org/licenses/gpl.html GPL version 3 or higher
+ *
+ * Authors:
+ *   Leonardo Robol <leonardo.robol@sns.it>
+ */
+
+/**
+ * @file
+ *
+ * @brief Multipoint evaluation of polynomials in multiprecision through
+ * a subproduct tree and a remainder tree.
+ */
+
+#ifndef MPS_MULTIPOINT_H_
+#define MPS_MULTIPOINT_H_
+
+#include <mps/mps.h>
+
+MPS_BEGIN_DECLS
+
+/**
+ * @brief Default degree starting from which the coefficients of the
+ * secular equation are regenerated with a multipoint evaluation, see
+ * mps_context_set_multipoint_regeneration().
+ */
+#define MPS_MULTIPOINT_REGENERATION_DEFAULT_DEGREE 2048
+
+/**
+ * @brief Maximum number of points in a leaf of a <code>mps_multipoint_tree</code>.
+ * The remainders are evaluated with the Horner scheme at these points.
+ */
+#define MPS_MULTIPOINT_LEAF_SIZE 8
+
+/**
+ * @brief Length of the shortest factor for which polynomials are multiplied
+ * through Kronecker substitution instead of with the schoolbook method.
+ */
+#define MPS_MULTIPOINT_KRONECKER_THRESHOLD 12
+
+/**
+ * @brief A node of a <code>mps_multipoint_tree</code>.
+ */
+struct mps_multipoint_node {
+  /**
+   * @brief The points of the node are <code>points[begin]</code>, ...,
+   * <code>points[end - 1]</code>.
+   */
+  int begin;
+
+  /**
+   * @brief See <code>begin</code>.
+   */
+  int end;
+
+  /**
+   * @brief Indices of the children in the nodes of the tree, or -1
+   * for the leaves.
+   */
+  int child[2];
+
+  /**
+   * @brief The <code>end - begin + 1</code> coefficients of the monic
+   * polynomial \f$\prod_j (x - x_j)\f$, where the product runs over the
+   * points of the node.
+   */
+  mpc_t * m;
+};
+
+/**
+ * @brief Subproduct tree of a set of points \f$x_1, \dots, x_n\f$.
+ *
+ * Every node stores the product of the linear factors \f$x - x_j\f$ of
+ * its points. A polynomial is evaluated at all the points by reducing it
+ * modulo the polynomials of the nodes, from the root down to the leaves.
+ * With the products computed through Kronecker substitution, and hence with
+ * the FFT based multiplication of GMP, this costs \f$O(M(n) \log n)\f$
+ * operations instead of the \f$O(n^2)\f$ of the Horner scheme.
+ *
+ * The points of every node are chosen spread around the set, taking
+ * alternately the points sorted by argument. This keeps the coefficients of
+ * the products, and therefore the cancellation in the remainders, small.
+ * The algorithm is not backward stable, though, so the result must be
+ * checked, for example by comparing evaluations carried out at different
+ * precisions.
+ */
+struct mps_multipoint_tree {
+  /**
+   * @brief Number of points.
+   */
+  int n;
+
+  /**
+   * @brief Precision of the computation, in bits.
+   */
+  long int prec;
+
+  /**
+   * @brief The points, permuted so that those of every node are contiguous.
+   */
+  mpc_t * points;
+
+  /**
+   * @brief <code>points[k]</code> is the <code>perm[k]</code>-th of the
+   * points given to mps_multipoint_tree_new().
+   */
+  int * perm;
+
+  /**
+   * @brief The nodes of the tree; the first one is the root.
+   */
+  mps_multipoint_node * nodes;
+
+  /**
+   * @brief Number of nodes of the tree.
+   */
+  int n_nodes;
+};
+
+void mps_mpc_poly_mul (mpc_t * c, mpc_t * a, int na, mpc_t * b, int nb, long int prec);
+
+mps_multipoint_tree * mps_multipoint_tree_new (mps_context * s, mpc_t * points, int n, long int prec);
+
+void mps_multipoint_tree_free (mps_multipoint_tree * tree);
+
+void mps_multipoint_tree_derivative (mps_multipoint_tree * tree, mpc_t * dm);
+
+void mps_multipoint_tree_eval (mps_context * s, mps_multipoint_tree * tree, int npolys,
+                               mpc_t ** polys, int * lengths, mpc_t ** values);
+
+MPS_END_DECLS
+
+#endif /* endif MPS_MULTIPOINT_H_ */
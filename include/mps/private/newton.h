@@ -22,8 +22,14 @@ void mps_fnewton (mps_context * st, mps_polynomial * p,
                   mps_approximation * root, cplx_t corr);
 void mps_dnewton (mps_context * st, mps_polynomial * p,
                   mps_approximation * root, cdpe_t corr);
+void mps_fnewton_block (mps_context * st, mps_polynomial * p,
+                        mps_approximation ** roots, int m, cplx_t * corr);
+void mps_dnewton_block (mps_context * st, mps_polynomial * p,
+                        mps_approximation ** roots, int m, cdpe_t * corr);
 void mps_mnewton (mps_context * st, mps_polynomial * p,
                   mps_approximation * root, mpc_t corr, long int wp);
+mps_boolean mps_ddnewton (mps_context * st, mps_polynomial * p,
+                          mps_approximation * root, cdd_t corr);
 
 MPS_END_DECLS
 
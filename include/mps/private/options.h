@@ -194,6 +194,12 @@ struct mps_output_configuration {
    */
   mps_search_set search_set;
 
+  /**
+   * @brief Disks and rectangles that make up the search set when it is
+   * <code>MPS_SEARCH_SET_CUSTOM</code>, or NULL if none has been given.
+   */
+  mps_search_region * search_region;
+
   /**
    * @brief These flags are used to determined which properties
    * of the roots must be determined by MPSolve.
@@ -0,0 +1,102 @@
+/*
+ * This file is part of MPSolve 3.1.5
+ *
+ * Copyright (C) 2001-2015, Dipartimento di Matematica "L. Tonelli", Pisa.
+ * License: http://www.gnu.org/licenses/gpl.html GPL version 3 or higher
+ *
+ * Authors:
+ *   Leonardo Robol <leonardo.robol@sns.it>
+ */
+
+/**
+ * @file
+ *
+ * @brief Target regions made of disks and rectangles, used as the search
+ * set when it is <code>MPS_SEARCH_SET_CUSTOM</code>.
+ *
+ * The region is the union of its disks and rectangles. The roots whose
+ * inclusion disks are certified out of the region are not refined anymore,
+ * and keep contributing to the Aberth sums and to the secular equation
+ * with the value they had when they have been excluded.
+ */
+
+#ifndef MPS_REGION_H_
+#define MPS_REGION_H_
+
+#include <mps/mps.h>
+
+MPS_BEGIN_DECLS
+
+/**
+ * @brief A closed disk in the complex plane.
+ */
+struct mps_search_disk {
+  /**
+   * @brief Center of the disk.
+   */
+  cplx_t center;
+
+  /**
+   * @brief Radius of the disk.
+   */
+  double radius;
+};
+
+/**
+ * @brief A closed rectangle in the complex plane, with sides parallel
+ * to the axes.
+ */
+struct mps_search_rectangle {
+  double re_min;
+  double re_max;
+  double im_min;
+  double im_max;
+};
+
+/**
+ * @brief Union of disks and rectangles where the roots are searched.
+ */
+struct mps_search_region {
+  /**
+   * @brief Disks of the region.
+   */
+  mps_search_disk * disks;
+
+  /**
+   * @brief Number of disks in <code>disks</code>.
+   */
+  int n_disks;
+
+  /**
+   * @brief Rectangles of the region.
+   */
+  mps_search_rectangle * rectangles;
+
+  /**
+   * @brief Number of rectangles in <code>rectangles</code>.
+   */
+  int n_rectangles;
+};
+
+mps_search_region * mps_search_region_new (void);
+
+void mps_search_region_free (mps_search_region * region);
+
+void mps_search_region_add_disk (mps_search_region * region, cplx_t center, double radius);
+
+void mps_search_region_add_rectangle (mps_search_region * region, double re_min, double im_min,
+                                      double re_max, double im_max);
+
+mps_root_inclusion mps_search_region_fclassify (mps_search_region * region, cplx_t center, double radius);
+
+mps_root_inclusion mps_search_region_finclusion (mps_context * s, int i, int n);
+
+mps_root_inclusion mps_search_region_dinclusion (mps_context * s, int i, int n);
+
+mps_root_inclusion mps_search_region_minclusion (mps_context * s, int i, int n);
+
+void mps_search_region_freeze (mps_context * s);
+
+MPS_END_DECLS
+
+#endif /* MPS_REGION_H_ */
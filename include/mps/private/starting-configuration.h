@@ -73,6 +73,11 @@ mps_starting_configuration mps_fcompute_starting_radii (mps_context * s, int n,
                                                         double clust_rad, double g, rdpe_t eps,
                                                         double fap[]);
 
+mps_starting_configuration mps_dcompute_starting_radii (mps_context * s, int n,
+                                                        mps_cluster_item * cluster_item,
+                                                        rdpe_t clust_rad, rdpe_t g, rdpe_t eps,
+                                                        rdpe_t dap[]);
+
 
 MPS_END_DECLS
 
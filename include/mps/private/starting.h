@@ -46,6 +46,11 @@ void mps_file_fstart (mps_context * ctx, mps_polynomial * poly, mps_approximatio
 void mps_file_dstart (mps_context * ctx, mps_polynomial * poly, mps_approximation ** approximations);
 void mps_file_mstart (mps_context * ctx, mps_polynomial * poly, mps_approximation ** approximations);
 
+/* functions in user-starting.c */
+void mps_user_fstart (mps_context * ctx, mps_polynomial * poly, mps_approximation ** approximations);
+void mps_user_dstart (mps_context * ctx, mps_polynomial * poly, mps_approximation ** approximations);
+void mps_user_mstart (mps_context * ctx, mps_polynomial * poly, mps_approximation ** approximations);
+
 MPS_END_DECLS
 
 #endif /* MPS_STARTING_H_ */
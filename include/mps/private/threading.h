@@ -25,6 +25,12 @@ MPS_BEGIN_DECLS
 #define MPS_THREAD_JOB_EXCEP -1
 #define MPS_MAX_CORES 8192
 
+/**
+ * @brief Number of times an idle thread looks for work, yielding the
+ * processor between each attempt, before parking.
+ */
+#define MPS_THREAD_SPIN_COUNT 128
+
 #define mps_with_lock(pmutex, code) { \
     pthread_mutex_lock (&pmutex); \
     code \
@@ -36,6 +42,12 @@ MPS_BEGIN_DECLS
  */
 typedef void * (*mps_thread_work)(void *);
 
+/**
+ * @brief A routine that processes the indices in <code>[begin, end)</code>
+ * of a loop run by mps_thread_pool_parallel_for().
+ */
+typedef void (*mps_thread_range_work)(mps_context * s, int begin, int end, void * user);
+
 /**
  * @brief A new job for <code>mps_thread_fsolve()</code>,
  * <code>mps_thread_dsolve()</code> or <code>mps_thread_msolve()</code>.
@@ -71,6 +83,10 @@ struct mps_thread_job {
  * A new job can be requested with the routine
  * <code>mps_thread_job_queue_next()</code>.
  *
+ * The order of the roots in <code>s->clusterization</code> is flattened
+ * in an array when the queue is created, and the jobs are handed out
+ * by atomically incrementing <code>cursor</code>, so that no lock is needed.
+ *
  * @see mps_thread_job_queue_next()
  */
 struct mps_thread_job_queue {
@@ -87,26 +103,96 @@ struct mps_thread_job_queue {
   unsigned int n_roots;
 
   /**
-   * @brief Iterations that is being performed right now.
+   * @brief Indices of the roots, in the order in which they appear
+   * in the clusterization.
    */
-  int iter;
+  int * roots;
 
   /**
-   * @brief Next root to iterate on.
+   * @brief Element of <code>s->clusterization</code> containing the
+   * root <code>roots[k]</code>.
    */
-  mps_root * root;
+  mps_cluster_item ** cluster_items;
 
   /**
-   * @brief Element of <code>s->clusterization</code> that
-   * we are iterating on.
+   * @brief Index of the job that raises the exception. As in the
+   * original list based queue, this is the job on the last root of the
+   * first cluster in the iteration <code>max_iter</code>.
    */
-  mps_cluster_item * cluster_item;
+  long excep_job;
 
   /**
-   * @brief Internal mutex of the queue used to guarantee
-   * exclusive access.
+   * @brief Number of jobs handed out so far. The job <code>k</code> is
+   * the iteration <code>k / n_roots</code> on the root
+   * <code>roots[k % n_roots]</code>.
    */
-  pthread_mutex_t mutex;
+  volatile long cursor;
+};
+
+/**
+ * @brief Published copy of the root positions that is used to compute
+ * the Aberth sums in the threaded floating point and DPE iterations
+ * without locking.
+ *
+ * Every root is written only by the thread that holds its
+ * <code>roots_mutex</code>, while all the other threads copy the
+ * positions in a private array before computing the sums. Every position
+ * is guarded by a sequence counter, that is odd while the position is
+ * being written, so that a copy never mixes the parts of two different
+ * positions.
+ *
+ * If <code>gauss_seidel</code> is false the snapshot is double buffered:
+ * the jobs of the iteration <code>k</code> read the buffer
+ * <code>k % 2</code> and publish their corrections in the other one.
+ * The sweeps are not separated by a barrier, and the jobs of the
+ * iteration <code>k + 1</code> start while the last ones of the
+ * iteration <code>k</code> are still running. Hence a job usually reads
+ * the positions computed in the previous sweep, but it may also read
+ * the ones of an older sweep for the roots whose job has not completed
+ * yet, or the ones of the following sweep for the roots that have
+ * already been iterated again. Otherwise a single buffer is used and
+ * every correction is visible to the other threads as soon as it is
+ * published.
+ *
+ * It must be allocated using <code>mps_thread_root_snapshot_new()</code>
+ * and freed with <code>mps_thread_root_snapshot_free()</code>.
+ */
+struct mps_thread_root_snapshot {
+  /**
+   * @brief Number of roots in the snapshot.
+   */
+  int n;
+
+  /**
+   * @brief The phase for which the snapshot has been created. Only
+   * the buffers of this phase are allocated.
+   */
+  mps_phase phase;
+
+  /**
+   * @brief True if the corrections must be visible to the other
+   * threads as soon as they are published.
+   */
+  mps_boolean gauss_seidel;
+
+  /**
+   * @brief Floating point buffers. If <code>gauss_seidel</code> is true
+   * both pointers refer to the same array.
+   */
+  cplx_t * fvalues[2];
+
+  /**
+   * @brief DPE buffers. If <code>gauss_seidel</code> is true
+   * both pointers refer to the same array.
+   */
+  cdpe_t * dvalues[2];
+
+  /**
+   * @brief Sequence counters of the positions in the two buffers. If
+   * <code>gauss_seidel</code> is true both pointers refer to the same
+   * array.
+   */
+  unsigned int * seq[2];
 };
 
 /**
@@ -156,6 +242,14 @@ struct mps_thread_worker_data {
    */
   volatile mps_boolean *excep;
 
+  /**
+   * @brief Pointer to the boolean that is set to true when a Newton
+   * correction cannot be computed in double-double arithmetic. The packet
+   * of iterations is then interrupted, and carried out again in
+   * multiprecision.
+   */
+  volatile mps_boolean *dd_failed;
+
   /**
    * @brief Array of <code>n</code> mutexes where <code>n = s->n</code>, i.e.
    * is the total number of roots of the polynomial.
@@ -190,6 +284,30 @@ struct mps_thread_worker_data {
    * may query for other work.
    */
   mps_thread_job_queue *queue;
+
+  /**
+   * @brief Published positions of the roots that are used to compute
+   * the Aberth sums without locking.
+   */
+  mps_thread_root_snapshot *snapshot;
+
+  /**
+   * @brief Private copy of the floating point positions in the
+   * snapshot, owned by this worker.
+   */
+  cplx_t *fvalues;
+
+  /**
+   * @brief Private copy of the DPE positions in the snapshot, owned
+   * by this worker.
+   */
+  cdpe_t *dvalues;
+
+  /**
+   * @brief Pairing of the approximations used in the packet, as described
+   * in conjugate.h, or NULL if all of them are iterated.
+   */
+  mps_conjugate_pairs *pairs;
 };
 
 /**
@@ -219,33 +337,26 @@ struct mps_thread {
   mps_thread_worker_data * data;
 
   /**
-   * @brief True if the thread is busy.
-   */
-  mps_boolean busy;
-
-  /**
-   * @brief Busy mutex of the thread. This is locked when the thread
-   * is doing something, se we can emulate a join on it by
-   * try to lock and unlock this mutex.
+   * @brief The deque of jobs owned by this thread. The thread pops
+   * the most recent jobs from its back, while the other threads
+   * of the pool steal the oldest ones from its front.
    */
-  pthread_mutex_t busy_mutex;
+  mps_thread_pool_queue * queue;
 
   /**
-   * @brief Condition that allow the thread to run. Before the thread
-   * finish the busy state (unlocking the busy mutex) or when it is
-   * created, it waits for the start condition to be true before
-   * doing anything.
+   * @brief The position of this thread in the <code>threads</code> array
+   * of the pool. It is used to choose the victims when stealing.
    */
-  pthread_cond_t start_condition;
+  int index;
 
   /**
    * @brief A boolean value that is true if the thread must continue to
    * poll, or false if it is required to exit. Since the thread
-   * may be waiting for work a call to pthread_cond_signal on
-   * start condition may be required to make it exit after setting
+   * may be parked waiting for work a broadcast on the park condition
+   * of the pool may be required to make it exit after setting
    * this variable.
    */
-  mps_boolean alive;
+  volatile mps_boolean alive;
 
   /**
    * @brief The routine that must be called when the thread starts.
@@ -261,6 +372,9 @@ struct mps_thread {
 /**
  * @brief An item that can be inserted and/or extracted from
  * a mps_thread_pool_queue.
+ *
+ * Items are stored by value in the queues, so submitting a job
+ * does not require any allocation.
  */
 struct mps_thread_pool_queue_item {
   /**
@@ -274,31 +388,58 @@ struct mps_thread_pool_queue_item {
   void * args;
 
   /**
-   * @brief The next item in the queue.
+   * @brief Counter of the pending jobs of the submitter, that is
+   * decreased when the job is completed.
    */
-  mps_thread_pool_queue_item * next;
+  volatile int * pending;
 };
 
 /**
- * @brief A queue of work items that thread can consume.
+ * @brief A double ended queue of work items that threads can consume.
+ *
+ * The items are kept in a circular buffer that is enlarged only when
+ * it is full, so in the steady state no allocation is performed.
  */
 struct mps_thread_pool_queue {
   /**
-   * @brief Pointer to the first item of the queue, or NULL if
-   * the queue is empty.
+   * @brief Circular buffer holding the items.
+   */
+  mps_thread_pool_queue_item * items;
+
+  /**
+   * @brief Number of items that fit in <code>items</code>.
+   */
+  int capacity;
+
+  /**
+   * @brief Index of the oldest item in the queue.
+   */
+  int front;
+
+  /**
+   * @brief Number of items currently in the queue.
    */
-  mps_thread_pool_queue_item * first;
+  int size;
 
   /**
-   * @brief Pointer to the last item of the queue, or NULL if
-   * the queue is empty.
+   * @brief Mutex guarding the queue. It is only contended when
+   * another thread is stealing from it.
    */
-  mps_thread_pool_queue_item * last;
+  pthread_mutex_t mutex;
 };
 
 /**
  * @brief A thread pool that contains a set of <code>mps_thread</code>
  * and allow to manage them as a set of worker.
+ *
+ * Every thread owns a <code>mps_thread_pool_queue</code>. Jobs submitted
+ * from outside the pool are distributed among the queues, while jobs
+ * submitted by a worker go in its own queue. Idle threads steal from the
+ * other queues, spin for a while and then park on <code>park_cond</code>.
+ *
+ * A pool can be shared by many contexts, see mps_context_set_thread_pool().
+ * In that case the threads consume their queues in FIFO order, so that the
+ * jobs of the different contexts are served in the order of submission.
  */
 struct mps_thread_pool {
   /**
@@ -323,24 +464,59 @@ struct mps_thread_pool {
   mps_thread * first;
 
   /**
-   * @brief Queue of the work that shall be consumed by the threads.
+   * @brief Array of the <code>n</code> threads of the pool, indexed by
+   * <code>mps_thread::index</code>.
    */
-  mps_thread_pool_queue * queue;
+  mps_thread ** threads;
+
+  /**
+   * @brief Lock protecting <code>threads</code> and <code>n</code>. Threads
+   * that are stealing take it for reading, while it is taken for writing
+   * when threads are added or removed.
+   */
+  pthread_rwlock_t threads_lock;
+
+  /**
+   * @brief Number of jobs that are waiting in the queues of the threads.
+   */
+  volatile int queued;
+
+  /**
+   * @brief Number of jobs that have been submitted and are not completed yet.
+   */
+  volatile int pending;
+
+  /**
+   * @brief Number of references to the pool. The pool is freed by
+   * mps_thread_pool_unref() when it drops to zero.
+   */
+  volatile int ref_count;
 
   /**
-   * @brief Mutex associated to the queue_changed condition.
+   * @brief Number of threads parked on <code>park_cond</code>.
    */
-  pthread_mutex_t queue_changed_mutex;
+  volatile int sleeping;
 
   /**
-   * @brief Condition that is notified when the queue changes.
+   * @brief Counter used to distribute the jobs submitted from outside
+   * the pool among the threads in a round-robin fashion.
    */
-  pthread_cond_t queue_changed;
+  volatile unsigned int next_queue;
+
+  /**
+   * @brief Mutex associated to the park condition.
+   */
+  pthread_mutex_t park_mutex;
+
+  /**
+   * @brief Condition on which idle threads sleep, after having
+   * spinned without finding any work.
+   */
+  pthread_cond_t park_cond;
 
   pthread_mutex_t work_completed_mutex;
   pthread_cond_t work_completed_cond;
-  int busy_counter;
-  
+
   /**
    * @brief When this vaulue is set to true every call to mps_assign_job
    * returns immediately. 
@@ -351,6 +527,12 @@ struct mps_thread_pool {
    * performance for the cases where only 1 CPU is available on the PC. 
    */
   mps_boolean strict_async;
+
+  /**
+   * @brief Placement of the threads on the CPUs. It must be changed
+   * with mps_thread_pool_set_affinity().
+   */
+  mps_thread_affinity affinity;
 };
 
 /* EXPORTED ROUTINES */
@@ -368,28 +550,68 @@ void mps_thread_pool_set_concurrency_limit (mps_context * s, mps_thread_pool * p
 
 void mps_thread_pool_assign (mps_context * s, mps_thread_pool * pool, mps_thread_work work, void * args);
 
+void mps_thread_pool_assign_bulk (mps_context * s, mps_thread_pool * pool, mps_thread_work work,
+                                  void * args, size_t size, int n);
+
+void mps_thread_pool_parallel_for (mps_context * s, mps_thread_pool * pool, int begin, int end,
+                                   int grain, mps_thread_range_work work, void * user);
+
 void mps_thread_pool_insert_new_thread (mps_context * s, mps_thread_pool * pool);
 
 void mps_thread_pool_wait (mps_context * s, mps_thread_pool * pool);
 
 mps_thread_pool * mps_thread_pool_get_system_pool (mps_context * s);
 
+void mps_thread_pool_set_affinity (mps_context * s, mps_thread_pool * pool,
+                                   mps_thread_affinity affinity);
+
 void mps_thread_pool_set_strict_async (mps_thread_pool * pool, mps_boolean strict_async);
 
 mps_thread_pool * mps_thread_pool_new (mps_context * s, int n_threads);
 
 void mps_thread_pool_free (mps_context * s, mps_thread_pool * pool);
 
+mps_thread_pool * mps_thread_pool_ref (mps_thread_pool * pool);
+
+void mps_thread_pool_unref (mps_context * s, mps_thread_pool * pool);
+
+mps_boolean mps_thread_pool_is_shared (mps_thread_pool * pool);
+
 mps_thread_job_queue * mps_thread_job_queue_new (mps_context * s);
 
 void mps_thread_job_queue_free (mps_thread_job_queue * q);
 
 mps_thread_job mps_thread_job_queue_next (mps_context * s, mps_thread_job_queue * q);
 
+mps_thread_root_snapshot * mps_thread_root_snapshot_new (mps_context * s, mps_phase phase);
+
+void mps_thread_root_snapshot_free (mps_thread_root_snapshot * snapshot);
+
+cplx_t * mps_thread_root_snapshot_fget (mps_thread_root_snapshot * snapshot, int iter, cplx_t * values);
+
+cdpe_t * mps_thread_root_snapshot_dget (mps_thread_root_snapshot * snapshot, int iter, cdpe_t * values);
+
+void mps_thread_root_snapshot_fpublish (mps_thread_root_snapshot * snapshot, int iter,
+                                        int i, cplx_t value);
+
+void mps_thread_root_snapshot_dpublish (mps_thread_root_snapshot * snapshot, int iter,
+                                        int i, cdpe_t value);
+
 void mps_thread_fpolzer (mps_context * s, int *nit, mps_boolean * excep, int required_zeros);
 
 void mps_thread_mpolzer (mps_context * s, int *nit, mps_boolean * excep, int required_zeros);
 
+/**
+ * @brief Largest working precision of the MP phase at which the packets of
+ * Aberth iterations are first carried out in double-double arithmetic, when
+ * the polynomial provides the ddnewton method. This covers the first precision
+ * level of the MP phase with the default minimum precision of 64 bits, that
+ * refines the approximations coming from the floating point or DPE phase.
+ */
+#define MPS_THREAD_DDPOLZER_MAX_PRECISION 192
+
+mps_boolean mps_thread_ddpolzer (mps_context * s, int *nit, mps_boolean * excep, int required_zeros);
+
 void mps_thread_dpolzer (mps_context * s, int *nit, mps_boolean * excep, int required_zeros);
 
 int mps_thread_get_core_number (mps_context * s);
@@ -0,0 +1,175 @@
+/*
+ * This file is part of MPSolve 3.1.5
+ *
+ * Copyright (C) 2001-2015, Dipartimento di Matematica "L. Tonelli", Pisa.
+ * License: http://www.gnu.org/licenses/gpl.html GPL version 3 or higher
+ *
+ * Authors:
+ *   Leonardo Robol <leonardo.robol@sns.it>
+ */
+
+#ifndef MPS_SPARSE_MONOMIAL_POLY_H_
+#define MPS_SPARSE_MONOMIAL_POLY_H_
+
+/**
+ * @file
+ * @brief Polynomials in the monomial basis that are stored as a list
+ * of (exponent, coefficient) pairs, suitable for lacunary polynomials
+ * such as \f$x^{100000} + x^{17} - 1\f$.
+ */
+
+#include <mps/polynomial.h>
+#include <gmp.h>
+#include <pthread.h>
+
+#define MPS_SPARSE_MONOMIAL_POLY_TYPE_NAME "mps_sparse_monomial_poly"
+#define MPS_SPARSE_MONOMIAL_POLY(t) (MPS_POLYNOMIAL_CAST (mps_sparse_monomial_poly, t))
+#define MPS_IS_SPARSE_MONOMIAL_POLY(t) \
+  (mps_polynomial_check_type (t, "mps_sparse_monomial_poly"))
+
+MPS_BEGIN_DECLS
+
+#ifdef _MPS_PRIVATE
+
+struct mps_sparse_monomial_poly_double_buffer {
+  char active;
+  mpc_t *mfpc1;
+  mpc_t *mfpc2;
+};
+
+/**
+ * @brief A polynomial in the monomial basis where only the non-zero
+ * terms are stored.
+ *
+ * All the arrays have <code>n_terms</code> valid entries, and are sorted
+ * by increasing exponent, so that the memory and the cost of an
+ * evaluation depend on the number of terms and not on the degree.
+ */
+struct mps_sparse_monomial_poly {
+  /**
+   * @brief Implementation of the methods.
+   */
+  struct mps_polynomial methods;
+
+  /**
+   * @brief Number of terms stored in the polynomial.
+   */
+  int n_terms;
+
+  /**
+   * @brief Number of terms that can be stored without reallocating
+   * the arrays.
+   */
+  int size;
+
+  /**
+   * @brief Exponents of the terms, in increasing order.
+   */
+  int *exponents;
+
+  /**
+   * @brief Floating point coefficients of the terms.
+   */
+  cplx_t *fpc;
+
+  /**
+   * @brief DPE coefficients of the terms.
+   */
+  cdpe_t *dpc;
+
+  /**
+   * @brief Multiprecision coefficients of the terms. This is the active
+   * buffer of <code>db</code>.
+   */
+  mpc_t *mfpc;
+
+  struct mps_sparse_monomial_poly_double_buffer db;
+
+  /**
+   * @brief Moduli of the coefficients of the terms.
+   */
+  double *fap;
+
+  /**
+   * @brief DPE version of fap.
+   */
+  rdpe_t *dap;
+
+  /**
+   * @brief Real part of the rational coefficients, used only if the
+   * structure of the polynomial is rational or integer.
+   */
+  mpq_t *initial_mqp_r;
+
+  /**
+   * @brief Imaginary part of the rational coefficients.
+   */
+  mpq_t *initial_mqp_i;
+
+  /**
+   * @brief Mutex that is held while the precision of the coefficients is
+   * raised.
+   */
+  pthread_mutex_t regenerating;
+
+  /**
+   * @brief Precision of the multiprecision coefficients.
+   */
+  long int prec;
+};
+
+#endif /* #ifdef _MPS_PRIVATE */
+
+mps_sparse_monomial_poly * mps_sparse_monomial_poly_new (mps_context * ctx, int degree);
+
+void mps_sparse_monomial_poly_free (mps_context * ctx, mps_polynomial * p);
+
+long int mps_sparse_monomial_poly_raise_data (mps_context * ctx, mps_polynomial * p, long int wp);
+
+void mps_sparse_monomial_poly_set_coefficient_d (mps_context * ctx, mps_sparse_monomial_poly * sp, int i,
+                                                 double real_part, double imag_part);
+
+void mps_sparse_monomial_poly_set_coefficient_q (mps_context * ctx, mps_sparse_monomial_poly * sp, int i,
+                                                 mpq_t real_part, mpq_t imag_part);
+
+void mps_sparse_monomial_poly_set_coefficient_f (mps_context * ctx, mps_sparse_monomial_poly * sp, int i,
+                                                 mpc_t coeff);
+
+void mps_sparse_monomial_poly_set_coefficient_int (mps_context * ctx, mps_sparse_monomial_poly * sp, int i,
+                                                   long long real_part, long long imag_part);
+
+mps_boolean mps_sparse_monomial_poly_feval (mps_context * ctx, mps_polynomial * p, cplx_t x, cplx_t value, double * error);
+
+mps_boolean mps_sparse_monomial_poly_deval (mps_context * ctx, mps_polynomial * p, cdpe_t x, cdpe_t value, rdpe_t error);
+
+mps_boolean mps_sparse_monomial_poly_meval (mps_context * ctx, mps_polynomial * p, mpc_t x, mpc_t value, rdpe_t error);
+
+void mps_sparse_monomial_poly_fnewton (mps_context * ctx, mps_polynomial * p,
+                                       mps_approximation * root, cplx_t corr);
+
+void mps_sparse_monomial_poly_dnewton (mps_context * ctx, mps_polynomial * p,
+                                       mps_approximation * root, cdpe_t corr);
+
+void mps_sparse_monomial_poly_mnewton (mps_context * ctx, mps_polynomial * p,
+                                       mps_approximation * root, mpc_t corr, long int wp);
+
+void mps_sparse_monomial_poly_fstart (mps_context * ctx, mps_polynomial * p, mps_approximation ** approximations);
+
+mps_boolean mps_sparse_monomial_poly_check_float_range (mps_context * ctx, mps_sparse_monomial_poly * sp);
+
+void mps_sparse_monomial_poly_dstart (mps_context * ctx, mps_polynomial * p, mps_approximation ** approximations);
+
+void mps_sparse_monomial_poly_mstart (mps_context * ctx, mps_polynomial * p, mps_approximation ** approximations);
+
+void mps_sparse_monomial_poly_get_leading_coefficient (mps_context * ctx, mps_polynomial * p,
+                                                       mpc_t leading_coefficient);
+
+int mps_sparse_monomial_poly_deflate (mps_context * ctx, mps_polynomial * p);
+
+mps_sparse_monomial_poly * mps_sparse_monomial_poly_read_from_stream (mps_context * ctx, mps_input_buffer * buffer,
+                                                                      mps_structure structure,
+                                                                      long int precision);
+
+MPS_END_DECLS
+
+#endif
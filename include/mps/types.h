@@ -76,6 +76,9 @@ struct mps_cluster;
 struct mps_cluster_item;
 struct mps_clusterization;
 
+/* conjugate.h */
+struct mps_conjugate_pairs;
+
 /* secular-equation.h */
 struct mps_secular_equation;
 struct mps_secular_iteration_data;
@@ -86,6 +89,9 @@ struct mps_monomial_poly;
 /* monomial-matrix-poly.h */
 struct mps_monomial_matrix_poly;
 
+/* sparse-monomial-poly.h */
+struct mps_sparse_monomial_poly;
+
 /* polynomial.h */
 struct mps_polynomial;
 
@@ -108,9 +114,15 @@ struct mps_list;
 struct mps_input_configuration;
 struct mps_output_configuration;
 
+/* region.h */
+struct mps_search_disk;
+struct mps_search_rectangle;
+struct mps_search_region;
+
 /* threading.h */
 struct mps_thread_job;
 struct mps_thread_job_queue;
+struct mps_thread_root_snapshot;
 struct mps_thread_worker_data;
 struct mps_thread;
 struct mps_thread_pool;
@@ -120,6 +132,21 @@ struct mps_thread_pool_queue_item;
 /* regeneration-driver.h */
 struct mps_regeneration_driver;
 
+/* float-roots.h */
+struct mps_froot_array;
+
+/* fmm.h */
+struct mps_fmm_node;
+struct mps_fmm_tree;
+
+/* multipoint.h */
+struct mps_multipoint_node;
+struct mps_multipoint_tree;
+
+/* batch.h */
+struct mps_batch_options;
+struct mps_batch_result;
+
 #else
 
 /* Forward declarations of the type used in the headers, so they can be
@@ -134,6 +161,9 @@ typedef struct mps_cluster mps_cluster;
 typedef struct mps_cluster_item mps_cluster_item;
 typedef struct mps_clusterization mps_clusterization;
 
+/* conjugate.h */
+typedef struct mps_conjugate_pairs mps_conjugate_pairs;
+
 /* secular-equation.h */
 typedef struct mps_secular_equation mps_secular_equation;
 typedef struct mps_secular_iteration_data mps_secular_iteration_data;
@@ -144,6 +174,9 @@ typedef struct mps_monomial_poly mps_monomial_poly;
 /* monomial-matrix-poly.h */
 typedef struct mps_monomial_matrix_poly mps_monomial_matrix_poly;
 
+/* sparse-monomial-poly.h */
+typedef struct mps_sparse_monomial_poly mps_sparse_monomial_poly;
+
 /* polynomial.h */
 typedef struct mps_polynomial mps_polynomial;
 
@@ -178,13 +211,20 @@ typedef enum mps_output_goal mps_output_goal;
 typedef enum mps_search_set mps_search_set;
 typedef enum mps_phase mps_phase;
 typedef enum mps_starting_strategy mps_starting_strategy;
+typedef enum mps_thread_affinity mps_thread_affinity;
 
 typedef struct mps_input_configuration mps_input_configuration;
 typedef struct mps_output_configuration mps_output_configuration;
 
+/* region.h */
+typedef struct mps_search_disk mps_search_disk;
+typedef struct mps_search_rectangle mps_search_rectangle;
+typedef struct mps_search_region mps_search_region;
+
 /* threading.h */
 typedef struct mps_thread_job mps_thread_job;
 typedef struct mps_thread_job_queue mps_thread_job_queue;
+typedef struct mps_thread_root_snapshot mps_thread_root_snapshot;
 typedef struct mps_thread_worker_data mps_thread_worker_data;
 typedef struct mps_thread mps_thread;
 typedef struct mps_thread_pool mps_thread_pool;
@@ -194,6 +234,21 @@ typedef struct mps_thread_pool_queue_item mps_thread_pool_queue_item;
 /* regeneration-driver.h */
 typedef struct mps_regeneration_driver mps_regeneration_driver;
 
+/* float-roots.h */
+typedef struct mps_froot_array mps_froot_array;
+
+/* fmm.h */
+typedef struct mps_fmm_node mps_fmm_node;
+typedef struct mps_fmm_tree mps_fmm_tree;
+
+/* multipoint.h */
+typedef struct mps_multipoint_node mps_multipoint_node;
+typedef struct mps_multipoint_tree mps_multipoint_tree;
+
+/* batch.h */
+typedef struct mps_batch_options mps_batch_options;
+typedef struct mps_batch_result mps_batch_result;
+
 #endif
 
 /**
@@ -358,7 +413,10 @@ enum mps_option_key {
   MPS_KEY_PRECISION,
 
   /* Key introduced in MPSolve 3.1 */
-  MPS_FLAG_CHEBYSHEV
+  MPS_FLAG_CHEBYSHEV,
+
+  /* Monomial polynomials stored as (exponent, coefficient) pairs */
+  MPS_FLAG_LACUNARY
 };
 
 /**
@@ -465,7 +523,8 @@ enum mps_search_set {
   MPS_SEARCH_SET_IMAG,
 
   /**
-   * @brief Custom set specified by the user.
+   * @brief Custom set specified by the user, as a union of disks and
+   * rectangles.
    */
   MPS_SEARCH_SET_CUSTOM
 };
@@ -476,7 +535,8 @@ enum mps_search_set {
 enum mps_representation {
   MPS_REPRESENTATION_SECULAR,
   MPS_REPRESENTATION_MONOMIAL,
-  MPS_REPRESENTATION_CHEBYSHEV
+  MPS_REPRESENTATION_CHEBYSHEV,
+  MPS_REPRESENTATION_SPARSE_MONOMIAL
 };
 
 /**
@@ -485,7 +545,37 @@ enum mps_representation {
 enum mps_starting_strategy {
   MPS_STARTING_STRATEGY_DEFAULT,
   MPS_STARTING_STRATEGY_RECURSIVE,
-  MPS_STARTING_STRATEGY_FILE
+  MPS_STARTING_STRATEGY_FILE,
+
+  /**
+   * @brief Use the approximations set with
+   * mps_context_set_starting_approximations_d() or
+   * mps_context_set_starting_approximations_m().
+   */
+  MPS_STARTING_STRATEGY_USER
+};
+
+/**
+ * @brief Placement of the threads of a <code>mps_thread_pool</code>
+ * on the CPUs of the system.
+ */
+enum mps_thread_affinity {
+  /**
+   * @brief Threads can run on any CPU.
+   */
+  MPS_THREAD_AFFINITY_NONE,
+
+  /**
+   * @brief Every thread is bound to a single CPU. CPUs of the same
+   * NUMA node are used first.
+   */
+  MPS_THREAD_AFFINITY_CORE,
+
+  /**
+   * @brief Every thread is bound to all the CPUs of a NUMA node, and
+   * the threads are distributed evenly among the nodes.
+   */
+  MPS_THREAD_AFFINITY_NODE
 };
 
 #endif /* endif MPS_TYPES_H_ */
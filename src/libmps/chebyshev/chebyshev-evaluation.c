@@ -8,8 +8,252 @@
  *   Leonardo Robol <leonardo.robol@sns.it>
  */
 
+/*
+ * The polynomial p(x) = c_0 T_0(x) + ... + c_n T_n(x) and its derivative
+ * are evaluated with the Clenshaw recurrence
+ *
+ *   b_k  = c_k + 2 x b_{k+1} - b_{k+2},             p(x)  = c_0 + x b_1 - b_2,
+ *   b'_k = 2 b_{k+1} + 2 x b'_{k+1} - b'_{k+2},     p'(x) = b_1 + x b'_1 - b'_2,
+ *
+ * with b_{n+1} = b_{n+2} = 0. The rounding error committed in the computation
+ * of b_k is at most a few units in the last place of |c_k| + |2 x b_{k+1}| + |b_{k+2}|,
+ * and it is propagated to the following ones by the same recurrence. The bound
+ * to the error on p(x) is then obtained by running the recurrence on these
+ * quantities, with 2|x| in place of 2x: this is the s_k sequence below, which
+ * has to be multiplied by 6u, since the complex product is affected by
+ * an error of at most sqrt(5) u, and the two sums by u each, plus one unit for
+ * the rounding of the coefficients.
+ */
+
 #include <mps/mps.h>
 
+static void
+mps_chebyshev_fclenshaw (mps_chebyshev_poly * cpoly, cplx_t x,
+                         cplx_t p, cplx_t p1, double * error)
+{
+  int k;
+  double ax = cplx_mod (x), s0, s1 = 0.0, s2 = 0.0;
+  cplx_t b0, b1, b2, d0, d1, d2, t;
+
+  cplx_set (b1, cplx_zero);
+  cplx_set (b2, cplx_zero);
+  cplx_set (d1, cplx_zero);
+  cplx_set (d2, cplx_zero);
+
+  for (k = MPS_POLYNOMIAL (cpoly)->degree; k >= 1; k--)
+    {
+      if (p1)
+        {
+          cplx_mul (t, x, d1);
+          cplx_add_eq (t, b1);
+          cplx_mul_eq_d (t, 2.0);
+          cplx_sub (d0, t, d2);
+          cplx_set (d2, d1);
+          cplx_set (d1, d0);
+        }
+
+      cplx_mul (t, x, b1);
+      cplx_mul_eq_d (t, 2.0);
+      s0 = 2.0 * ax * s1 + s2 + cplx_mod (cpoly->fpc[k]) + cplx_mod (t) + cplx_mod (b2);
+      cplx_add (b0, cpoly->fpc[k], t);
+      cplx_sub_eq (b0, b2);
+
+      cplx_set (b2, b1);
+      cplx_set (b1, b0);
+      s2 = s1;
+      s1 = s0;
+    }
+
+  cplx_mul (t, x, b1);
+  *error = (ax * s1 + s2 + cplx_mod (cpoly->fpc[0]) + cplx_mod (t) + cplx_mod (b2)) *
+           3.0 * DBL_EPSILON;
+  cplx_add (p, cpoly->fpc[0], t);
+  cplx_sub_eq (p, b2);
+
+  if (p1)
+    {
+      cplx_mul (t, x, d1);
+      cplx_add (p1, b1, t);
+      cplx_sub_eq (p1, d2);
+    }
+}
+
+static void
+mps_chebyshev_dclenshaw (mps_chebyshev_poly * cpoly, cdpe_t x,
+                         cdpe_t p, cdpe_t p1, rdpe_t error)
+{
+  int k;
+  rdpe_t ax, s0, s1, s2, rtmp;
+  cdpe_t b0, b1, b2, d0, d1, d2, t;
+
+  cdpe_mod (ax, x);
+  rdpe_set (s1, rdpe_zero);
+  rdpe_set (s2, rdpe_zero);
+  cdpe_set (b1, cdpe_zero);
+  cdpe_set (b2, cdpe_zero);
+  cdpe_set (d1, cdpe_zero);
+  cdpe_set (d2, cdpe_zero);
+
+  for (k = MPS_POLYNOMIAL (cpoly)->degree; k >= 1; k--)
+    {
+      if (p1)
+        {
+          cdpe_mul (t, x, d1);
+          cdpe_add_eq (t, b1);
+          cdpe_mul_eq_d (t, 2.0);
+          cdpe_sub (d0, t, d2);
+          cdpe_set (d2, d1);
+          cdpe_set (d1, d0);
+        }
+
+      cdpe_mul (t, x, b1);
+      cdpe_mul_eq_d (t, 2.0);
+
+      rdpe_mul (s0, ax, s1);
+      rdpe_mul_eq_d (s0, 2.0);
+      rdpe_add_eq (s0, s2);
+      cdpe_mod (rtmp, cpoly->dpc[k]);
+      rdpe_add_eq (s0, rtmp);
+      cdpe_mod (rtmp, t);
+      rdpe_add_eq (s0, rtmp);
+      cdpe_mod (rtmp, b2);
+      rdpe_add_eq (s0, rtmp);
+
+      cdpe_add (b0, cpoly->dpc[k], t);
+      cdpe_sub_eq (b0, b2);
+
+      cdpe_set (b2, b1);
+      cdpe_set (b1, b0);
+      rdpe_set (s2, s1);
+      rdpe_set (s1, s0);
+    }
+
+  cdpe_mul (t, x, b1);
+
+  rdpe_mul (s0, ax, s1);
+  rdpe_add_eq (s0, s2);
+  cdpe_mod (rtmp, cpoly->dpc[0]);
+  rdpe_add_eq (s0, rtmp);
+  cdpe_mod (rtmp, t);
+  rdpe_add_eq (s0, rtmp);
+  cdpe_mod (rtmp, b2);
+  rdpe_add_eq (s0, rtmp);
+  rdpe_mul_d (error, s0, 3.0 * DBL_EPSILON);
+
+  cdpe_add (p, cpoly->dpc[0], t);
+  cdpe_sub_eq (p, b2);
+
+  if (p1)
+    {
+      cdpe_mul (t, x, d1);
+      cdpe_add (p1, b1, t);
+      cdpe_sub_eq (p1, d2);
+    }
+}
+
+/*
+ * Multiprecision version of the Clenshaw recurrence, carried out with
+ * working precision wp. The coefficients have to be available at least
+ * with this precision.
+ */
+static void
+mps_chebyshev_mclenshaw (mps_chebyshev_poly * cpoly, mpc_t x,
+                         mpc_t p, mpc_t p1, rdpe_t error, long int wp)
+{
+  int k;
+  mpc_scratch * sc = mpc_scratch_get ();
+  mpc_ptr x2, b1, b2, d1, d2, t;
+  rdpe_t ax, s0, s1, s2, rtmp;
+
+  x2 = mpc_scratch_push (sc, wp);
+  b1 = mpc_scratch_push (sc, wp);
+  b2 = mpc_scratch_push (sc, wp);
+  d1 = mpc_scratch_push (sc, wp);
+  d2 = mpc_scratch_push (sc, wp);
+
+  mpc_rmod (ax, x);
+  mpc_mul_2exp (x2, x, 1);
+  rdpe_set (s1, rdpe_zero);
+  rdpe_set (s2, rdpe_zero);
+  mpc_set_ui (b1, 0U, 0U);
+  mpc_set_ui (b2, 0U, 0U);
+  mpc_set_ui (d1, 0U, 0U);
+  mpc_set_ui (d2, 0U, 0U);
+
+  for (k = MPS_POLYNOMIAL (cpoly)->degree; k >= 1; k--)
+    {
+      if (p1)
+        {
+          /* d2 = 2 b_{k+1} + 2 x d1 - d2, then swap d1 and d2 */
+          mpc_sub (d2, b1, d2);
+          mpc_add_eq (d2, b1);
+          mpc_fma_scratch (sc, d2, x2, d1, d2);
+          t = d1; d1 = d2; d2 = t;
+        }
+
+      /* Bound to the rounding errors, where |2 x b_{k+1}| is replaced by
+       * 2 |x| |b_{k+1}|. */
+      rdpe_mul (s0, ax, s1);
+      mpc_rmod (rtmp, b1);
+      rdpe_mul_eq (rtmp, ax);
+      rdpe_add_eq (s0, rtmp);
+      rdpe_mul_eq_d (s0, 2.0);
+      rdpe_add_eq (s0, s2);
+      cdpe_mod (rtmp, cpoly->dpc[k]);
+      rdpe_add_eq (s0, rtmp);
+      mpc_rmod (rtmp, b2);
+      rdpe_add_eq (s0, rtmp);
+
+      /* b2 = c_k + 2 x b1 - b2, then swap b1 and b2 */
+      mpc_sub (b2, cpoly->mfpc[k], b2);
+      mpc_fma_scratch (sc, b2, x2, b1, b2);
+      t = b1; b1 = b2; b2 = t;
+
+      rdpe_set (s2, s1);
+      rdpe_set (s1, s0);
+    }
+
+  rdpe_mul (s0, ax, s1);
+  rdpe_add_eq (s0, s2);
+  mpc_rmod (rtmp, b1);
+  rdpe_mul_eq (rtmp, ax);
+  rdpe_add_eq (s0, rtmp);
+  cdpe_mod (rtmp, cpoly->dpc[0]);
+  rdpe_add_eq (s0, rtmp);
+  mpc_rmod (rtmp, b2);
+  rdpe_add_eq (s0, rtmp);
+
+  rdpe_set_2dl (rtmp, 3.0, 1 - wp);
+  rdpe_mul (error, s0, rtmp);
+
+  if (p1)
+    {
+      mpc_sub (d2, b1, d2);
+      mpc_fma_scratch (sc, p1, x, d1, d2);
+    }
+
+  mpc_sub (b2, cpoly->mfpc[0], b2);
+  mpc_fma_scratch (sc, p, x, b1, b2);
+
+  mpc_scratch_pop (sc, 5);
+}
+
+mps_boolean
+mps_chebyshev_poly_feval (mps_context * ctx, mps_polynomial * poly, cplx_t x, cplx_t value, double * error)
+{
+  mps_chebyshev_fclenshaw (MPS_CHEBYSHEV_POLY (poly), x, value, NULL, error);
+
+  return true;
+}
+
+mps_boolean
+mps_chebyshev_poly_deval (mps_context * ctx, mps_polynomial * poly, cdpe_t x, cdpe_t value, rdpe_t error)
+{
+  mps_chebyshev_dclenshaw (MPS_CHEBYSHEV_POLY (poly), x, value, NULL, error);
+
+  return true;
+}
+
 mps_boolean
 mps_chebyshev_poly_meval (mps_context * ctx, mps_polynomial * poly, mpc_t x, mpc_t value, rdpe_t error)
 {
@@ -20,64 +264,99 @@ mps_chebyshev_poly_meval (mps_context * ctx, mps_polynomial * poly, mpc_t x, mpc
   if (poly->prec > 0 && poly->prec < wp)
     wp = poly->prec;
 
-  mps_chebyshev_poly * cpoly = MPS_CHEBYSHEV_POLY (poly);
-  int i;
+  /* Make sure that we have sufficient precision to perform the computation */
+  mps_polynomial_raise_data (ctx, poly, wp);
 
-  mpc_t t0, t1, ctmp, ctmp2;
-  rdpe_t ax, rtmp, rtmp2;
+  mps_chebyshev_mclenshaw (MPS_CHEBYSHEV_POLY (poly), x, value, NULL, error, wp);
 
-  mpc_rmod (ax, x);
-  rdpe_set (error, rdpe_zero);
+  return true;
+}
 
-  /* Make sure that we have sufficient precision to perform the computation */
-  mps_polynomial_raise_data (ctx, poly, wp);
+void
+mps_chebyshev_poly_fnewton (mps_context * ctx, mps_polynomial * poly,
+                            mps_approximation * root, cplx_t corr)
+{
+  cplx_t p, p1;
+  double absp, error;
+
+  mps_chebyshev_fclenshaw (MPS_CHEBYSHEV_POLY (poly), root->fvalue, p, p1, &error);
 
-  mpc_init2 (t0, wp);
-  mpc_init2 (t1, wp);
-  mpc_init2 (ctmp, wp);
-  mpc_init2 (ctmp2, wp);
+  absp = cplx_mod (p);
+  root->again = absp > error;
 
-  mpc_set (value, cpoly->mfpc[0]);
-  mpc_set_ui (t0, 1U, 0U);
-  if (poly->degree == 0)
+  if (cplx_eq_zero (p1))
     {
-      return true;
+      cplx_set (corr, cplx_zero);
+      root->again = false;
+      return;
     }
 
-  mpc_set (t1, x);
-  mpc_mul (ctmp, cpoly->mfpc[1], x);
-  mpc_add_eq (value, ctmp);
+  cplx_div (corr, p, p1);
+  root->frad = poly->degree * (absp + error) / cplx_mod (p1) + DBL_MIN;
+}
+
+void
+mps_chebyshev_poly_dnewton (mps_context * ctx, mps_polynomial * poly,
+                            mps_approximation * root, cdpe_t corr)
+{
+  cdpe_t p, p1;
+  rdpe_t absp, error, rtmp;
+
+  mps_chebyshev_dclenshaw (MPS_CHEBYSHEV_POLY (poly), root->dvalue, p, p1, error);
 
-  mpc_rmod (rtmp, ctmp);
-  rdpe_add_eq (error, rtmp);
+  cdpe_mod (absp, p);
+  root->again = rdpe_gt (absp, error);
 
-  for (i = 2; i <= poly->degree; i++)
+  if (cdpe_eq_zero (p1))
     {
-      mpc_mul (ctmp, x, t1);
-      mpc_mul_eq_ui (ctmp, 2U);
-      mpc_rmod (rtmp, ctmp);
-      mpc_sub_eq (ctmp, t0);
+      cdpe_set (corr, cdpe_zero);
+      root->again = false;
+      return;
+    }
 
-      mpc_rmod (rtmp2, t0);
-      rdpe_add_eq (rtmp, rtmp2);
+  cdpe_div (corr, p, p1);
 
-      mpc_mul (ctmp2, ctmp, cpoly->mfpc[i]);
-      mpc_add_eq (value, ctmp2);
+  rdpe_add (root->drad, absp, error);
+  rdpe_mul_eq_d (root->drad, (double) poly->degree);
+  cdpe_mod (rtmp, p1);
+  rdpe_div_eq (root->drad, rtmp);
+}
 
-      rdpe_mul_eq (rtmp, ax);
-      rdpe_add_eq (error, rtmp);
+void
+mps_chebyshev_poly_mnewton (mps_context * ctx, mps_polynomial * poly,
+                            mps_approximation * root, mpc_t corr, long int wp)
+{
+  mpc_scratch * sc = mpc_scratch_get ();
+  mpc_ptr p, p1;
+  rdpe_t absp, error, rtmp;
 
-      mpc_set (t0, t1);
-      mpc_set (t1, ctmp);
-    }
+  if (poly->prec > 0 && poly->prec < wp)
+    wp = poly->prec;
+
+  mps_polynomial_raise_data (ctx, poly, wp);
 
-  mpc_clear (t0);
-  mpc_clear (t1);
-  mpc_clear (ctmp);
-  mpc_clear (ctmp2);
+  p = mpc_scratch_push (sc, wp);
+  p1 = mpc_scratch_push (sc, wp);
 
-  rdpe_set_2dl (rtmp, 2.0, -wp);
-  rdpe_mul_eq (error, rtmp);
+  mps_chebyshev_mclenshaw (MPS_CHEBYSHEV_POLY (poly), root->mvalue, p, p1, error, wp);
 
-  return true;
+  mpc_rmod (absp, p);
+  root->again = rdpe_gt (absp, error);
+
+  if (mpc_eq_zero (p1))
+    {
+      mpc_set_ui (corr, 0U, 0U);
+      root->again = false;
+    }
+  else
+    {
+      mpc_div_scratch (sc, corr, p, p1);
+
+      rdpe_add (root->drad, absp, error);
+      rdpe_mul_eq_d (root->drad, (double) poly->degree);
+      mpc_rmod (rtmp, p1);
+      rdpe_div_eq (root->drad, rtmp);
+    }
+
+  mpc_scratch_pop (sc, 2);
 }
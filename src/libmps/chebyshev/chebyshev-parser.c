@@ -34,7 +34,7 @@ mps_chebyshev_poly_read_from_stream (mps_context * ctx, mps_input_buffer * buffe
   /* Raise the precision if needed to parse the input coefficients */
   if (precision > 0)
     {
-      for (i = 0; i < ctx->n; i++)
+      for (i = 0; i <= ctx->n; i++)
         mpc_set_prec (cpoly->mfpc[i], precision);
     }
 
@@ -115,11 +115,17 @@ mps_chebyshev_poly_read_from_stream (mps_context * ctx, mps_input_buffer * buffe
     case MPS_DENSITY_SPARSE:
       /* Set all the coefficients to zero first, so whatever is not given
        * will be assumed to be null. */
-      for (i = 0; i < ctx->n; i++)
+      for (i = 0; i <= ctx->n; i++)
         {
           mpc_set_ui (cpoly->mfpc[i], 0U, 0U);
-          mpq_set_ui (cpoly->rational_real_coeffs[i], 0U, 1U);
-          mpq_set_ui (cpoly->rational_imag_coeffs[i], 0U, 1U);
+          cdpe_set (cpoly->dpc[i], cdpe_zero);
+          cplx_set (cpoly->fpc[i], cplx_zero);
+
+          if (MPS_STRUCTURE_IS_RATIONAL (structure) || MPS_STRUCTURE_IS_INTEGER (structure))
+            {
+              mpq_set_ui (cpoly->rational_real_coeffs[i], 0U, 1U);
+              mpq_set_ui (cpoly->rational_imag_coeffs[i], 0U, 1U);
+            }
         }
 
       while ((token = mps_input_buffer_next_token (buffer)) != NULL)
@@ -0,0 +1,154 @@
+/*
+ * This file is part of MPSolve 3.1.5
+ *
+ * Copyright (C) 2001-2015, Dipartimento di Matematica "L. Tonelli", Pisa.
+ * License: http://www.gnu.org/licenses/gpl.html GPL version 3 or higher
+ *
+ * Authors:
+ *   Leonardo Robol <leonardo.robol@sns.it>
+ */
+
+/*
+ * Starting approximations for polynomials in the Chebyshev basis.
+ *
+ * With the substitution x = (w + 1/w) / 2 we have T_k(x) = (w^k + w^{-k}) / 2, so
+ * that 2 w^n p(x) is a polynomial of degree 2n in w, whose coefficients are
+ * c_n, ..., c_1, 2 c_0, c_1, ..., c_n. Its roots come in pairs w, 1/w, both mapped
+ * to the same x, and the Newton polygon of the moduli of its coefficients is
+ * symmetric. The radii of the roots with |w| >= 1 are then obtained from the
+ * Newton polygon of a_0, ..., a_n, where a_k = |c_k| for k > 0 and a_0 is the
+ * maximum of 2 |c_0| and of the other a_k, i.e., the value at the center of
+ * the symmetric polygon. The starting points are placed on the images of the
+ * circles with these radii, which are the Bernstein ellipses with foci -1 and 1.
+ */
+
+#include <mps/mps.h>
+#include <math.h>
+
+#define MPS_STARTING_SIGMA (0.66 * (PI / ctx->n))
+#define pi2 6.283184
+
+/*
+ * Circles with radius too close to 1 would be mapped onto the segment
+ * [-1, 1], where the approximations of a real polynomial would remain
+ * real, so their radius is enlarged to at least 1 + 1 / n.
+ */
+#define MPS_CHEBYSHEV_MIN_RADIUS(n) (1.0 + 1.0 / (n))
+
+void
+mps_chebyshev_poly_fstart (mps_context * ctx, mps_polynomial * p, mps_approximation ** approximations)
+{
+  mps_chebyshev_poly * cpoly = MPS_CHEBYSHEV_POLY (p);
+  int i, j, n = p->degree;
+  double sigma, ang, th, r, w_re, w_im;
+  double * fap = mps_newv (double, n + 1);
+  mps_starting_configuration c;
+
+  if (ctx->random_seed)
+    sigma = drand ();
+  else
+    sigma = ctx->last_sigma = MPS_STARTING_SIGMA;
+
+  fap[0] = 2.0 * cplx_mod (cpoly->fpc[0]);
+  for (i = 1; i <= n; i++)
+    {
+      fap[i] = cplx_mod (cpoly->fpc[i]);
+      fap[0] = MAX (fap[0], fap[i]);
+    }
+
+  c = mps_fcompute_starting_radii (ctx, n, NULL, 0.0, 0.0, ctx->eps_out, fap);
+
+  th = pi2 / n;
+  for (i = 0; i < c.n_radii; i++)
+    {
+      ang = pi2 / (c.partitioning[i + 1] - c.partitioning[i]);
+      r = MAX (c.fradii[i], MPS_CHEBYSHEV_MIN_RADIUS (n));
+
+      for (j = c.partitioning[i]; j < c.partitioning[i + 1]; j++)
+        {
+          w_re = cos (ang * (j - c.partitioning[i]) + th * c.partitioning[i + 1] + sigma);
+          w_im = sin (ang * (j - c.partitioning[i]) + th * c.partitioning[i + 1] + sigma);
+
+          /* x = (w + 1/w) / 2 with w = r (w_re + i w_im) */
+          cplx_set_d (approximations[j]->fvalue,
+                      0.5 * (r + 1.0 / r) * w_re,
+                      0.5 * (r - 1.0 / r) * w_im);
+
+          if (r == DBL_MAX)
+            approximations[j]->status = MPS_ROOT_STATUS_NOT_FLOAT;
+        }
+    }
+
+  mps_starting_configuration_clear (ctx, &c);
+  free (fap);
+}
+
+void
+mps_chebyshev_poly_dstart (mps_context * ctx, mps_polynomial * p, mps_approximation ** approximations)
+{
+  mps_chebyshev_poly * cpoly = MPS_CHEBYSHEV_POLY (p);
+  int i, j, n = p->degree;
+  double sigma, ang, th;
+  rdpe_t r, ri, rmin, re_scale, im_scale;
+  rdpe_t * dap = rdpe_valloc (n + 1);
+  mps_starting_configuration c;
+
+  if (ctx->random_seed)
+    sigma = drand ();
+  else
+    sigma = ctx->last_sigma = MPS_STARTING_SIGMA;
+
+  cdpe_mod (dap[0], cpoly->dpc[0]);
+  rdpe_mul_eq_d (dap[0], 2.0);
+  for (i = 1; i <= n; i++)
+    {
+      cdpe_mod (dap[i], cpoly->dpc[i]);
+      if (rdpe_lt (dap[0], dap[i]))
+        rdpe_set (dap[0], dap[i]);
+    }
+
+  c = mps_dcompute_starting_radii (ctx, n, NULL, (__rdpe_struct *) rdpe_zero,
+                                   (__rdpe_struct *) rdpe_zero, ctx->eps_out, dap);
+
+  rdpe_set_d (rmin, MPS_CHEBYSHEV_MIN_RADIUS (n));
+  th = pi2 / n;
+  for (i = 0; i < c.n_radii; i++)
+    {
+      ang = pi2 / (c.partitioning[i + 1] - c.partitioning[i]);
+      rdpe_set (r, c.dradii[i]);
+      if (rdpe_lt (r, rmin))
+        rdpe_set (r, rmin);
+
+      /* The semiaxes of the ellipse, (r + 1/r) / 2 and (r - 1/r) / 2 */
+      rdpe_inv (ri, r);
+      rdpe_add (re_scale, r, ri);
+      rdpe_div_eq_d (re_scale, 2.0);
+      rdpe_sub (im_scale, r, ri);
+      rdpe_div_eq_d (im_scale, 2.0);
+
+      for (j = c.partitioning[i]; j < c.partitioning[i + 1]; j++)
+        {
+          cdpe_t x;
+
+          rdpe_mul_d (cdpe_Re (x), re_scale,
+                      cos (ang * (j - c.partitioning[i]) + th * c.partitioning[i + 1] + sigma));
+          rdpe_mul_d (cdpe_Im (x), im_scale,
+                      sin (ang * (j - c.partitioning[i]) + th * c.partitioning[i + 1] + sigma));
+          cdpe_set (approximations[j]->dvalue, x);
+        }
+    }
+
+  mps_starting_configuration_clear (ctx, &c);
+  rdpe_vfree (dap);
+}
+
+void
+mps_chebyshev_poly_mstart (mps_context * ctx, mps_polynomial * p, mps_approximation ** approximations)
+{
+  int i;
+
+  mps_chebyshev_poly_dstart (ctx, p, approximations);
+
+  for (i = 0; i < p->degree; i++)
+    mpc_set_cdpe (approximations[i]->mvalue, approximations[i]->dvalue);
+}
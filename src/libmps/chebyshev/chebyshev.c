@@ -15,7 +15,17 @@ long int mps_chebyshev_poly_raise_data (mps_context * ctx, mps_polynomial * poly
 void mps_chebyshev_get_leading_coefficient (mps_context * ctx, mps_polynomial * poly, mpc_t lc);
 
 /* This is implemented in chebyshev-evaluation.c */
+mps_boolean mps_chebyshev_poly_feval (mps_context * ctx, mps_polynomial * poly, cplx_t x, cplx_t value, double * error);
+mps_boolean mps_chebyshev_poly_deval (mps_context * ctx, mps_polynomial * poly, cdpe_t x, cdpe_t value, rdpe_t error);
 mps_boolean mps_chebyshev_poly_meval (mps_context * ctx, mps_polynomial * poly, mpc_t x, mpc_t value, rdpe_t error);
+void mps_chebyshev_poly_fnewton (mps_context * ctx, mps_polynomial * poly, mps_approximation * root, cplx_t corr);
+void mps_chebyshev_poly_dnewton (mps_context * ctx, mps_polynomial * poly, mps_approximation * root, cdpe_t corr);
+void mps_chebyshev_poly_mnewton (mps_context * ctx, mps_polynomial * poly, mps_approximation * root, mpc_t corr, long int wp);
+
+/* This is implemented in chebyshev-starting.c */
+void mps_chebyshev_poly_fstart (mps_context * ctx, mps_polynomial * p, mps_approximation ** approximations);
+void mps_chebyshev_poly_dstart (mps_context * ctx, mps_polynomial * p, mps_approximation ** approximations);
+void mps_chebyshev_poly_mstart (mps_context * ctx, mps_polynomial * p, mps_approximation ** approximations);
 
 mps_chebyshev_poly *
 mps_chebyshev_poly_new (mps_context * ctx, int n, mps_structure structure)
@@ -54,7 +64,15 @@ mps_chebyshev_poly_new (mps_context * ctx, int n, mps_structure structure)
   /* Construct the polynomial vtable in a proper way */
   MPS_POLYNOMIAL (poly)->free = mps_chebyshev_poly_free;
   MPS_POLYNOMIAL (poly)->raise_data = mps_chebyshev_poly_raise_data;
+  MPS_POLYNOMIAL (poly)->feval = mps_chebyshev_poly_feval;
+  MPS_POLYNOMIAL (poly)->deval = mps_chebyshev_poly_deval;
   MPS_POLYNOMIAL (poly)->meval = mps_chebyshev_poly_meval;
+  MPS_POLYNOMIAL (poly)->fnewton = mps_chebyshev_poly_fnewton;
+  MPS_POLYNOMIAL (poly)->dnewton = mps_chebyshev_poly_dnewton;
+  MPS_POLYNOMIAL (poly)->mnewton = mps_chebyshev_poly_mnewton;
+  MPS_POLYNOMIAL (poly)->fstart = mps_chebyshev_poly_fstart;
+  MPS_POLYNOMIAL (poly)->dstart = mps_chebyshev_poly_dstart;
+  MPS_POLYNOMIAL (poly)->mstart = mps_chebyshev_poly_mstart;
   MPS_POLYNOMIAL (poly)->get_leading_coefficient = mps_chebyshev_get_leading_coefficient;
 
   /* Attach the typename to this polynomial */
@@ -178,6 +196,9 @@ mps_chebyshev_poly_set_coefficient_q (mps_context * ctx, mps_chebyshev_poly * po
 
   mpf_set_q (mpc_Re (cpoly->mfpc[i]), real_part);
   mpf_set_q (mpc_Im (cpoly->mfpc[i]), imag_part);
+
+  mpc_get_cdpe (cpoly->dpc[i], cpoly->mfpc[i]);
+  mpc_get_cplx (cpoly->fpc[i], cpoly->mfpc[i]);
 }
 
 void
@@ -191,5 +212,8 @@ mps_chebyshev_poly_set_coefficient_i (mps_context * ctx, mps_chebyshev_poly * po
 
   mpf_set_q (mpc_Re (cpoly->mfpc[i]), cpoly->rational_real_coeffs[i]);
   mpf_set_q (mpc_Im (cpoly->mfpc[i]), cpoly->rational_imag_coeffs[i]);
+
+  mpc_get_cdpe (cpoly->dpc[i], cpoly->mfpc[i]);
+  mpc_get_cplx (cpoly->fpc[i], cpoly->mfpc[i]);
 }
 
@@ -12,6 +12,7 @@
 
 
 #include <mps/mps.h>
+#include <mps/private/mpcn.h>
 #include <pthread.h>
 
 /**
@@ -62,6 +63,34 @@ mps_faberth_wl (mps_context * s, int j, cplx_t abcorr, pthread_mutex_t * aberth_
 }
 
 
+/**
+ * @brief Compute Aberth correction for the j-th root reading the other
+ * roots from the contiguous array <code>values</code>, as copied from
+ * a <code>mps_thread_root_snapshot</code> by
+ * mps_thread_root_snapshot_fget().
+ *
+ * No lock is taken, so this can be called concurrently by the threads
+ * iterating on different roots.
+ */
+MPS_PRIVATE void
+mps_faberth_snapshot (mps_context * s, int j, cplx_t froot, cplx_t * values, cplx_t abcorr)
+{
+  int i;
+  cplx_t z;
+
+  cplx_set (abcorr, cplx_zero);
+  for (i = 0; i < s->n; i++)
+    {
+      if (i == j)
+        continue;
+
+      cplx_sub (z, froot, values[i]);
+      cplx_inv_eq (z);
+      cplx_add_eq (abcorr, z);
+    }
+}
+
+
 /**
  * @brief Compute Aberth correction for j-th root, without
  * selective correction.
@@ -83,6 +112,31 @@ mps_daberth (mps_context * s, mps_approximation * root, cdpe_t abcorr)
     }
 }
 
+/*
+ * Sum of mps_maberth() computed with the kernels with n limbs of mpcn.h.
+ */
+MPS_MPCN_INLINE void
+mps_maberth_n (const int n, mps_context * s, mps_approximation * root, cdpe_t abcorr)
+{
+  int i;
+  cdpe_t z;
+  mps_mpcn_t x, y;
+
+  mps_mpcn_set_mpc (n, x, root->mvalue);
+
+  cdpe_set (abcorr, cdpe_zero);
+  for (i = 0; i < s->n; i++)
+    {
+      if (s->root[i] == root)
+        continue;
+      mps_mpcn_set_mpc (n, y, s->root[i]->mvalue);
+      mps_mpcn_sub (n, y, x, y);
+      mps_mpcn_get_cdpe (n, z, y);
+      cdpe_inv_eq (z);
+      cdpe_add_eq (abcorr, z);
+    }
+}
+
 /**
  * @brief Compute Aberth correction for j-th root, without
  * selective correction.
@@ -92,9 +146,29 @@ mps_maberth (mps_context * s, mps_approximation * root, mpc_t abcorr)
 {
   int i;
   cdpe_t z, temp;
-  mpc_t diff;
+  mpc_scratch * sc;
+  mpc_ptr diff;
+
+  switch (mps_mpcn_limbs (s->mpwp))
+    {
+    case 2:
+      mps_maberth_n (2, s, root, temp);
+      mpc_set_cdpe (abcorr, temp);
+      return;
+
+    case 4:
+      mps_maberth_n (4, s, root, temp);
+      mpc_set_cdpe (abcorr, temp);
+      return;
+
+    case 8:
+      mps_maberth_n (8, s, root, temp);
+      mpc_set_cdpe (abcorr, temp);
+      return;
+    }
 
-  mpc_init2 (diff, s->mpwp);
+  sc = mpc_scratch_get ();
+  diff = mpc_scratch_push (sc, s->mpwp);
 
   cdpe_set (temp, cdpe_zero);
   for (i = 0; i < s->n; i++)
@@ -108,7 +182,7 @@ mps_maberth (mps_context * s, mps_approximation * root, mpc_t abcorr)
     }
   mpc_set_cdpe (abcorr, temp);
 
-  mpc_clear (diff);
+  mpc_scratch_pop (sc, 1);
 }
 
 /**
@@ -167,9 +241,8 @@ mps_maberth_s (mps_context * s, mps_approximation * ab_root, mps_cluster * clust
 {
   mps_root * root;
   cdpe_t z, temp;
-  mpc_t diff;
-
-  mpc_init2 (diff, s->mpwp);
+  mpc_scratch * sc = mpc_scratch_get ();
+  mpc_ptr diff = mpc_scratch_push (sc, s->mpwp);
 
   cdpe_set (temp, cdpe_zero);
   for (root = cluster->first; root != NULL; root = root->next)
@@ -184,7 +257,7 @@ mps_maberth_s (mps_context * s, mps_approximation * ab_root, mps_cluster * clust
     }
   mpc_set_cdpe (abcorr, temp);
 
-  mpc_clear (diff);
+  mpc_scratch_pop (sc, 1);
 }
 
 MPS_PRIVATE void
@@ -212,16 +285,36 @@ mps_daberth_wl (mps_context * s, int j, cdpe_t abcorr, pthread_mutex_t * aberth_
     }
 }
 
+/**
+ * @brief DPE version of mps_faberth_snapshot().
+ */
+MPS_PRIVATE void
+mps_daberth_snapshot (mps_context * s, int j, cdpe_t droot, cdpe_t * values, cdpe_t abcorr)
+{
+  int i;
+  cdpe_t z;
+
+  cdpe_set (abcorr, cdpe_zero);
+  for (i = 0; i < s->n; i++)
+    {
+      if (i == j)
+        continue;
+
+      cdpe_sub (z, droot, values[i]);
+      cdpe_inv_eq (z);
+      cdpe_add_eq (abcorr, z);
+    }
+}
+
 MPS_PRIVATE void
 mps_maberth_s_wl (mps_context * s, int j, mps_cluster * cluster, mpc_t abcorr,
                   pthread_mutex_t * aberth_mutexes)
 {
   mps_root * root;
   cdpe_t z, temp;
-  mpc_t diff, mroot;
-
-  mpc_init2 (mroot, s->mpwp);
-  mpc_init2 (diff, s->mpwp);
+  mpc_scratch * sc = mpc_scratch_get ();
+  mpc_ptr mroot = mpc_scratch_push (sc, s->mpwp);
+  mpc_ptr diff = mpc_scratch_push (sc, s->mpwp);
 
   pthread_mutex_lock (&aberth_mutexes[j]);
   mpc_set (mroot, s->root[j]->mvalue);
@@ -248,6 +341,44 @@ mps_maberth_s_wl (mps_context * s, int j, mps_cluster * cluster, mpc_t abcorr,
     }
   mpc_set_cdpe (abcorr, temp);
 
-  mpc_clear (mroot);
-  mpc_clear (diff);
+  mpc_scratch_pop (sc, 2);
+}
+
+/**
+ * @brief Double-double version of mps_maberth_s(), that reads the
+ * approximations from the field <code>ddvalue</code>.
+ *
+ * The differences of the approximations are computed in double-double
+ * arithmetic, while their inverses are summed in floating point: as in the
+ * multiprecision version, the accuracy of the sum only affects the relative
+ * accuracy of the Aberth correction.
+ *
+ * @return false if the sum overflowed.
+ */
+MPS_PRIVATE mps_boolean
+mps_ddaberth_s (mps_context * s, int j, mps_cluster * cluster, cplx_t abcorr)
+{
+  mps_root * root;
+  cdd_t diff;
+  cplx_t z;
+
+  cplx_set (abcorr, cplx_zero);
+  for (root = cluster->first; root != NULL; root = root->next)
+    {
+      int k;
+      k = root->k;
+      if (k == j)
+        continue;
+
+      cdd_sub (diff, s->root[j]->ddvalue, s->root[k]->ddvalue);
+
+      if (cdd_eq_zero (diff))
+        continue;
+
+      cdd_get_cplx (z, diff);
+      cplx_inv_eq (z);
+      cplx_add_eq (abcorr, z);
+    }
+
+  return isfinite (cplx_Re (abcorr)) && isfinite (cplx_Im (abcorr));
 }
@@ -46,6 +46,7 @@ mps_approximation_copy (mps_context * ctx, mps_approximation * original)
   rdpe_set (new->drad, original->drad);
   cdpe_set (new->dvalue, original->dvalue);
   cplx_set (new->fvalue, original->fvalue);
+  cdd_set (new->ddvalue, original->ddvalue);
   new->frad = original->frad;
   new->wp = original->wp;
   new->status = original->status;
@@ -0,0 +1,492 @@
+/*
+ * This file is part of MPSolve 3.1.5
+ *
+ * Copyright (C) 2001-2015, Dipartimento di Matematica "L. Tonelli", Pisa.
+ * License: http://www.gnu.org/licenses/gpl.html GPL version 3 or higher
+ *
+ * Authors:
+ *   Leonardo Robol <leonardo.robol@sns.it>
+ */
+
+#include <float.h>
+#include <mps/mps.h>
+
+/*! @cond PRIVATE */
+struct mps_batch_item {
+  int index;
+  int degree;
+};
+
+struct mps_batch_data {
+  mps_polynomial ** polys;
+  mps_batch_result * results;
+  mps_context ** contexts;
+
+  /* Polynomials sorted by degree, and the next one to solve */
+  struct mps_batch_item * order;
+  volatile int cursor;
+  int n;
+
+  volatile int failures;
+};
+/*! @endcond */
+
+static int
+mps_batch_item_compare (const void * a, const void * b)
+{
+  const struct mps_batch_item * x = (const struct mps_batch_item*) a;
+  const struct mps_batch_item * y = (const struct mps_batch_item*) b;
+
+  if (x->degree != y->degree)
+    return x->degree - y->degree;
+  else
+    return x->index - y->index;
+}
+
+/*
+ * Contexts used by the workers of mps_solve_batch() and mps_solve_sweep().
+ * They are kept between the calls, together with the data allocated for
+ * the last polynomials that they have solved, and they all run on the same
+ * pool with one thread, since the parallelism is across the polynomials.
+ * Hence, a call does not start any thread, and does not allocate any
+ * context unless it needs more workers than the previous ones.
+ */
+static pthread_mutex_t batch_workers_mutex = PTHREAD_MUTEX_INITIALIZER;
+static mps_context ** batch_workers = NULL;
+static int batch_workers_size = 0;
+static mps_thread_pool * batch_sequential_pool = NULL;
+
+/* Must be called with batch_workers_mutex held */
+static mps_context *
+mps_batch_workers_pop (void)
+{
+  if (batch_workers_size > 0)
+    return batch_workers[--batch_workers_size];
+
+  /* The pool is created with a fixed number of threads, so it does not
+   * need a context to look for the number of cores. */
+  if (batch_sequential_pool == NULL)
+    batch_sequential_pool = mps_thread_pool_new (NULL, 1);
+
+  return mps_context_new_with_pool (batch_sequential_pool);
+}
+
+/*
+ * Get the contexts of the workers that solve n polynomials on the pool
+ * shared by the process, which is stored in pool, and return their number.
+ */
+static int
+mps_batch_workers_acquire (int n, mps_batch_options * options,
+                           mps_context *** contexts, mps_thread_pool ** pool)
+{
+  mps_context * first;
+  int i, n_workers;
+
+  pthread_mutex_lock (&batch_workers_mutex);
+
+  first = mps_batch_workers_pop ();
+  *pool = mps_thread_pool_get_system_pool (first);
+  n_workers = MIN ((int) (*pool)->n, n);
+
+  *contexts = mps_newv (mps_context*, n_workers);
+  (*contexts)[0] = first;
+  for (i = 1; i < n_workers; i++)
+    (*contexts)[i] = mps_batch_workers_pop ();
+
+  pthread_mutex_unlock (&batch_workers_mutex);
+
+  for (i = 0; i < n_workers; i++)
+    {
+      mps_context_select_algorithm ((*contexts)[i], options->algorithm);
+      mps_context_set_output_goal ((*contexts)[i], options->goal);
+      mps_context_set_output_prec ((*contexts)[i], options->output_prec);
+    }
+
+  return n_workers;
+}
+
+/*
+ * Give back the contexts obtained with mps_batch_workers_acquire().
+ */
+static void
+mps_batch_workers_release (mps_context ** contexts, int n_workers)
+{
+  int i;
+
+  pthread_mutex_lock (&batch_workers_mutex);
+
+  batch_workers = mps_realloc (batch_workers,
+                               sizeof(mps_context*) * (batch_workers_size + n_workers));
+
+  for (i = 0; i < n_workers; i++)
+    {
+      /* The polynomials belong to the caller, and the roots of the last
+       * continuation must not be used as the starting points of the next
+       * polynomial. */
+      contexts[i]->active_poly = NULL;
+      mps_context_select_starting_strategy (contexts[i], MPS_STARTING_STRATEGY_DEFAULT);
+      batch_workers[batch_workers_size++] = contexts[i];
+    }
+
+  pthread_mutex_unlock (&batch_workers_mutex);
+
+  free (contexts);
+}
+
+/**
+ * @brief Free the contexts and the thread pool that mps_solve_batch(),
+ * mps_solve_continuation() and mps_solve_sweep() keep between the calls.
+ *
+ * The contexts hold the data allocated for the largest polynomials that
+ * they have solved, so this should be called when no more polynomials are
+ * going to be solved, or to reclaim the memory. They are allocated again
+ * by the next call. This must not be called while one of these functions
+ * is running.
+ */
+void
+mps_batch_release (void)
+{
+  int i;
+
+  pthread_mutex_lock (&batch_workers_mutex);
+
+  for (i = 0; i < batch_workers_size; i++)
+    mps_context_free (batch_workers[i]);
+
+  free (batch_workers);
+  batch_workers = NULL;
+  batch_workers_size = 0;
+
+  /* The contexts had their own references to the pool */
+  if (batch_sequential_pool != NULL)
+    {
+      mps_thread_pool_unref (NULL, batch_sequential_pool);
+      batch_sequential_pool = NULL;
+    }
+
+  pthread_mutex_unlock (&batch_workers_mutex);
+}
+
+static void
+mps_batch_solve_polynomial (mps_context * ctx, struct mps_batch_data * data, int i)
+{
+  mps_batch_result * result = data->results + i;
+
+  /* Errors of the previous polynomials must not affect this one */
+  ctx->error_state = false;
+
+  mps_context_set_input_poly (ctx, data->polys[i]);
+
+  if (!mps_context_has_errors (ctx))
+    mps_mpsolve (ctx);
+
+  result->error = mps_context_has_errors (ctx);
+  result->iterations = mps_context_get_newton_corrections (ctx);
+  result->iterations_saved = 0;
+  result->zero_roots = mps_context_get_zero_roots (ctx);
+
+  if (result->error)
+    __sync_add_and_fetch (&data->failures, 1);
+  else
+    mps_context_get_roots_d (ctx, &result->roots, result->radii ? &result->radii : NULL);
+}
+
+static void
+mps_batch_worker (mps_context * s, int begin, int end, void * data_ptr)
+{
+  struct mps_batch_data * data = (struct mps_batch_data*) data_ptr;
+  int w, k;
+
+  /* Every worker owns a context, that is reused for all the polynomials
+   * that it picks. Since they are sorted by degree, most of the times the
+   * context does not need to be resized. */
+  for (w = begin; w < end; w++)
+    while ((k = __sync_fetch_and_add (&data->cursor, 1)) < data->n)
+      mps_batch_solve_polynomial (data->contexts[w], data, data->order[k].index);
+}
+
+/**
+ * @brief Fill the options with the default values used by MPSolve.
+ */
+void
+mps_batch_options_init (mps_batch_options * options)
+{
+  options->algorithm = MPS_ALGORITHM_SECULAR_GA;
+  options->goal = MPS_OUTPUT_GOAL_APPROXIMATE;
+  options->output_prec = 0.8 * DBL_DIG * LOG2_10;
+}
+
+/**
+ * @brief Solve n independent polynomials.
+ *
+ * The polynomials are distributed among the threads of the pool shared by
+ * the process (see mps_thread_pool_get_system_pool()), and every thread
+ * solves its polynomials one after the other, using a single context that
+ * is reused for all of them, and that is kept for the following calls. The
+ * polynomials are handed out in order of degree, so that the data allocated
+ * for a degree are reused as much as possible.
+ *
+ * The approximations of the roots of <code>polys[i]</code> and their inclusion
+ * radii are stored in the arrays of <code>results[i]</code>.
+ *
+ * @param polys The polynomials to solve. They must be different objects, since
+ * they are solved concurrently.
+ * @param n The number of polynomials.
+ * @param options The options used for all the polynomials, or NULL to use
+ * the default ones.
+ * @param results An array of n results, where the roots are stored.
+ *
+ * @return The number of polynomials that could not be solved.
+ */
+int
+mps_solve_batch (mps_polynomial ** polys, int n, mps_batch_options * options,
+                 mps_batch_result * results)
+{
+  struct mps_batch_data data;
+  mps_batch_options default_options;
+  mps_thread_pool * pool;
+  int i, n_workers;
+
+  if (n <= 0)
+    return 0;
+
+  if (options == NULL)
+    {
+      mps_batch_options_init (&default_options);
+      options = &default_options;
+    }
+
+  data.polys = polys;
+  data.results = results;
+  data.cursor = 0;
+  data.n = n;
+  data.failures = 0;
+
+  data.order = mps_newv (struct mps_batch_item, n);
+  for (i = 0; i < n; i++)
+    {
+      data.order[i].index = i;
+      data.order[i].degree = polys[i]->degree;
+    }
+  qsort (data.order, n, sizeof(struct mps_batch_item), mps_batch_item_compare);
+
+  n_workers = mps_batch_workers_acquire (n, options, &data.contexts, &pool);
+
+  mps_thread_pool_parallel_for (data.contexts[0], pool, 0, n_workers, 1,
+                                mps_batch_worker, &data);
+
+  mps_batch_workers_release (data.contexts, n_workers);
+  free (data.order);
+
+  return data.failures;
+}
+
+/*
+ * Solve polys[begin], ..., polys[end - 1] as the steps of a continuation,
+ * using ctx for all of them, and return the number of failures.
+ */
+static int
+mps_continuation_solve_range (mps_context * ctx, mps_polynomial ** polys,
+                              mps_batch_result * results, int begin, int end)
+{
+  cplx_t * previous_roots = NULL;
+  int i, previous_degree = -1, failures = 0;
+  long int cold_iterations = 0;
+
+  for (i = begin; i < end; i++)
+    {
+      mps_batch_result * result = results + i;
+      mps_boolean warm;
+
+      ctx->error_state = false;
+      mps_context_set_input_poly (ctx, polys[i]);
+
+      /* The degree is compared after the zero roots have been deflated */
+      warm = previous_roots != NULL && mps_context_get_degree (ctx) == previous_degree;
+      if (warm)
+        mps_context_set_starting_approximations_d (ctx, previous_roots, NULL,
+                                                   mps_context_get_degree (ctx));
+      else
+        mps_context_select_starting_strategy (ctx, MPS_STARTING_STRATEGY_DEFAULT);
+
+      if (!mps_context_has_errors (ctx))
+        mps_mpsolve (ctx);
+
+      /* The roots of the previous step may have led the iterations astray,
+       * so give the step a second chance starting from scratch. */
+      if (warm && mps_context_has_errors (ctx))
+        {
+          ctx->error_state = false;
+          mps_context_set_input_poly (ctx, polys[i]);
+          mps_context_select_starting_strategy (ctx, MPS_STARTING_STRATEGY_DEFAULT);
+          warm = false;
+
+          if (!mps_context_has_errors (ctx))
+            mps_mpsolve (ctx);
+        }
+
+      result->error = mps_context_has_errors (ctx);
+      result->iterations = mps_context_get_newton_corrections (ctx);
+      result->iterations_saved = warm ? cold_iterations - result->iterations : 0;
+      result->zero_roots = mps_context_get_zero_roots (ctx);
+
+      if (!warm)
+        cold_iterations = result->iterations;
+
+      cplx_vfree (previous_roots);
+      previous_roots = NULL;
+
+      if (result->error)
+        {
+          failures++;
+          continue;
+        }
+
+      mps_context_get_roots_d (ctx, &result->roots, result->radii ? &result->radii : NULL);
+
+      /* Keep the roots of this step, that will be the starting points of the next one */
+      previous_degree = mps_context_get_degree (ctx);
+      mps_context_get_roots_d (ctx, &previous_roots, NULL);
+    }
+
+  cplx_vfree (previous_roots);
+
+  return failures;
+}
+
+/**
+ * @brief Solve the polynomials <code>polys[0]</code>, ...,
+ * <code>polys[n - 1]</code>, that are the steps of a continuation, i.e.,
+ * whose coefficients change slightly from one to the next.
+ *
+ * The polynomials are solved one after the other using the same context,
+ * and the roots of every step are used as starting approximations for the
+ * following one (see mps_context_set_starting_approximations_d()). A step
+ * starts from scratch if it is the first one, if the previous one could not
+ * be solved or if the degree has changed. A step that fails when started
+ * from the roots of the previous one is solved again from scratch.
+ *
+ * The approximations of the roots of <code>polys[i]</code> and their inclusion
+ * radii are stored in the arrays of <code>results[i]</code>, as in
+ * mps_solve_batch(). The number of Newton corrections computed for each step,
+ * and the ones that have been saved with respect to the last step that started
+ * from scratch, are reported in the <code>iterations</code> and
+ * <code>iterations_saved</code> fields.
+ *
+ * @param polys The polynomials to solve.
+ * @param n The number of polynomials.
+ * @param options The options used for all the polynomials, or NULL to use
+ * the default ones.
+ * @param results An array of n results, where the roots are stored.
+ *
+ * @return The number of polynomials that could not be solved.
+ */
+int
+mps_solve_continuation (mps_polynomial ** polys, int n, mps_batch_options * options,
+                        mps_batch_result * results)
+{
+  mps_context * ctx;
+  mps_batch_options default_options;
+  int failures;
+
+  if (n <= 0)
+    return 0;
+
+  if (options == NULL)
+    {
+      mps_batch_options_init (&default_options);
+      options = &default_options;
+    }
+
+  ctx = mps_context_new ();
+  mps_context_select_algorithm (ctx, options->algorithm);
+  mps_context_set_output_goal (ctx, options->goal);
+  mps_context_set_output_prec (ctx, options->output_prec);
+
+  failures = mps_continuation_solve_range (ctx, polys, results, 0, n);
+
+  mps_context_free (ctx);
+
+  return failures;
+}
+
+/*! @cond PRIVATE */
+struct mps_sweep_data {
+  mps_polynomial ** polys;
+  mps_batch_result * results;
+  mps_context ** contexts;
+  int n;
+  int n_workers;
+
+  volatile int failures;
+};
+/*! @endcond */
+
+static void
+mps_sweep_worker (mps_context * s, int begin, int end, void * data_ptr)
+{
+  struct mps_sweep_data * data = (struct mps_sweep_data*) data_ptr;
+  int w, failures;
+
+  /* Every worker follows the path on a contiguous section of the grid */
+  for (w = begin; w < end; w++)
+    {
+      failures = mps_continuation_solve_range (data->contexts[w], data->polys, data->results,
+                                               (int)(((long) data->n * w) / data->n_workers),
+                                               (int)(((long) data->n * (w + 1)) / data->n_workers));
+      __sync_add_and_fetch (&data->failures, failures);
+    }
+}
+
+/**
+ * @brief Solve the steps of a continuation concurrently.
+ *
+ * This is the parallel version of mps_solve_continuation(): the steps are
+ * split in as many contiguous sections as the threads of the pool shared by
+ * the process (see mps_thread_pool_get_system_pool()), and every thread
+ * follows the path on its section with its own context. Only the first step
+ * of every section starts from scratch, so a sweep over a fine grid saves
+ * almost as many iterations as a sequential continuation, while using all the
+ * cores.
+ *
+ * @param polys The polynomials to solve. They must be different objects, since
+ * they are solved concurrently.
+ * @param n The number of polynomials.
+ * @param options The options used for all the polynomials, or NULL to use
+ * the default ones.
+ * @param results An array of n results, where the roots are stored as in
+ * mps_solve_continuation().
+ *
+ * @return The number of polynomials that could not be solved.
+ */
+int
+mps_solve_sweep (mps_polynomial ** polys, int n, mps_batch_options * options,
+                 mps_batch_result * results)
+{
+  struct mps_sweep_data data;
+  mps_batch_options default_options;
+  mps_thread_pool * pool;
+
+  if (n <= 0)
+    return 0;
+
+  if (options == NULL)
+    {
+      mps_batch_options_init (&default_options);
+      options = &default_options;
+    }
+
+  data.polys = polys;
+  data.results = results;
+  data.n = n;
+  data.failures = 0;
+
+  data.n_workers = mps_batch_workers_acquire (n, options, &data.contexts, &pool);
+
+  mps_thread_pool_parallel_for (data.contexts[0], pool, 0, data.n_workers, 1,
+                                mps_sweep_worker, &data);
+
+  mps_batch_workers_release (data.contexts, data.n_workers);
+
+  return data.failures;
+}
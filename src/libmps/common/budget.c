@@ -0,0 +1,79 @@
+/*
+ * This file is part of MPSolve 3.1.5
+ *
+ * Copyright (C) 2001-2015, Dipartimento di Matematica "L. Tonelli", Pisa.
+ * License: http://www.gnu.org/licenses/gpl.html GPL version 3 or higher
+ *
+ * Authors:
+ *   Leonardo Robol <leonardo.robol@sns.it>
+ */
+
+#include <time.h>
+#include <mps/mps.h>
+
+/*
+ * Seconds elapsed from an arbitrary point in the past, measured with a
+ * clock that is not affected by the changes of the system time.
+ */
+static double
+mps_budget_now (void)
+{
+  struct timespec now;
+
+  clock_gettime (CLOCK_MONOTONIC, &now);
+
+  return now.tv_sec + 1e-9 * now.tv_nsec;
+}
+
+/**
+ * @brief Set the deadline of the computation that is starting, according
+ * to the time budget, and clear the flag that marks the budget as
+ * exhausted.
+ */
+MPS_PRIVATE void
+mps_budget_start (mps_context * s)
+{
+  s->budget_exhausted = false;
+
+  if (s->time_budget > 0)
+    s->deadline = mps_budget_now () + s->time_budget;
+}
+
+/**
+ * @brief Check if the deadline set by the time budget has passed.
+ *
+ * If this is the case the budget is marked as exhausted, so that the
+ * algorithms do not start any other packet of iterations.
+ */
+MPS_PRIVATE mps_boolean
+mps_budget_time_over (mps_context * s)
+{
+  if (s->time_budget <= 0 || mps_budget_now () < s->deadline)
+    return false;
+
+  MPS_DEBUG (s, "The time budget is exhausted");
+  s->budget_exhausted = true;
+
+  return true;
+}
+
+/**
+ * @brief Check if the computation can be carried on with <code>wp</code>
+ * bits of working precision.
+ *
+ * The working precision is not clamped to the budget, since a last step
+ * at a precision only slightly higher than the current one would cost as
+ * much as a full one without improving the approximations. If
+ * <code>wp</code> is over the budget, the budget is marked as exhausted.
+ */
+MPS_PRIVATE mps_boolean
+mps_budget_allows_precision (mps_context * s, long int wp)
+{
+  if (s->precision_budget <= 0 || wp <= s->precision_budget)
+    return true;
+
+  MPS_DEBUG (s, "The precision budget of %ld bits is exhausted", s->precision_budget);
+  s->budget_exhausted = true;
+
+  return false;
+}
@@ -0,0 +1,1032 @@
+/*
+ * This file is part of MPSolve 3.1.5
+ *
+ * Copyright (C) 2001-2015, Dipartimento di Matematica "L. Tonelli", Pisa.
+ * License: http://www.gnu.org/licenses/gpl.html GPL version 3 or higher
+ *
+ * Authors:
+ *   Leonardo Robol <leonardo.robol@sns.it>
+ */
+
+#include <float.h>
+#include <math.h>
+#include <mps/mps.h>
+
+#define pi2 6.283184
+
+/*! @cond PRIVATE */
+struct mps_conjugate_item {
+  double re;
+  double im;
+  int k;
+};
+
+struct mps_conjugate_ditem {
+  cdpe_t key;
+  int k;
+};
+/*! @endcond */
+
+static int
+mps_conjugate_item_compare (const void * a, const void * b)
+{
+  const struct mps_conjugate_item * x = (const struct mps_conjugate_item*) a;
+  const struct mps_conjugate_item * y = (const struct mps_conjugate_item*) b;
+
+  if (x->re != y->re)
+    return (x->re < y->re) ? -1 : 1;
+  if (x->im != y->im)
+    return (x->im < y->im) ? -1 : 1;
+
+  return x->k - y->k;
+}
+
+/*
+ * Order the rdpe_t by their representation, which is the same for
+ * equal numbers. This is all that is needed to find the exact conjugates.
+ */
+static int
+mps_conjugate_rdpe_compare (const rdpe_t x, const rdpe_t y)
+{
+  if (rdpe_Esp (x) != rdpe_Esp (y))
+    return (rdpe_Esp (x) < rdpe_Esp (y)) ? -1 : 1;
+  if (rdpe_Mnt (x) != rdpe_Mnt (y))
+    return (rdpe_Mnt (x) < rdpe_Mnt (y)) ? -1 : 1;
+
+  return 0;
+}
+
+static int
+mps_conjugate_key_compare (const cdpe_t x, const cdpe_t y)
+{
+  int c = mps_conjugate_rdpe_compare (cdpe_Re (x), cdpe_Re (y));
+
+  return (c != 0) ? c : mps_conjugate_rdpe_compare (cdpe_Im (x), cdpe_Im (y));
+}
+
+static int
+mps_conjugate_ditem_compare (const void * a, const void * b)
+{
+  const struct mps_conjugate_ditem * x = (const struct mps_conjugate_ditem*) a;
+  const struct mps_conjugate_ditem * y = (const struct mps_conjugate_ditem*) b;
+  int c = mps_conjugate_key_compare (x->key, y->key);
+
+  return (c != 0) ? c : x->k - y->k;
+}
+
+/**
+ * @brief Check if the iterations may exploit the symmetry of the roots
+ * with respect to the real axis.
+ *
+ * This is the case if it has been requested with
+ * mps_context_set_conjugate_symmetry(), the coefficients of the polynomial
+ * are real, and the floating point iterations have not been stalling in the
+ * last packets.
+ */
+mps_boolean
+mps_conjugate_symmetry_enabled (mps_context * s)
+{
+  return s->conjugate_symmetry && s->active_poly != NULL &&
+         MPS_STRUCTURE_IS_REAL (s->active_poly->structure) &&
+         s->conjugate_stalls < MPS_CONJUGATE_MAX_STALLS;
+}
+
+static mps_conjugate_pairs *
+mps_conjugate_pairs_new (mps_context * s, mps_phase phase, int * conjugate)
+{
+  mps_conjugate_pairs * pairs = mps_new (mps_conjugate_pairs);
+  int i;
+
+  pairs->n = s->n;
+  pairs->phase = phase;
+  pairs->conjugate = conjugate;
+  pairs->split = mps_boolean_valloc (s->n);
+
+  for (i = 0; i < s->n; i++)
+    pairs->split[i] = false;
+
+  return pairs;
+}
+
+static void
+mps_conjugate_pairs_free (mps_conjugate_pairs * pairs)
+{
+  free (pairs->conjugate);
+  mps_boolean_vfree (pairs->split);
+  free (pairs);
+}
+
+/*
+ * Make the j-th approximation the exact conjugate of the i-th one, and
+ * merge their states so that none of them is considered more accurate
+ * than it is.
+ */
+static mps_boolean
+mps_conjugate_fsnap (mps_context * s, int i, int j)
+{
+  mps_approximation * root = s->root[i], * mirror = s->root[j];
+  cplx_t d;
+
+  if (root->status != mirror->status)
+    return false;
+
+  cplx_set_d (d, cplx_Re (root->fvalue) - cplx_Re (mirror->fvalue),
+              cplx_Im (root->fvalue) + cplx_Im (mirror->fvalue));
+  root->frad = MAX (root->frad, mirror->frad) + cplx_mod (d);
+  root->again = root->again || mirror->again;
+  root->approximated = root->approximated && mirror->approximated;
+
+  cplx_set_d (mirror->fvalue, cplx_Re (root->fvalue), -cplx_Im (root->fvalue));
+  cdpe_set_x (mirror->dvalue, mirror->fvalue);
+  mirror->frad = root->frad;
+  mirror->again = root->again;
+  mirror->approximated = root->approximated;
+
+  return true;
+}
+
+/**
+ * @brief Pair the floating point approximations with their conjugates.
+ *
+ * The approximations need to be symmetric only up to the rounding errors
+ * of the iterations that did not exploit the symmetry, i.e., within a
+ * relative distance of <code>MPS_CONJUGATE_TOLERANCE</code> times the
+ * machine precision. The pairs are made exactly conjugate, and the
+ * inclusion radii are enlarged accordingly. The approximations without a
+ * conjugate are iterated on their own.
+ *
+ * @return The pairing to be used in the next packet of iterations, or NULL
+ * if the symmetry cannot be used. In the latter case all the approximations
+ * must be iterated.
+ */
+mps_conjugate_pairs *
+mps_conjugate_fpairs (mps_context * s)
+{
+  struct mps_conjugate_item * upper, * lower;
+  int * conjugate;
+  int * matched;
+  int i, j, k, l, nu = 0, nl = 0, best;
+  double tol, d, best_d;
+
+  if (!mps_conjugate_symmetry_enabled (s))
+    return NULL;
+
+  upper = mps_newv (struct mps_conjugate_item, s->n);
+  lower = mps_newv (struct mps_conjugate_item, s->n);
+  conjugate = mps_newv (int, s->n);
+
+  for (i = 0; i < s->n; i++)
+    {
+      double re = cplx_Re (s->root[i]->fvalue);
+      double im = cplx_Im (s->root[i]->fvalue);
+
+      conjugate[i] = i;
+
+      if (fabs (im) <= MPS_CONJUGATE_TOLERANCE * DBL_EPSILON * fabs (re))
+        {
+          cplx_Im (s->root[i]->fvalue) = 0.0;
+          s->root[i]->frad += fabs (im);
+        }
+      else if (im > 0)
+        {
+          upper[nu].re = re;
+          upper[nu].im = im;
+          upper[nu++].k = i;
+        }
+      else
+        {
+          lower[nl].re = re;
+          lower[nl].im = -im;
+          lower[nl++].k = i;
+        }
+    }
+
+  /* Approximations with close real parts are now contiguous, so the
+   * conjugate of every element of lower is found by a binary search
+   * followed by a scan of the elements within the tolerance. */
+  qsort (upper, nu, sizeof(struct mps_conjugate_item), mps_conjugate_item_compare);
+  matched = mps_newv (int, nu);
+  for (i = 0; i < nu; i++)
+    matched[i] = false;
+
+  for (l = 0; l < nl; l++)
+    {
+      tol = MPS_CONJUGATE_TOLERANCE * DBL_EPSILON * (fabs (lower[l].re) + lower[l].im);
+
+      for (i = 0, j = nu; i < j;)
+        {
+          k = (i + j) / 2;
+          if (upper[k].re < lower[l].re - tol)
+            i = k + 1;
+          else
+            j = k;
+        }
+
+      best = -1;
+      best_d = tol;
+      for (k = i; k < nu && upper[k].re <= lower[l].re + tol; k++)
+        {
+          d = fabs (upper[k].re - lower[l].re) + fabs (upper[k].im - lower[l].im);
+          if (!matched[k] && d <= best_d)
+            {
+              best = k;
+              best_d = d;
+            }
+        }
+
+      if (best < 0 || !mps_conjugate_fsnap (s, upper[best].k, lower[l].k))
+        continue;
+
+      matched[best] = true;
+      conjugate[upper[best].k] = lower[l].k;
+      conjugate[lower[l].k] = -1 - upper[best].k;
+    }
+
+  free (matched);
+  free (upper);
+  free (lower);
+
+  return mps_conjugate_pairs_new (s, float_phase, conjugate);
+}
+
+/*
+ * Check if the multiprecision value y is the exact conjugate of x.
+ */
+static mps_boolean
+mps_conjugate_mexact (mpc_t x, mpc_t y)
+{
+  mps_boolean exact;
+  mpf_t t;
+
+  if (mpf_cmp (mpc_Re (x), mpc_Re (y)) != 0)
+    return false;
+
+  mpf_init2 (t, mpf_get_prec (mpc_Im (y)));
+  mpf_neg (t, mpc_Im (y));
+  exact = (mpf_cmp (mpc_Im (x), t) == 0);
+  mpf_clear (t);
+
+  return exact;
+}
+
+/*
+ * Pair the approximations whose values are exactly conjugate. The keys are
+ * the values converted to cdpe_t, and if values is not NULL the pairs
+ * found on the keys are checked on the multiprecision values. On exit,
+ * unmatched holds the number of approximations that are not real and do
+ * not have a conjugate.
+ */
+static int *
+mps_conjugate_match (mps_context * s, cdpe_t * keys, mpc_t * values, int * unmatched)
+{
+  struct mps_conjugate_ditem * upper, * lower;
+  int * conjugate = mps_newv (int, s->n);
+  int i, a = 0, b = 0, c, nu = 0, nl = 0;
+
+  upper = mps_newv (struct mps_conjugate_ditem, s->n);
+  lower = mps_newv (struct mps_conjugate_ditem, s->n);
+
+  for (i = 0; i < s->n; i++)
+    {
+      conjugate[i] = i;
+
+      if (rdpe_sgn (cdpe_Im (keys[i])) > 0)
+        {
+          cdpe_set (upper[nu].key, keys[i]);
+          upper[nu++].k = i;
+        }
+      else if (rdpe_sgn (cdpe_Im (keys[i])) < 0)
+        {
+          cdpe_set (lower[nl].key, keys[i]);
+          rdpe_neg_eq (cdpe_Im (lower[nl].key));
+          lower[nl++].k = i;
+        }
+    }
+
+  qsort (upper, nu, sizeof(struct mps_conjugate_ditem), mps_conjugate_ditem_compare);
+  qsort (lower, nl, sizeof(struct mps_conjugate_ditem), mps_conjugate_ditem_compare);
+
+  /* Merge the two sorted lists, pairing the elements with the same key */
+  while (a < nu && b < nl)
+    {
+      c = mps_conjugate_key_compare (upper[a].key, lower[b].key);
+
+      if (c < 0)
+        a++;
+      else if (c > 0)
+        b++;
+      else
+        {
+          if (values == NULL || mps_conjugate_mexact (values[upper[a].k], values[lower[b].k]))
+            {
+              conjugate[upper[a].k] = lower[b].k;
+              conjugate[lower[b].k] = -1 - upper[a].k;
+            }
+          a++;
+          b++;
+        }
+    }
+
+  *unmatched = 0;
+  for (i = 0; i < s->n; i++)
+    if (conjugate[i] == i && !rdpe_eq_zero (cdpe_Im (keys[i])))
+      (*unmatched)++;
+
+  free (upper);
+  free (lower);
+
+  return conjugate;
+}
+
+/*
+ * Merge the states of two approximations that are exactly conjugate, or
+ * unpair them if they cannot be iterated together.
+ */
+static void
+mps_conjugate_merge (mps_context * s, int * conjugate, int i, mps_phase phase)
+{
+  mps_approximation * root = s->root[i], * mirror;
+  int j = conjugate[i];
+
+  if (j < 0 || j == i)
+    return;
+
+  mirror = s->root[j];
+
+  if (root->status != mirror->status || root->inclusion != mirror->inclusion ||
+      (phase == mp_phase && mpc_get_prec (root->mvalue) != mpc_get_prec (mirror->mvalue)))
+    {
+      conjugate[i] = i;
+      conjugate[j] = j;
+      return;
+    }
+
+  if (rdpe_lt (root->drad, mirror->drad))
+    rdpe_set (root->drad, mirror->drad);
+  root->again = root->again || mirror->again;
+  root->approximated = root->approximated && mirror->approximated;
+
+  rdpe_set (mirror->drad, root->drad);
+  mirror->again = root->again;
+  mirror->approximated = root->approximated;
+}
+
+/**
+ * @brief Pair the DPE approximations that are exactly conjugate.
+ *
+ * The pairs found by mps_conjugate_fpairs() are exactly conjugate, and the
+ * iterations on the pairs keep them so, so there is no need for a tolerance
+ * here. The approximations without a conjugate are iterated on their own.
+ *
+ * @return The pairing to be used in the next packet of iterations, or NULL
+ * if the symmetry cannot be used.
+ */
+mps_conjugate_pairs *
+mps_conjugate_dpairs (mps_context * s)
+{
+  cdpe_t * keys;
+  int * conjugate;
+  int i, unmatched;
+
+  if (!mps_conjugate_symmetry_enabled (s))
+    return NULL;
+
+  keys = cdpe_valloc (s->n);
+  for (i = 0; i < s->n; i++)
+    cdpe_set (keys[i], s->root[i]->dvalue);
+
+  conjugate = mps_conjugate_match (s, keys, NULL, &unmatched);
+  for (i = 0; i < s->n; i++)
+    mps_conjugate_merge (s, conjugate, i, dpe_phase);
+
+  cdpe_vfree (keys);
+
+  return mps_conjugate_pairs_new (s, dpe_phase, conjugate);
+}
+
+/**
+ * @brief Multiprecision version of mps_conjugate_dpairs().
+ *
+ * The two approximations of a pair also need to have the same precision,
+ * so that the conjugate of one of them can be stored exactly in the other.
+ */
+mps_conjugate_pairs *
+mps_conjugate_mpairs (mps_context * s)
+{
+  cdpe_t * keys;
+  mpc_t * values;
+  int * conjugate;
+  int i, unmatched;
+
+  if (!mps_conjugate_symmetry_enabled (s))
+    return NULL;
+
+  keys = cdpe_valloc (s->n);
+  values = mps_newv (mpc_t, s->n);
+  for (i = 0; i < s->n; i++)
+    {
+      mpc_get_cdpe (keys[i], s->root[i]->mvalue);
+      mpc_Move (values[i], s->root[i]->mvalue);
+    }
+
+  conjugate = mps_conjugate_match (s, keys, values, &unmatched);
+  for (i = 0; i < s->n; i++)
+    mps_conjugate_merge (s, conjugate, i, mp_phase);
+
+  cdpe_vfree (keys);
+  free (values);
+
+  return mps_conjugate_pairs_new (s, mp_phase, conjugate);
+}
+
+/**
+ * @brief Pair the nodes of the secular equation with their conjugates.
+ *
+ * If the polynomial has real coefficients and the nodes are symmetric with
+ * respect to the real axis, the coefficients of the secular equation of
+ * conjugate nodes are conjugate, and only one of them needs to be computed.
+ *
+ * @param s The current mps_context.
+ * @param nodes The nodes of the secular equation.
+ *
+ * @return A newly allocated array that pairs the nodes as described in
+ * conjugate.h, or NULL if the symmetry cannot be used or some node does
+ * not have an exact conjugate.
+ */
+int *
+mps_conjugate_mnodes (mps_context * s, mpc_t * nodes)
+{
+  cdpe_t * keys;
+  int * conjugate;
+  int i, unmatched;
+
+  if (!mps_conjugate_symmetry_enabled (s))
+    return NULL;
+
+  keys = cdpe_valloc (s->n);
+  for (i = 0; i < s->n; i++)
+    mpc_get_cdpe (keys[i], nodes[i]);
+
+  conjugate = mps_conjugate_match (s, keys, nodes, &unmatched);
+  cdpe_vfree (keys);
+
+  if (unmatched > 0)
+    {
+      free (conjugate);
+      return NULL;
+    }
+
+  return conjugate;
+}
+
+/**
+ * @brief Check if the job of the i-th approximation must be skipped,
+ * since it is updated together with the approximation it is paired with.
+ *
+ * @param pairs The pairing of the approximations, or NULL.
+ * @param i The index of the approximation.
+ * @param roots_mutex The locks of the approximations held while they are
+ * iterated, or NULL if the pairs are not split concurrently.
+ */
+mps_boolean
+mps_conjugate_skip (mps_conjugate_pairs * pairs, int i, pthread_mutex_t * roots_mutex)
+{
+  mps_boolean split;
+  int owner;
+
+  if (pairs == NULL || pairs->conjugate[i] >= 0)
+    return false;
+
+  owner = -1 - pairs->conjugate[i];
+
+  if (roots_mutex)
+    pthread_mutex_lock (&roots_mutex[owner]);
+  split = pairs->split[owner];
+  if (roots_mutex)
+    pthread_mutex_unlock (&roots_mutex[owner]);
+
+  return !split;
+}
+
+/*
+ * Return the index of the conjugate that is updated together with the i-th
+ * approximation, or -1 if there is none.
+ */
+static int
+mps_conjugate_mirror (mps_conjugate_pairs * pairs, int i)
+{
+  int j = pairs->conjugate[i];
+
+  return (j >= 0 && j != i && !pairs->split[i]) ? j : -1;
+}
+
+/*
+ * Check if an approximation of a pair that has crossed the real axis must
+ * be split. Close to a simple real root r, the Aberth correction of r + iy
+ * that takes into account its conjugate is approximately 2iy, so the
+ * iterations would jump back and forth across the real axis without
+ * converging. This happens when the Newton correction points to the
+ * projection of the old position on the real axis, whose distance is d.
+ */
+static mps_boolean
+mps_conjugate_crossing (cdpe_t old_value, cdpe_t corr, rdpe_t d)
+{
+  cdpe_t t;
+  rdpe_t m, h;
+
+  rdpe_set (d, cdpe_Im (old_value));
+  rdpe_set (cdpe_Re (t), cdpe_Re (corr));
+  rdpe_sub (cdpe_Im (t), cdpe_Im (corr), d);
+
+  cdpe_mod (m, t);
+  rdpe_mul_d (h, d, 0.5);
+
+  return rdpe_lt (m, h);
+}
+
+/*
+ * Copy the state of the i-th approximation to the j-th one, where the
+ * value is conjugated.
+ */
+static void
+mps_conjugate_fcopy (mps_context * s, int i, int j)
+{
+  mps_approximation * root = s->root[i], * mirror = s->root[j];
+
+  cplx_set_d (mirror->fvalue, cplx_Re (root->fvalue), -cplx_Im (root->fvalue));
+  cdpe_set_x (mirror->dvalue, mirror->fvalue);
+  mirror->frad = root->frad;
+  mirror->again = root->again;
+  mirror->approximated = root->approximated;
+  mirror->status = root->status;
+}
+
+/**
+ * @brief Propagate the floating point update of the i-th approximation to
+ * its conjugate.
+ *
+ * If the approximation crosses the real axis while closing in on a real
+ * root, the pair is split in two real approximations, that are iterated
+ * separately from now on: the split is recorded in <code>pairs</code>, and
+ * mps_conjugate_skip() stops skipping the job of the conjugate. In the
+ * other cases, the approximation is replaced by its conjugate if needed, so
+ * that the pair stays the same. Real approximations that are iterated on
+ * their own are kept on the real axis.
+ *
+ * This must be called while holding the lock of the i-th approximation.
+ *
+ * @param s The current mps_context.
+ * @param pairs The pairing computed by mps_conjugate_fpairs().
+ * @param i The index of the approximation that has been updated.
+ * @param old_value The value of the approximation before the update.
+ * @param corr The Newton correction computed at <code>old_value</code>.
+ *
+ * @return The index of the other approximation that has been changed,
+ * or -1 if there is none.
+ */
+int
+mps_conjugate_fupdate (mps_context * s, mps_conjugate_pairs * pairs, int i, cplx_t old_value, cplx_t corr)
+{
+  mps_approximation * root = s->root[i], * mirror;
+  int j = mps_conjugate_mirror (pairs, i);
+  cdpe_t old, dcorr;
+  rdpe_t rd;
+  double re, d;
+
+  if (j < 0)
+    {
+      /* Rounding errors must not move a real approximation away from the
+       * real axis */
+      if (cplx_Im (old_value) == 0)
+        cplx_Im (root->fvalue) = 0.0;
+      return -1;
+    }
+
+  if (cplx_Im (root->fvalue) < 0)
+    {
+      cdpe_set_x (old, old_value);
+      cdpe_set_x (dcorr, corr);
+
+      if (mps_conjugate_crossing (old, dcorr, rd))
+        {
+          /* The new positions have not been checked yet, so both the
+           * approximations need to be iterated again. */
+          mirror = s->root[j];
+          re = cplx_Re (root->fvalue);
+          d = cplx_Im (old_value);
+
+          cplx_set_d (root->fvalue, re + d, 0.0);
+          cplx_set_d (mirror->fvalue, re - d, 0.0);
+          cdpe_set_x (mirror->dvalue, mirror->fvalue);
+          mirror->frad = root->frad = root->frad + 2 * d;
+          mirror->again = root->again = true;
+          mirror->approximated = root->approximated = false;
+          mirror->status = root->status;
+
+          pairs->split[i] = true;
+
+          return j;
+        }
+
+      cplx_Im (root->fvalue) = -cplx_Im (root->fvalue);
+    }
+
+  mps_conjugate_fcopy (s, i, j);
+
+  return j;
+}
+
+/**
+ * @brief DPE version of mps_conjugate_fupdate().
+ */
+int
+mps_conjugate_dupdate (mps_context * s, mps_conjugate_pairs * pairs, int i, cdpe_t old_value, cdpe_t corr)
+{
+  mps_approximation * root = s->root[i], * mirror;
+  int j = mps_conjugate_mirror (pairs, i);
+  rdpe_t re, d;
+
+  if (j < 0)
+    {
+      if (rdpe_eq_zero (cdpe_Im (old_value)))
+        rdpe_set (cdpe_Im (root->dvalue), rdpe_zero);
+      return -1;
+    }
+
+  mirror = s->root[j];
+
+  if (rdpe_sgn (cdpe_Im (root->dvalue)) < 0)
+    {
+      if (mps_conjugate_crossing (old_value, corr, d))
+        {
+          rdpe_set (re, cdpe_Re (root->dvalue));
+
+          rdpe_add (cdpe_Re (root->dvalue), re, d);
+          rdpe_sub (cdpe_Re (mirror->dvalue), re, d);
+          rdpe_set (cdpe_Im (root->dvalue), rdpe_zero);
+          rdpe_set (cdpe_Im (mirror->dvalue), rdpe_zero);
+
+          rdpe_mul_eq_d (d, 2);
+          rdpe_add_eq (root->drad, d);
+          rdpe_set (mirror->drad, root->drad);
+          mirror->again = root->again = true;
+          mirror->approximated = root->approximated = false;
+
+          pairs->split[i] = true;
+
+          return j;
+        }
+
+      rdpe_neg_eq (cdpe_Im (root->dvalue));
+    }
+
+  rdpe_set (cdpe_Re (mirror->dvalue), cdpe_Re (root->dvalue));
+  rdpe_neg (cdpe_Im (mirror->dvalue), cdpe_Im (root->dvalue));
+  rdpe_set (mirror->drad, root->drad);
+  mirror->again = root->again;
+  mirror->approximated = root->approximated;
+
+  return j;
+}
+
+/**
+ * @brief Multiprecision version of mps_conjugate_fupdate().
+ *
+ * @param aberth_mutex The locks that protect the multiprecision values of
+ * the approximations while they are read by the other threads, or NULL.
+ */
+int
+mps_conjugate_mupdate (mps_context * s, mps_conjugate_pairs * pairs, int i, mpc_t old_value,
+                       mpc_t corr, pthread_mutex_t * aberth_mutex)
+{
+  mps_approximation * root = s->root[i], * mirror;
+  int j = mps_conjugate_mirror (pairs, i);
+  cdpe_t old, dcorr;
+  rdpe_t d;
+  mpf_t re;
+
+  if (j < 0)
+    {
+      if (mpf_sgn (mpc_Im (old_value)) == 0 && mpf_sgn (mpc_Im (root->mvalue)) != 0)
+        {
+          if (aberth_mutex)
+            pthread_mutex_lock (&aberth_mutex[i]);
+          mpf_set_ui (mpc_Im (root->mvalue), 0U);
+          if (aberth_mutex)
+            pthread_mutex_unlock (&aberth_mutex[i]);
+        }
+      return -1;
+    }
+
+  mirror = s->root[j];
+
+  if (mpf_sgn (mpc_Im (root->mvalue)) < 0)
+    {
+      mpc_get_cdpe (old, old_value);
+      mpc_get_cdpe (dcorr, corr);
+
+      if (mps_conjugate_crossing (old, dcorr, d))
+        {
+          mpf_init2 (re, mpc_get_prec (root->mvalue));
+          mpf_set (re, mpc_Re (root->mvalue));
+
+          if (aberth_mutex)
+            pthread_mutex_lock (&aberth_mutex[i]);
+          mpf_add (mpc_Re (root->mvalue), re, mpc_Im (old_value));
+          mpf_set_ui (mpc_Im (root->mvalue), 0U);
+          if (aberth_mutex)
+            pthread_mutex_unlock (&aberth_mutex[i]);
+
+          if (aberth_mutex)
+            pthread_mutex_lock (&aberth_mutex[j]);
+          mpf_sub (mpc_Re (mirror->mvalue), re, mpc_Im (old_value));
+          mpf_set_ui (mpc_Im (mirror->mvalue), 0U);
+          if (aberth_mutex)
+            pthread_mutex_unlock (&aberth_mutex[j]);
+
+          mpf_clear (re);
+
+          rdpe_mul_eq_d (d, 2);
+          rdpe_add_eq (root->drad, d);
+          rdpe_set (mirror->drad, root->drad);
+          mirror->again = root->again = true;
+          mirror->approximated = root->approximated = false;
+
+          pairs->split[i] = true;
+
+          return j;
+        }
+
+      if (aberth_mutex)
+        pthread_mutex_lock (&aberth_mutex[i]);
+      mpf_neg (mpc_Im (root->mvalue), mpc_Im (root->mvalue));
+      if (aberth_mutex)
+        pthread_mutex_unlock (&aberth_mutex[i]);
+    }
+
+  if (aberth_mutex)
+    pthread_mutex_lock (&aberth_mutex[j]);
+  mpc_con (mirror->mvalue, root->mvalue);
+  if (aberth_mutex)
+    pthread_mutex_unlock (&aberth_mutex[j]);
+
+  rdpe_set (mirror->drad, root->drad);
+  mirror->again = root->again;
+  mirror->approximated = root->approximated;
+
+  return j;
+}
+
+/*
+ * Join the real approximations that are not in the root neighbourhood in
+ * conjugate pairs. These are usually the leftovers of pairs that have been
+ * split by mps_conjugate_fupdate() close to a single real root, and would
+ * otherwise wander on the real axis forever.
+ */
+static void
+mps_conjugate_fjoin (mps_context * s)
+{
+  struct mps_conjugate_item * items = mps_newv (struct mps_conjugate_item, s->n);
+  int i, m = 0;
+  double c, d;
+
+  for (i = 0; i < s->n; i++)
+    if (s->root[i]->again && cplx_Im (s->root[i]->fvalue) == 0)
+      {
+        items[m].re = cplx_Re (s->root[i]->fvalue);
+        items[m].im = 0.0;
+        items[m++].k = i;
+      }
+
+  qsort (items, m, sizeof(struct mps_conjugate_item), mps_conjugate_item_compare);
+
+  for (i = 0; i + 1 < m; i += 2)
+    {
+      mps_approximation * a = s->root[items[i].k], * b = s->root[items[i + 1].k];
+
+      c = 0.5 * (items[i].re + items[i + 1].re);
+      d = MAX (0.5 * (items[i + 1].re - items[i].re),
+               MPS_CONJUGATE_TOLERANCE * DBL_EPSILON * fabs (c));
+
+      cplx_set_d (a->fvalue, c, d);
+      cplx_set_d (b->fvalue, c, -d);
+      a->frad = b->frad = MAX (a->frad, b->frad) + d;
+    }
+
+  free (items);
+}
+
+/*
+ * Rotate the i-th approximation by an angle that depends on i, and is above
+ * the tolerance of mps_conjugate_fpairs().
+ */
+static void
+mps_conjugate_frotate (mps_context * s, int i)
+{
+  double t = 4 * MPS_CONJUGATE_TOLERANCE * DBL_EPSILON * (1 + (double) i / s->n);
+  cplx_t rotation;
+
+  cplx_set_d (rotation, cos (t), sin (t));
+  cplx_mul_eq (s->root[i]->fvalue, rotation);
+  cdpe_set_x (s->root[i]->dvalue, s->root[i]->fvalue);
+  s->root[i]->frad += t * cplx_mod (s->root[i]->fvalue);
+}
+
+/*
+ * Rotate the approximations that are not approximated yet, so that none of
+ * them is real or the exact conjugate of another one. The iterations on all
+ * the approximations would otherwise keep them so, and could never fix a
+ * wrong number of real approximations. This includes the ones in the root
+ * neighbourhood, since two real approximations may have converged to the
+ * same real root. The angle is different for every approximation, so
+ * that equal ones are separated, and is above the tolerance of
+ * mps_conjugate_fpairs(), so they are not paired again.
+ */
+static void
+mps_conjugate_unpair (mps_context * s)
+{
+  int i;
+
+  for (i = 0; i < s->n; i++)
+    if (s->root[i]->again || !s->root[i]->approximated)
+      mps_conjugate_frotate (s, i);
+}
+
+/**
+ * @brief Split the conjugate pairs that are still iterated at the end of a
+ * packet of floating point iterations.
+ *
+ * A pair may not be able to reach the root neighbourhood, for instance if
+ * it is attracted by a real root, or if the approximations left on the real
+ * axis are fewer than the real roots. The two approximations of these pairs
+ * are rotated as in mps_conjugate_unpair(), and are iterated on their own
+ * until the end of the packet, while the other pairs are kept.
+ *
+ * @param s The current mps_context.
+ * @param pairs The pairing computed by mps_conjugate_fpairs().
+ *
+ * @return true if some pair has been split.
+ */
+mps_boolean
+mps_conjugate_fsplit (mps_context * s, mps_conjugate_pairs * pairs)
+{
+  mps_boolean split = false;
+  int i, j;
+
+  for (i = 0; i < pairs->n; i++)
+    {
+      j = mps_conjugate_mirror (pairs, i);
+      if (j < 0 || !s->root[i]->again)
+        continue;
+
+      mps_conjugate_frotate (s, i);
+      mps_conjugate_frotate (s, j);
+      pairs->split[i] = true;
+      split = true;
+    }
+
+  return split;
+}
+
+/*
+ * Check if a pair that is still iterated at the end of a DPE or
+ * multiprecision packet has an inclusion disc that touches the real axis.
+ * Such a pair is closing in on a real root, or on two close ones, and the
+ * iterations keep its approximations exactly conjugate, so it can neither
+ * be isolated nor reach the real axis, where mps_conjugate_dupdate() and
+ * mps_conjugate_mupdate() would split it.
+ */
+static mps_boolean
+mps_conjugate_stuck (mps_context * s, mps_conjugate_pairs * pairs)
+{
+  cdpe_t x;
+  rdpe_t im;
+  int i;
+
+  for (i = 0; i < pairs->n; i++)
+    {
+      if (mps_conjugate_mirror (pairs, i) < 0 || !s->root[i]->again)
+        continue;
+
+      if (pairs->phase == mp_phase)
+        mpc_get_cdpe (x, s->root[i]->mvalue);
+      else
+        cdpe_set (x, s->root[i]->dvalue);
+
+      rdpe_abs (im, cdpe_Im (x));
+      if (rdpe_le (im, s->root[i]->drad))
+        return true;
+    }
+
+  return false;
+}
+
+/*
+ * DPE and multiprecision version of mps_conjugate_unpair(). The angle is
+ * between 4 and 8 times MPS_CONJUGATE_TOLERANCE times the precision of the
+ * values, and the rotation is computed as z + t i z, which is exact up to
+ * the second order in t.
+ */
+static void
+mps_conjugate_munpair (mps_context * s, mps_phase phase)
+{
+  cdpe_t dt;
+  rdpe_t rtmp;
+  mpc_t t;
+  long int wp;
+  int i;
+
+  for (i = 0; i < s->n; i++)
+    {
+      mps_approximation * root = s->root[i];
+
+      if (!root->again && root->approximated)
+        continue;
+
+      if (phase == mp_phase)
+        {
+          wp = mpc_get_prec (root->mvalue);
+          mpc_init2 (t, wp);
+          mpc_rot (t, root->mvalue);
+          mpc_mul_ui (t, t, s->n + i);
+          mpc_div_ui (t, t, s->n);
+          mpc_div_2exp (t, t, wp - 12);
+          mpc_add_eq (root->mvalue, t);
+          mpc_rmod (rtmp, t);
+          mpc_clear (t);
+        }
+      else
+        {
+          cdpe_rot (dt, root->dvalue);
+          cdpe_mul_eq_d (dt, 4 * MPS_CONJUGATE_TOLERANCE * DBL_EPSILON * (1 + (double) i / s->n));
+          cdpe_add_eq (root->dvalue, dt);
+          cdpe_mod (rtmp, dt);
+        }
+
+      rdpe_add_eq (root->drad, rtmp);
+    }
+}
+
+/**
+ * @brief Stop using the symmetry until the next call to mps_mpsolve().
+ *
+ * @param s The current mps_context.
+ */
+void
+mps_conjugate_abandon (mps_context * s)
+{
+  s->conjugate_stalls = MPS_CONJUGATE_MAX_STALLS;
+}
+
+/**
+ * @brief Release the pairing used in a packet of iterations.
+ *
+ * For the floating point packets, the real approximations that are not in
+ * the root neighbourhood at the end of the packet are joined in conjugate
+ * pairs. If too many consecutive packets end before all the approximations
+ * are in the root neighbourhood, the number of real approximations may
+ * still not match the number of real roots: the approximations that are
+ * not approximated yet are unpaired, and the symmetry is not used anymore until
+ * the next call to mps_mpsolve().
+ *
+ * The DPE and multiprecision packets fall back in the same way when too
+ * many consecutive packets end with a pair, still being iterated, whose
+ * inclusion disc touches the real axis, since such a pair cannot be
+ * isolated.
+ *
+ * @param s The current mps_context.
+ * @param pairs The pairing used in the packet, that is freed.
+ * @param zeros The number of approximations in the root neighbourhood at
+ * the end of the packet.
+ */
+void
+mps_conjugate_packet_done (mps_context * s, mps_conjugate_pairs * pairs, int zeros)
+{
+  if (pairs->phase == float_phase)
+    {
+      if (zeros >= s->n)
+        s->conjugate_stalls = 0;
+      else
+        {
+          mps_conjugate_fjoin (s);
+
+          if (++s->conjugate_stalls == MPS_CONJUGATE_MAX_STALLS)
+            {
+              MPS_DEBUG_WITH_INFO (s, "Iterations on conjugate pairs are stalling, iterating on all the approximations");
+              mps_conjugate_unpair (s);
+            }
+        }
+    }
+  else if (mps_conjugate_stuck (s, pairs))
+    {
+      if (++s->conjugate_stalls == MPS_CONJUGATE_MAX_STALLS)
+        {
+          MPS_DEBUG_WITH_INFO (s, "Conjugate pairs cannot be isolated from the real axis, iterating on all the approximations");
+          mps_conjugate_munpair (s, pairs->phase);
+        }
+    }
+  else
+    s->conjugate_stalls = 0;
+
+  mps_conjugate_pairs_free (pairs);
+}
@@ -80,7 +80,92 @@ mps_context_select_starting_strategy (mps_context * s, mps_starting_strategy str
 }
 
 static void
-mps_context_init (mps_context * s)
+mps_context_free_starting_approximations (mps_context * s)
+{
+  if (s->starting_points)
+    {
+      mpc_vclear (s->starting_points, s->n_starting_points);
+      mpc_vfree (s->starting_points);
+    }
+
+  free (s->starting_radii);
+
+  s->starting_points = NULL;
+  s->starting_radii = NULL;
+  s->n_starting_points = 0;
+}
+
+static void
+mps_context_alloc_starting_approximations (mps_context * s, int n, long int prec, mps_boolean radii)
+{
+  mps_context_free_starting_approximations (s);
+
+  s->n_starting_points = n;
+  s->starting_points = mpc_valloc (n);
+  mpc_vinit2 (s->starting_points, n, prec);
+
+  if (radii)
+    s->starting_radii = rdpe_valloc (n);
+
+  mps_context_select_starting_strategy (s, MPS_STARTING_STRATEGY_USER);
+}
+
+/**
+ * @brief Use the given points as starting approximations for the next
+ * call to mps_mpsolve(), instead of computing them from the coefficients
+ * of the polynomial.
+ *
+ * This is useful to solve a polynomial whose coefficients are close to the
+ * ones of a polynomial that has already been solved, starting from its
+ * roots. The points are copied, and are used only once: the following
+ * computations use the default starting strategy again. If their number
+ * is different from the degree of the (deflated) polynomial that is
+ * solved they are ignored.
+ *
+ * @param s The current mps_context.
+ * @param points The starting approximations.
+ * @param radii The inclusion radii of the approximations, or NULL if they
+ * are not known. They are used only until the approximations are updated
+ * for the first time.
+ * @param n The number of points.
+ */
+void
+mps_context_set_starting_approximations_d (mps_context * s, cplx_t * points, double * radii, int n)
+{
+  int i;
+
+  mps_context_alloc_starting_approximations (s, n, DBL_MANT_DIG, radii != NULL);
+
+  for (i = 0; i < n; i++)
+    {
+      mpc_set_cplx (s->starting_points[i], points[i]);
+      if (radii)
+        rdpe_set_d (s->starting_radii[i], radii[i]);
+    }
+}
+
+/**
+ * @brief Multiprecision version of
+ * mps_context_set_starting_approximations_d().
+ */
+void
+mps_context_set_starting_approximations_m (mps_context * s, mpc_t * points, rdpe_t * radii, int n)
+{
+  int i;
+
+  mps_context_alloc_starting_approximations (s, n, n > 0 ? mpc_get_prec (points[0]) : DBL_MANT_DIG,
+                                             radii != NULL);
+
+  for (i = 0; i < n; i++)
+    {
+      mpc_set (s->starting_points[i], points[i]);
+      if (radii)
+        rdpe_set (s->starting_radii[i], radii[i]);
+    }
+}
+
+static void
+mps_context_init (mps_context * s, mps_thread_pool * pool)
 {
   mpf_t test;
 
@@ -95,6 +180,13 @@ mps_context_init (mps_context * s)
 
   mps_set_default_values (s);
 
+  /* Allocate the thread_pool used in computations, unless a shared
+   * one has been given. */
+  if (pool)
+    s->pool = mps_thread_pool_ref (pool);
+  else
+    s->pool = mps_thread_pool_new (s, 0);
+
   /* Find minimum GMP supported precision */
   mpf_init2 (test, 1);
   s->minimum_gmp_precision = mpf_get_prec (test);
@@ -106,6 +198,12 @@ mps_context_init (mps_context * s)
 
   mps_mp_set_prec (s, DBL_DIG * LOG2_10 + 1);
 
+  s->newton_corrections = 0;
+
+  pthread_mutex_init (&s->memory_in_use.mutex, NULL);
+  s->memory_in_use.value = 0;
+  s->memory_high_water = 0;
+
   s->initialized = false;
   s->exit_required = false;
 }
@@ -141,12 +239,29 @@ mps_context_new ()
   if (!ctx)
     {
       ctx = (mps_context*)mps_malloc (sizeof(mps_context));
-      mps_context_init (ctx);
+      mps_context_init (ctx, NULL);
     }
 
   return ctx;
 }
 
+/**
+ * @brief Allocate a new mps_context that runs its computations on
+ * <code>pool</code>.
+ *
+ * Unlike mps_context_new(), no private thread pool is started, so this
+ * is cheap for contexts that are going to use a shared pool anyway.
+ */
+mps_context *
+mps_context_new_with_pool (mps_thread_pool * pool)
+{
+  mps_context * ctx = (mps_context*)mps_malloc (sizeof(mps_context));
+
+  mps_context_init (ctx, pool);
+
+  return ctx;
+}
+
 
 /**
  * @brief Free a not more useful mps_context.
@@ -167,6 +282,10 @@ mps_context_free (mps_context * s)
   s->instr = stdin;
   s->logstr = stderr;
 
+  mps_context_free_starting_approximations (s);
+  if (s->starting_strategy == MPS_STARTING_STRATEGY_USER)
+    mps_context_select_starting_strategy (s, MPS_STARTING_STRATEGY_DEFAULT);
+
   /* There's no need to resize bmpc since they will be allocated on demand.
    * We free them here to correct bad assumptions on the size of this
    * vector. */
@@ -175,10 +294,16 @@ mps_context_free (mps_context * s)
 
   pthread_mutex_lock (&context_factory_mutex);
 
-  if (context_factory_size < MPS_CONTEXT_FACTORY_MAXIMUM_SIZE)
+  /* Contexts using a shared pool do not own any thread, so there is
+   * no point in recycling them. */
+  if (context_factory_size < MPS_CONTEXT_FACTORY_MAXIMUM_SIZE &&
+      !mps_thread_pool_is_shared (s->pool))
     {
       context_factory = mps_realloc (context_factory,
                                      sizeof(mps_context*) * (context_factory_size + 1));
+      /* Do not report the memory used by the previous owner */
+      s->memory_high_water = s->memory_in_use.value;
+
       context_factory[context_factory_size++] = s;
       pthread_mutex_unlock (&context_factory_mutex);
       return;
@@ -188,9 +313,10 @@ mps_context_free (mps_context * s)
   if (s->initialized)
     mps_free_data (s);
 
-  mps_thread_pool_free (s, s->pool);
+  mps_thread_pool_unref (s, s->pool);
 
   free (s->input_config);
+  mps_search_region_free (s->output_config->search_region);
   free (s->output_config);
 
   s->active_poly = NULL;
@@ -320,7 +446,7 @@ mps_context_set_degree (mps_context * s, int n)
 
   /* Check if the numer of thread is greater of the number of roots,
      and in that case decrease it */
-  if (s->n_threads > s->deg)
+  if (s->n_threads > s->deg && !mps_thread_pool_is_shared (s->pool))
     {
       MPS_DEBUG_WITH_INFO (s, "Adjusting concurrency limit to %d", s->deg);
       mps_thread_pool_set_concurrency_limit (s, s->pool, s->deg);
@@ -356,9 +482,10 @@ mps_context_set_input_poly (mps_context * s, mps_polynomial * p)
 
   int i;
   s->active_poly = p;
+  s->zero_roots = 0;
 
   if (!p->thread_safe)
-    mps_thread_pool_set_concurrency_limit (s, s->pool, 1);
+    mps_context_set_sequential (s);
 
   /* Set the density or sparsity of the polynomial, if it's not
    * a user polynomial */
@@ -386,6 +513,11 @@ mps_context_set_input_poly (mps_context * s, mps_polynomial * p)
         }
     }
 
+  /* Sparse polynomials only store the terms, so the zero roots can be
+   * removed by shifting the exponents. */
+  if (MPS_IS_SPARSE_MONOMIAL_POLY (p))
+    s->zero_roots = mps_sparse_monomial_poly_deflate (s, p);
+
   mps_context_set_degree (s, p->degree);
 }
 
@@ -603,6 +735,54 @@ mps_context_get_approximations (mps_context * ctx)
   return approximations;
 }
 
+/**
+ * @brief Account for <code>bytes</code> more bytes of memory used by the
+ * coefficients of a polynomial (or less, if <code>bytes</code> is negative).
+ */
+void
+mps_context_account_memory (mps_context * s, long int bytes)
+{
+  MPS_LOCK (s->memory_in_use);
+  s->memory_in_use.value += bytes;
+  if (s->memory_in_use.value > s->memory_high_water)
+    s->memory_high_water = s->memory_in_use.value;
+  MPS_UNLOCK (s->memory_in_use);
+}
+
+/**
+ * @brief Get the number of Newton corrections that have been computed
+ * during the last call to mps_mpsolve().
+ *
+ * This is a measure of the work done by the iterations that does not depend
+ * on the speed of the machine, and can be used, for example, to see how much
+ * a good choice of the starting approximations saves.
+ */
+long int
+mps_context_get_newton_corrections (mps_context * s)
+{
+  return s->newton_corrections;
+}
+
+/**
+ * @brief Get the maximum number of bytes that have been used at the
+ * same time by the coefficients of the polynomials created with this
+ * context.
+ *
+ * The representations of the coefficients are allocated only when a
+ * phase of the computation first needs them, so this value depends on
+ * the phases that have been used, and not only on the degree.
+ */
+long int
+mps_context_get_memory_high_water (mps_context * s)
+{
+  long int ret;
+
+  MPS_LOCK (s->memory_in_use);
+  ret = s->memory_high_water;
+  MPS_UNLOCK (s->memory_in_use);
+  return ret;
+}
+
 
 /**
  * @brief Set the output precision for the roots.
@@ -676,6 +856,62 @@ mps_context_set_output_goal (mps_context * s, mps_output_goal goal)
   s->output_config->goal = goal;
 }
 
+/**
+ * @brief Add a closed disk to the region where the roots are searched.
+ *
+ * The search set becomes <code>MPS_SEARCH_SET_CUSTOM</code>, i.e., the union
+ * of the disks and rectangles added so far. The approximations whose
+ * inclusion disks are certified to lie out of it are not refined
+ * anymore, and are not reported by mps_output().
+ *
+ * @param s The <code>mps_context</code> of the computation.
+ * @param center_re Real part of the center of the disk.
+ * @param center_im Imaginary part of the center of the disk.
+ * @param radius Radius of the disk.
+ */
+void
+mps_context_add_search_disk (mps_context * s, double center_re, double center_im, double radius)
+{
+  cplx_t center;
+
+  if (s->output_config->search_region == NULL)
+    s->output_config->search_region = mps_search_region_new ();
+
+  cplx_set_d (center, center_re, center_im);
+  mps_search_region_add_disk (s->output_config->search_region, center, radius);
+  s->output_config->search_set = MPS_SEARCH_SET_CUSTOM;
+}
+
+/**
+ * @brief Add the closed rectangle \f$[re\_min, re\_max] \times [im\_min, im\_max]\f$
+ * to the region where the roots are searched.
+ *
+ * @see mps_context_add_search_disk()
+ */
+void
+mps_context_add_search_rectangle (mps_context * s, double re_min, double im_min,
+                                  double re_max, double im_max)
+{
+  if (s->output_config->search_region == NULL)
+    s->output_config->search_region = mps_search_region_new ();
+
+  mps_search_region_add_rectangle (s->output_config->search_region,
+                                   re_min, im_min, re_max, im_max);
+  s->output_config->search_set = MPS_SEARCH_SET_CUSTOM;
+}
+
+/**
+ * @brief Remove the disks and rectangles added to the search region, and
+ * search the roots in the whole complex plane again.
+ */
+void
+mps_context_clear_search_region (mps_context * s)
+{
+  mps_search_region_free (s->output_config->search_region);
+  s->output_config->search_region = NULL;
+  s->output_config->search_set = MPS_SEARCH_SET_COMPLEX_PLANE;
+}
+
 /**
  * @brief Set the value of the jacobi iterations switch in the MPSolve context.
  *
@@ -691,6 +927,188 @@ mps_context_set_jacobi_iterations (mps_context * s, mps_boolean jacobi_iteration
   s->jacobi_iterations = jacobi_iterations;
 }
 
+/**
+ * @brief Select how the threaded floating point and DPE iterations read
+ * the other roots when computing the Aberth correction.
+ *
+ * If aberth_snapshot is true every sweep reads the positions published by
+ * the previous one from a double buffered snapshot, otherwise the most
+ * recent positions computed by the other threads are used (Gauss-Seidel
+ * style). In both cases no lock is taken on the roots.
+ *
+ * @param s The mps_context where the value will be set
+ * @param aberth_snapshot The desired value for the aberth_snapshot switch.
+ */
+void
+mps_context_set_aberth_snapshot (mps_context * s, mps_boolean aberth_snapshot)
+{
+  s->aberth_snapshot = aberth_snapshot;
+}
+
+/**
+ * @brief Select when the Aberth sums of the Jacobi-style floating point and
+ * DPE iterations are evaluated with a fast multipole (Barnes-Hut) scheme.
+ *
+ * The scheme costs \f$O(n \log n)\f$ operations for all the roots instead of
+ * \f$O(n^2)\f$, but its result is only accurate up to <code>accuracy</code>,
+ * relative to the sum of the moduli of the terms. Roots that belong to a
+ * cluster always use the direct sum.
+ *
+ * @param s The mps_context where the value will be set
+ * @param degree The scheme is used for polynomials of at least this degree;
+ * 0 disables it.
+ * @param accuracy The relative accuracy of the sums.
+ */
+void
+mps_context_set_aberth_fmm (mps_context * s, long int degree, double accuracy)
+{
+  s->aberth_fmm_degree = degree;
+  s->aberth_fmm_accuracy = accuracy;
+}
+
+/**
+ * @brief Select when the secular algorithm regenerates the coefficients of
+ * the secular equation with a multipoint evaluation of the polynomial.
+ *
+ * The values of a monomial polynomial and of \f$\prod_{j \neq i} (b_i - b_j)\f$
+ * at all the nodes \f$b_i\f$ are then computed with a subproduct tree in
+ * \f$O(M(n) \log n)\f$ operations instead of \f$O(n^2)\f$. The values are
+ * computed at two different precisions, and the nodes where they do not agree
+ * up to the current accuracy are evaluated again with the Horner scheme.
+ *
+ * @param s The mps_context where the value will be set
+ * @param degree The multipoint evaluation is used for polynomials of at least
+ * this degree; 0 disables it.
+ */
+void
+mps_context_set_multipoint_regeneration (mps_context * s, long int degree)
+{
+  s->multipoint_regeneration_degree = degree;
+}
+
+/**
+ * @brief Exploit the symmetry of the roots of the polynomials with real
+ * coefficients in the floating point iterations.
+ *
+ * The starting points are placed in conjugate pairs, and the Aberth
+ * iterations of both algorithms are carried out only on one element of every
+ * pair, with the contribution of the other one to the Aberth sums computed
+ * by conjugation. This roughly halves the work of the floating point phase.
+ * Pairs that approach two real roots are split, and if the iterations stop
+ * making progress all the approximations are iterated as usual. The option
+ * has no effect on polynomials with complex coefficients.
+ *
+ * @param s The mps_context where the value will be set
+ * @param conjugate_symmetry The desired value for the conjugate_symmetry switch.
+ */
+void
+mps_context_set_conjugate_symmetry (mps_context * s, mps_boolean conjugate_symmetry)
+{
+  s->conjugate_symmetry = conjugate_symmetry;
+}
+
+/**
+ * @brief Bind the threads used by the context to the CPUs of the system.
+ *
+ * With <code>MPS_THREAD_AFFINITY_CORE</code> every thread runs on a single
+ * CPU, while with <code>MPS_THREAD_AFFINITY_NODE</code> it can run on any CPU
+ * of a NUMA node. In both cases the approximations of the roots are allocated
+ * by the threads of the pool, so that their memory is local to the threads
+ * that iterate on them. This has no effect on systems where the affinity of
+ * the threads cannot be set.
+ *
+ * @param s The mps_context where the value will be set
+ * @param affinity The placement of the threads.
+ */
+void
+mps_context_set_thread_affinity (mps_context * s, mps_thread_affinity affinity)
+{
+  s->thread_affinity = affinity;
+  mps_thread_pool_set_affinity (s, s->pool, affinity);
+}
+
+/**
+ * @brief Select the thread pool used by the context.
+ *
+ * Many contexts can share the same pool, so that a process solving a
+ * large number of polynomials at the same time uses a bounded number
+ * of threads. The jobs of the contexts are served in the order in which
+ * they are submitted, and every context only waits for its own jobs. The
+ * pool shared by the whole process can be obtained with
+ * mps_thread_pool_get_system_pool().
+ *
+ * The context holds a reference to the pool, and drops the one that it
+ * held on the previous pool, which is freed if it was not used by other
+ * contexts. This must not be called while the context is solving.
+ *
+ * @param s The mps_context where the pool will be set.
+ * @param pool The pool to use, or NULL to allocate a private pool for
+ * this context.
+ */
+void
+mps_context_set_thread_pool (mps_context * s, mps_thread_pool * pool)
+{
+  mps_thread_pool * old_pool = s->pool;
+
+  if (pool == old_pool)
+    return;
+
+  if (pool)
+    s->pool = mps_thread_pool_ref (pool);
+  else
+    s->pool = mps_thread_pool_new (s, 0);
+
+  if (s->thread_affinity != MPS_THREAD_AFFINITY_NONE && !mps_thread_pool_is_shared (s->pool))
+    mps_thread_pool_set_affinity (s, s->pool, s->thread_affinity);
+
+  mps_thread_pool_unref (s, old_pool);
+}
+
+/**
+ * @brief Let the context use the thread pool shared by the whole process,
+ * that has one thread for every core of the system.
+ *
+ * @param s The mps_context where the pool will be set.
+ */
+void
+mps_context_use_system_thread_pool (mps_context * s)
+{
+  mps_context_set_thread_pool (s, mps_thread_pool_get_system_pool (s));
+}
+
+/**
+ * @brief Get the thread pool used by the context, that can be passed to
+ * mps_context_set_thread_pool() to share it with other contexts.
+ */
+mps_thread_pool *
+mps_context_get_thread_pool (mps_context * s)
+{
+  return s->pool;
+}
+
+/**
+ * @brief Make sure that the context never runs more than one job at a time,
+ * as required by the polynomials that are not thread safe.
+ *
+ * Pools shared with other contexts cannot be resized, so in that case the
+ * context switches to a private pool with a single thread.
+ */
+void
+mps_context_set_sequential (mps_context * s)
+{
+  if (s->pool->n == 1)
+    return;
+
+  if (mps_thread_pool_is_shared (s->pool))
+    {
+      mps_thread_pool * pool = mps_thread_pool_new (s, 1);
+      mps_context_set_thread_pool (s, pool);
+      mps_thread_pool_unref (s, pool);
+    }
+  else
+    mps_thread_pool_set_concurrency_limit (s, s->pool, 1);
+}
+
 
 /**
  * @brief Set the debug level in MPSolve.
@@ -852,6 +1270,59 @@ mps_context_get_root_status (mps_context * ctx, int i)
   return ctx->root[i]->status;
 }
 
+/**
+ * @brief Check if the root in position i has been approximated to the
+ * output precision, i.e., if the radius of its inclusion disk is at most
+ * \f$2^{-prec}\f$ times its modulus.
+ *
+ * This is useful after a call to mps_mpsolve() that has been stopped by
+ * the time or precision budget, to select the roots that are accurate
+ * anyway.
+ */
+mps_boolean
+mps_context_get_root_accurate (mps_context * ctx, int i)
+{
+  rdpe_t rad, module;
+
+  switch (ctx->lastphase)
+    {
+    case float_phase:
+      rdpe_set_d (rad, ctx->root[i]->frad);
+      rdpe_set_d (module, cplx_mod (ctx->root[i]->fvalue));
+      break;
+
+    case dpe_phase:
+      rdpe_set (rad, ctx->root[i]->drad);
+      cdpe_mod (module, ctx->root[i]->dvalue);
+      break;
+
+    case mp_phase:
+      rdpe_set (rad, ctx->root[i]->drad);
+      mpc_rmod (module, ctx->root[i]->mvalue);
+      break;
+
+    default:
+      return false;
+    }
+
+  rdpe_mul_eq (module, ctx->eps_out);
+
+  return rdpe_le (rad, module);
+}
+
+/**
+ * @brief Return true if the last call to mps_mpsolve() has returned
+ * before reaching the output precision because the time or the precision
+ * budget was exhausted.
+ *
+ * @see mps_context_set_time_budget(), mps_context_set_precision_budget()
+ */
+mps_boolean
+mps_context_get_budget_exhausted (mps_context * s)
+{
+  return s->budget_exhausted;
+}
+
 /**
  * @brief Set the internal flag "avoid_multiprecision" to the specified value. 
  *
@@ -883,6 +1354,43 @@ mps_context_set_crude_approximation_mode (mps_context * s, mps_boolean crude_app
   s->crude_approximation_mode = crude_approximation_mode;
 }
 
+/**
+ * @brief Bound the wall clock time taken by the next calls to mps_mpsolve().
+ *
+ * The time is checked between two packets of iterations, so the calls may
+ * last a little longer than the budget. When it is over, mps_mpsolve()
+ * returns the current approximations, each one with a valid inclusion
+ * radius and status. mps_context_get_budget_exhausted() reports if this
+ * happened, and mps_context_get_root_accurate() tells which roots have
+ * been approximated to the output precision anyway.
+ *
+ * @param s The <code>mps_context</code> of the computation.
+ * @param seconds The time budget, or a non positive value to remove it.
+ */
+void
+mps_context_set_time_budget (mps_context * s, double seconds)
+{
+  s->time_budget = seconds;
+}
+
+/**
+ * @brief Bound the working precision used by the next calls to mps_mpsolve().
+ *
+ * When the approximations cannot be improved without going over
+ * <code>bits</code> bits of working precision, mps_mpsolve() returns them
+ * as they are, in the same way as when the time budget is exhausted.
+ *
+ * @param s The <code>mps_context</code> of the computation.
+ * @param bits The maximum working precision, or 0 to remove the limit.
+ *
+ * @see mps_context_set_time_budget()
+ */
+void
+mps_context_set_precision_budget (mps_context * s, long int bits)
+{
+  s->precision_budget = MAX (bits, 0);
+}
+
 /**
  * @brief Select the regeneration driver implementation to use. 
  *
@@ -41,6 +41,13 @@ mps_set_default_values (mps_context * s)
   s->max_it = 20;                /* number of max iterations per packet */
   s->max_newt_it = 15;           /* number of max newton iterations for */
   s->jacobi_iterations = false;
+  s->aberth_snapshot = false;
+  s->aberth_fmm_degree = MPS_ABERTH_FMM_DEFAULT_DEGREE;
+  s->aberth_fmm_accuracy = MPS_ABERTH_FMM_DEFAULT_ACCURACY;
+  s->multipoint_regeneration_degree = MPS_MULTIPOINT_REGENERATION_DEFAULT_DEGREE;
+  s->conjugate_symmetry = false;
+  s->conjugate_stalls = 0;
+  s->thread_affinity = MPS_THREAD_AFFINITY_NONE;
 
   /* Set number of threads to 1.5 * number_of_cores, if this is
    * computable. Set it to 12 otherwise.                     */
@@ -88,6 +95,7 @@ mps_set_default_values (mps_context * s)
   s->output_config->multiplicity = false;
   s->output_config->root_properties = MPS_OUTPUT_PROPERTY_NONE;
   s->output_config->search_set = MPS_SEARCH_SET_COMPLEX_PLANE;
+  s->output_config->search_region = NULL;
 
   s->data_prec_max.value = 53;
 
@@ -97,9 +105,13 @@ mps_set_default_values (mps_context * s)
   s->mpsolve_ptr = MPS_MPSOLVE_PTR (mps_standard_mpsolve);
   s->algorithm = MPS_ALGORITHM_STANDARD_MPSOLVE;
   s->starting_strategy = MPS_STARTING_STRATEGY_DEFAULT;
+  s->starting_points = NULL;
+  s->starting_radii = NULL;
+  s->n_starting_points = 0;
 
-  /* Allocate the thread_pool used in computations. */
-  s->pool = mps_thread_pool_new (s, 0);
+  /* The thread pool is attached by mps_context_init (). */
+  s->pool = NULL;
+  s->pool_pending = 0;
 
   /* Callbacks for async version */
   s->callback = NULL;
@@ -121,6 +133,10 @@ mps_set_default_values (mps_context * s)
   s->avoid_multiprecision = false;
   s->crude_approximation_mode = false;
 
+  s->time_budget = 0.0;
+  s->precision_budget = 0;
+  s->budget_exhausted = false;
+
   /* Get a standard regeneration driver to use for MPSolve. Note that this functions
    * does not actually allocate anything, but simply provides a pointer to the internal
    * MPSolve implementation of the standard regeneration_driver. This instance must
@@ -0,0 +1,256 @@
+/*
+ * This file is part of MPSolve 3.1.5
+ *
+ * Copyright (C) 2001-2015, Dipartimento di Matematica "L. Tonelli", Pisa.
+ * License: http://www.gnu.org/licenses/gpl.html GPL version 3 or higher
+ *
+ * Authors:
+ *   Leonardo Robol <leonardo.robol@sns.it>
+ */
+
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+#include <mps/mps.h>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__)) && \
+  (__GNUC__ >= 5 || defined(__clang__))
+#define MPS_FROOT_ARRAY_X86_KERNELS
+#include <immintrin.h>
+#endif
+
+/*
+ * All the kernels compute 1 / d, with d = z - z_i, as conj(d / m) / |d / m|^2 / m,
+ * where m = max(|Re(d)|, |Im(d)|). This avoids the overflows and underflows
+ * of |d|^2, like cplx_inv(), but with no branches.
+ */
+
+static void
+mps_froot_array_kernel_scalar (const double * re, const double * im,
+                               int begin, int end, double zr, double zi,
+                               double * sr, double * si)
+{
+  double dr, di, t, q;
+  int i;
+
+  for (i = begin; i < end; i++)
+    {
+      dr = zr - re[i];
+      di = zi - im[i];
+      t = 1.0 / MAX (fabs (dr), fabs (di));
+      dr *= t;
+      di *= t;
+      q = t / (dr * dr + di * di);
+      *sr += dr * q;
+      *si -= di * q;
+    }
+}
+
+#ifdef MPS_FROOT_ARRAY_X86_KERNELS
+
+__attribute__ ((target ("avx2")))
+static void
+mps_froot_array_kernel_avx2 (const double * re, const double * im,
+                             int begin, int end, double zr, double zi,
+                             double * sr, double * si)
+{
+  __m256d vzr = _mm256_set1_pd (zr), vzi = _mm256_set1_pd (zi);
+  __m256d one = _mm256_set1_pd (1.0), sign = _mm256_set1_pd (-0.0);
+  __m256d vsr = _mm256_setzero_pd (), vsi = _mm256_setzero_pd ();
+  __m256d dr, di, t, q;
+  double lanes[4];
+  int i = begin;
+
+  /* Reach an aligned position with the scalar code */
+  while (i < end && (i & 3))
+    {
+      mps_froot_array_kernel_scalar (re, im, i, i + 1, zr, zi, sr, si);
+      i++;
+    }
+
+  for (; i + 4 <= end; i += 4)
+    {
+      dr = _mm256_sub_pd (vzr, _mm256_load_pd (re + i));
+      di = _mm256_sub_pd (vzi, _mm256_load_pd (im + i));
+      t = _mm256_div_pd (one, _mm256_max_pd (_mm256_andnot_pd (sign, dr),
+                                             _mm256_andnot_pd (sign, di)));
+      dr = _mm256_mul_pd (dr, t);
+      di = _mm256_mul_pd (di, t);
+      q = _mm256_div_pd (t, _mm256_add_pd (_mm256_mul_pd (dr, dr),
+                                           _mm256_mul_pd (di, di)));
+      vsr = _mm256_add_pd (vsr, _mm256_mul_pd (dr, q));
+      vsi = _mm256_sub_pd (vsi, _mm256_mul_pd (di, q));
+    }
+
+  _mm256_storeu_pd (lanes, vsr);
+  *sr += (lanes[0] + lanes[1]) + (lanes[2] + lanes[3]);
+  _mm256_storeu_pd (lanes, vsi);
+  *si += (lanes[0] + lanes[1]) + (lanes[2] + lanes[3]);
+
+  mps_froot_array_kernel_scalar (re, im, i, end, zr, zi, sr, si);
+}
+
+__attribute__ ((target ("avx512f")))
+static void
+mps_froot_array_kernel_avx512 (const double * re, const double * im,
+                               int begin, int end, double zr, double zi,
+                               double * sr, double * si)
+{
+  __m512d vzr = _mm512_set1_pd (zr), vzi = _mm512_set1_pd (zi);
+  __m512d one = _mm512_set1_pd (1.0);
+  __m512d vsr = _mm512_setzero_pd (), vsi = _mm512_setzero_pd ();
+  __m512d dr, di, t, q;
+  double lanes[8];
+  int i = begin;
+
+  while (i < end && (i & 7))
+    {
+      mps_froot_array_kernel_scalar (re, im, i, i + 1, zr, zi, sr, si);
+      i++;
+    }
+
+  for (; i + 8 <= end; i += 8)
+    {
+      dr = _mm512_sub_pd (vzr, _mm512_load_pd (re + i));
+      di = _mm512_sub_pd (vzi, _mm512_load_pd (im + i));
+      t = _mm512_div_pd (one, _mm512_max_pd (_mm512_abs_pd (dr), _mm512_abs_pd (di)));
+      dr = _mm512_mul_pd (dr, t);
+      di = _mm512_mul_pd (di, t);
+      q = _mm512_div_pd (t, _mm512_add_pd (_mm512_mul_pd (dr, dr),
+                                           _mm512_mul_pd (di, di)));
+      vsr = _mm512_add_pd (vsr, _mm512_mul_pd (dr, q));
+      vsi = _mm512_sub_pd (vsi, _mm512_mul_pd (di, q));
+    }
+
+  _mm512_storeu_pd (lanes, vsr);
+  *sr += ((lanes[0] + lanes[1]) + (lanes[2] + lanes[3])) +
+         ((lanes[4] + lanes[5]) + (lanes[6] + lanes[7]));
+  _mm512_storeu_pd (lanes, vsi);
+  *si += ((lanes[0] + lanes[1]) + (lanes[2] + lanes[3])) +
+         ((lanes[4] + lanes[5]) + (lanes[6] + lanes[7]));
+
+  mps_froot_array_kernel_scalar (re, im, i, end, zr, zi, sr, si);
+}
+
+#endif
+
+static double *
+mps_froot_array_alloc (int n)
+{
+  void * ptr = NULL;
+
+  if (posix_memalign (&ptr, MPS_FROOT_ARRAY_ALIGNMENT, sizeof(double) * MAX (n, 1)))
+    return NULL;
+
+  return (double*) ptr;
+}
+
+/**
+ * @brief Allocate the arrays for n approximations, and select the fastest
+ * kernel supported by the CPU.
+ *
+ * The environment variable <code>MPS_SIMD</code> can be set to
+ * <code>scalar</code>, <code>avx2</code> or <code>avx512</code> to restrict
+ * the choice of the kernel, for example for benchmarks.
+ */
+mps_froot_array *
+mps_froot_array_new (mps_context * s, int n)
+{
+  mps_froot_array * roots = mps_new (mps_froot_array);
+#ifdef MPS_FROOT_ARRAY_X86_KERNELS
+  const char * simd = getenv ("MPS_SIMD");
+#endif
+
+  roots->n = n;
+  roots->re = mps_froot_array_alloc (n);
+  roots->im = mps_froot_array_alloc (n);
+
+  if (!roots->re || !roots->im)
+    {
+      mps_error (s, "Cannot allocate memory for the approximations");
+      mps_froot_array_free (roots);
+      return NULL;
+    }
+
+  roots->kernel = mps_froot_array_kernel_scalar;
+  roots->kernel_name = "scalar";
+
+#ifdef MPS_FROOT_ARRAY_X86_KERNELS
+  __builtin_cpu_init ();
+
+  if (simd && strcmp (simd, "scalar") == 0)
+    return roots;
+
+  if ((!simd || strcmp (simd, "avx512") == 0) && __builtin_cpu_supports ("avx512f"))
+    {
+      roots->kernel = mps_froot_array_kernel_avx512;
+      roots->kernel_name = "avx512";
+    }
+  else if (__builtin_cpu_supports ("avx2"))
+    {
+      roots->kernel = mps_froot_array_kernel_avx2;
+      roots->kernel_name = "avx2";
+    }
+#endif
+
+  return roots;
+}
+
+/**
+ * @brief Free a <code>mps_froot_array</code>.
+ */
+void
+mps_froot_array_free (mps_froot_array * roots)
+{
+  if (!roots)
+    return;
+
+  free (roots->re);
+  free (roots->im);
+  free (roots);
+}
+
+/**
+ * @brief Copy the floating point approximations of the context into
+ * the arrays.
+ */
+void
+mps_froot_array_load (mps_context * s, mps_froot_array * roots)
+{
+  int i;
+
+  for (i = 0; i < roots->n; i++)
+    {
+      roots->re[i] = cplx_Re (s->root[i]->fvalue);
+      roots->im[i] = cplx_Im (s->root[i]->fvalue);
+    }
+}
+
+/**
+ * @brief Set the i-th approximation to value.
+ */
+void
+mps_froot_array_set (mps_froot_array * roots, int i, cplx_t value)
+{
+  roots->re[i] = cplx_Re (value);
+  roots->im[i] = cplx_Im (value);
+}
+
+/**
+ * @brief Compute the Aberth correction \f$\sum_{i \neq j} 1 / (z_j - z_i)\f$
+ * for the j-th approximation.
+ *
+ * The arrays are only read, so this can be called concurrently on
+ * different roots.
+ */
+void
+mps_froot_array_aberth (mps_froot_array * roots, int j, cplx_t abcorr)
+{
+  double sr = 0, si = 0;
+  double zr = roots->re[j], zi = roots->im[j];
+
+  roots->kernel (roots->re, roots->im, 0, j, zr, zi, &sr, &si);
+  roots->kernel (roots->re, roots->im, j + 1, roots->n, zr, zi, &sr, &si);
+
+  cplx_set_d (abcorr, sr, si);
+}
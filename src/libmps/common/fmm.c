@@ -0,0 +1,410 @@
+/*
+ * This file is part of MPSolve 3.1.5
+ *
+ * Copyright (C) 2001-2015, Dipartimento di Matematica "L. Tonelli", Pisa.
+ * License: http://www.gnu.org/licenses/gpl.html GPL version 3 or higher
+ *
+ * Authors:
+ *   Leonardo Robol <leonardo.robol@sns.it>
+ */
+
+#include <math.h>
+#include <string.h>
+#include <mps/mps.h>
+
+/**
+ * @brief Largest difference between the exponents of the components of
+ * the DPE approximations for which they are scaled into a common range of
+ * doubles.
+ */
+#define MPS_FMM_DPE_RANGE 400
+
+static int
+mps_fmm_tree_order (double accuracy)
+{
+  int order;
+
+  if (accuracy <= 0)
+    return MPS_FMM_MAX_ORDER;
+
+  /* A node with radius r seen from a distance d >= r / theta contributes
+   * with an error at most theta^p / (1 - theta) / d for every point, while
+   * the modulus of each term is at least 1 / (d * (1 + theta)). */
+  order = (int) ceil (log (accuracy * (1 - MPS_FMM_THETA) / (1 + MPS_FMM_THETA)) /
+                      log (MPS_FMM_THETA));
+
+  return MAX (1, MIN (order, MPS_FMM_MAX_ORDER));
+}
+
+static mps_fmm_tree *
+mps_fmm_tree_new (mps_context * s)
+{
+  mps_fmm_tree * tree = mps_new (mps_fmm_tree);
+  mps_cluster_item * item;
+  mps_root * root;
+  int i;
+
+  tree->n = s->n;
+  tree->order = mps_fmm_tree_order (s->aberth_fmm_accuracy);
+  tree->exponent = 0;
+  tree->points = cplx_valloc (s->n);
+  tree->perm = mps_newv (int, s->n);
+  tree->exact = mps_newv (mps_boolean, s->n);
+  tree->n_nodes = 0;
+  tree->nodes_size = 4 * (s->n / MPS_FMM_LEAF_SIZE + 1);
+  tree->nodes = mps_newv (mps_fmm_node, tree->nodes_size);
+  tree->moments = NULL;
+
+  for (i = 0; i < s->n; i++)
+    {
+      tree->perm[i] = i;
+      tree->exact[i] = false;
+    }
+
+  /* Roots that are known to belong to a cluster are close to some of the
+   * others, so their sums are dominated by a few terms and are computed
+   * directly. The clusterization made of a single cluster with all the roots
+   * only means that no analysis has been carried out yet. */
+  if (s->clusterization)
+    for (item = s->clusterization->first; item != NULL; item = item->next)
+      if (item->cluster->n > 1 && item->cluster->n < s->n)
+        for (root = item->cluster->first; root != NULL; root = root->next)
+          tree->exact[root->k] = true;
+
+  return tree;
+}
+
+/**
+ * @brief Free a tree allocated with mps_fmm_ftree_new() or mps_fmm_dtree_new().
+ */
+void
+mps_fmm_tree_free (mps_fmm_tree * tree)
+{
+  if (!tree)
+    return;
+
+  cplx_vfree (tree->points);
+  cplx_vfree (tree->moments);
+  free (tree->perm);
+  free (tree->exact);
+  free (tree->nodes);
+  free (tree);
+}
+
+static int
+mps_fmm_tree_build_node (mps_fmm_tree * tree, int * buffer, int begin, int end,
+                         double cx, double cy, double half, int depth)
+{
+  int k, q, index, count[4], offset[4];
+  mps_fmm_node * node;
+  double radius = 0;
+  cplx_t d;
+
+  if (tree->n_nodes == tree->nodes_size)
+    {
+      tree->nodes_size *= 2;
+      tree->nodes = mps_realloc (tree->nodes, sizeof(mps_fmm_node) * tree->nodes_size);
+    }
+
+  index = tree->n_nodes++;
+  node = tree->nodes + index;
+
+  cplx_set_d (node->center, cx, cy);
+  node->begin = begin;
+  node->end = end;
+  for (q = 0; q < 4; q++)
+    node->child[q] = -1;
+
+  for (k = begin; k < end; k++)
+    {
+      cplx_sub (d, tree->points[tree->perm[k]], node->center);
+      radius = MAX (radius, cplx_mod (d));
+    }
+  node->radius = radius;
+
+  if (end - begin <= MPS_FMM_LEAF_SIZE || depth >= MPS_FMM_MAX_DEPTH || radius == 0)
+    return index;
+
+  /* Sort the points of the node by quadrant */
+  for (q = 0; q < 4; q++)
+    count[q] = 0;
+
+  for (k = begin; k < end; k++)
+    {
+      cplx_t * p = tree->points + tree->perm[k];
+      count[(cplx_Re (*p) >= cx) + 2 * (cplx_Im (*p) >= cy)]++;
+    }
+
+  offset[0] = begin;
+  for (q = 1; q < 4; q++)
+    offset[q] = offset[q - 1] + count[q - 1];
+
+  for (k = begin; k < end; k++)
+    {
+      cplx_t * p = tree->points + tree->perm[k];
+      buffer[offset[(cplx_Re (*p) >= cx) + 2 * (cplx_Im (*p) >= cy)]++] = tree->perm[k];
+    }
+
+  memcpy (tree->perm + begin, buffer + begin, sizeof(int) * (end - begin));
+
+  /* The nodes may be reallocated while building the children, so
+   * node cannot be used from now on. */
+  for (q = 0, k = begin; q < 4; k += count[q], q++)
+    if (count[q] > 0)
+      {
+        int child = mps_fmm_tree_build_node (tree, buffer, k, k + count[q],
+                                             cx + ((q & 1) ? 0.5 : -0.5) * half,
+                                             cy + ((q & 2) ? 0.5 : -0.5) * half,
+                                             0.5 * half, depth + 1);
+        tree->nodes[index].child[q] = child;
+      }
+
+  return index;
+}
+
+static void
+mps_fmm_tree_build (mps_fmm_tree * tree)
+{
+  double xmin = INFINITY, xmax = -INFINITY, ymin = INFINITY, ymax = -INFINITY;
+  int i, k, l, * buffer = mps_newv (int, tree->n);
+
+  for (i = 0; i < tree->n; i++)
+    {
+      xmin = MIN (xmin, cplx_Re (tree->points[i]));
+      xmax = MAX (xmax, cplx_Re (tree->points[i]));
+      ymin = MIN (ymin, cplx_Im (tree->points[i]));
+      ymax = MAX (ymax, cplx_Im (tree->points[i]));
+    }
+
+  mps_fmm_tree_build_node (tree, buffer, 0, tree->n,
+                           0.5 * (xmin + xmax), 0.5 * (ymin + ymax),
+                           0.5 * MAX (xmax - xmin, ymax - ymin), 0);
+
+  free (buffer);
+
+  /* Compute the normalized moments of every node */
+  tree->moments = cplx_valloc (tree->n_nodes * tree->order);
+
+  for (i = 0; i < tree->n_nodes; i++)
+    {
+      mps_fmm_node * node = tree->nodes + i;
+      cplx_t * moments = tree->moments + i * tree->order;
+      cplx_t w, power;
+
+      for (l = 0; l < tree->order; l++)
+        cplx_set (moments[l], cplx_zero);
+
+      cplx_set_d (moments[0], node->end - node->begin, 0);
+
+      if (node->radius == 0)
+        continue;
+
+      for (k = node->begin; k < node->end; k++)
+        {
+          cplx_sub (w, tree->points[tree->perm[k]], node->center);
+          cplx_div_eq_d (w, node->radius);
+          cplx_set (power, w);
+
+          for (l = 1; l < tree->order; l++)
+            {
+              cplx_add_eq (moments[l], power);
+              cplx_mul_eq (power, w);
+            }
+        }
+    }
+}
+
+/**
+ * @brief Build the tree that evaluates the floating point Aberth sums of
+ * the current approximations.
+ *
+ * @return The tree, or NULL if the degree is below the threshold set with
+ * mps_context_set_aberth_fmm() or if some of the approximations are not
+ * finite. In that case the sums need to be computed directly.
+ */
+mps_fmm_tree *
+mps_fmm_ftree_new (mps_context * s)
+{
+  mps_fmm_tree * tree;
+  int i;
+
+  if (s->aberth_fmm_degree <= 0 || s->n < s->aberth_fmm_degree)
+    return NULL;
+
+  for (i = 0; i < s->n; i++)
+    if (!isfinite (cplx_Re (s->root[i]->fvalue)) || !isfinite (cplx_Im (s->root[i]->fvalue)))
+      return NULL;
+
+  tree = mps_fmm_tree_new (s);
+
+  for (i = 0; i < s->n; i++)
+    cplx_set (tree->points[i], s->root[i]->fvalue);
+
+  mps_fmm_tree_build (tree);
+
+  return tree;
+}
+
+/**
+ * @brief Build the tree that evaluates the DPE Aberth sums of the current
+ * approximations.
+ *
+ * The approximations are scaled by a common power of two and stored as
+ * doubles, which is possible only if the exponents of their components are
+ * not too far apart.
+ *
+ * @return The tree, or NULL if the degree is below the threshold set with
+ * mps_context_set_aberth_fmm() or if the approximations cannot be scaled
+ * into the range of doubles. In that case the sums need to be computed
+ * directly.
+ */
+mps_fmm_tree *
+mps_fmm_dtree_new (mps_context * s)
+{
+  mps_fmm_tree * tree;
+  long int exponent = LONG_MIN;
+  int i;
+
+  if (s->aberth_fmm_degree <= 0 || s->n < s->aberth_fmm_degree)
+    return NULL;
+
+  for (i = 0; i < s->n; i++)
+    {
+      if (rdpe_Mnt (cdpe_Re (s->root[i]->dvalue)) != 0)
+        exponent = MAX (exponent, rdpe_Esp (cdpe_Re (s->root[i]->dvalue)));
+      if (rdpe_Mnt (cdpe_Im (s->root[i]->dvalue)) != 0)
+        exponent = MAX (exponent, rdpe_Esp (cdpe_Im (s->root[i]->dvalue)));
+    }
+
+  if (exponent == LONG_MIN)
+    return NULL;
+
+  for (i = 0; i < s->n; i++)
+    {
+      if (rdpe_Mnt (cdpe_Re (s->root[i]->dvalue)) != 0 &&
+          rdpe_Esp (cdpe_Re (s->root[i]->dvalue)) < exponent - MPS_FMM_DPE_RANGE)
+        return NULL;
+      if (rdpe_Mnt (cdpe_Im (s->root[i]->dvalue)) != 0 &&
+          rdpe_Esp (cdpe_Im (s->root[i]->dvalue)) < exponent - MPS_FMM_DPE_RANGE)
+        return NULL;
+    }
+
+  tree = mps_fmm_tree_new (s);
+  tree->exponent = exponent;
+
+  for (i = 0; i < s->n; i++)
+    cplx_set_d (tree->points[i],
+                ldexp (rdpe_Mnt (cdpe_Re (s->root[i]->dvalue)),
+                       rdpe_Esp (cdpe_Re (s->root[i]->dvalue)) - exponent),
+                ldexp (rdpe_Mnt (cdpe_Im (s->root[i]->dvalue)),
+                       rdpe_Esp (cdpe_Im (s->root[i]->dvalue)) - exponent));
+
+  mps_fmm_tree_build (tree);
+
+  return tree;
+}
+
+/**
+ * @brief Compute \f$\sum_{i \neq j} 1 / (z_j - z_i)\f$ on the points of
+ * the tree.
+ */
+static void
+mps_fmm_tree_sum (mps_fmm_tree * tree, int j, cplx_t sum)
+{
+  int stack[3 * MPS_FMM_MAX_DEPTH + 4];
+  int top = 0, k, l, q;
+  cplx_t d, w, u, acc;
+  cplx_t * z = tree->points + j;
+
+  cplx_set (sum, cplx_zero);
+  stack[top++] = 0;
+
+  while (top > 0)
+    {
+      mps_fmm_node * node = tree->nodes + stack[--top];
+
+      cplx_sub (d, *z, node->center);
+
+      if (node->radius < MPS_FMM_THETA * cplx_mod (d))
+        {
+          cplx_t * moments = tree->moments + (node - tree->nodes) * tree->order;
+
+          /* Far field: evaluate the expansion with Horner's rule */
+          cplx_inv (w, d);
+          cplx_mul_d (u, w, node->radius);
+
+          cplx_set (acc, moments[tree->order - 1]);
+          for (l = tree->order - 2; l >= 0; l--)
+            {
+              cplx_mul_eq (acc, u);
+              cplx_add_eq (acc, moments[l]);
+            }
+
+          cplx_mul_eq (acc, w);
+          cplx_add_eq (sum, acc);
+        }
+      else if (node->child[0] < 0 && node->child[1] < 0 &&
+               node->child[2] < 0 && node->child[3] < 0)
+        {
+          /* Near field: sum directly over the points of the leaf */
+          for (k = node->begin; k < node->end; k++)
+            {
+              if (tree->perm[k] == j)
+                continue;
+
+              cplx_sub (d, *z, tree->points[tree->perm[k]]);
+              cplx_inv_eq (d);
+              cplx_add_eq (sum, d);
+            }
+        }
+      else
+        {
+          for (q = 0; q < 4; q++)
+            if (node->child[q] >= 0)
+              stack[top++] = node->child[q];
+        }
+    }
+}
+
+/**
+ * @brief Compute the Aberth correction for the j-th root in the floating
+ * point phase using the tree built by mps_fmm_ftree_new().
+ *
+ * The tree is only read, so this can be called concurrently on different
+ * roots. If tree is NULL, or if the root belongs to a cluster, the sum is
+ * computed directly by mps_faberth().
+ */
+void
+mps_fmm_faberth (mps_context * s, mps_fmm_tree * tree, int j, cplx_t abcorr)
+{
+  if (!tree || tree->exact[j])
+    mps_faberth (s, s->root[j], abcorr);
+  else
+    mps_fmm_tree_sum (tree, j, abcorr);
+}
+
+/**
+ * @brief DPE version of mps_fmm_faberth(), for trees built by
+ * mps_fmm_dtree_new().
+ */
+void
+mps_fmm_daberth (mps_context * s, mps_fmm_tree * tree, int j, cdpe_t abcorr)
+{
+  cplx_t sum;
+  cdpe_t csum;
+  rdpe_t scale;
+
+  if (!tree || tree->exact[j])
+    {
+      mps_daberth (s, s->root[j], abcorr);
+      return;
+    }
+
+  mps_fmm_tree_sum (tree, j, sum);
+
+  /* The points have been scaled by 2^(-exponent), so the sum has been
+   * multiplied by 2^exponent. */
+  cdpe_set_x (csum, sum);
+  rdpe_set_2dl (scale, 1.0, -tree->exponent);
+  cdpe_mul_e (abcorr, csum, scale);
+}
@@ -30,7 +30,8 @@ get_approximated_bits (mps_approximation * appr)
 }
 
 static rdpe_t *
-evaluate_root_conditioning (mps_context * ctx, mps_polynomial * p, mps_approximation ** appr, int n)
+evaluate_root_conditioning (mps_context * ctx, mps_polynomial * p, mps_approximation ** appr, int n,
+                            mps_conjugate_pairs * pairs)
 {
   int i;
 
@@ -40,6 +41,11 @@ evaluate_root_conditioning (mps_context * ctx, mps_polynomial * p, mps_approxima
     {
       mpc_t value;
       rdpe_t error, module;
+
+      /* Conjugate roots have the same conditioning */
+      if (mps_conjugate_skip (pairs, i, NULL))
+        continue;
+
       mpc_init2 (value, appr[i]->wp);
 
       mps_polynomial_meval (ctx, p, appr[i]->mvalue, value, error);
@@ -60,6 +66,10 @@ evaluate_root_conditioning (mps_context * ctx, mps_polynomial * p, mps_approxima
       mpc_clear (value);
     }
 
+  for (i = 0; i < n; i++)
+    if (mps_conjugate_skip (pairs, i, NULL))
+      rdpe_set (root_conditioning[i], root_conditioning[-1 - pairs->conjugate[i]]);
+
   return root_conditioning;
 }
 
@@ -93,21 +103,33 @@ improve_root (mps_context * ctx, mps_polynomial * p, mps_approximation * root, l
 
 /*! @cond PRIVATE */
 typedef struct {
-  mps_context * ctx;
   mps_polynomial * p;
-  mps_approximation * root;
+  rdpe_t * root_conditioning;
   long int precision;
+  mps_conjugate_pairs * pairs;
 } __improve_root_data;
 /*! @endcond */
 
-static void *
-improve_root_wrapper (void * data_ptr)
+static void
+improve_root_wrapper (mps_context * ctx, int begin, int end, void * data_ptr)
 {
   __improve_root_data *data = (__improve_root_data*)data_ptr;
+  int i;
 
-  improve_root (data->ctx, data->p, data->root, data->precision);
-  free (data);
-  return NULL;
+  for (i = begin; i < end; i++)
+    if (ctx->root[i]->status == MPS_ROOT_STATUS_ISOLATED &&
+        ctx->root[i]->inclusion != MPS_ROOT_INCLUSION_OUT &&
+        !mps_conjugate_skip (data->pairs, i, NULL))
+      {
+        /* Evaluate the necessary precision to iterate on this root.
+         * If the the current polynomial precision is enough, iterate on it.
+         * Otherwise, let it for the next round. */
+        long int necessary_precision = get_approximated_bits (ctx->root[i]) + log2 (ctx->n) +
+                                       rdpe_log (data->root_conditioning[i]) / LOG2;
+
+        if (necessary_precision < data->precision)
+          improve_root (ctx, data->p, ctx->root[i], data->precision);
+      }
 }
 
 
@@ -157,6 +179,8 @@ mps_improve (mps_context * ctx)
   int approximated_roots = 0;
   mps_polynomial * p = ctx->active_poly;
   rdpe_t * root_conditioning = NULL;
+  mps_conjugate_pairs * pairs;
+  __improve_root_data data;
 
   ctx->operation = MPS_OPERATION_REFINEMENT;
 
@@ -169,8 +193,16 @@ mps_improve (mps_context * ctx)
   /* Set lastphase to mp */
   ctx->lastphase = mp_phase;
 
+  /* If the roots are exactly symmetric with respect to the real axis, only
+   * one root of every conjugate pair is refined. */
+  pairs = mps_conjugate_mpairs (ctx);
+
   /* Determine the conditioning of the roots */
-  root_conditioning = evaluate_root_conditioning (ctx, p, ctx->root, ctx->n);
+  root_conditioning = evaluate_root_conditioning (ctx, p, ctx->root, ctx->n, pairs);
+
+  data.p = p;
+  data.root_conditioning = root_conditioning;
+  data.pairs = pairs;
 
   /* We adopt the strategy of various iterations refinements on
    * the approximations by setting the precision of the input
@@ -193,33 +225,26 @@ mps_improve (mps_context * ctx)
    * continue until we get all of them. */
   while (approximated_roots < ctx->n)
     {
+      /* Keep the current approximations if the time budget is over */
+      if (mps_budget_time_over (ctx))
+        goto cleanup;
+
       mps_polynomial_raise_data (ctx, p, current_precision);
 
       MPS_DEBUG (ctx, "Step of improvement");
 
-      for (i = 0; i < ctx->n; i++)
-        if (ctx->root[i]->status == MPS_ROOT_STATUS_ISOLATED && 
-	    ctx->root[i]->inclusion != MPS_ROOT_INCLUSION_OUT)
+      data.precision = current_precision;
+      mps_thread_pool_parallel_for (ctx, NULL, 0, ctx->n, 1, improve_root_wrapper, &data);
+
+      for (i = 0; pairs && i < ctx->n; i++)
+        if (mps_conjugate_skip (pairs, i, NULL))
           {
-            /* Evaluate the necessary precision to iterate on this root.
-             * If the the current polynomial precision is enough, iterate on it.
-             * Otherwise, let it for the next round. */
-            long int necessary_precision = get_approximated_bits (ctx->root[i]) + log2 (ctx->n) +
-                                           rdpe_log (root_conditioning[i]) / LOG2;
-
-            if (necessary_precision < current_precision)
-              {
-                __improve_root_data * data = mps_new (__improve_root_data);
-                data->ctx = ctx;
-                data->p = p;
-                data->root = ctx->root[i];
-                data->precision = current_precision;
-
-                mps_thread_pool_assign (ctx, NULL, improve_root_wrapper, data);
-              }
-          }
+            mps_approximation * root = ctx->root[-1 - pairs->conjugate[i]];
 
-      mps_thread_pool_wait (ctx, ctx->pool);
+            mpc_set_prec (ctx->root[i]->mvalue, mpc_get_prec (root->mvalue));
+            mpc_con (ctx->root[i]->mvalue, root->mvalue);
+            rdpe_set (ctx->root[i]->drad, root->drad);
+          }
 
       for (i = 0; i < ctx->n; i++)
         if (!MPS_ROOT_STATUS_IS_APPROXIMATED (ctx->root[i]->status) &&
@@ -232,7 +257,11 @@ mps_improve (mps_context * ctx)
               MPS_DEBUG (ctx, "Approximated roots = %d", approximated_roots);
           }
 
-      /* Increase precision to reach the desired number of approximated roots */
+      /* Increase precision to reach the desired number of approximated roots,
+       * if the precision budget allows it. */
+      if (!mps_budget_allows_precision (ctx, 2 * current_precision))
+        goto cleanup;
+
       current_precision = 2 * current_precision;
 
       /* Check if we have gone too far with the precision, and we have gone over
@@ -253,5 +282,8 @@ mps_improve (mps_context * ctx)
 
 cleanup:
 
+  if (pairs)
+    mps_conjugate_packet_done (ctx, pairs, ctx->n);
+
   free (root_conditioning);
 }
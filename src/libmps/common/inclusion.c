@@ -128,6 +128,7 @@ mps_fupdate_inclusions (mps_context * s)
                 break;
 
               case MPS_SEARCH_SET_CUSTOM:
+                s->root[i]->inclusion = mps_search_region_finclusion (s, i, nf);
                 break;
               }
         }
@@ -286,6 +287,7 @@ mps_dupdate_inclusions (mps_context * s)
                 break;
 
               case MPS_SEARCH_SET_CUSTOM:
+                s->root[i]->inclusion = mps_search_region_dinclusion (s, i, nf);
                 break;
               }
         }
@@ -448,6 +450,7 @@ mps_mupdate_inclusions (mps_context * s)
                 break;
 
               case MPS_SEARCH_SET_CUSTOM:
+                s->root[i]->inclusion = mps_search_region_minclusion (s, i, nf);
                 break;
               }
         }
@@ -40,11 +40,16 @@ void *realloc (void * ptr, size_t n);
 static void
 mps_preliminary_setup (mps_context * ctx)
 {
+  ctx->newton_corrections = 0;
+  ctx->conjugate_stalls = 0;
+
+  mps_budget_start (ctx);
+
   /* Make sure that non thread safe polynomial implementations are handled
    * in a safe way. */
   if (!ctx->active_poly->thread_safe)
     {
-      mps_thread_pool_set_concurrency_limit (ctx, NULL, 1);
+      mps_context_set_sequential (ctx);
     }
 }
 
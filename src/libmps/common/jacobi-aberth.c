@@ -12,55 +12,90 @@
 
 /*! @cond PRIVATE */
 struct __mps_fjacobi_aberth_step_data {
-  mps_context * ctx;
   mps_polynomial * p;
-  mps_approximation * root;
-  cplx_t * correction;
+  cplx_t * corrections;
+  cplx_t * newton_corrections;
+  mps_froot_array * froots;
+  mps_fmm_tree * tree;
+  mps_conjugate_pairs * pairs;
 };
 /*! @endcond */
 
-static void *
-__mps_fjacobi_aberth_step_worker (void * data_ptr)
+/**
+ * @brief Number of roots that a thread picks at once from the
+ * shared cursor in the Jacobi-style steps.
+ */
+static int
+mps_jacobi_aberth_grain (mps_context * ctx)
 {
-  struct __mps_fjacobi_aberth_step_data *data = (struct __mps_fjacobi_aberth_step_data*)data_ptr;
-
-  cplx_t abcorr, corr;
+  return MAX (1, ctx->n / (4 * ctx->pool->n));
+}
 
-  mps_context * ctx = data->ctx;
-  mps_approximation * root = data->root;
+static void
+__mps_fjacobi_aberth_step_worker (mps_context * ctx, int begin, int end, void * data_ptr)
+{
+  struct __mps_fjacobi_aberth_step_data *data = (struct __mps_fjacobi_aberth_step_data*)data_ptr;
   mps_polynomial * p = data->p;
+  mps_approximation * block[MPS_HORNER_BLOCK_SIZE];
+  cplx_t corrs[MPS_HORNER_BLOCK_SIZE];
+  int index[MPS_HORNER_BLOCK_SIZE];
+  cplx_t abcorr;
+  int i = begin, k, l;
 
-  mps_polynomial_fnewton (ctx, p, root, corr);
-
-  if (root->approximated)
-    root->again = false;
-
-  if (root->again)
+  while (i < end)
     {
-      mps_faberth (ctx, root, abcorr);
-      cplx_mul_eq (abcorr, corr);
-      cplx_sub (abcorr, cplx_one, abcorr);
-
-      if (cplx_check_fpe (abcorr))
+      /* Collect a block of roots that need to be iterated, so that the
+       * polynomial can evaluate the Newton corrections together. The
+       * conjugates are updated together with the approximations they are
+       * paired with. */
+      for (k = 0; i < end && k < MPS_HORNER_BLOCK_SIZE; i++)
+        if (ctx->root[i]->again && !mps_conjugate_skip (data->pairs, i, NULL))
+          {
+            index[k] = i;
+            block[k++] = ctx->root[i];
+          }
+
+      if (k == 0)
+        continue;
+
+      mps_polynomial_fnewton_block (ctx, p, block, k, corrs);
+
+      for (l = 0; l < k; l++)
         {
-          root->again = false;
-          root->status = MPS_ROOT_STATUS_NOT_FLOAT;
+          mps_approximation * root = block[l];
+          cplx_t * corr = corrs + l;
+
+          if (root->approximated)
+            root->again = false;
+
+          cplx_set (data->newton_corrections[index[l]], *corr);
+
+          if (root->again)
+            {
+              /* The conjugates are stored explicitly, so these sums already
+               * contain their contributions. */
+              if (data->tree)
+                mps_fmm_faberth (ctx, data->tree, index[l], abcorr);
+              else
+                mps_froot_array_aberth (data->froots, index[l], abcorr);
+              cplx_mul_eq (abcorr, *corr);
+              cplx_sub (abcorr, cplx_one, abcorr);
+
+              if (cplx_check_fpe (abcorr))
+                {
+                  root->again = false;
+                  root->status = MPS_ROOT_STATUS_NOT_FLOAT;
+                }
+
+              if (cplx_eq_zero (abcorr))
+                root->again = false;
+              else
+                cplx_div (*corr, *corr, abcorr);
+
+              cplx_set (data->corrections[index[l]], *corr);
+            }
         }
-
-      if (cplx_eq_zero (abcorr))
-        root->again = false;
-      else
-        cplx_div (corr, corr, abcorr);
-
-      cplx_set (*data->correction, corr);
     }
-
-  /* In case of a unique element in the thread pool
-   * the function call system has been optimized out. */
-  if (ctx->pool->n > 1)
-    free (data);
-
-  return NULL;
 }
 
 /**
@@ -68,65 +103,79 @@ __mps_fjacobi_aberth_step_worker (void * data_ptr)
  *
  * @param ctx The context in which this instance of MPSolve is running.
  * @param p The polynomial on which Aberth method should be applied.
- * @param approximations The starting approximations for the method. They will be
- *        updated with the new values when the function returns.
+ * @param froots Copy of the approximations used for the Aberth sums. It is
+ *        updated together with the approximations.
+ * @param pairs The pairing of the approximations computed by
+ *        mps_conjugate_fpairs(), or NULL if all of them should be iterated.
  * @param nit Number of iterations performed in the packet.
  */
 static mps_boolean
-mps_fjacobi_aberth_step (mps_context * ctx, mps_polynomial * p, int * nit)
+mps_fjacobi_aberth_step (mps_context * ctx, mps_polynomial * p, mps_froot_array * froots,
+                         mps_conjugate_pairs * pairs, int * nit)
 {
   mps_boolean again = false;
-  int i = 0;
+  int i = 0, mirror;
+  cplx_t old_value;
 
   cplx_t * corrections = mps_newv (cplx_t, ctx->n);
+  cplx_t * newton_corrections = mps_newv (cplx_t, ctx->n);
+  struct __mps_fjacobi_aberth_step_data data = {
+    p, corrections, newton_corrections, froots, NULL, pairs
+  };
 
+  /* The approximations that are not iterated keep their position. This
+   * includes the conjugates that are split from their pair during the step. */
   for (i = 0; i < ctx->n; i++)
     {
-      if (ctx->root[i]->again)
-        {
-	  /* In case of a unique element in the thread pool
-	   * the function call system has been optimized out. */
-	  if (ctx->pool->n > 1)
-	    {
-	      struct __mps_fjacobi_aberth_step_data * data = mps_new (struct __mps_fjacobi_aberth_step_data);
-
-	      data->ctx = ctx;
-	      data->p = p;
-	      data->root = ctx->root[i];
-	      data->correction = &corrections[i];
-
-	      /* The worker is in charge of freeing the data that we have allocated
-	       * here, so we can't ignore this issue in the main thread. */
-	      mps_thread_pool_assign (ctx, ctx->pool,
-				      __mps_fjacobi_aberth_step_worker, data);
-	    }
-	  else
-	    {
-	      struct __mps_fjacobi_aberth_step_data data = {
-		ctx, p, ctx->root[i], &corrections[i]
-	      };
-
-	      __mps_fjacobi_aberth_step_worker (&data);
-	    }
-
-	  if (nit)
-	    (*nit)++;
-	}
+      cplx_set (corrections[i], cplx_zero);
+      cplx_set (newton_corrections[i], cplx_zero);
     }
 
-  mps_thread_pool_wait (ctx, ctx->pool);
+  if (nit)
+    for (i = 0; i < ctx->n; i++)
+      if (ctx->root[i]->again && !mps_conjugate_skip (pairs, i, NULL))
+        (*nit)++;
+
+  /* For large degrees the Aberth sums are evaluated on a tree built from
+   * the approximations at the start of the step. */
+  data.tree = mps_fmm_ftree_new (ctx);
+
+  mps_thread_pool_parallel_for (ctx, ctx->pool, 0, ctx->n, mps_jacobi_aberth_grain (ctx),
+                                __mps_fjacobi_aberth_step_worker, &data);
+
+  mps_fmm_tree_free (data.tree);
 
   /* Update again */
   for (i = 0; i < ctx->n; i++)
     {
+      if (mps_conjugate_skip (pairs, i, NULL))
+        continue;
+
+      cplx_set (old_value, ctx->root[i]->fvalue);
+
       if (ctx->root[i]->again)
         {
           cplx_sub_eq (ctx->root[i]->fvalue, corrections[i]);
+          mps_froot_array_set (froots, i, ctx->root[i]->fvalue);
           ctx->root[i]->frad += cplx_mod (corrections[i]);
           again = true;
         }
+
+      /* The conjugate needs to be updated also if the approximation
+       * has just reached the root neighbourhood */
+      if (pairs)
+        {
+          mirror = mps_conjugate_fupdate (ctx, pairs, i, old_value, newton_corrections[i]);
+          if (mirror >= 0)
+            {
+              mps_froot_array_set (froots, i, ctx->root[i]->fvalue);
+              mps_froot_array_set (froots, mirror, ctx->root[mirror]->fvalue);
+              again = again || ctx->root[i]->again;
+            }
+        }
     }
 
+  cplx_vfree (newton_corrections);
   cplx_vfree (corrections);
 
   return again;
@@ -147,11 +196,15 @@ mps_faberth_packet (mps_context * ctx, mps_polynomial * p, mps_boolean just_rege
 {
   int iterations = 0, i = 0, approximated_roots = 0, packet = 0, root_neighborhood_roots = 0;
   int it_threshold = ctx->n;
+  mps_conjugate_pairs * pairs;
+  mps_froot_array * froots;
 
 #ifndef DISABLE_DEBUG
   clock_t *my_clock = mps_start_timer ();
 #endif
 
+  mps_search_region_freeze (ctx);
+
   for (i = 0; i < ctx->n; i++)
     {
       if (MPS_ROOT_STATUS_IS_APPROXIMATED (ctx->root[i]->status))
@@ -161,13 +214,42 @@ mps_faberth_packet (mps_context * ctx, mps_polynomial * p, mps_boolean just_rege
         it_threshold--;
     }
 
+  /* The Aberth sums read the positions of the roots from contiguous
+   * arrays, that are kept up to date during the packet. */
+  froots = mps_froot_array_new (ctx, ctx->n);
+  if (!froots)
+    return 0;
+
+  /* Iterate only on one approximation of every conjugate pair, if possible.
+   * The pairs are made exactly conjugate here, so this must be done before
+   * loading the approximations in froots. */
+  pairs = mps_conjugate_fpairs (ctx);
+
+  mps_froot_array_load (ctx, froots);
+  MPS_DEBUG_WITH_INFO (ctx, "Using the %s kernel for the Aberth sums", froots->kernel_name);
+
   do
     {
       packet++;
 
       if (ctx->debug_level & MPS_DEBUG_APPROXIMATIONS)
         MPS_DEBUG (ctx, "Carrying out a packet of floating point Aberth iterations (packet = %d)", packet);
-    } while (mps_fjacobi_aberth_step (ctx, p, &iterations) && packet <= ctx->max_it);
+    } while (mps_fjacobi_aberth_step (ctx, p, froots, pairs, &iterations) && packet <= ctx->max_it);
+
+  /* The pairs that have not reached the root neighbourhood are split and
+   * get another packet on their own. Leaving them to the next packet would
+   * cost a regeneration of the secular equation, or a new packet on all
+   * the approximations with the same pairs. */
+  if (pairs && mps_conjugate_fsplit (ctx, pairs))
+    {
+      MPS_DEBUG_WITH_INFO (ctx, "Splitting the conjugate pairs that are still iterated");
+
+      mps_froot_array_load (ctx, froots);
+      packet = 0;
+      while (mps_fjacobi_aberth_step (ctx, p, froots, pairs, &iterations) && ++packet <= ctx->max_it);
+    }
+
+  mps_froot_array_free (froots);
 
   MPS_DEBUG_WITH_INFO (ctx, "Performed %d iterations in floating point", iterations);
 
@@ -186,6 +268,9 @@ mps_faberth_packet (mps_context * ctx, mps_polynomial * p, mps_boolean just_rege
   MPS_DEBUG_WITH_INFO (ctx, "%d roots are approximated within the current precision", approximated_roots);
   MPS_DEBUG_WITH_INFO (ctx, "%d roots are in the root neighborhood", root_neighborhood_roots);
 
+  if (pairs)
+    mps_conjugate_packet_done (ctx, pairs, root_neighborhood_roots);
+
 #ifndef DISABLE_DEBUG
   ctx->fp_iteration_time += mps_stop_timer (my_clock);
 #endif
@@ -195,42 +280,63 @@ mps_faberth_packet (mps_context * ctx, mps_polynomial * p, mps_boolean just_rege
 
 /*! @cond PRIVATE */
 struct __mps_djacobi_aberth_step_data {
-  mps_context * ctx;
   mps_polynomial * p;
-  mps_approximation * root;
-  cdpe_t * aberth_correction;
+  cdpe_t * aberth_corrections;
+  cdpe_t * newton_corrections;
+  mps_fmm_tree * tree;
+  mps_conjugate_pairs * pairs;
 };
 /*! @endcond */
 
-static void *
-__mps_djacobi_aberth_step_worker (void * data_ptr)
+static void
+__mps_djacobi_aberth_step_worker (mps_context * ctx, int begin, int end, void * data_ptr)
 {
   struct __mps_djacobi_aberth_step_data *data = (struct __mps_djacobi_aberth_step_data*)data_ptr;
-  cdpe_t abcorr;
-
-  mps_context * ctx = data->ctx;
-  mps_approximation * root = data->root;
   mps_polynomial * p = data->p;
+  mps_approximation * block[MPS_HORNER_BLOCK_SIZE];
+  cdpe_t corrs[MPS_HORNER_BLOCK_SIZE];
+  int index[MPS_HORNER_BLOCK_SIZE];
+  cdpe_t abcorr;
+  int i = begin, k, l;
 
-  mps_polynomial_dnewton (ctx, p, root, *data->aberth_correction);
+  while (i < end)
+    {
+      for (k = 0; i < end && k < MPS_HORNER_BLOCK_SIZE; i++)
+        if (ctx->root[i]->again && !mps_conjugate_skip (data->pairs, i, NULL))
+          {
+            index[k] = i;
+            block[k++] = ctx->root[i];
+          }
 
-  if (root->approximated)
-    root->again = false;
+      if (k == 0)
+        continue;
 
-  if (root->again)
-    {
-      mps_daberth (ctx, root, abcorr);
-      cdpe_mul_eq (abcorr, *data->aberth_correction);
-      cdpe_sub (abcorr, cdpe_one, abcorr);
+      mps_polynomial_dnewton_block (ctx, p, block, k, corrs);
 
-      if (!cdpe_eq_zero (abcorr))
-        cdpe_div (*data->aberth_correction, *data->aberth_correction, abcorr);
-      else
-        root->again = false;
+      for (l = 0; l < k; l++)
+        {
+          mps_approximation * root = block[l];
+          cdpe_t * corr = data->aberth_corrections + index[l];
+
+          cdpe_set (*corr, corrs[l]);
+          cdpe_set (data->newton_corrections[index[l]], corrs[l]);
+
+          if (root->approximated)
+            root->again = false;
+
+          if (root->again)
+            {
+              mps_fmm_daberth (ctx, data->tree, index[l], abcorr);
+              cdpe_mul_eq (abcorr, *corr);
+              cdpe_sub (abcorr, cdpe_one, abcorr);
+
+              if (!cdpe_eq_zero (abcorr))
+                cdpe_div (*corr, *corr, abcorr);
+              else
+                root->again = false;
+            }
+        }
     }
-
-  free (data);
-  return NULL;
 }
 
 /**
@@ -238,44 +344,46 @@ __mps_djacobi_aberth_step_worker (void * data_ptr)
  *
  * @param ctx The context in which this instance of MPSolve is running.
  * @param p The polynomial on which Aberth method should be applied.
- * @param approximations The starting approximations for the method. They will be
- *        updated with the new values when the function returns.
+ * @param pairs The pairing of the approximations computed by
+ *        mps_conjugate_dpairs(), or NULL if all of them should be iterated.
  */
 static mps_boolean
-mps_djacobi_aberth_step (mps_context * ctx, mps_polynomial * p, int * nit)
+mps_djacobi_aberth_step (mps_context * ctx, mps_polynomial * p,
+                         mps_conjugate_pairs * pairs, int * nit)
 {
   cdpe_t * daberth_corrections = NULL;
+  cdpe_t * newton_corrections = NULL;
+  cdpe_t old_value;
   mps_boolean again = false;
   int i = 0;
 
   daberth_corrections = cdpe_valloc (ctx->n);
+  newton_corrections = cdpe_valloc (ctx->n);
 
-  for (i = 0; i < ctx->n; i++)
-    {
-      if (ctx->root[i]->again)
-        {
-          struct __mps_djacobi_aberth_step_data * data = mps_new (struct __mps_djacobi_aberth_step_data);
+  struct __mps_djacobi_aberth_step_data data = {
+    p, daberth_corrections, newton_corrections, NULL, pairs
+  };
 
-          data->ctx = ctx;
-          data->p = p;
-          data->root = ctx->root[i];
-          data->aberth_correction = &daberth_corrections[i];
+  if (nit)
+    for (i = 0; i < ctx->n; i++)
+      if (ctx->root[i]->again && !mps_conjugate_skip (pairs, i, NULL))
+        (*nit)++;
 
-          /* The worker is in charge of freeing the data that we have allocated
-           * here, so we can't ignore this issue in the main thread. */
-          mps_thread_pool_assign (ctx, ctx->pool, __mps_djacobi_aberth_step_worker,
-                                  data);
+  data.tree = mps_fmm_dtree_new (ctx);
 
-          if (nit)
-            (*nit)++;
-        }
-    }
+  mps_thread_pool_parallel_for (ctx, ctx->pool, 0, ctx->n, mps_jacobi_aberth_grain (ctx),
+                                __mps_djacobi_aberth_step_worker, &data);
 
-  mps_thread_pool_wait (ctx, ctx->pool);
+  mps_fmm_tree_free (data.tree);
 
   /* Update again */
   for (i = 0; i < ctx->n; i++)
     {
+      if (mps_conjugate_skip (pairs, i, NULL))
+        continue;
+
+      cdpe_set (old_value, ctx->root[i]->dvalue);
+
       if (ctx->root[i]->again)
         {
           rdpe_t correction_module;
@@ -285,9 +393,15 @@ mps_djacobi_aberth_step (mps_context * ctx, mps_polynomial * p, int * nit)
           cdpe_mod (correction_module, daberth_corrections[i]);
           rdpe_add_eq (ctx->root[i]->drad, correction_module);
         }
+
+      /* The conjugate needs to be updated also if the approximation
+       * has just reached the root neighbourhood */
+      if (pairs)
+        mps_conjugate_dupdate (ctx, pairs, i, old_value, newton_corrections[i]);
     }
 
   cdpe_vfree (daberth_corrections);
+  cdpe_vfree (newton_corrections);
   return again;
 }
 
@@ -304,19 +418,24 @@ mps_daberth_packet (mps_context * ctx, mps_polynomial * p, mps_boolean just_rege
 {
   int iterations = 0, i = 0, approximated_roots = 0, packet = 0, root_neighborhood_roots = 0;
   int it_threshold = ctx->n;
+  mps_conjugate_pairs * pairs;
 
 #ifndef DISABLE_DEBUG
   clock_t *my_clock = mps_start_timer ();
 #endif
 
+  mps_search_region_freeze (ctx);
+
   for (i = 0; i < ctx->n; i++)
-    {
-      if (MPS_ROOT_STATUS_IS_APPROXIMATED (ctx->root[i]->status))
-        ctx->root[i]->approximated = true;
+    if (MPS_ROOT_STATUS_IS_APPROXIMATED (ctx->root[i]->status))
+      ctx->root[i]->approximated = true;
 
-      if (!ctx->root[i]->again)
-        it_threshold--;
-    }
+  /* The pairing merges the flags of the conjugate approximations */
+  pairs = mps_conjugate_dpairs (ctx);
+
+  for (i = 0; i < ctx->n; i++)
+    if (!ctx->root[i]->again)
+      it_threshold--;
 
   do
     {
@@ -324,7 +443,10 @@ mps_daberth_packet (mps_context * ctx, mps_polynomial * p, mps_boolean just_rege
 
       if (ctx->debug_level & MPS_DEBUG_APPROXIMATIONS)
         MPS_DEBUG (ctx, "Carrying out a packet of CDPE Aberth iterations (packet = %d)", packet);
-    } while (mps_djacobi_aberth_step (ctx, p, &iterations));
+    } while (mps_djacobi_aberth_step (ctx, p, pairs, &iterations));
+
+  if (pairs)
+    mps_conjugate_packet_done (ctx, pairs, ctx->n);
 
   MPS_DEBUG_WITH_INFO (ctx, "Performed %d iterations in CDPE", iterations);
 
@@ -352,51 +474,55 @@ mps_daberth_packet (mps_context * ctx, mps_polynomial * p, mps_boolean just_rege
 
 /*! @cond PRIVATE */
 struct __mps_mjacobi_aberth_step_data {
-  mps_context * ctx;
   mps_polynomial * p;
-  mps_approximation * root;
-  mpc_t * aberth_correction;
+  mpc_t * aberth_corrections;
+  mpc_t * newton_corrections;
+  mps_conjugate_pairs * pairs;
 };
 /*! @endcond */
 
-static void *
-__mps_mjacobi_aberth_step_worker (void * data_ptr)
+static void
+__mps_mjacobi_aberth_step_worker (mps_context * ctx, int begin, int end, void * data_ptr)
 {
   struct __mps_mjacobi_aberth_step_data *data = (struct __mps_mjacobi_aberth_step_data*)data_ptr;
-  mpc_t corr, abcorr;
-
-  mps_context * ctx = data->ctx;
-  mps_approximation * root = data->root;
   mps_polynomial * p = data->p;
+  mpc_t corr, abcorr;
+  int i;
 
+  /* The temporaries are shared by all the roots of the chunk */
   mpc_init2 (corr, ctx->mpwp);
   mpc_init2 (abcorr, ctx->mpwp);
 
-  mps_polynomial_mnewton (ctx, p, root, corr, mpc_get_prec (root->mvalue));
+  for (i = begin; i < end; i++)
+    {
+      mps_approximation * root = ctx->root[i];
 
-  if (root->approximated)
-    root->again = false;
+      if (!root->again || mps_conjugate_skip (data->pairs, i, NULL))
+        continue;
 
-  if (root->again)
-    {
-      mps_maberth (ctx, root, abcorr);
-      mpc_mul_eq (abcorr, corr);
-      mpc_ui_sub (abcorr, 1U, 0U, abcorr);
+      mps_polynomial_mnewton (ctx, p, root, corr, mpc_get_prec (root->mvalue));
+      mpc_set (data->newton_corrections[i], corr);
 
-      if (!mpc_eq_zero (abcorr))
-        mpc_div (abcorr, corr, abcorr);
-      else
+      if (root->approximated)
         root->again = false;
 
-      mpc_set (*data->aberth_correction, abcorr);
+      if (root->again)
+        {
+          mps_maberth (ctx, root, abcorr);
+          mpc_mul_eq (abcorr, corr);
+          mpc_ui_sub (abcorr, 1U, 0U, abcorr);
+
+          if (!mpc_eq_zero (abcorr))
+            mpc_div (abcorr, corr, abcorr);
+          else
+            root->again = false;
+
+          mpc_set (data->aberth_corrections[i], abcorr);
+        }
     }
 
   mpc_clear (corr);
   mpc_clear (abcorr);
-
-  free (data);
-
-  return NULL;
 }
 
 /**
@@ -404,45 +530,48 @@ __mps_mjacobi_aberth_step_worker (void * data_ptr)
  *
  * @param ctx The context in which this instance of MPSolve is running.
  * @param p The polynomial on which Aberth method should be applied.
- * @param approximations The starting approximations for the method. They will be
- *        updated with the new values when the function returns.
+ * @param pairs The pairing of the approximations computed by
+ *        mps_conjugate_mpairs(), or NULL if all of them should be iterated.
  */
 static mps_boolean
-mps_mjacobi_aberth_step (mps_context * ctx, mps_polynomial * p, int * nit)
+mps_mjacobi_aberth_step (mps_context * ctx, mps_polynomial * p,
+                         mps_conjugate_pairs * pairs, int * nit)
 {
   mpc_t * maberth_corrections = NULL;
+  mpc_t * newton_corrections = NULL;
+  mpc_t old_value;
   mps_boolean again = false;
   int i = 0;
 
   maberth_corrections = mpc_valloc (ctx->n);
   mpc_vinit2 (maberth_corrections, ctx->n, ctx->mpwp);
+  newton_corrections = mpc_valloc (ctx->n);
+  mpc_vinit2 (newton_corrections, ctx->n, ctx->mpwp);
+  mpc_init2 (old_value, ctx->mpwp);
 
-  for (i = 0; i < ctx->n; i++)
-    {
-      if (ctx->root[i]->again)
-        {
-          struct __mps_mjacobi_aberth_step_data * data = mps_new (struct __mps_mjacobi_aberth_step_data);
-
-          data->ctx = ctx;
-          data->p = p;
-          data->root = ctx->root[i];
-          data->aberth_correction = &maberth_corrections[i];
-
-          /* The worker is in charge of freeing the data that we have allocated
-           * here, so we can't ignore this issue in the main thread. */
-          mps_thread_pool_assign (ctx, ctx->pool, __mps_mjacobi_aberth_step_worker,
-                                  data);
+  struct __mps_mjacobi_aberth_step_data data = {
+    p, maberth_corrections, newton_corrections, pairs
+  };
 
-          if (nit)
-            (*nit)++;
-        }
-    }
+  if (nit)
+    for (i = 0; i < ctx->n; i++)
+      if (ctx->root[i]->again && !mps_conjugate_skip (pairs, i, NULL))
+        (*nit)++;
 
-  mps_thread_pool_wait (ctx, ctx->pool);
+  /* The cost of the multiprecision iterations depends on the precision
+   * of the single roots, so the chunks are kept small. */
+  mps_thread_pool_parallel_for (ctx, ctx->pool, 0, ctx->n, 1,
+                                __mps_mjacobi_aberth_step_worker, &data);
 
   /* Update again */
   for (i = 0; i < ctx->n; i++)
     {
+      if (mps_conjugate_skip (pairs, i, NULL))
+        continue;
+
+      if (pairs)
+        mpc_set (old_value, ctx->root[i]->mvalue);
+
       if (ctx->root[i]->again)
         {
           rdpe_t correction_module;
@@ -452,8 +581,16 @@ mps_mjacobi_aberth_step (mps_context * ctx, mps_polynomial * p, int * nit)
           mpc_rmod (correction_module, maberth_corrections[i]);
           rdpe_add_eq (ctx->root[i]->drad, correction_module);
         }
+
+      /* The conjugate needs to be updated also if the approximation
+       * has just reached the root neighbourhood */
+      if (pairs)
+        mps_conjugate_mupdate (ctx, pairs, i, old_value, newton_corrections[i], NULL);
     }
 
+  mpc_clear (old_value);
+  mpc_vclear (newton_corrections, ctx->n);
+  mpc_vfree (newton_corrections);
   mpc_vclear (maberth_corrections, ctx->n);
   mpc_vfree (maberth_corrections);
 
@@ -473,19 +610,24 @@ mps_maberth_packet (mps_context * ctx, mps_polynomial * p, mps_boolean just_rege
 {
   int iterations = 0, i = 0, approximated_roots = 0, packet = 0, root_neighborhood_roots = 0;
   int it_threshold = ctx->n;
+  mps_conjugate_pairs * pairs;
 
 #ifndef DISABLE_DEBUG
   clock_t *my_clock = mps_start_timer ();
 #endif
 
+  mps_search_region_freeze (ctx);
+
   for (i = 0; i < ctx->n; i++)
-    {
-      if (MPS_ROOT_STATUS_IS_APPROXIMATED (ctx->root[i]->status))
-        ctx->root[i]->approximated = true;
+    if (MPS_ROOT_STATUS_IS_APPROXIMATED (ctx->root[i]->status))
+      ctx->root[i]->approximated = true;
 
-      if (!ctx->root[i]->again)
-        it_threshold--;
-    }
+  /* The pairing merges the flags of the conjugate approximations */
+  pairs = mps_conjugate_mpairs (ctx);
+
+  for (i = 0; i < ctx->n; i++)
+    if (!ctx->root[i]->again)
+      it_threshold--;
 
   do
     {
@@ -493,7 +635,10 @@ mps_maberth_packet (mps_context * ctx, mps_polynomial * p, mps_boolean just_rege
 
       if (ctx->debug_level & MPS_DEBUG_APPROXIMATIONS)
         MPS_DEBUG (ctx, "Carrying out a packet of multiprecision Aberth iterations (packet = %d)", packet);
-    } while (mps_mjacobi_aberth_step (ctx, p, &iterations));
+    } while (mps_mjacobi_aberth_step (ctx, p, pairs, &iterations));
+
+  if (pairs)
+    mps_conjugate_packet_done (ctx, pairs, ctx->n);
 
   MPS_DEBUG_WITH_INFO (ctx, "Performed %d iterations in multiprecision", iterations);
 
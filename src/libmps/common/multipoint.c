@@ -0,0 +1,694 @@
+/*
+ * This file is part of MPSolve 3.1.5
+ *
+ * Copyright (C) 2001-2015, Dipartimento di Matematica "L. Tonelli", Pisa.
+ * License: http://www.gnu.org/licenses/gpl.html GPL version 3 or higher
+ *
+ * Authors:
+ *   Leonardo Robol <leonardo.robol@sns.it>
+ */
+
+#include <limits.h>
+#include <math.h>
+#include <string.h>
+#include <stdlib.h>
+#include <mps/mps.h>
+
+/* Polynomials are stored as arrays of coefficients of increasing degree,
+ * and their length is the number of coefficients. */
+
+static int
+mps_ceil_log2 (long int n)
+{
+  int k = 0;
+
+  while ((1L << k) < n)
+    k++;
+
+  return k;
+}
+
+/**
+ * @brief Convert the n coefficients of a to the fixed point integers
+ * (re[k] + i im[k]) 2^e, with |re[k]|, |im[k]| < 2^prec.
+ *
+ * @return false if all the coefficients are zero.
+ */
+static mps_boolean
+mps_mpc_poly_to_fixed (mpz_t * re, mpz_t * im, mpc_t * a, int n, long int prec, long int * e)
+{
+  long int emax = LONG_MIN, exp;
+  mpf_t t;
+  int k;
+
+  for (k = 0; k < n; k++)
+    {
+      if (mpf_sgn (mpc_Re (a[k])) != 0)
+        {
+          mpf_get_d_2exp (&exp, mpc_Re (a[k]));
+          emax = MAX (emax, exp);
+        }
+      if (mpf_sgn (mpc_Im (a[k])) != 0)
+        {
+          mpf_get_d_2exp (&exp, mpc_Im (a[k]));
+          emax = MAX (emax, exp);
+        }
+    }
+
+  if (emax == LONG_MIN)
+    return false;
+
+  *e = emax - prec;
+
+  mpf_init2 (t, prec + GMP_NUMB_BITS);
+  for (k = 0; k < n; k++)
+    {
+      if (*e < 0)
+        mpf_mul_2exp (t, mpc_Re (a[k]), -*e);
+      else
+        mpf_div_2exp (t, mpc_Re (a[k]), *e);
+      mpz_set_f (re[k], t);
+
+      if (*e < 0)
+        mpf_mul_2exp (t, mpc_Im (a[k]), -*e);
+      else
+        mpf_div_2exp (t, mpc_Im (a[k]), *e);
+      mpz_set_f (im[k], t);
+    }
+  mpf_clear (t);
+
+  return true;
+}
+
+/**
+ * @brief Set z to the evaluation at \f$2^{w}\f$ of the polynomial with the
+ * n integer coefficients v, where w is <code>GMP_NUMB_BITS * slot</code>.
+ *
+ * The slots must be wide enough to hold the moduli of the coefficients.
+ */
+static void
+mps_kronecker_pack (mpz_t z, mpz_t * v, int n, int slot)
+{
+  size_t total = (size_t) n * slot, size;
+  mp_limb_t * zp, * np;
+  mpz_t neg;
+  int k;
+
+  mpz_init (neg);
+
+  zp = mpz_limbs_write (z, total);
+  np = mpz_limbs_write (neg, total);
+  memset (zp, 0, total * sizeof (mp_limb_t));
+  memset (np, 0, total * sizeof (mp_limb_t));
+
+  /* The positive and the negative coefficients are packed separately, so
+   * that no carry has to be propagated. */
+  for (k = 0; k < n; k++)
+    {
+      size = mpz_size (v[k]);
+      if (size)
+        memcpy ((mpz_sgn (v[k]) > 0 ? zp : np) + (size_t) k * slot,
+                mpz_limbs_read (v[k]), size * sizeof (mp_limb_t));
+    }
+
+  mpz_limbs_finish (z, total);
+  mpz_limbs_finish (neg, total);
+  mpz_sub (z, z, neg);
+
+  mpz_clear (neg);
+}
+
+/**
+ * @brief Inverse of mps_kronecker_pack(): recover the n signed coefficients
+ * of z, assuming that they are smaller than \f$2^{w - 1}\f$ in modulus.
+ */
+static void
+mps_kronecker_unpack (mpz_t * v, mpz_t z, int n, int slot)
+{
+  size_t total = (size_t) n * slot, size;
+  mp_limb_t * up, * digit;
+  mpz_t u, half, d;
+  int k;
+
+  mpz_init (u);
+  mpz_init (half);
+
+  /* Add 2^(w - 1) to every digit, so that all of them are non negative and
+   * the slots of u can be read independently. */
+  up = mpz_limbs_write (u, total);
+  memset (up, 0, total * sizeof (mp_limb_t));
+  for (k = 0; k < n; k++)
+    up[(size_t) k * slot + slot - 1] = ((mp_limb_t) 1) << (GMP_NUMB_BITS - 1);
+  mpz_limbs_finish (u, total);
+  mpz_add (u, u, z);
+
+  mpz_setbit (half, (mp_bitcnt_t) slot * GMP_NUMB_BITS - 1);
+
+  digit = mps_newv (mp_limb_t, total);
+  memset (digit, 0, total * sizeof (mp_limb_t));
+  size = MIN (mpz_size (u), total);
+  memcpy (digit, mpz_limbs_read (u), size * sizeof (mp_limb_t));
+
+  for (k = 0; k < n; k++)
+    {
+      mp_limb_t * p = digit + (size_t) k * slot;
+      mp_size_t ds = slot;
+
+      while (ds > 0 && p[ds - 1] == 0)
+        ds--;
+
+      mpz_roinit_n (d, p, ds);
+      mpz_sub (v[k], d, half);
+    }
+
+  free (digit);
+  mpz_clear (half);
+  mpz_clear (u);
+}
+
+static void
+mps_mpc_poly_mul_schoolbook (mpc_t * c, mpc_t * a, int na, mpc_t * b, int nb)
+{
+  int i, j;
+
+  for (i = 0; i < na + nb - 1; i++)
+    mpc_set_ui (c[i], 0U, 0U);
+
+  for (i = 0; i < na; i++)
+    for (j = 0; j < nb; j++)
+      mpc_fma (c[i + j], a[i], b[j], c[i + j]);
+}
+
+/**
+ * @brief Multiply two polynomials with multiprecision coefficients.
+ *
+ * For long factors the product is computed through Kronecker substitution:
+ * the coefficients are converted to fixed point integers, packed in a single
+ * integer and multiplied with <code>mpz_mul()</code>, that switches to the FFT
+ * for large operands. The error on every coefficient of the result is then
+ * bounded by a small multiple of \f$2^{-prec}\f$, relative to the product of
+ * the largest coefficients of the factors.
+ *
+ * @param c The <code>na + nb - 1</code> coefficients of the product. It must
+ * not overlap with the factors.
+ * @param a The coefficients of the first factor.
+ * @param na The number of coefficients of <code>a</code>.
+ * @param b The coefficients of the second factor.
+ * @param nb The number of coefficients of <code>b</code>.
+ * @param prec The precision of the fixed point representation of the factors.
+ */
+void
+mps_mpc_poly_mul (mpc_t * c, mpc_t * a, int na, mpc_t * b, int nb, long int prec)
+{
+  mpz_t * ar, * ai, * br, * bi, * cr, * ci;
+  mpz_t zar, zai, zbr, zbi, p1, p2, p3;
+  long int ea, eb;
+  int k, nc = na + nb - 1, slot;
+
+  if (MIN (na, nb) < MPS_MULTIPOINT_KRONECKER_THRESHOLD)
+    {
+      mps_mpc_poly_mul_schoolbook (c, a, na, b, nb);
+      return;
+    }
+
+  ar = mps_newv (mpz_t, 2 * na);
+  ai = ar + na;
+  br = mps_newv (mpz_t, 2 * nb);
+  bi = br + nb;
+  cr = mps_newv (mpz_t, 2 * nc);
+  ci = cr + nc;
+
+  for (k = 0; k < 2 * na; k++)
+    mpz_init (ar[k]);
+  for (k = 0; k < 2 * nb; k++)
+    mpz_init (br[k]);
+  for (k = 0; k < 2 * nc; k++)
+    mpz_init (cr[k]);
+
+  if (!mps_mpc_poly_to_fixed (ar, ai, a, na, prec, &ea) ||
+      !mps_mpc_poly_to_fixed (br, bi, b, nb, prec, &eb))
+    {
+      for (k = 0; k < nc; k++)
+        mpc_set_ui (c[k], 0U, 0U);
+      goto mul_cleanup;
+    }
+
+  /* The coefficients of the products below are bounded by
+   * 4 * MIN (na, nb) * 2^(2 * prec). */
+  slot = (2 * prec + mps_ceil_log2 (MIN (na, nb)) + 4) / GMP_NUMB_BITS + 1;
+
+  mpz_init (zar);
+  mpz_init (zai);
+  mpz_init (zbr);
+  mpz_init (zbi);
+  mpz_init (p1);
+  mpz_init (p2);
+  mpz_init (p3);
+
+  mps_kronecker_pack (zar, ar, na, slot);
+  mps_kronecker_pack (zai, ai, na, slot);
+  mps_kronecker_pack (zbr, br, nb, slot);
+  mps_kronecker_pack (zbi, bi, nb, slot);
+
+  /* Complex product with three real multiplications. */
+  mpz_mul (p1, zar, zbr);
+  mpz_mul (p2, zai, zbi);
+  mpz_add (zar, zar, zai);
+  mpz_add (zbr, zbr, zbi);
+  mpz_mul (p3, zar, zbr);
+
+  mpz_sub (p3, p3, p1);
+  mpz_sub (p3, p3, p2);
+  mpz_sub (p1, p1, p2);
+
+  mps_kronecker_unpack (cr, p1, nc, slot);
+  mps_kronecker_unpack (ci, p3, nc, slot);
+
+  for (k = 0; k < nc; k++)
+    {
+      mpf_set_z (mpc_Re (c[k]), cr[k]);
+      mpf_set_z (mpc_Im (c[k]), ci[k]);
+      if (ea + eb < 0)
+        mpc_div_2exp (c[k], c[k], -(ea + eb));
+      else
+        mpc_mul_2exp (c[k], c[k], ea + eb);
+    }
+
+  mpz_clear (zar);
+  mpz_clear (zai);
+  mpz_clear (zbr);
+  mpz_clear (zbi);
+  mpz_clear (p1);
+  mpz_clear (p2);
+  mpz_clear (p3);
+
+mul_cleanup:
+  for (k = 0; k < 2 * na; k++)
+    mpz_clear (ar[k]);
+  for (k = 0; k < 2 * nb; k++)
+    mpz_clear (br[k]);
+  for (k = 0; k < 2 * nc; k++)
+    mpz_clear (cr[k]);
+
+  free (ar);
+  free (br);
+  free (cr);
+}
+
+/**
+ * @brief Compute the first k coefficients of \f$1 / f\f$ with Newton
+ * iterations, where f has nf coefficients and \f$f(0) = 1\f$.
+ */
+static void
+mps_mpc_poly_inverse (mpc_t * g, mpc_t * f, int nf, int k, long int prec)
+{
+  mpc_t * e, * h;
+  int m, m2, j;
+
+  e = mpc_valloc (2 * k);
+  h = mpc_valloc (2 * k);
+  mpc_vinit2 (e, 2 * k, prec);
+  mpc_vinit2 (h, 2 * k, prec);
+
+  mpc_set_ui (g[0], 1U, 0U);
+  for (m = 1; m < k; m = m2)
+    {
+      m2 = MIN (2 * m, k);
+
+      /* The first m coefficients of e = f * g - 1 vanish, and
+       * g <- g - g * e doubles the number of correct coefficients. */
+      mps_mpc_poly_mul (e, f, MIN (nf, m2), g, m, prec);
+      for (j = MIN (nf, m2) + m - 1; j < m2; j++)
+        mpc_set_ui (e[j], 0U, 0U);
+      mps_mpc_poly_mul (h, g, m2 - m, e + m, m2 - m, prec);
+
+      for (j = 0; j < m2 - m; j++)
+        mpc_neg (g[m + j], h[j]);
+    }
+
+  mpc_vclear (e, 2 * k);
+  mpc_vclear (h, 2 * k);
+  free (e);
+  free (h);
+}
+
+/**
+ * @brief Reduce the polynomial a with na coefficients modulo the monic
+ * polynomial m of degree d, given the first <code>na - d</code> coefficients
+ * of the inverse of the reversal of m.
+ */
+static void
+mps_mpc_poly_rem (mpc_t * r, mpc_t * a, int na, mpc_t * m, int d, mpc_t * minv, long int prec)
+{
+  int k = na - d, j;
+  mpc_t * ra, * q, * t;
+
+  if (k <= 0)
+    {
+      for (j = 0; j < na; j++)
+        mpc_set (r[j], a[j]);
+      for (j = na; j < d; j++)
+        mpc_set_ui (r[j], 0U, 0U);
+      return;
+    }
+
+  ra = mpc_valloc (k);
+  q = mpc_valloc (2 * k);
+  t = mpc_valloc (na);
+  mpc_vinit2 (ra, k, prec);
+  mpc_vinit2 (q, 2 * k, prec);
+  mpc_vinit2 (t, na, prec);
+
+  /* The reversal of the quotient is rev(a) / rev(m) mod x^k */
+  for (j = 0; j < k; j++)
+    mpc_set (ra[j], a[na - 1 - j]);
+  mps_mpc_poly_mul (q, ra, k, minv, k, prec);
+
+  for (j = 0; j < k; j++)
+    mpc_set (ra[j], q[k - 1 - j]);
+
+  mps_mpc_poly_mul (t, ra, k, m, d + 1, prec);
+
+  for (j = 0; j < d; j++)
+    mpc_sub (r[j], a[j], t[j]);
+
+  mpc_vclear (ra, k);
+  mpc_vclear (q, 2 * k);
+  mpc_vclear (t, na);
+  free (ra);
+  free (q);
+  free (t);
+}
+
+/*! @cond PRIVATE */
+struct mps_multipoint_point {
+  int index;
+  double arg;
+};
+/*! @endcond */
+
+static int
+mps_multipoint_compare_points (const void * p1, const void * p2)
+{
+  double a1 = ((const struct mps_multipoint_point *) p1)->arg;
+  double a2 = ((const struct mps_multipoint_point *) p2)->arg;
+
+  return (a1 > a2) - (a1 < a2);
+}
+
+static double
+mps_mpc_arg (mpc_t x)
+{
+  long int er, ei;
+  double dr = mpf_get_d_2exp (&er, mpc_Re (x));
+  double di = mpf_get_d_2exp (&ei, mpc_Im (x));
+  long int e = MAX (er, ei);
+
+  return atan2 (ldexp (di, (int) MAX (ei - e, -2000)), ldexp (dr, (int) MAX (er - e, -2000)));
+}
+
+/* Build the subtree with the points sorted[0], sorted[stride], ..., and
+ * return the index of its root. */
+static int
+mps_multipoint_tree_build (mps_multipoint_tree * tree, mpc_t * points,
+                           struct mps_multipoint_point * sorted, int stride, int n, int * next)
+{
+  int id = tree->n_nodes++, j, k, l, r;
+  mps_multipoint_node * node = tree->nodes + id;
+  mpc_t t;
+
+  node->child[0] = node->child[1] = -1;
+
+  if (n <= MPS_MULTIPOINT_LEAF_SIZE)
+    {
+      node->begin = *next;
+      node->end = *next + n;
+      node->m = mpc_valloc (n + 1);
+      mpc_vinit2 (node->m, n + 1, tree->prec);
+
+      mpc_init2 (t, tree->prec);
+      mpc_set_ui (node->m[0], 1U, 0U);
+      for (j = 0; j < n; j++)
+        {
+          int i = node->begin + j;
+
+          tree->perm[i] = sorted[j * stride].index;
+          mpc_set (tree->points[i], points[tree->perm[i]]);
+
+          /* Multiply by (x - x_i) */
+          mpc_set (node->m[j + 1], node->m[j]);
+          for (k = j; k > 0; k--)
+            {
+              mpc_mul (t, node->m[k], tree->points[i]);
+              mpc_sub (node->m[k], node->m[k - 1], t);
+            }
+          mpc_mul (t, node->m[0], tree->points[i]);
+          mpc_neg (node->m[0], t);
+        }
+      mpc_clear (t);
+
+      *next += n;
+      return id;
+    }
+
+  /* Split the points taking them alternately, so that both children see
+   * points spread all around the set. */
+  l = mps_multipoint_tree_build (tree, points, sorted, 2 * stride, (n + 1) / 2, next);
+  r = mps_multipoint_tree_build (tree, points, sorted + stride, 2 * stride, n / 2, next);
+
+  node = tree->nodes + id;
+  node->child[0] = l;
+  node->child[1] = r;
+  node->begin = tree->nodes[l].begin;
+  node->end = tree->nodes[r].end;
+
+  node->m = mpc_valloc (n + 1);
+  mpc_vinit2 (node->m, n + 1, tree->prec);
+  mps_mpc_poly_mul (node->m, tree->nodes[l].m, (n + 1) / 2 + 1, tree->nodes[r].m, n / 2 + 1, tree->prec);
+
+  /* The product of monic polynomials is monic. */
+  mpc_set_ui (node->m[n], 1U, 0U);
+
+  return id;
+}
+
+/**
+ * @brief Build the subproduct tree of the given points.
+ *
+ * @param s The current mps_context.
+ * @param points The points.
+ * @param n The number of points.
+ * @param prec The precision of the computations.
+ */
+mps_multipoint_tree *
+mps_multipoint_tree_new (mps_context * s, mpc_t * points, int n, long int prec)
+{
+  mps_multipoint_tree * tree = mps_new (mps_multipoint_tree);
+  struct mps_multipoint_point * sorted = mps_newv (struct mps_multipoint_point, n);
+  int i, next = 0;
+
+  tree->n = n;
+  tree->prec = prec;
+  tree->points = mpc_valloc (n);
+  mpc_vinit2 (tree->points, n, prec);
+  tree->perm = mps_newv (int, n);
+  tree->nodes = mps_newv (mps_multipoint_node, 2 * n);
+  tree->n_nodes = 0;
+
+  for (i = 0; i < n; i++)
+    {
+      sorted[i].index = i;
+      sorted[i].arg = mps_mpc_arg (points[i]);
+    }
+
+  qsort (sorted, n, sizeof (struct mps_multipoint_point), mps_multipoint_compare_points);
+
+  mps_multipoint_tree_build (tree, points, sorted, 1, n, &next);
+
+  free (sorted);
+
+  return tree;
+}
+
+/**
+ * @brief Free a tree allocated with mps_multipoint_tree_new().
+ */
+void
+mps_multipoint_tree_free (mps_multipoint_tree * tree)
+{
+  int k;
+
+  for (k = 0; k < tree->n_nodes; k++)
+    {
+      mps_multipoint_node * node = tree->nodes + k;
+      mpc_vclear (node->m, node->end - node->begin + 1);
+      free (node->m);
+    }
+
+  mpc_vclear (tree->points, tree->n);
+  free (tree->points);
+  free (tree->perm);
+  free (tree->nodes);
+  free (tree);
+}
+
+/**
+ * @brief Store in dm the n coefficients of the derivative of
+ * \f$\prod_j (x - x_j)\f$, whose value at \f$x_i\f$ is
+ * \f$\prod_{j \neq i} (x_i - x_j)\f$.
+ */
+void
+mps_multipoint_tree_derivative (mps_multipoint_tree * tree, mpc_t * dm)
+{
+  int k;
+
+  for (k = 0; k < tree->n; k++)
+    mpc_mul_ui (dm[k], tree->nodes[0].m[k + 1], k + 1);
+}
+
+static void
+mps_multipoint_tree_descend (mps_multipoint_tree * tree, int id, int npolys,
+                             mpc_t ** rems, int * lengths, mpc_t ** values)
+{
+  mps_multipoint_node * node = tree->nodes + id;
+  int i, j, k, c;
+
+  if (node->child[0] < 0)
+    {
+      mpc_t t;
+      mpc_init2 (t, tree->prec);
+
+      for (j = 0; j < npolys; j++)
+        for (i = node->begin; i < node->end; i++)
+          {
+            mpc_set_ui (t, 0U, 0U);
+            for (k = lengths[j] - 1; k >= 0; k--)
+              mpc_horner_step (t, tree->points[i], rems[j][k]);
+            mpc_set (values[j][tree->perm[i]], t);
+          }
+
+      mpc_clear (t);
+      return;
+    }
+
+  for (c = 0; c < 2; c++)
+    {
+      mps_multipoint_node * child = tree->nodes + node->child[c];
+      int d = child->end - child->begin, kmax = 0;
+      mpc_t ** crems = mps_newv (mpc_t *, npolys);
+      int * clengths = mps_newv (int, npolys);
+      mpc_t * minv = NULL, * rm = NULL;
+
+      for (j = 0; j < npolys; j++)
+        kmax = MAX (kmax, lengths[j] - d);
+
+      /* One inverse of the reversed polynomial of the child is shared
+       * by all the reductions. */
+      if (kmax > 0)
+        {
+          minv = mpc_valloc (kmax);
+          rm = mpc_valloc (d + 1);
+          mpc_vinit2 (minv, kmax, tree->prec);
+          mpc_vinit2 (rm, d + 1, tree->prec);
+
+          for (k = 0; k <= d; k++)
+            mpc_set (rm[k], child->m[d - k]);
+
+          mps_mpc_poly_inverse (minv, rm, d + 1, kmax, tree->prec);
+        }
+
+      for (j = 0; j < npolys; j++)
+        {
+          clengths[j] = MIN (lengths[j], d);
+          crems[j] = mpc_valloc (d);
+          mpc_vinit2 (crems[j], d, tree->prec);
+          mps_mpc_poly_rem (crems[j], rems[j], lengths[j], child->m, d, minv, tree->prec);
+        }
+
+      mps_multipoint_tree_descend (tree, node->child[c], npolys, crems, clengths, values);
+
+      for (j = 0; j < npolys; j++)
+        {
+          mpc_vclear (crems[j], d);
+          free (crems[j]);
+        }
+
+      if (kmax > 0)
+        {
+          mpc_vclear (minv, kmax);
+          mpc_vclear (rm, d + 1);
+          free (minv);
+          free (rm);
+        }
+
+      free (crems);
+      free (clengths);
+    }
+}
+
+/**
+ * @brief Evaluate some polynomials at all the points of a tree.
+ *
+ * @param s The current mps_context.
+ * @param tree The subproduct tree of the points.
+ * @param npolys The number of polynomials to evaluate.
+ * @param polys The coefficients of the polynomials.
+ * @param lengths The number of coefficients of each polynomial.
+ * @param values On output, <code>values[j][i]</code> is the value of the j-th
+ * polynomial at the i-th point given to mps_multipoint_tree_new(). These must
+ * be already initialized.
+ */
+void
+mps_multipoint_tree_eval (mps_context * s, mps_multipoint_tree * tree, int npolys,
+                          mpc_t ** polys, int * lengths, mpc_t ** values)
+{
+  mpc_t ** rems = mps_newv (mpc_t *, npolys);
+  int * rlengths = mps_newv (int, npolys);
+  mps_multipoint_node * root = tree->nodes;
+  int d = tree->n, j, k;
+  mpc_t * minv = NULL, * rm = NULL;
+  int kmax = 0;
+
+  for (j = 0; j < npolys; j++)
+    kmax = MAX (kmax, lengths[j] - d);
+
+  if (kmax > 0)
+    {
+      minv = mpc_valloc (kmax);
+      rm = mpc_valloc (d + 1);
+      mpc_vinit2 (minv, kmax, tree->prec);
+      mpc_vinit2 (rm, d + 1, tree->prec);
+
+      for (k = 0; k <= d; k++)
+        mpc_set (rm[k], root->m[d - k]);
+
+      mps_mpc_poly_inverse (minv, rm, d + 1, kmax, tree->prec);
+    }
+
+  for (j = 0; j < npolys; j++)
+    {
+      rems[j] = mpc_valloc (d);
+      mpc_vinit2 (rems[j], d, tree->prec);
+      rlengths[j] = MIN (lengths[j], d);
+      mps_mpc_poly_rem (rems[j], polys[j], lengths[j], root->m, d, minv, tree->prec);
+    }
+
+  mps_multipoint_tree_descend (tree, 0, npolys, rems, rlengths, values);
+
+  for (j = 0; j < npolys; j++)
+    {
+      mpc_vclear (rems[j], d);
+      free (rems[j]);
+    }
+
+  if (kmax > 0)
+    {
+      mpc_vclear (minv, kmax);
+      mpc_vclear (rm, d + 1);
+      free (minv);
+      free (rm);
+    }
+
+  free (rems);
+  free (rlengths);
+}
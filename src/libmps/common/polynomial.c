@@ -40,6 +40,7 @@ mps_polynomial_init (mps_context * ctx, mps_polynomial * p)
   p->feval = NULL;
   p->deval = NULL;
   p->meval = NULL;
+  p->ddeval = NULL;
   p->fstart = mps_general_fstart;
   p->dstart = mps_general_dstart;
   p->mstart = mps_general_mstart;
@@ -48,6 +49,9 @@ mps_polynomial_init (mps_context * ctx, mps_polynomial * p)
   p->fnewton = NULL;
   p->dnewton = NULL;
   p->mnewton = NULL;
+  p->ddnewton = NULL;
+  p->fnewton_block = NULL;
+  p->dnewton_block = NULL;
   p->get_leading_coefficient = _mps_polynomial_get_leading_coefficient;
 }
 
@@ -106,6 +110,15 @@ mps_polynomial_meval (mps_context * ctx, mps_polynomial * p, mpc_t x, mpc_t valu
   return (*p->meval)(ctx, p, x, value, error);
 }
 
+mps_boolean
+mps_polynomial_ddeval (mps_context * ctx, mps_polynomial * p, cdd_t x, cdd_t value, double * error)
+{
+  if (p->ddeval == NULL)
+    return false;
+
+  return (*p->ddeval)(ctx, p, x, value, error);
+}
+
 void
 mps_polynomial_fstart (mps_context * ctx, mps_polynomial * p, mps_approximation ** approximations)
 {
@@ -125,6 +138,11 @@ mps_polynomial_fstart (mps_context * ctx, mps_polynomial * p, mps_approximation
       /* The FILE starting strategy is one-shot only. */
       mps_context_select_starting_strategy (ctx, MPS_STARTING_STRATEGY_DEFAULT);
       break;
+    case MPS_STARTING_STRATEGY_USER:
+      mps_user_fstart (ctx, p, approximations);
+      /* The approximations set by the user are used only once, as the FILE ones. */
+      mps_context_select_starting_strategy (ctx, MPS_STARTING_STRATEGY_DEFAULT);
+      break;
     }
 }
 
@@ -147,6 +165,11 @@ mps_polynomial_dstart (mps_context * ctx, mps_polynomial * p, mps_approximation
       /* The FILE starting strategy is one-shot only. */
       mps_context_select_starting_strategy (ctx, MPS_STARTING_STRATEGY_DEFAULT);
       break;
+    case MPS_STARTING_STRATEGY_USER:
+      mps_user_dstart (ctx, p, approximations);
+      /* The approximations set by the user are used only once, as the FILE ones. */
+      mps_context_select_starting_strategy (ctx, MPS_STARTING_STRATEGY_DEFAULT);
+      break;
     }
 }
 
@@ -169,6 +192,11 @@ mps_polynomial_mstart (mps_context * ctx, mps_polynomial * p, mps_approximation
       /* The FILE starting strategy is one-shot only. */
       mps_context_select_starting_strategy (ctx, MPS_STARTING_STRATEGY_DEFAULT);
       break;
+    case MPS_STARTING_STRATEGY_USER:
+      mps_user_mstart (ctx, p, approximations);
+      /* The approximations set by the user are used only once, as the FILE ones. */
+      mps_context_select_starting_strategy (ctx, MPS_STARTING_STRATEGY_DEFAULT);
+      break;
     }
 }
 
@@ -189,6 +217,7 @@ mps_polynomial_fnewton (mps_context * ctx, mps_polynomial *p,
                         mps_approximation * root, cplx_t corr)
 {
   (*p->fnewton)(ctx, p, root, corr);
+  __sync_add_and_fetch (&ctx->newton_corrections, 1);
 }
 
 void
@@ -196,6 +225,48 @@ mps_polynomial_dnewton (mps_context * ctx, mps_polynomial *p,
                         mps_approximation * root, cdpe_t corr)
 {
   (*p->dnewton)(ctx, p, root, corr);
+  __sync_add_and_fetch (&ctx->newton_corrections, 1);
+}
+
+/**
+ * @brief Compute the Newton corrections at the approximations
+ * <code>roots[0]</code>, ..., <code>roots[n - 1]</code>.
+ *
+ * Polynomials that can evaluate many points together more efficiently than
+ * one at a time provide the fnewton_block method; otherwise the fnewton one
+ * is called on every approximation.
+ */
+void
+mps_polynomial_fnewton_block (mps_context * ctx, mps_polynomial *p,
+                              mps_approximation ** roots, int n, cplx_t * corr)
+{
+  int i;
+
+  if (p->fnewton_block)
+    (*p->fnewton_block)(ctx, p, roots, n, corr);
+  else
+    for (i = 0; i < n; i++)
+      (*p->fnewton)(ctx, p, roots[i], corr[i]);
+
+  __sync_add_and_fetch (&ctx->newton_corrections, n);
+}
+
+/**
+ * @brief DPE version of mps_polynomial_fnewton_block().
+ */
+void
+mps_polynomial_dnewton_block (mps_context * ctx, mps_polynomial *p,
+                              mps_approximation ** roots, int n, cdpe_t * corr)
+{
+  int i;
+
+  if (p->dnewton_block)
+    (*p->dnewton_block)(ctx, p, roots, n, corr);
+  else
+    for (i = 0; i < n; i++)
+      (*p->dnewton)(ctx, p, roots[i], corr[i]);
+
+  __sync_add_and_fetch (&ctx->newton_corrections, n);
 }
 
 void
@@ -204,6 +275,25 @@ mps_polynomial_mnewton (mps_context * ctx, mps_polynomial *p,
                         long int wp)
 {
   (*p->mnewton)(ctx, p, root, corr, wp);
+  __sync_add_and_fetch (&ctx->newton_corrections, 1);
+}
+
+/**
+ * @brief Compute the Newton correction in double-double arithmetic.
+ *
+ * @return false if the polynomial does not provide the ddnewton method,
+ * or if the correction could not be computed in double-double arithmetic;
+ * the caller should then fall back to mps_polynomial_mnewton().
+ */
+mps_boolean
+mps_polynomial_ddnewton (mps_context * ctx, mps_polynomial *p,
+                         mps_approximation * root, cdd_t corr)
+{
+  if (p->ddnewton == NULL || !(*p->ddnewton)(ctx, p, root, corr))
+    return false;
+
+  __sync_add_and_fetch (&ctx->newton_corrections, 1);
+  return true;
 }
 
 void
@@ -0,0 +1,224 @@
+/*
+ * This file is part of MPSolve 3.1.5
+ *
+ * Copyright (C) 2001-2015, Dipartimento di Matematica "L. Tonelli", Pisa.
+ * License: http://www.gnu.org/licenses/gpl.html GPL version 3 or higher
+ *
+ * Authors:
+ *   Leonardo Robol <leonardo.robol@sns.it>
+ */
+
+#include <float.h>
+#include <math.h>
+#include <mps/mps.h>
+
+/**
+ * @brief Allocate an empty search region.
+ */
+mps_search_region *
+mps_search_region_new (void)
+{
+  mps_search_region * region = mps_new (mps_search_region);
+
+  region->disks = NULL;
+  region->n_disks = 0;
+  region->rectangles = NULL;
+  region->n_rectangles = 0;
+
+  return region;
+}
+
+/**
+ * @brief Free a search region allocated with mps_search_region_new().
+ */
+void
+mps_search_region_free (mps_search_region * region)
+{
+  if (region == NULL)
+    return;
+
+  free (region->disks);
+  free (region->rectangles);
+  free (region);
+}
+
+/**
+ * @brief Add the closed disk of the given center and radius to the region.
+ */
+void
+mps_search_region_add_disk (mps_search_region * region, cplx_t center, double radius)
+{
+  region->disks = (mps_search_disk*)mps_realloc (region->disks,
+                                                  sizeof(mps_search_disk) * (region->n_disks + 1));
+
+  cplx_set (region->disks[region->n_disks].center, center);
+  region->disks[region->n_disks].radius = radius;
+  region->n_disks++;
+}
+
+/**
+ * @brief Add the closed rectangle \f$[re\_min, re\_max] \times [im\_min, im\_max]\f$
+ * to the region.
+ */
+void
+mps_search_region_add_rectangle (mps_search_region * region, double re_min, double im_min,
+                                 double re_max, double im_max)
+{
+  mps_search_rectangle * rect;
+
+  region->rectangles = (mps_search_rectangle*)mps_realloc (region->rectangles,
+                                                            sizeof(mps_search_rectangle) * (region->n_rectangles + 1));
+
+  rect = region->rectangles + region->n_rectangles;
+  rect->re_min = MIN (re_min, re_max);
+  rect->re_max = MAX (re_min, re_max);
+  rect->im_min = MIN (im_min, im_max);
+  rect->im_max = MAX (im_min, im_max);
+  region->n_rectangles++;
+}
+
+/**
+ * @brief Locate the disk of the given center and radius with respect to
+ * the region.
+ *
+ * @return <code>MPS_ROOT_INCLUSION_IN</code> if the disk is contained in one
+ * of the disks or rectangles of the region, <code>MPS_ROOT_INCLUSION_OUT</code>
+ * if it does not intersect any of them, and <code>MPS_ROOT_INCLUSION_UNKNOWN</code>
+ * otherwise.
+ */
+mps_root_inclusion
+mps_search_region_fclassify (mps_search_region * region, cplx_t center, double radius)
+{
+  double x = cplx_Re (center), y = cplx_Im (center);
+  double d, dx, dy;
+  mps_boolean touches = false;
+  int k;
+
+  if (region == NULL)
+    return MPS_ROOT_INCLUSION_UNKNOWN;
+
+  for (k = 0; k < region->n_disks; k++)
+    {
+      mps_search_disk * disk = region->disks + k;
+
+      d = hypot (x - cplx_Re (disk->center), y - cplx_Im (disk->center));
+      if (d + radius <= disk->radius)
+        return MPS_ROOT_INCLUSION_IN;
+      if (!(d > radius + disk->radius))
+        touches = true;
+    }
+
+  for (k = 0; k < region->n_rectangles; k++)
+    {
+      mps_search_rectangle * rect = region->rectangles + k;
+
+      if (x - radius >= rect->re_min && x + radius <= rect->re_max &&
+          y - radius >= rect->im_min && y + radius <= rect->im_max)
+        return MPS_ROOT_INCLUSION_IN;
+
+      /* Distance of the center from the rectangle */
+      dx = MAX (MAX (rect->re_min - x, x - rect->re_max), 0.0);
+      dy = MAX (MAX (rect->im_min - y, y - rect->im_max), 0.0);
+      if (!(hypot (dx, dy) > radius))
+        touches = true;
+    }
+
+  return touches ? MPS_ROOT_INCLUSION_UNKNOWN : MPS_ROOT_INCLUSION_OUT;
+}
+
+/*
+ * Locate the disk of the given center and radius, enlarged to take into
+ * account the rounding errors made by mps_search_region_fclassify() and by
+ * the conversion of the center to floating point.
+ */
+static mps_root_inclusion
+mps_search_region_classify_with_error (mps_context * s, cplx_t center, double radius)
+{
+  if (!(radius < DBL_MAX))
+    return MPS_ROOT_INCLUSION_UNKNOWN;
+
+  radius += 4.0 * DBL_EPSILON * cplx_mod (center);
+
+  return mps_search_region_fclassify (s->output_config->search_region, center, radius);
+}
+
+/**
+ * @brief Locate the inclusion disk of the i-th approximation in floating
+ * point with respect to the search region.
+ *
+ * As in mps_ftouchunit(), the inclusion radius is multiplied by
+ * <code>n</code> before the check.
+ */
+MPS_PRIVATE mps_root_inclusion
+mps_search_region_finclusion (mps_context * s, int i, int n)
+{
+  if (s->root[i]->frad >= DBL_MAX / n)
+    return MPS_ROOT_INCLUSION_UNKNOWN;
+
+  return mps_search_region_classify_with_error (s, s->root[i]->fvalue, n * s->root[i]->frad);
+}
+
+/**
+ * @brief DPE version of mps_search_region_finclusion().
+ *
+ * The approximations that are not representable as floating point numbers
+ * are very far from the origin, and are located with the infinite or zero
+ * center and radius that the conversion gives.
+ */
+MPS_PRIVATE mps_root_inclusion
+mps_search_region_dinclusion (mps_context * s, int i, int n)
+{
+  rdpe_t rad;
+  cplx_t center;
+
+  rdpe_mul_d (rad, s->root[i]->drad, (double)n);
+  if (rdpe_gt (rad, rdpe_maxd))
+    return MPS_ROOT_INCLUSION_UNKNOWN;
+
+  cdpe_get_x (center, s->root[i]->dvalue);
+
+  return mps_search_region_classify_with_error (s, center, rdpe_get_d (rad));
+}
+
+/**
+ * @brief Multiprecision version of mps_search_region_finclusion().
+ */
+MPS_PRIVATE mps_root_inclusion
+mps_search_region_minclusion (mps_context * s, int i, int n)
+{
+  rdpe_t rad;
+  cdpe_t dcenter;
+  cplx_t center;
+
+  rdpe_mul_d (rad, s->root[i]->drad, (double)n);
+  if (rdpe_gt (rad, rdpe_maxd))
+    return MPS_ROOT_INCLUSION_UNKNOWN;
+
+  mpc_get_cdpe (dcenter, s->root[i]->mvalue);
+  cdpe_get_x (center, dcenter);
+
+  return mps_search_region_classify_with_error (s, center, rdpe_get_d (rad));
+}
+
+/**
+ * @brief Stop the iterations on the approximations whose inclusion disks
+ * are certified to be out of the search set.
+ *
+ * These approximations are marked as approximated, so that they do not
+ * prevent the increase of the working precision, and keep their current
+ * value in the Aberth sums and in the regeneration of the secular
+ * equation, so that only the roots in the search set are refined in
+ * multiprecision.
+ */
+MPS_PRIVATE void
+mps_search_region_freeze (mps_context * s)
+{
+  int i;
+
+  for (i = 0; i < s->n; i++)
+    if (s->root[i]->inclusion == MPS_ROOT_INCLUSION_OUT)
+      {
+        s->root[i]->again = false;
+        s->root[i]->approximated = true;
+      }
+}
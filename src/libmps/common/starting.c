@@ -303,10 +303,16 @@ mps_fstart (mps_context * s, int n, mps_cluster_item * cluster_item,
 
   mps_cluster * cluster = NULL;
   mps_root * root = NULL;
+  mps_boolean symmetric = false;
 
   if (cluster_item)
     cluster = cluster_item->cluster;
 
+  /* The starting points of the whole polynomial are placed in conjugate
+   * pairs if the iterations can exploit the symmetry of the roots. */
+  if (cluster_item == NULL && g == 0.0)
+    symmetric = mps_conjugate_symmetry_enabled (s);
+
   if (s->random_seed)
     sigma = drand ();
   else
@@ -353,11 +359,32 @@ mps_fstart (mps_context * s, int n, mps_cluster_item * cluster_item,
           if ((r == DBL_MIN) || (r == DBL_MAX))
             /* if ((r == small) || (r == big)) DARIO Giugno 23 */
             s->root[l]->status = MPS_ROOT_STATUS_NOT_FLOAT;
-          cplx_set_d (s->root[l]->fvalue,
-                      r * cos (ang * jj + th * c.partitioning[i + 1] +
-                               sigma),
-                      r * sin (ang * jj + th * c.partitioning[i + 1] +
-                               sigma));
+          if (symmetric)
+            {
+              /* Use the angles (2 jj + 1) pi / nzeros, that are symmetric with
+               * respect to the real axis, and set the second half of the
+               * annulus by conjugation so that the pairs are exact. An
+               * annulus with an odd number of roots contains a real one, so
+               * its real starting point is kept. */
+              if (2 * jj + 1 == nzeros)
+                cplx_set_d (s->root[l]->fvalue, -r, 0.0);
+              else if (2 * jj + 1 < nzeros)
+                cplx_set_d (s->root[l]->fvalue,
+                            r * cos (ang * (jj + 0.5)),
+                            r * sin (ang * (jj + 0.5)));
+              else
+                {
+                  mps_approximation * mirror = s->root[c.partitioning[i + 1] - 1 - jj];
+                  cplx_set_d (s->root[l]->fvalue, cplx_Re (mirror->fvalue),
+                              -cplx_Im (mirror->fvalue));
+                }
+            }
+          else
+            cplx_set_d (s->root[l]->fvalue,
+                        r * cos (ang * jj + th * c.partitioning[i + 1] +
+                                 sigma),
+                        r * sin (ang * jj + th * c.partitioning[i + 1] +
+                                 sigma));
           if (s->debug_level & MPS_DEBUG_APPROXIMATIONS)
             {
               MPS_DEBUG_CPLX (s, s->root[l]->fvalue, "s->froot[%d]", l);
@@ -1209,6 +1236,7 @@ mps_frestart (mps_context * s)
           }
       /* Compute the coefficients of the derivative of p(x) having order
        * equal to the multiplicity of the cluster -1. */
+      mps_monomial_poly_ensure_fppc (s, p);
       sum = 0.0;
       for (j = 0; j <= MPS_POLYNOMIAL (p)->degree; j++)
         {
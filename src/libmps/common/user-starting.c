@@ -0,0 +1,102 @@
+/*
+ * This file is part of MPSolve 3.1.5
+ *
+ * Copyright (C) 2001-2015, Dipartimento di Matematica "L. Tonelli", Pisa.
+ * License: http://www.gnu.org/licenses/gpl.html GPL version 3 or higher
+ *
+ * Authors:
+ *   Leonardo Robol <leonardo.robol@sns.it>
+ */
+
+#include <mps/mps.h>
+#include <float.h>
+
+/**
+ * @brief Copy the approximations set with
+ * mps_context_set_starting_approximations_d() or
+ * mps_context_set_starting_approximations_m() into the given ones.
+ *
+ * @param ctx The current mps_context.
+ * @param poly The polynomial for which the approximations should be selected.
+ * @param approximations The approximations that will be set.
+ *
+ * @return false if the number of stored approximations does not match the
+ * degree of the polynomial, and nothing has been done.
+ */
+static mps_boolean
+mps_user_load_approximations (mps_context * ctx, mps_polynomial * poly,
+                              mps_approximation ** approximations)
+{
+  int i;
+
+  if (ctx->n_starting_points != poly->degree)
+    {
+      MPS_DEBUG (ctx, "%d starting approximations have been set, but the degree is %d: "
+                 "falling back to the default starting points", ctx->n_starting_points,
+                 poly->degree);
+      return false;
+    }
+
+  for (i = 0; i < poly->degree; i++)
+    {
+      mps_approximation * appr = approximations[i];
+
+      mpc_set (appr->mvalue, ctx->starting_points[i]);
+      mpc_get_cdpe (appr->dvalue, appr->mvalue);
+      mpc_get_cplx (appr->fvalue, appr->mvalue);
+
+      /* Without the radii nothing is known about the approximations, and
+       * the ones left from a previous computation must not be used. */
+      if (ctx->starting_radii)
+        {
+          rdpe_set (appr->drad, ctx->starting_radii[i]);
+          appr->frad = rdpe_get_d (appr->drad);
+        }
+      else
+        {
+          rdpe_set_d (appr->drad, DBL_MAX);
+          appr->frad = DBL_MAX;
+        }
+    }
+
+  return true;
+}
+
+/**
+ * @brief Select the starting points for the polynomial by copying the ones
+ * that have been set with mps_context_set_starting_approximations_d() or
+ * mps_context_set_starting_approximations_m().
+ *
+ * If they cannot be used the default starting points of the polynomial
+ * are computed instead.
+ *
+ * @param ctx The current mps_context.
+ * @param poly The polynomial for which the approximations should be selected.
+ * @param approximations The approximations that will be set.
+ */
+void
+mps_user_fstart (mps_context * ctx, mps_polynomial * poly, mps_approximation ** approximations)
+{
+  if (!mps_user_load_approximations (ctx, poly, approximations))
+    (*poly->fstart)(ctx, poly, approximations);
+}
+
+/**
+ * @brief DPE version of mps_user_fstart().
+ */
+void
+mps_user_dstart (mps_context * ctx, mps_polynomial * poly, mps_approximation ** approximations)
+{
+  if (!mps_user_load_approximations (ctx, poly, approximations))
+    (*poly->dstart)(ctx, poly, approximations);
+}
+
+/**
+ * @brief Multiprecision version of mps_user_fstart().
+ */
+void
+mps_user_mstart (mps_context * ctx, mps_polynomial * poly, mps_approximation ** approximations)
+{
+  if (!mps_user_load_approximations (ctx, poly, approximations))
+    (*poly->mstart)(ctx, poly, approximations);
+}
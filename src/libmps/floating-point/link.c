@@ -11,6 +11,7 @@
  */
 
 
+#include <float.h>
 #include <mps/link.h>
 
 /***********************************************************
@@ -71,6 +72,72 @@ mpc_get_cdpe (cdpe_t c, mpc_t mc)
   mpf_get_rdpe (cdpe_Im (c), mpc_Im (mc));
 }
 
+/*
+ * Split f in the sum of two doubles. The result is exact to about 106 bits
+ * as long as the exponent of f is far enough from the limits of the range
+ * of the doubles, so that the low part does not underflow.
+ */
+static int
+mpf_get_rdd (rdd_t d, mpf_t f)
+{
+  long int esp;
+  mpf_t t;
+
+  if (mpf_sgn (f) == 0)
+    {
+      rdd_set_d (d, 0.0);
+      return 1;
+    }
+
+  mpf_get_d_2exp (&esp, f);
+  if (esp > DBL_MAX_EXP - 1 || esp < DBL_MIN_EXP + 2 * DBL_MANT_DIG)
+    return 0;
+
+  mpf_init2 (t, mpf_get_prec (f));
+  d->hi = mpf_get_d (f);
+  mpf_set_d (t, d->hi);
+  mpf_sub (t, f, t);
+  d->lo = mpf_get_d (t);
+  mpf_clear (t);
+
+  /* Normalize the pair, since mpf_get_d () truncates */
+  rdd_quick_two_sum (d->hi, d->lo, &d->hi, &d->lo);
+
+  return 1;
+}
+
+static void
+mpf_set_rdd (mpf_t f, rdd_t d)
+{
+  mpf_t t;
+
+  mpf_init2 (t, DBL_MANT_DIG);
+  mpf_set_d (f, d->hi);
+  mpf_set_d (t, d->lo);
+  mpf_add (f, f, t);
+  mpf_clear (t);
+}
+
+void
+mpc_set_cdd (mpc_t mc, cdd_t c)
+{
+  mpf_set_rdd (mpc_Re (mc), cdd_Re (c));
+  mpf_set_rdd (mpc_Im (mc), cdd_Im (c));
+}
+
+int
+mpc_get_cdd (cdd_t c, mpc_t mc)
+{
+  cdd_t t;
+
+  if (!mpf_get_rdd (cdd_Re (t), mpc_Re (mc)) ||
+      !mpf_get_rdd (cdd_Im (t), mpc_Im (mc)))
+    return 0;
+
+  cdd_set (c, t);
+  return 1;
+}
+
 /***********************************************************
 **                                                        **
 ***********************************************************/
@@ -11,91 +11,163 @@
  */
 
 #include <stdlib.h>
+#include <string.h>
 #include <mps/mps.h>
 
-#define MPS_MPF_TEMP_SIZE 6
+/*
+ * Scratch arena for the temporaries of the multiprecision kernels.
+ *
+ * Every thread owns a pool of mpc_t, grouped in buckets by precision:
+ * the slots of the k-th bucket are allocated with 64 * 2^k bits and
+ * handed out with mpc_scratch_push(), which only lowers their precision
+ * with mpf_set_prec_raw() to the one requested. They must be given back
+ * in LIFO order with mpc_scratch_pop(), so that once the pool has grown
+ * to the size needed by the computation no more memory is allocated.
+ */
+#define MPC_SCRATCH_BUCKETS 40
+#define MPC_SCRATCH_BUCKET_PREC(k) (64UL << (k))
 
-struct mps_tls {
-  pthread_t thread;
-  mpf_t *data;
-  long int precision;
-  struct mps_tls *next;
+struct mpc_scratch_bucket {
+  mpc_ptr * slots;
+  int size;
+  int used;
 };
 
-typedef struct mps_tls mps_tls;
+struct mpc_scratch {
+  struct mpc_scratch_bucket buckets[MPC_SCRATCH_BUCKETS];
+
+  /* Bucket of each slot that has been handed out, in order */
+  unsigned char * stack;
+  int stack_size;
+  int stack_used;
+};
 
 static pthread_once_t once_key_created = PTHREAD_ONCE_INIT;
 static pthread_key_t key;
 
 static void
-mps_mpc_cache_cleanup (void * pointer)
+mpc_scratch_cleanup (void * pointer)
 {
-  mps_tls *ptr = pointer;
-  int i;
+  mpc_scratch * sc = pointer;
+  int i, k;
 
-  for (i = 0; i < MPS_MPF_TEMP_SIZE; i++)
-    mpf_clear (ptr->data[i]);
+  for (k = 0; k < MPC_SCRATCH_BUCKETS; k++)
+    {
+      for (i = 0; i < sc->buckets[k].size; i++)
+        {
+          mpc_set_prec_raw (sc->buckets[k].slots[i], MPC_SCRATCH_BUCKET_PREC (k));
+          mpc_clear (sc->buckets[k].slots[i]);
+          free (sc->buckets[k].slots[i]);
+        }
+      free (sc->buckets[k].slots);
+    }
 
-  free (ptr);
+  free (sc->stack);
+  free (sc);
 }
 
-static mps_tls *
-create_new_mps_tls (long int precision_needed)
+static void
+create_key (void)
 {
-  mps_tls *ptr;
-  int i;
+  pthread_key_create (&key, mpc_scratch_cleanup);
+}
 
-  ptr = mps_new (mps_tls);
+/**
+ * @brief Get the scratch arena of the calling thread, creating it if needed.
+ *
+ * The kernels that perform many operations should get the arena once and
+ * then use the <code>*_scratch</code> variants of the functions, that do not
+ * need to look it up in the thread local storage.
+ */
+mpc_scratch *
+mpc_scratch_get (void)
+{
+  mpc_scratch * sc;
 
-  ptr->data = mps_newv (mpf_t, MPS_MPF_TEMP_SIZE);
-  ptr->precision = precision_needed;
+  pthread_once (&once_key_created, create_key);
+  sc = pthread_getspecific (key);
 
-  for (i = 0; i < MPS_MPF_TEMP_SIZE; i++)
-    mpf_init2 (ptr->data[i], precision_needed);
+  if (sc == NULL)
+    {
+      sc = mps_new (mpc_scratch);
+      memset (sc, 0, sizeof (mpc_scratch));
 
-  /* Set up a destructor for this data in case the thread exits */
-  pthread_setspecific (key, ptr);
+      /* Set up a destructor for this data in case the thread exits */
+      pthread_setspecific (key, sc);
+    }
 
-  return ptr;
+  return sc;
 }
 
-static void
-adjust_mps_tls_precision (mps_tls *ptr, long int precision_needed)
+/**
+ * @brief Get a temporary mpc_t with precision prec from the arena.
+ *
+ * The value of the temporary is undefined, and its precision must not be
+ * changed with mpc_set_prec().
+ */
+mpc_ptr
+mpc_scratch_push (mpc_scratch * sc, unsigned long int prec)
 {
-  int i;
+  struct mpc_scratch_bucket * b;
+  mpc_ptr slot;
+  int i, k = 0;
+
+  prec = (prec <= 2) ? 53 : prec;
+  while (MPC_SCRATCH_BUCKET_PREC (k) < prec)
+    k++;
+
+  b = sc->buckets + k;
+  if (b->used == b->size)
+    {
+      b->size = (b->size == 0) ? 8 : 2 * b->size;
+      b->slots = mps_realloc (b->slots, b->size * sizeof (mpc_ptr));
+      for (i = b->used; i < b->size; i++)
+        {
+          b->slots[i] = mps_new (__mpc_struct);
+          mpc_init2 (b->slots[i], MPC_SCRATCH_BUCKET_PREC (k));
+        }
+    }
+
+  if (sc->stack_used == sc->stack_size)
+    {
+      sc->stack_size = (sc->stack_size == 0) ? 32 : 2 * sc->stack_size;
+      sc->stack = mps_realloc (sc->stack, sc->stack_size);
+    }
 
-  for (i = 0; i < MPS_MPF_TEMP_SIZE; i++)
-    mpf_set_prec (ptr->data[i], precision_needed);
+  slot = b->slots[b->used++];
+  sc->stack[sc->stack_used++] = k;
+  mpc_set_prec_raw (slot, prec);
 
-  ptr->precision = precision_needed;
+  return slot;
 }
 
-static void
-create_key (void)
+/**
+ * @brief Get a temporary mpf_t with precision prec from the arena.
+ *
+ * It takes a slot of the arena as mpc_scratch_push(), and must be given
+ * back in the same way.
+ */
+mpf_ptr
+mpf_scratch_push (mpc_scratch * sc, unsigned long int prec)
 {
-  pthread_key_create (&key, mps_mpc_cache_cleanup);
+  return mpc_Re (mpc_scratch_push (sc, prec));
 }
 
-static mpf_t*
-init (long int precision_needed)
+/**
+ * @brief Give back to the arena the last n temporaries obtained from it.
+ */
+void
+mpc_scratch_pop (mpc_scratch * sc, int n)
 {
-  pthread_once (&once_key_created, create_key);
-  mps_tls *ptr = pthread_getspecific (key);
-
-  /* This means that we have to create a new entry */
-  if (ptr == NULL)
-    {
-      ptr = create_new_mps_tls (precision_needed);
-    }
-  else if (ptr->precision < precision_needed || precision_needed < .25 * ptr->precision)
+  while (n-- > 0)
     {
-      adjust_mps_tls_precision (ptr, precision_needed);
-    }
+      int k = sc->stack[--sc->stack_used];
+      struct mpc_scratch_bucket * b = sc->buckets + k;
 
-  return ptr->data;
+      mpc_set_prec_raw (b->slots[--b->used], MPC_SCRATCH_BUCKET_PREC (k));
+    }
 }
 
-
 /***********************************************************
 **              functions for mpc_t                       **
 ***********************************************************/
@@ -278,11 +350,19 @@ mpc_neg (mpc_t rc, mpc_t c)
 void
 mpc_smod (mpf_t f, mpc_t c)
 {
-  mpf_t *t = init (mpf_get_prec (f));
+  mpc_smod_scratch (mpc_scratch_get (), f, c);
+}
+
+void
+mpc_smod_scratch (mpc_scratch * sc, mpf_t f, mpc_t c)
+{
+  mpf_ptr t = mpf_scratch_push (sc, mpf_get_prec (f));
 
   mpf_mul (f, mpc_Re (c), mpc_Re (c));
-  mpf_mul (*t, mpc_Im (c), mpc_Im (c));
-  mpf_add (f, f, *t);
+  mpf_mul (t, mpc_Im (c), mpc_Im (c));
+  mpf_add (f, f, t);
+
+  mpc_scratch_pop (sc, 1);
 }
 
 void
@@ -297,11 +377,7 @@ mpc_rmod (rdpe_t r, mpc_t c)
 void
 mpc_mod (mpf_t f, mpc_t c)
 {
-  mpf_t *t = init (mpf_get_prec (f));
-
-  mpf_mul (f, mpc_Re (c), mpc_Re (c));
-  mpf_mul (*t, mpc_Im (c), mpc_Im (c));
-  mpf_add (f, f, *t);
+  mpc_smod (f, c);
   mpf_sqrt (f, f);
 }
 
@@ -315,62 +391,83 @@ mpc_con (mpc_t rc, mpc_t c)
 void
 mpc_inv (mpc_t rc, mpc_t c)
 {
-  mpf_t *f = init (mpf_get_prec (mpc_Re (rc))) + 5;
+  mpc_inv_scratch (mpc_scratch_get (), rc, c);
+}
+
+void
+mpc_inv_scratch (mpc_scratch * sc, mpc_t rc, mpc_t c)
+{
+  mpf_ptr f = mpf_scratch_push (sc, mpf_get_prec (mpc_Re (rc)));
 
-  mpc_smod (*f, c);
+  mpc_smod_scratch (sc, f, c);
   mpc_con (rc, c);
-  mpf_div (mpc_Re (rc), mpc_Re (rc), *f);
-  mpf_div (mpc_Im (rc), mpc_Im (rc), *f);
+  mpf_div (mpc_Re (rc), mpc_Re (rc), f);
+  mpf_div (mpc_Im (rc), mpc_Im (rc), f);
+
+  mpc_scratch_pop (sc, 1);
 }
 
 void
 mpc_inv2 (mpc_t rc, mpc_t c)
 {
-  mpf_t *f = init (mpf_get_prec (mpc_Re (rc))) + 5;
+  mpc_scratch * sc = mpc_scratch_get ();
+  mpf_ptr f = mpf_scratch_push (sc, mpf_get_prec (mpc_Re (rc)));
 
-  mpc_smod (*f, c);
-  mpf_ui_div (*f, 1L, *f);
+  mpc_smod_scratch (sc, f, c);
+  mpf_ui_div (f, 1L, f);
   mpc_con (rc, c);
-  mpf_mul (mpc_Re (rc), mpc_Re (rc), *f);
-  mpf_mul (mpc_Im (rc), mpc_Im (rc), *f);
+  mpf_mul (mpc_Re (rc), mpc_Re (rc), f);
+  mpf_mul (mpc_Im (rc), mpc_Im (rc), f);
+
+  mpc_scratch_pop (sc, 1);
 }
 
 void
 mpc_sqr (mpc_t rc, mpc_t c)
 {
-  mpf_t *f = init (mpf_get_prec (mpc_Re (rc)));
+  mpc_sqr_scratch (mpc_scratch_get (), rc, c);
+}
 
-  mpf_mul (*f, mpc_Re (c), mpc_Im (c));
+void
+mpc_sqr_scratch (mpc_scratch * sc, mpc_t rc, mpc_t c)
+{
+  mpf_ptr f = mpf_scratch_push (sc, mpf_get_prec (mpc_Re (rc)));
+
+  mpf_mul (f, mpc_Re (c), mpc_Im (c));
   mpf_mul (mpc_Re (rc), mpc_Re (c), mpc_Re (c));
   mpf_mul (mpc_Im (rc), mpc_Im (c), mpc_Im (c));
 
   mpf_sub (mpc_Re (rc), mpc_Re (rc), mpc_Im (rc));
-  mpf_mul_2exp (mpc_Im (rc), *f, 1);
+  mpf_mul_2exp (mpc_Im (rc), f, 1);
+
+  mpc_scratch_pop (sc, 1);
 }
 
 void
 mpc_rot (mpc_t rc, mpc_t c)
 {
-  mpf_t *f = init (mpf_get_prec (mpc_Re (rc)));
+  mpc_scratch * sc = mpc_scratch_get ();
+  mpf_ptr f = mpf_scratch_push (sc, mpf_get_prec (mpc_Re (rc)));
 
-  mpf_set (*f, mpc_Re (c));
+  mpf_set (f, mpc_Re (c));
   mpf_set (mpc_Re (rc), mpc_Im (c));
-  mpf_set (mpc_Im (rc), *f);
+  mpf_set (mpc_Im (rc), f);
   mpf_neg (mpc_Re (rc), mpc_Re (rc));
+
+  mpc_scratch_pop (sc, 1);
 }
 
 void
 mpc_flip (mpc_t rc, mpc_t c)
 {
-  mpf_t f;
-
-  mpf_init2 (f, mpf_get_prec (mpc_Re (rc)));
+  mpc_scratch * sc = mpc_scratch_get ();
+  mpf_ptr f = mpf_scratch_push (sc, mpf_get_prec (mpc_Re (rc)));
 
   mpf_set (f, mpc_Re (c));
   mpf_set (mpc_Re (rc), mpc_Im (c));
   mpf_set (mpc_Im (rc), f);
 
-  mpf_clear (f);
+  mpc_scratch_pop (sc, 1);
 }
 
 /* binary functions */
@@ -430,20 +527,29 @@ mpc_ui_sub (mpc_t rc, unsigned long int r, unsigned long int i, mpc_t c)
 void
 mpc_mul (mpc_t rc, mpc_t c1, mpc_t c2)
 {
-  mpf_t *s1, *s2, *s3;
+  mpc_mul_scratch (mpc_scratch_get (), rc, c1, c2);
+}
+
+void
+mpc_mul_scratch (mpc_scratch * sc, mpc_t rc, mpc_t c1, mpc_t c2)
+{
+  long int prec = mpf_get_prec (mpc_Re (rc));
+  mpf_ptr s1, s2, s3;
 
-  s1 = init (mpf_get_prec (mpc_Re (rc)));
-  s2 = s1 + 1;
-  s3 = s2 + 1;
+  s1 = mpf_scratch_push (sc, prec);
+  s2 = mpf_scratch_push (sc, prec);
+  s3 = mpf_scratch_push (sc, prec);
 
-  mpf_sub (*s1, mpc_Re (c1), mpc_Im (c1));
-  mpf_add (*s2, mpc_Re (c2), mpc_Im (c2));
-  mpf_mul (*s1, *s1, *s2);
-  mpf_mul (*s2, mpc_Re (c1), mpc_Im (c2));
-  mpf_mul (*s3, mpc_Im (c1), mpc_Re (c2));
-  mpf_sub (mpc_Re (rc), *s1, *s2);
-  mpf_add (mpc_Re (rc), mpc_Re (rc), *s3);
-  mpf_add (mpc_Im (rc), *s2, *s3);
+  mpf_sub (s1, mpc_Re (c1), mpc_Im (c1));
+  mpf_add (s2, mpc_Re (c2), mpc_Im (c2));
+  mpf_mul (s1, s1, s2);
+  mpf_mul (s2, mpc_Re (c1), mpc_Im (c2));
+  mpf_mul (s3, mpc_Im (c1), mpc_Re (c2));
+  mpf_sub (mpc_Re (rc), s1, s2);
+  mpf_add (mpc_Re (rc), mpc_Re (rc), s3);
+  mpf_add (mpc_Im (rc), s2, s3);
+
+  mpc_scratch_pop (sc, 3);
 }
 
 void
@@ -470,14 +576,18 @@ mpc_mul_2exp (mpc_t rc, mpc_t c, unsigned long int i)
 void
 mpc_div (mpc_t rc, mpc_t c1, mpc_t c2)
 {
-  /* Find a good offset so that we don't pollute mul and inv registers */
-  mpc_t t;
+  mpc_div_scratch (mpc_scratch_get (), rc, c1, c2);
+}
 
-  mpc_init2 (t, mpf_get_prec (mpc_Re (rc)));
+void
+mpc_div_scratch (mpc_scratch * sc, mpc_t rc, mpc_t c1, mpc_t c2)
+{
+  mpc_ptr t = mpc_scratch_push (sc, mpf_get_prec (mpc_Re (rc)));
 
-  mpc_inv (t, c2);
-  mpc_mul (rc, c1, t);
-  mpc_clear (t);
+  mpc_inv_scratch (sc, t, c2);
+  mpc_mul_scratch (sc, rc, c1, t);
+
+  mpc_scratch_pop (sc, 1);
 }
 
 void
@@ -490,14 +600,13 @@ mpc_div_f (mpc_t rc, mpc_t c, mpf_t f)
 void
 mpc_f_div (mpc_t rc, mpf_t f, mpc_t c)
 {
-  mpc_t t;
-
-  mpc_init2 (t, mpf_get_prec (mpc_Re (rc)));
+  mpc_scratch * sc = mpc_scratch_get ();
+  mpc_ptr t = mpc_scratch_push (sc, mpf_get_prec (mpc_Re (rc)));
 
-  mpc_inv (t, c);
+  mpc_inv_scratch (sc, t, c);
   mpc_mul_f (rc, t, f);
 
-  mpc_clear (t);
+  mpc_scratch_pop (sc, 1);
 }
 
 void
@@ -525,14 +634,13 @@ void
 mpc_pow_si (mpc_t rc, mpc_t c, register signed long int i)
 /* rc = c^i, i integer */
 {
-  mpc_t t;
-
-  mpc_init2 (t, mpf_get_prec (mpc_Re (rc)));
+  mpc_scratch * sc = mpc_scratch_get ();
+  mpc_ptr t = mpc_scratch_push (sc, mpf_get_prec (mpc_Re (rc)));
 
   mpc_set (t, c);
   if (i < 0)
     {
-      mpc_inv_eq (t);
+      mpc_inv_scratch (sc, t, t);
       i = -i;
     }
   if (i & 1)
@@ -543,13 +651,112 @@ mpc_pow_si (mpc_t rc, mpc_t c, register signed long int i)
 
   while (i)
     {
-      mpc_sqr_eq (t);
+      mpc_sqr_scratch (sc, t, t);
       if (i & 1)
-        mpc_mul_eq (rc, t);
+        mpc_mul_scratch (sc, rc, rc, t);
       i >>= 1;                  /* divide i by 2 */
     }
 
-  mpc_clear (t);
+  mpc_scratch_pop (sc, 1);
+}
+
+/* fused functions */
+void
+mpc_fma (mpc_t rc, mpc_t c1, mpc_t c2, mpc_t c3)
+/* rc = c1 * c2 + c3 */
+{
+  mpc_fma_scratch (mpc_scratch_get (), rc, c1, c2, c3);
+}
+
+void
+mpc_fma_scratch (mpc_scratch * sc, mpc_t rc, mpc_t c1, mpc_t c2, mpc_t c3)
+{
+  long int prec = mpf_get_prec (mpc_Re (rc));
+  mpf_ptr s1, s2, s3;
+
+  s1 = mpf_scratch_push (sc, prec);
+  s2 = mpf_scratch_push (sc, prec);
+  s3 = mpf_scratch_push (sc, prec);
+
+  /* Same product as mpc_mul(), but c3 is added to the partial results
+   * before they are stored in rc, which may be any of the operands. */
+  mpf_sub (s1, mpc_Re (c1), mpc_Im (c1));
+  mpf_add (s2, mpc_Re (c2), mpc_Im (c2));
+  mpf_mul (s1, s1, s2);
+  mpf_mul (s2, mpc_Re (c1), mpc_Im (c2));
+  mpf_mul (s3, mpc_Im (c1), mpc_Re (c2));
+  mpf_sub (s1, s1, s2);
+  mpf_add (s2, s2, s3);
+  mpf_add (s1, s1, s3);
+  mpf_add (mpc_Re (rc), s1, mpc_Re (c3));
+  mpf_add (mpc_Im (rc), s2, mpc_Im (c3));
+
+  mpc_scratch_pop (sc, 3);
+}
+
+void
+mpc_horner_step (mpc_t v, mpc_t x, mpc_t a)
+/* v = v * x + a */
+{
+  mpc_fma_scratch (mpc_scratch_get (), v, v, x, a);
+}
+
+void
+mpc_horner_step_scratch (mpc_scratch * sc, mpc_t v, mpc_t x, mpc_t a)
+{
+  mpc_fma_scratch (sc, v, v, x, a);
+}
+
+int
+mpc_sum_inv_diff (mpc_t rc, mpc_t x, mpc_t y[], mpc_t a[], int n)
+/* rc = sum of a[j] / (x - y[j]) for j = 0, ..., n - 1, where a[j] = 1 if a is NULL.
+ * The index of the first y[j] equal to x is returned, leaving rc untouched,
+ * and -1 otherwise. */
+{
+  mpc_scratch * sc = mpc_scratch_get ();
+  long int prec = mpf_get_prec (mpc_Re (rc));
+  mpc_ptr d, sum;
+  mpf_ptr m, t;
+  int j, result = -1;
+
+  d = mpc_scratch_push (sc, prec);
+  sum = mpc_scratch_push (sc, prec);
+  m = mpf_scratch_push (sc, prec);
+  t = mpf_scratch_push (sc, prec);
+
+  mpc_set_ui (sum, 0U, 0U);
+  for (j = 0; j < n; j++)
+    {
+      /* a / d = a * conj(d) / |d|^2, with a single division */
+      mpc_sub (d, x, y[j]);
+      mpf_mul (m, mpc_Re (d), mpc_Re (d));
+      mpf_mul (t, mpc_Im (d), mpc_Im (d));
+      mpf_add (m, m, t);
+
+      if (mpf_sgn (m) == 0)
+        {
+          result = j;
+          break;
+        }
+
+      mpf_ui_div (m, 1U, m);
+      mpf_neg (mpc_Im (d), mpc_Im (d));
+
+      if (a)
+        mpc_mul_scratch (sc, d, a[j], d);
+
+      mpf_mul (t, mpc_Re (d), m);
+      mpf_add (mpc_Re (sum), mpc_Re (sum), t);
+      mpf_mul (t, mpc_Im (d), m);
+      mpf_add (mpc_Im (sum), mpc_Im (sum), t);
+    }
+
+  if (result < 0)
+    mpc_set (rc, sum);
+
+  mpc_scratch_pop (sc, 4);
+
+  return result;
 }
 
 /* op= style functions */
@@ -8,9 +8,143 @@
  *   Leonardo Robol <leonardo.robol@sns.it>
  */
 
+/*
+ * The determinant of H - xI, with H upper Hessenberg, is computed by compressing
+ * the last two columns of the matrix: if b is the last diagonal entry and a the
+ * one below the diagonal in the last row, the second to last column is replaced by
+ * b times itself minus a times the last one. This leaves a triangular last row
+ * and, after dropping it, a matrix of size one less with the same determinant,
+ * whose last column is stored in vec.
+ *
+ * Since the computation only involves sums and products, differentiating every
+ * step with respect to x gives the derivative of the determinant, that is needed
+ * for the Newton correction. The rounding error committed on each entry is at most
+ * 6u times the sum of the moduli of the two products, and it is propagated in the
+ * same way as the entries themselves: running this recurrence on the moduli gives
+ * an a-posteriori bound to the error on the determinant.
+ */
+
 #include <mps/mps.h>
 #include <string.h>
 
+/* The floating point version rescales the entries by a power of two when they
+ * leave this range, to avoid overflow and underflow. */
+#define MPS_HESSENBERG_SCALE_EXPONENT 256
+
+/**
+ * @brief Compute the determinant of \f$H - \lambda I\f$, where H is upper
+ * Hessenberg, together with its derivative with respect to \f$\lambda\f$
+ * and a bound to the error.
+ *
+ * The values are all scaled by the same power of two, so that the correct results are
+ * \f$det \cdot 2^{exponent}\f$, and so on.
+ *
+ * @param ctx The current mps_context
+ * @param hessenberg_matrix The hessenberg matrix whose determinant should be computed.
+ * @param shift The value of \f$\lambda\f$.
+ * @param n The size of the matrix.
+ * @param det The storage for the determinant.
+ * @param ddet The storage for the derivative, or NULL if it is not needed.
+ * @param error A bound to the absolute error on det.
+ * @param exponent The exponent of the scaling factor.
+ */
+void
+mps_fhessenberg_shifted_newton (mps_context * ctx, cplx_t * hessenberg_matrix, const cplx_t shift,
+                                size_t n, cplx_t det, cplx_t ddet, double * error,
+                                long int * exponent)
+{
+  cplx_t *vec = mps_newv (cplx_t, 2 * n);
+  cplx_t *dvec = vec + n;
+  double *evec = mps_newv (double, n);
+  const double eps = 3.0 * DBL_EPSILON;
+  int i, k;
+
+  *exponent = 0;
+
+  /* Copy the last column in vec */
+  for (i = 0; i < n; i++)
+    {
+      cplx_set (vec[i], MPS_MATRIX_ELEM (hessenberg_matrix, i, n - 1, n));
+      cplx_set (dvec[i], cplx_zero);
+      evec[i] = 0.0;
+    }
+  cplx_sub_eq (vec[n - 1], shift);
+  cplx_set_d (dvec[n - 1], -1.0, 0.0);
+  evec[n - 1] = DBL_EPSILON * cplx_mod (vec[n - 1]);
+
+  for (k = n - 1; k > 0; k--)
+    {
+      /* Compress the last two cols of the matrix */
+      cplx_t a, b, db, h, s, t;
+      double amod, bmod, eb, max = 0.0;
+
+      cplx_set (a, MPS_MATRIX_ELEM (hessenberg_matrix, k, k - 1, n));
+      cplx_set (b, vec[k]);
+      cplx_set (db, dvec[k]);
+      amod = cplx_mod (a);
+      bmod = cplx_mod (b);
+      eb = evec[k];
+
+      for (i = 0; i < k; i++)
+        {
+          double hmod;
+
+          cplx_set (h, MPS_MATRIX_ELEM (hessenberg_matrix, i, k - 1, n));
+
+          /* The last step require the extra accounting for the shifted case. */
+          if (i == k - 1)
+            cplx_sub_eq (h, shift);
+
+          hmod = cplx_mod (h);
+
+          if (ddet)
+            {
+              cplx_mul (s, h, db);
+              cplx_mul (t, dvec[i], a);
+              cplx_sub (dvec[i], s, t);
+
+              if (i == k - 1)
+                cplx_sub_eq (dvec[i], b);
+
+              max = MAX (max, fabs (cplx_Re (dvec[i])) + fabs (cplx_Im (dvec[i])));
+            }
+
+          evec[i] = hmod * eb + amod * evec[i] + eps * (hmod * bmod + cplx_mod (vec[i]) * amod);
+
+          cplx_mul (s, h, b);
+          cplx_mul (t, vec[i], a);
+          cplx_sub (vec[i], s, t);
+
+          max = MAX (max, fabs (cplx_Re (vec[i])) + fabs (cplx_Im (vec[i])) + evec[i]);
+        }
+
+      if (max > ldexp (1.0, MPS_HESSENBERG_SCALE_EXPONENT) ||
+          (max < ldexp (1.0, -MPS_HESSENBERG_SCALE_EXPONENT) && max != 0.0))
+        {
+          int e;
+
+          frexp (max, &e);
+
+          for (i = 0; i < k; i++)
+            {
+              cplx_set_d (vec[i], ldexp (cplx_Re (vec[i]), -e), ldexp (cplx_Im (vec[i]), -e));
+              cplx_set_d (dvec[i], ldexp (cplx_Re (dvec[i]), -e), ldexp (cplx_Im (dvec[i]), -e));
+              evec[i] = ldexp (evec[i], -e);
+            }
+
+          *exponent += e;
+        }
+    }
+
+  cplx_set (det, vec[0]);
+  if (ddet)
+    cplx_set (ddet, dvec[0]);
+  *error = evec[0];
+
+  free (vec);
+  free (evec);
+}
+
 /**
  * @brief This is the full implementation of the recursive determinant computation.
  *
@@ -20,8 +154,8 @@
  * @param output The storage for the result.
  */
 void
-mps_fhessenberg_determinant (mps_context * ctx, cplx_t * hessenberg_matrix, size_t n, cplx_t output, 
-			     long int * exponent)
+mps_fhessenberg_determinant (mps_context * ctx, cplx_t * hessenberg_matrix, size_t n, cplx_t output,
+                             long int * exponent)
 {
   mps_fhessenberg_shifted_determinant (ctx, hessenberg_matrix, cplx_zero, n, output, exponent);
 }
@@ -37,66 +171,108 @@ mps_fhessenberg_determinant (mps_context * ctx, cplx_t * hessenberg_matrix, size
  * @param output The storage for the result.
  */
 void
-mps_fhessenberg_shifted_determinant (mps_context * ctx, cplx_t * hessenberg_matrix, const cplx_t shift, 
-				     size_t n, cplx_t output, long int *acc_exponent)
+mps_fhessenberg_shifted_determinant (mps_context * ctx, cplx_t * hessenberg_matrix, const cplx_t shift,
+                                     size_t n, cplx_t output, long int *acc_exponent)
+{
+  double error;
+
+  mps_fhessenberg_shifted_newton (ctx, hessenberg_matrix, shift, n, output, NULL,
+                                  &error, acc_exponent);
+}
+
+/**
+ * @brief DPE version of mps_fhessenberg_shifted_newton(). No scaling is needed
+ * in this case.
+ *
+ * @param ctx The current mps_context
+ * @param hessenberg_matrix The hessenberg matrix whose determinant should be computed.
+ * @param shift The value of \f$\lambda\f$.
+ * @param n The size of the matrix.
+ * @param det The storage for the determinant.
+ * @param ddet The storage for the derivative, or NULL if it is not needed.
+ * @param error A bound to the absolute error on det.
+ */
+void
+mps_dhessenberg_shifted_newton (mps_context * ctx, cdpe_t * hessenberg_matrix, const cdpe_t shift,
+                                size_t n, cdpe_t det, cdpe_t ddet, rdpe_t error)
 {
-  cplx_t *vec = mps_newv (cplx_t, n);
-  size_t local_n = n;
-  int i, j;
-  *acc_exponent = 0;
+  cdpe_t *vec = mps_newv (cdpe_t, 2 * n);
+  cdpe_t *dvec = vec + n;
+  rdpe_t *evec = rdpe_valloc (n);
+  rdpe_t eps;
+  int i, k;
+
+  rdpe_set_d (eps, 3.0 * DBL_EPSILON);
 
   /* Copy the last column in vec */
   for (i = 0; i < n; i++)
     {
-      cplx_set (vec[i], MPS_MATRIX_ELEM (hessenberg_matrix, i, n - 1, n));
+      cdpe_set (vec[i], MPS_MATRIX_ELEM (hessenberg_matrix, i, n - 1, n));
+      cdpe_set (dvec[i], cdpe_zero);
+      rdpe_set (evec[i], rdpe_zero);
     }
-  cplx_sub_eq (vec[n-1], shift);
+  cdpe_sub_eq (vec[n - 1], shift);
+  cdpe_set_d (dvec[n - 1], -1.0, 0.0);
+  cdpe_mod (evec[n - 1], vec[n - 1]);
+  rdpe_mul_eq_d (evec[n - 1], DBL_EPSILON);
 
-  while (local_n-- > 1)
+  for (k = n - 1; k > 0; k--)
     {
       /* Compress the last two cols of the matrix */
-      cplx_t t, s;
+      cdpe_t a, b, db, h, s, t;
+      rdpe_t amod, bmod, eb, hmod, r1, r2;
 
-      for (i = 0; i < local_n - 1; i++)
+      cdpe_set (a, MPS_MATRIX_ELEM (hessenberg_matrix, k, k - 1, n));
+      cdpe_set (b, vec[k]);
+      cdpe_set (db, dvec[k]);
+      cdpe_mod (amod, a);
+      cdpe_mod (bmod, b);
+      rdpe_set (eb, evec[k]);
+
+      for (i = 0; i < k; i++)
         {
-          cplx_mul (s, MPS_MATRIX_ELEM (hessenberg_matrix, i, local_n - 1, n), 
-		    vec[local_n]);
-          cplx_mul (t, vec[i], MPS_MATRIX_ELEM (hessenberg_matrix, local_n, local_n - 1, n));
-          cplx_sub (vec[i], s, t);
+          cdpe_set (h, MPS_MATRIX_ELEM (hessenberg_matrix, i, k - 1, n));
+
+          /* The last step require the extra accounting for the shifted case. */
+          if (i == k - 1)
+            cdpe_sub_eq (h, shift);
+
+          cdpe_mod (hmod, h);
+
+          if (ddet)
+            {
+              cdpe_mul (s, h, db);
+              cdpe_mul (t, dvec[i], a);
+              cdpe_sub (dvec[i], s, t);
+
+              if (i == k - 1)
+                cdpe_sub_eq (dvec[i], b);
+            }
+
+          /* evec[i] = hmod * eb + amod * evec[i] + eps * (hmod * bmod + |vec[i]| * amod) */
+          cdpe_mod (r1, vec[i]);
+          rdpe_mul_eq (r1, amod);
+          rdpe_mul (r2, hmod, bmod);
+          rdpe_add_eq (r1, r2);
+          rdpe_mul_eq (r1, eps);
+          rdpe_mul_eq (evec[i], amod);
+          rdpe_add_eq (evec[i], r1);
+          rdpe_mul (r2, hmod, eb);
+          rdpe_add_eq (evec[i], r2);
+
+          cdpe_mul (s, h, b);
+          cdpe_mul (t, vec[i], a);
+          cdpe_sub (vec[i], s, t);
         }
-
-      /* The last step require the extra accounting for the shifted case. */
-      cplx_sub (s, MPS_MATRIX_ELEM (hessenberg_matrix, local_n - 1, local_n - 1, n), shift);
-      cplx_mul_eq (s, vec[local_n]);
-      cplx_mul (t, vec[local_n-1], MPS_MATRIX_ELEM (hessenberg_matrix, local_n, local_n - 1, n));
-      cplx_sub (vec[local_n - 1], s, t);
-
-      if (i % 50 == 0)
-	{
-	  int exponent;
-	  double max = 0.0;
-
-	  for (j = 0; j < local_n; j++)
-	    {
-	      double m = cplx_mod (vec[j]);
-	      if (m > max)
-		max = m;
-	    }
-
-	  frexp (max, &exponent);
-	  max = pow(2.0, exponent);
-	  
-	  for (j = 0; j < local_n; j++)
-	    {
-	      cplx_div_eq_d (vec[j], max);
-	    }
-
-	  *acc_exponent += exponent;
-	}
     }
 
-  cplx_set (output, *vec);
+  cdpe_set (det, vec[0]);
+  if (ddet)
+    cdpe_set (ddet, dvec[0]);
+  rdpe_set (error, evec[0]);
+
   free (vec);
+  rdpe_vfree (evec);
 }
 
 /**
@@ -124,45 +300,126 @@ mps_dhessenberg_determinant (mps_context * ctx, cdpe_t * hessenberg_matrix, size
  * @param output The storage for the result.
  */
 MPS_PRIVATE void
-mps_dhessenberg_shifted_determinant (mps_context * ctx, cdpe_t * hessenberg_matrix, const cdpe_t shift, 
-				     size_t n, cdpe_t output)
+mps_dhessenberg_shifted_determinant (mps_context * ctx, cdpe_t * hessenberg_matrix, const cdpe_t shift,
+                                     size_t n, cdpe_t output)
 {
-  cdpe_t *vec = mps_newv (cdpe_t, n);
-  size_t local_n = n;
-  int i;
+  rdpe_t error;
+
+  mps_dhessenberg_shifted_newton (ctx, hessenberg_matrix, shift, n, output, NULL, error);
+}
+
+/**
+ * @brief Multiprecision version of mps_fhessenberg_shifted_newton(). The computation
+ * is carried out with the precision of det.
+ *
+ * @param ctx The current mps_context
+ * @param hessenberg_matrix The hessenberg matrix whose determinant should be computed.
+ * @param shift The value of \f$\lambda\f$.
+ * @param n The size of the matrix.
+ * @param det The storage for the determinant.
+ * @param ddet The storage for the derivative, or NULL if it is not needed.
+ * @param error A bound to the absolute error on det.
+ */
+void
+mps_mhessenberg_shifted_newton (mps_context * ctx, mpc_t * hessenberg_matrix, mpc_t shift,
+                                size_t n, mpc_t det, mpc_t ddet, rdpe_t error)
+{
+  mpc_scratch * sc = mpc_scratch_get ();
+  long int wp = mpc_get_prec (det);
+  mpc_ptr *vec = mps_newv (mpc_ptr, 2 * n);
+  mpc_ptr *dvec = vec + n;
+  mpc_ptr b, db, h, s, t;
+  rdpe_t *evec = rdpe_valloc (n);
+  rdpe_t eps;
+  int i, k;
+
+  rdpe_set_2dl (eps, 3.0, 2 - wp);
+
+  for (i = 0; i < n; i++)
+    {
+      vec[i] = mpc_scratch_push (sc, wp);
+      dvec[i] = ddet ? mpc_scratch_push (sc, wp) : NULL;
+    }
+  b = mpc_scratch_push (sc, wp);
+  db = mpc_scratch_push (sc, wp);
+  h = mpc_scratch_push (sc, wp);
+  s = mpc_scratch_push (sc, wp);
+  t = mpc_scratch_push (sc, wp);
 
   /* Copy the last column in vec */
   for (i = 0; i < n; i++)
     {
-      cdpe_set (vec[i], MPS_MATRIX_ELEM (hessenberg_matrix, i, n - 1, n));
+      mpc_set (vec[i], MPS_MATRIX_ELEM (hessenberg_matrix, i, n - 1, n));
+      if (ddet)
+        mpc_set_ui (dvec[i], 0U, 0U);
+      rdpe_set (evec[i], rdpe_zero);
     }
-  cdpe_sub_eq (vec[n], shift);
+  mpc_sub_eq (vec[n - 1], shift);
+  if (ddet)
+    mpc_set_si (dvec[n - 1], -1, 0);
+  mpc_rmod (evec[n - 1], vec[n - 1]);
+  rdpe_mul_eq (evec[n - 1], eps);
 
-  while (local_n-- > 1)
+  for (k = n - 1; k > 0; k--)
     {
       /* Compress the last two cols of the matrix */
-      cdpe_t t, s;
+      mpc_ptr a = MPS_MATRIX_ELEM (hessenberg_matrix, k, k - 1, n);
+      rdpe_t amod, bmod, eb, hmod, r1, r2;
+
+      mpc_set (b, vec[k]);
+      if (ddet)
+        mpc_set (db, dvec[k]);
+      mpc_rmod (amod, a);
+      mpc_rmod (bmod, b);
+      rdpe_set (eb, evec[k]);
 
-      for (i = 0; i < local_n - 1; i++)
+      for (i = 0; i < k; i++)
         {
-          cdpe_mul (s, MPS_MATRIX_ELEM (hessenberg_matrix, i, local_n - 1, n), 
-		    vec[local_n]);
-          cdpe_mul (t, vec[i], MPS_MATRIX_ELEM (hessenberg_matrix, local_n, local_n - 1, n));
-          cdpe_sub (vec[i], s, t);
+          /* The last step require the extra accounting for the shifted case. */
+          if (i == k - 1)
+            mpc_sub (h, MPS_MATRIX_ELEM (hessenberg_matrix, i, k - 1, n), shift);
+          else
+            mpc_set (h, MPS_MATRIX_ELEM (hessenberg_matrix, i, k - 1, n));
+
+          mpc_rmod (hmod, h);
+
+          if (ddet)
+            {
+              mpc_mul_scratch (sc, s, h, db);
+              mpc_mul_scratch (sc, t, dvec[i], a);
+              mpc_sub (dvec[i], s, t);
+
+              if (i == k - 1)
+                mpc_sub_eq (dvec[i], b);
+            }
+
+          /* evec[i] = hmod * eb + amod * evec[i] + eps * (hmod * bmod + |vec[i]| * amod) */
+          mpc_rmod (r1, vec[i]);
+          rdpe_mul_eq (r1, amod);
+          rdpe_mul (r2, hmod, bmod);
+          rdpe_add_eq (r1, r2);
+          rdpe_mul_eq (r1, eps);
+          rdpe_mul_eq (evec[i], amod);
+          rdpe_add_eq (evec[i], r1);
+          rdpe_mul (r2, hmod, eb);
+          rdpe_add_eq (evec[i], r2);
+
+          mpc_mul_scratch (sc, s, h, b);
+          mpc_mul_scratch (sc, t, vec[i], a);
+          mpc_sub (vec[i], s, t);
         }
-
-      /* The last step require the extra accounting for the shifted case. */
-      cdpe_sub (s, MPS_MATRIX_ELEM (hessenberg_matrix, local_n - 1, local_n - 1, n), shift);
-      cdpe_mul_eq (s, vec[local_n]);
-      cdpe_mul (t, vec[local_n-1], MPS_MATRIX_ELEM (hessenberg_matrix, local_n, local_n - 1, n));
-      cdpe_sub (vec[local_n - 1], s, t);
     }
 
-  cdpe_set (output, *vec);
+  mpc_set (det, vec[0]);
+  if (ddet)
+    mpc_set (ddet, dvec[0]);
+  rdpe_set (error, evec[0]);
+
+  mpc_scratch_pop (sc, (ddet ? 2 : 1) * n + 5);
   free (vec);
+  rdpe_vfree (evec);
 }
 
-
 /**
  * @brief This is the full implementation of the recursive determinant computation.
  *
@@ -200,87 +457,5 @@ mps_mhessenberg_determinant (mps_context * ctx, mpc_t * hessenberg_matrix, size_
 MPS_PRIVATE void
 mps_mhessenberg_shifted_determinant (mps_context * ctx, mpc_t * hessenberg_matrix, mpc_t shift, size_t n, mpc_t output, rdpe_t error)
 {
-  mpc_t *matrix = mps_newv (mpc_t, n * n);
-  size_t local_n = n;
-  long int wp = mpc_get_prec (output);
-  mps_boolean shifted = !mpc_eq_zero (shift);
-  int i, j;
-  mpc_t t, s;
-  rdpe_t mod, epsilon;
-
-  rdpe_t *verrors = mps_newv (rdpe_t, n);
-
-  memset (verrors, 0, sizeof(rdpe_t) * n);
-
-  /* Init the elements in the matrix */
-  mpc_init2 (t, wp);
-  mpc_init2 (s, wp);
-  mpc_vinit2 (matrix, n * n, wp);
-
-  rdpe_set_2dl (epsilon, 1.0, 1 - wp);
-  rdpe_set (error, rdpe_one);
-
-  /* Make a copy of the original matrix and subtract the shift, if any*/
-  for (i = 0; i < n; i++)
-    {
-      for (j = 0; j < n; j++)
-        {
-          if ((i == j) && shifted)
-            mpc_sub (MPS_MATRIX_ELEM (matrix, i, j, n),
-                     MPS_MATRIX_ELEM (hessenberg_matrix, i, j, n),
-                     shift);
-          else
-            mpc_set (MPS_MATRIX_ELEM (matrix, i, j, n),
-                     MPS_MATRIX_ELEM (hessenberg_matrix, i, j, n));
-        }
-    }
-
-  while (local_n-- > 1)
-    {
-      /* Recursively compress the last two cols of the matrix */
-      rdpe_t err_a_bottom, err_b_bottom, tmp;
-
-      mpc_rmod (err_a_bottom, MPS_MATRIX_ELEM (matrix, local_n, local_n - 1, n));
-      mpc_rmod (err_b_bottom, MPS_MATRIX_ELEM (matrix, local_n, local_n, n));
-
-      rdpe_mul (tmp, err_b_bottom, epsilon);
-      rdpe_add_eq (verrors[local_n], tmp);
-
-      for (i = 0; i < local_n; i++)
-        {
-          rdpe_t err_a, err_b;
-
-          mpc_rmod (err_a, MPS_MATRIX_ELEM (matrix, i, local_n - 1, n));
-          mpc_rmod (err_b, MPS_MATRIX_ELEM (matrix, i, local_n, n));
-
-          rdpe_mul_eq (err_a, verrors[local_n]);
-
-          rdpe_mul_eq (err_b, epsilon);
-          rdpe_add_eq (err_b, verrors[i]);
-          rdpe_mul_eq (err_b, err_a_bottom);
-
-          mpc_mul (s, MPS_MATRIX_ELEM (matrix, i, local_n - 1, n),
-                   MPS_MATRIX_ELEM (matrix, local_n, local_n, n));
-          mpc_mul (t, MPS_MATRIX_ELEM (matrix, i, local_n, n),
-                   MPS_MATRIX_ELEM (matrix, local_n, local_n - 1, n));
-          mpc_sub (MPS_MATRIX_ELEM (matrix, i, local_n - 1, n), s, t);
-
-          mpc_rmod (mod, MPS_MATRIX_ELEM (matrix, i, local_n - 1, n));
-          rdpe_mul_eq (mod, epsilon);
-
-          rdpe_add_eq (verrors[i], mod);
-          rdpe_add_eq (verrors[i], err_a);
-          rdpe_add_eq (verrors[i], err_b);
-        }
-    }
-
-  rdpe_set (error, verrors[0]);
-
-  mpc_set (output, *matrix);
-
-  mpc_vclear (matrix, n * n);
-  free (matrix);
-
-  mpc_clear (t);
-  mpc_clear (s);
+  mps_mhessenberg_shifted_newton (ctx, hessenberg_matrix, shift, n, output, NULL, error);
 }
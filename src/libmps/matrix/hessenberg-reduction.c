@@ -0,0 +1,93 @@
+/*
+ * This file is part of MPSolve 3.1.5
+ *
+ * Copyright (C) 2001-2015, Dipartimento di Matematica "L. Tonelli", Pisa.
+ * License: http://www.gnu.org/licenses/gpl.html GPL version 3 or higher
+ *
+ * Authors:
+ *   Leonardo Robol <leonardo.robol@sns.it>
+ */
+
+#include <mps/mps.h>
+
+/**
+ * @brief Reduce a matrix to upper Hessenberg form with a sequence of
+ * stabilized elementary similarity transformations.
+ *
+ * For every column k, the entry of largest modulus below the diagonal is
+ * moved to the subdiagonal by exchanging two rows and the corresponding
+ * columns, and it is used as a pivot to annihilate the entries below it. Every
+ * multiplier has modulus at most one, so the reduction is stable in practice,
+ * and it is cheaper than the one based on Householder reflectors.
+ *
+ * The computation is carried out with the precision of the entries of the
+ * matrix.
+ *
+ * @param ctx The current mps_context.
+ * @param matrix The matrix to reduce, stored in row-major order. It is overwritten
+ * with its Hessenberg form.
+ * @param n The size of the matrix.
+ */
+void
+mps_mhessenberg_reduce (mps_context * ctx, mpc_t * matrix, size_t n)
+{
+  mpc_scratch * sc = mpc_scratch_get ();
+  long int wp = mpc_get_prec (matrix[0]);
+  mpc_ptr mult = mpc_scratch_push (sc, wp);
+  mpc_ptr t = mpc_scratch_push (sc, wp);
+  rdpe_t max, mod;
+  int i, j, k, p;
+
+  for (k = 0; k + 2 < n; k++)
+    {
+      /* Look for the pivot in the k-th column */
+      p = k + 1;
+      mpc_rmod (max, MPS_MATRIX_ELEM (matrix, p, k, n));
+      for (i = k + 2; i < n; i++)
+        {
+          mpc_rmod (mod, MPS_MATRIX_ELEM (matrix, i, k, n));
+          if (rdpe_gt (mod, max))
+            {
+              rdpe_set (max, mod);
+              p = i;
+            }
+        }
+
+      if (rdpe_eq (max, rdpe_zero))
+        continue;
+
+      if (p != k + 1)
+        {
+          for (j = k; j < n; j++)
+            mpc_swap (MPS_MATRIX_ELEM (matrix, p, j, n), MPS_MATRIX_ELEM (matrix, k + 1, j, n));
+          for (i = 0; i < n; i++)
+            mpc_swap (MPS_MATRIX_ELEM (matrix, i, p, n), MPS_MATRIX_ELEM (matrix, i, k + 1, n));
+        }
+
+      for (i = k + 2; i < n; i++)
+        {
+          if (mpc_eq_zero (MPS_MATRIX_ELEM (matrix, i, k, n)))
+            continue;
+
+          mpc_div_scratch (sc, mult, MPS_MATRIX_ELEM (matrix, i, k, n),
+                           MPS_MATRIX_ELEM (matrix, k + 1, k, n));
+          mpc_set_ui (MPS_MATRIX_ELEM (matrix, i, k, n), 0U, 0U);
+
+          /* Subtract mult times the (k+1)-th row from the i-th one... */
+          for (j = k + 1; j < n; j++)
+            {
+              mpc_mul_scratch (sc, t, mult, MPS_MATRIX_ELEM (matrix, k + 1, j, n));
+              mpc_sub_eq (MPS_MATRIX_ELEM (matrix, i, j, n), t);
+            }
+
+          /* ...and add mult times the i-th column to the (k+1)-th one. */
+          for (j = 0; j < n; j++)
+            {
+              mpc_mul_scratch (sc, t, mult, MPS_MATRIX_ELEM (matrix, j, i, n));
+              mpc_add_eq (MPS_MATRIX_ELEM (matrix, j, k + 1, n), t);
+            }
+        }
+    }
+
+  mpc_scratch_pop (sc, 2);
+}
@@ -12,10 +12,39 @@
 
 
 #include <mps/mps.h>
+#include <mps/private/mpcn.h>
 
 MPS_PRIVATE void
 mps_mhorner_sparse (mps_context * s, mps_monomial_poly * p, mpc_t x, mpc_t value);
 
+/*
+ * Dense Horner scheme carried out with the kernels with n limbs of
+ * mpcn.h.
+ */
+MPS_MPCN_INLINE void
+mps_mhorner_n (const int n, mps_monomial_poly * p, mpc_t x, mpc_t value)
+{
+  int j;
+  mps_mpcn_t v, nx, a;
+
+  mps_mpcn_set_mpc (n, nx, x);
+
+  mps_with_lock (p->mfpc_mutex[MPS_POLYNOMIAL (p)->degree],
+                 mps_mpcn_set_mpc (n, v, p->mfpc[MPS_POLYNOMIAL (p)->degree]);
+                 );
+
+  for (j = MPS_POLYNOMIAL (p)->degree - 1; j >= 0; j--)
+    {
+      pthread_mutex_lock (&p->mfpc_mutex[j]);
+      mps_mpcn_set_mpc (n, a, p->mfpc[j]);
+      pthread_mutex_unlock (&p->mfpc_mutex[j]);
+
+      mps_mpcn_horner_step (n, v, nx, a);
+    }
+
+  mps_mpcn_get_mpc (n, value, v);
+}
+
 /**
  * @brief Compute the value of the polynomial <code>p</code> in the point <code>x</code>
  * and save it in <code>value</code>. If you need a bound to the relative error, try
@@ -29,26 +58,44 @@ mps_mhorner_sparse (mps_context * s, mps_monomial_poly * p, mpc_t x, mpc_t value
 MPS_PRIVATE void
 mps_mhorner (mps_context * s, mps_monomial_poly * p, mpc_t x, mpc_t value)
 {
+  mpc_scratch * sc;
   int j;
 
   if (MPS_DENSITY_IS_SPARSE (s->active_poly->density))
     {
       mps_mhorner_sparse (s, p, x, value);
+      return;
     }
-  else
+
+  /* Use the kernels with a fixed number of limbs if the precision
+   * is small enough. */
+  switch (mps_mpcn_limbs (mpc_get_prec (value)))
     {
+    case 2:
+      mps_mhorner_n (2, p, x, value);
+      break;
+
+    case 4:
+      mps_mhorner_n (4, p, x, value);
+      break;
+
+    case 8:
+      mps_mhorner_n (8, p, x, value);
+      break;
+
+    default:
+      sc = mpc_scratch_get ();
       mps_with_lock (p->mfpc_mutex[MPS_POLYNOMIAL (p)->degree],
                      mpc_set (value, p->mfpc[MPS_POLYNOMIAL (p)->degree]);
                      );
 
       for (j = MPS_POLYNOMIAL (p)->degree - 1; j >= 0; j--)
         {
-          mpc_mul_eq (value, x);
-
           pthread_mutex_lock (&p->mfpc_mutex[j]);
-          mpc_add_eq (value, p->mfpc[j]);
+          mpc_horner_step_scratch (sc, value, x, p->mfpc[j]);
           pthread_mutex_unlock (&p->mfpc_mutex[j]);
         }
+      break;
     }
 }
 
@@ -136,7 +183,8 @@ MPS_PRIVATE void
 mps_mhorner_with_error (mps_context * s, mps_monomial_poly * p, mpc_t x, mpc_t value, rdpe_t relative_error, long int wp)
 {
   int j, my_wp;
-  mpc_t ss;
+  mpc_scratch * sc = mpc_scratch_get ();
+  mpc_ptr ss;
 
   cdpe_t cdtmp;
   rdpe_t r_ss, r_value, pol_on_ss;
@@ -150,8 +198,8 @@ mps_mhorner_with_error (mps_context * s, mps_monomial_poly * p, mpc_t x, mpc_t v
   /* Set up precision related variables */
   rdpe_set_2dl (my_eps, 0.5, -my_wp);
 
-  /* Init multiprecision temporary values */
-  mpc_init2 (ss, my_wp);
+  /* Get the multiprecision temporary values from the scratch arena */
+  ss = mpc_scratch_push (sc, my_wp);
 
   rdpe_set (relative_error, rdpe_zero);
 
@@ -159,8 +207,7 @@ mps_mhorner_with_error (mps_context * s, mps_monomial_poly * p, mpc_t x, mpc_t v
   for (j = MPS_POLYNOMIAL (p)->degree - 1; j >= 0; j--)
     {
       /* Normal horner computation */
-      mpc_mul (ss, value, x);
-      mpc_add_eq (ss, p->mfpc[j]);
+      mpc_fma_scratch (sc, ss, value, x, p->mfpc[j]);
 
       /* Error estimate */
       mpc_get_cdpe (cdtmp, ss);
@@ -181,7 +228,7 @@ mps_mhorner_with_error (mps_context * s, mps_monomial_poly * p, mpc_t x, mpc_t v
       mpc_set (value, ss);
     }
 
-  mpc_clear (ss);
+  mpc_scratch_pop (sc, 1);
 }
 
 /**
@@ -380,3 +427,375 @@ mps_fhorner_with_error (mps_context * s, mps_monomial_poly * p, cplx_t x, cplx_t
 
   *error *= DBL_EPSILON;
 }
+
+/**
+ * @brief Evaluate the polynomial p in the point x in double-double arithmetic,
+ * using the coefficients computed by mps_monomial_poly_update_dd_coefficients().
+ *
+ * @param s The <code>mps_context</code> of the computation.
+ * @param p The <code>mps_monomial_poly</code> to evaluate.
+ * @param x The point where the polynomial will be evaluated.
+ * @param value The value computed by the function.
+ */
+void
+mps_ddhorner (mps_context * s, mps_monomial_poly * p, cdd_t x, cdd_t value)
+{
+  int j;
+
+  cdd_set (value, p->ddpc[MPS_POLYNOMIAL (p)->degree]);
+  for (j = MPS_POLYNOMIAL (p)->degree - 1; j >= 0; j--)
+    {
+      cdd_mul (value, value, x);
+      cdd_add (value, value, p->ddpc[j]);
+    }
+}
+
+/**
+ * @brief Double-double version of mps_fhorner_with_error().
+ */
+void
+mps_ddhorner_with_error (mps_context * s, mps_monomial_poly * p, cdd_t x, cdd_t value, double * error)
+{
+  int j;
+  double ax = cdd_mod (x);
+
+  mps_ddhorner (s, p, x, value);
+
+  *error = cdd_mod_bound (p->ddpc[MPS_POLYNOMIAL (p)->degree]);
+  for (j = MPS_POLYNOMIAL (p)->degree - 1; j >= 0; j--)
+    {
+      *error = *error * ax + cdd_mod_bound (p->ddpc[j]);
+    }
+
+  *error *= ldexp (1.0, -MPS_DD_PRECISION);
+}
+
+/*
+ * The error of the compensated Horner scheme on a polynomial of degree n
+ * is bounded by DBL_EPSILON |p(x)| + c * ap(|x|), where ap has the moduli
+ * of the coefficients of p and c is the value returned by this function.
+ * This is a conservative version of the bound of Graillat and
+ * Menissier-Morain for the complex compensated Horner scheme, plus the
+ * error on the coefficients if they are not exact.
+ */
+static double
+mps_compensated_error_factor (int n, mps_boolean exact)
+{
+  double u = DBL_EPSILON / 2;
+  double g = (4 * n + 2) * u / (1 - (4 * n + 2) * u);
+
+  return (4 * g * g + (exact ? 0 : u)) * (1 + g);
+}
+
+/**
+ * @brief Evaluate the polynomial p in the point x with the compensated
+ * Horner scheme, and give also a bound to the absolute error of the
+ * computation.
+ *
+ * The rounding errors of every product and sum of the Horner scheme are
+ * computed exactly with the error free transformations TwoProd and TwoSum,
+ * and then accumulated in a second Horner scheme that is added to the result
+ * at the end. The computed value is as accurate as if it was computed in
+ * twice the working precision and then rounded, so apart from the final
+ * rounding its error bound is about \f$n u\f$ times smaller than the one
+ * of mps_fhorner_with_error().
+ *
+ * @param s The <code>mps_context</code> of the computation.
+ * @param p The <code>mps_monomial_poly</code> to evaluate.
+ * @param x The point where the polynomial will be evaluated.
+ * @param reversed If true the coefficients are taken in reverse order, i.e.,
+ * the reversed polynomial \f$x^n p(1/x)\f$ is evaluated.
+ * @param value The value computed by the function.
+ * @param error A pointer to the location when an upper bound to the absolute
+ * error of the computation will be stored.
+ */
+void
+mps_fhorner_compensated (mps_context * s, mps_monomial_poly * p, cplx_t x, mps_boolean reversed,
+                         cplx_t value, double * error)
+{
+  int n = MPS_POLYNOMIAL (p)->degree;
+  int i, k;
+  double xr = cplx_Re (x), xi = cplx_Im (x), ax = cplx_mod (x);
+  double vr, vi, ap;
+  double p1, e1, p2, e2, p3, e3, p4, e4, sr, e5, si, e6, e7, e8;
+  cplx_t acc, term;
+
+  k = reversed ? 0 : n;
+  vr = cplx_Re (p->fpc[k]);
+  vi = cplx_Im (p->fpc[k]);
+  ap = p->fap[k];
+  cplx_set (acc, cplx_zero);
+
+  for (i = n - 1; i >= 0; i--)
+    {
+      k = reversed ? n - i : i;
+
+      /* v * x = (sr + e1 - e2 + e5) + (si + e3 + e4 + e6) I */
+      rdd_two_prod (vr, xr, &p1, &e1);
+      rdd_two_prod (vi, xi, &p2, &e2);
+      rdd_two_prod (vr, xi, &p3, &e3);
+      rdd_two_prod (vi, xr, &p4, &e4);
+      rdd_two_sum (p1, -p2, &sr, &e5);
+      rdd_two_sum (p3, p4, &si, &e6);
+
+      /* v * x + a_k */
+      rdd_two_sum (sr, cplx_Re (p->fpc[k]), &vr, &e7);
+      rdd_two_sum (si, cplx_Im (p->fpc[k]), &vi, &e8);
+
+      /* Accumulate the errors */
+      cplx_set_d (term, e1 - e2 + e5 + e7, e3 + e4 + e6 + e8);
+      cplx_mul_eq (acc, x);
+      cplx_add_eq (acc, term);
+
+      ap = ap * ax + p->fap[k];
+    }
+
+  cplx_set_d (value, vr + cplx_Re (acc), vi + cplx_Im (acc));
+  *error = DBL_EPSILON * cplx_mod (value) + mps_compensated_error_factor (n, p->dpc_exact) * ap;
+}
+
+/*
+ * DPE versions of the error free transformations. The operands are scaled
+ * to a common exponent, so that TwoSum and TwoProd can be applied to the
+ * mantissas.
+ */
+static void
+mps_rdpe_two_prod (const rdpe_t a, const rdpe_t b, rdpe_t p, rdpe_t e)
+{
+  double pm, em;
+
+  rdd_two_prod (rdpe_Mnt (a), rdpe_Mnt (b), &pm, &em);
+  rdpe_set_2dl (p, pm, rdpe_Esp (a) + rdpe_Esp (b));
+  rdpe_set_2dl (e, em, rdpe_Esp (a) + rdpe_Esp (b));
+}
+
+static void
+mps_rdpe_two_sum (const rdpe_t a, const rdpe_t b, rdpe_t s, rdpe_t e)
+{
+  long int ea = rdpe_Esp (a), eb = rdpe_Esp (b), es;
+  double sm, em;
+
+  /* A zero has exponent 0, so it must be checked before the exponents
+   * are compared. If they are far apart the sum is exactly represented
+   * by the two addends. */
+  if (rdpe_Mnt (b) == 0 || (rdpe_Mnt (a) != 0 && ea - eb > 2 * DBL_MANT_DIG))
+    {
+      rdpe_set (s, a);
+      rdpe_set (e, b);
+      return;
+    }
+  if (rdpe_Mnt (a) == 0 || eb - ea > 2 * DBL_MANT_DIG)
+    {
+      rdpe_set (s, b);
+      rdpe_set (e, a);
+      return;
+    }
+
+  es = MAX (ea, eb);
+  rdd_two_sum (ldexp (rdpe_Mnt (a), (int)(ea - es)), ldexp (rdpe_Mnt (b), (int)(eb - es)),
+               &sm, &em);
+  rdpe_set_2dl (s, sm, es);
+  rdpe_set_2dl (e, em, es);
+}
+
+/**
+ * @brief DPE version of mps_fhorner_compensated().
+ *
+ * @param s The <code>mps_context</code> of the computation.
+ * @param p The <code>mps_monomial_poly</code> to evaluate.
+ * @param x The point where the polynomial will be evaluated.
+ * @param value The value computed by the function.
+ * @param error An upper bound to the absolute error of the computation.
+ */
+void
+mps_dhorner_compensated (mps_context * s, mps_monomial_poly * p, cdpe_t x,
+                         cdpe_t value, rdpe_t error)
+{
+  int n = MPS_POLYNOMIAL (p)->degree;
+  int i;
+  rdpe_t ax, ap, p1, e1, p2, e2, p3, e3, p4, e4, e5, e6, e7, e8, sr, si, rtmp;
+  cdpe_t v, acc, term;
+
+  cdpe_mod (ax, x);
+  cdpe_set (v, p->dpc[n]);
+  rdpe_set (ap, p->dap[n]);
+  cdpe_set (acc, cdpe_zero);
+
+  for (i = n - 1; i >= 0; i--)
+    {
+      mps_rdpe_two_prod (cdpe_Re (v), cdpe_Re (x), p1, e1);
+      mps_rdpe_two_prod (cdpe_Im (v), cdpe_Im (x), p2, e2);
+      mps_rdpe_two_prod (cdpe_Re (v), cdpe_Im (x), p3, e3);
+      mps_rdpe_two_prod (cdpe_Im (v), cdpe_Re (x), p4, e4);
+      rdpe_neg_eq (p2);
+      mps_rdpe_two_sum (p1, p2, sr, e5);
+      mps_rdpe_two_sum (p3, p4, si, e6);
+
+      mps_rdpe_two_sum (sr, cdpe_Re (p->dpc[i]), cdpe_Re (v), e7);
+      mps_rdpe_two_sum (si, cdpe_Im (p->dpc[i]), cdpe_Im (v), e8);
+
+      rdpe_sub (cdpe_Re (term), e1, e2);
+      rdpe_add_eq (cdpe_Re (term), e5);
+      rdpe_add_eq (cdpe_Re (term), e7);
+      rdpe_add (cdpe_Im (term), e3, e4);
+      rdpe_add_eq (cdpe_Im (term), e6);
+      rdpe_add_eq (cdpe_Im (term), e8);
+      cdpe_mul_eq (acc, x);
+      cdpe_add_eq (acc, term);
+
+      rdpe_mul_eq (ap, ax);
+      rdpe_add_eq (ap, p->dap[i]);
+    }
+
+  cdpe_add (value, v, acc);
+
+  cdpe_mod (error, value);
+  rdpe_mul_eq_d (error, DBL_EPSILON);
+  rdpe_mul_d (rtmp, ap, mps_compensated_error_factor (n, p->dpc_exact));
+  rdpe_add_eq (error, rtmp);
+}
+
+/**
+ * @brief Evaluate the polynomial p, and the quantities needed by the Newton
+ * correction, at a block of points with a single pass on the coefficients.
+ *
+ * The points are stored in separate arrays for the real and imaginary parts,
+ * so that the inner loop runs on all of them at once and can be carried out
+ * with vector instructions. The operations performed for every point are the
+ * same, and in the same order, of mps_fnewton().
+ *
+ * @param s The <code>mps_context</code> of the computation.
+ * @param p The <code>mps_monomial_poly</code> to evaluate.
+ * @param m The number of points, at most <code>MPS_HORNER_BLOCK_SIZE</code>.
+ * @param x The points where the polynomial will be evaluated.
+ * @param ax The moduli of the points.
+ * @param reversed If true the coefficients are taken in reverse order, i.e.,
+ * the reversed polynomial \f$x^n p(1/x)\f$ is evaluated.
+ * @param value The values of the polynomial.
+ * @param derivative The values of the derivative, computed alongside with
+ * the polynomial by Horner's rule.
+ * @param apol The values of the polynomial with coefficients equal to the
+ * moduli of the ones of p at the moduli of the points, that are needed to
+ * bound the error of the evaluation.
+ */
+MPS_PRIVATE void
+mps_fhorner_block (mps_context * s, mps_monomial_poly * p, int m, cplx_t * x, double * ax,
+                   mps_boolean reversed, cplx_t * value, cplx_t * derivative, double * apol)
+{
+  double xr[MPS_HORNER_BLOCK_SIZE], xi[MPS_HORNER_BLOCK_SIZE];
+  double pr[MPS_HORNER_BLOCK_SIZE], pi[MPS_HORNER_BLOCK_SIZE];
+  double dr[MPS_HORNER_BLOCK_SIZE], di[MPS_HORNER_BLOCK_SIZE];
+  double a[MPS_HORNER_BLOCK_SIZE], az[MPS_HORNER_BLOCK_SIZE];
+  double cr, ci, ca, tr, ti;
+  cplx_t * fpc = p->fpc;
+  double * fap = p->fap;
+  int n = MPS_POLYNOMIAL (p)->degree;
+  int i, k, l;
+
+  k = reversed ? 0 : n;
+  for (l = 0; l < m; l++)
+    {
+      xr[l] = cplx_Re (x[l]);
+      xi[l] = cplx_Im (x[l]);
+      az[l] = ax[l];
+      pr[l] = dr[l] = cplx_Re (fpc[k]);
+      pi[l] = di[l] = cplx_Im (fpc[k]);
+      a[l] = fap[k];
+    }
+
+  for (i = n - 1; i > 0; i--)
+    {
+      k = reversed ? n - i : i;
+      cr = cplx_Re (fpc[k]);
+      ci = cplx_Im (fpc[k]);
+      ca = fap[k];
+
+      for (l = 0; l < m; l++)
+        {
+          tr = pr[l] * xr[l] - pi[l] * xi[l];
+          ti = pi[l] * xr[l] + pr[l] * xi[l];
+          pr[l] = tr + cr;
+          pi[l] = ti + ci;
+
+          tr = dr[l] * xr[l] - di[l] * xi[l];
+          ti = di[l] * xr[l] + dr[l] * xi[l];
+          dr[l] = tr + pr[l];
+          di[l] = ti + pi[l];
+
+          a[l] = a[l] * az[l] + ca;
+        }
+    }
+
+  if (n > 0)
+    {
+      k = reversed ? n : 0;
+      cr = cplx_Re (fpc[k]);
+      ci = cplx_Im (fpc[k]);
+      ca = fap[k];
+
+      for (l = 0; l < m; l++)
+        {
+          tr = pr[l] * xr[l] - pi[l] * xi[l];
+          ti = pi[l] * xr[l] + pr[l] * xi[l];
+          pr[l] = tr + cr;
+          pi[l] = ti + ci;
+
+          a[l] = a[l] * az[l] + ca;
+        }
+    }
+
+  for (l = 0; l < m; l++)
+    {
+      cplx_set_d (value[l], pr[l], pi[l]);
+      cplx_set_d (derivative[l], dr[l], di[l]);
+      apol[l] = a[l];
+    }
+}
+
+/**
+ * @brief DPE version of mps_fhorner_block(), used by mps_dnewton().
+ *
+ * The coefficients are read once for all the points of the block. Only the
+ * direct order of the coefficients is available, since the DPE Newton
+ * correction does not need the reversed polynomial.
+ */
+MPS_PRIVATE void
+mps_dhorner_block (mps_context * s, mps_monomial_poly * p, int m, cdpe_t * x, rdpe_t * ax,
+                   cdpe_t * value, cdpe_t * derivative, rdpe_t * apol)
+{
+  cdpe_t * dpc = p->dpc;
+  rdpe_t * dap = p->dap;
+  int n = MPS_POLYNOMIAL (p)->degree;
+  cdpe_t tmp;
+  rdpe_t rtmp;
+  int i, l;
+
+  for (l = 0; l < m; l++)
+    {
+      cdpe_set (value[l], dpc[n]);
+      cdpe_set (derivative[l], dpc[n]);
+      rdpe_set (apol[l], dap[n]);
+    }
+
+  for (i = n - 1; i > 0; i--)
+    for (l = 0; l < m; l++)
+      {
+        cdpe_mul (tmp, value[l], x[l]);
+        cdpe_add (value[l], tmp, dpc[i]);
+        cdpe_mul (tmp, derivative[l], x[l]);
+        cdpe_add (derivative[l], tmp, value[l]);
+
+        rdpe_mul (rtmp, apol[l], ax[l]);
+        rdpe_add (apol[l], rtmp, dap[i]);
+      }
+
+  if (n > 0)
+    for (l = 0; l < m; l++)
+      {
+        cdpe_mul (tmp, value[l], x[l]);
+        cdpe_add (value[l], tmp, dpc[0]);
+
+        rdpe_mul (rtmp, apol[l], ax[l]);
+        rdpe_add (apol[l], rtmp, dap[0]);
+      }
+}
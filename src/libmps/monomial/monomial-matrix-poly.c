@@ -8,21 +8,36 @@
  *   Leonardo Robol <leonardo.robol@sns.it>
  */
 
+/*
+ * The eigenvalues of P(x) = P_0 + x P_1 + ... + x^n P_n are the ones of the
+ * block companion matrix C of the monic polynomial P_n^{-1} P(x), and
+ * det(xI - C) = det P(x) / det P_n. The matrix C is reduced once to upper
+ * Hessenberg form H, at the current precision, so that every evaluation
+ * of the determinant only requires O(N^2) operations, where N = nm is
+ * the size of H.
+ */
+
 #include <mps/mps.h>
 #include <string.h>
 
+/* Precision used for the first reduction, from which the floating point
+ * and DPE versions of the Hessenberg matrix are obtained. */
+#define MPS_MONOMIAL_MATRIX_POLY_INITIAL_PREC (2 * DBL_MANT_DIG)
+
 mps_monomial_matrix_poly*
 mps_monomial_matrix_poly_new (mps_context * ctx, int degree, int m, mps_boolean monic)
 {
   mps_monomial_matrix_poly * poly = mps_new (mps_monomial_matrix_poly);
+  int n = degree * m;
 
-  MPS_POLYNOMIAL (poly)->degree = degree * m;
+  MPS_POLYNOMIAL (poly)->degree = n;
   mps_polynomial_init (ctx, MPS_POLYNOMIAL (poly));
 
   /* Matrix polynomial specific fields */
   poly->monic = monic;
   poly->m = m;
   poly->degree = degree;
+  poly->flags = 0;
 
   /* Allocation of the necessary memory to hold all the matrices. */
   poly->P = mps_newv (cplx_t, poly->m * poly->m * (degree + 1));
@@ -34,15 +49,31 @@ mps_monomial_matrix_poly_new (mps_context * ctx, int degree, int m, mps_boolean
   mpq_vinit (poly->mpqPr, poly->m * poly->m * (degree + 1));
   mpq_vinit (poly->mpqPi, poly->m * poly->m * (degree + 1));
 
+  /* The Hessenberg matrices are allocated on the first call to
+   * mps_monomial_matrix_poly_raise_data (), since they may be large. */
+  poly->db.active = 1;
+  poly->db.mH1 = poly->db.mH2 = NULL;
+  poly->mH = NULL;
+  poly->fH = NULL;
+  poly->dH = NULL;
+  poly->prec = 0;
+  poly->singular = false;
+  pthread_mutex_init (&poly->regenerating, NULL);
+
   MPS_POLYNOMIAL (poly)->type_name = "mps_monomial_matrix_poly";
-  MPS_POLYNOMIAL (poly)->thread_safe = false;
+  MPS_POLYNOMIAL (poly)->thread_safe = true;
 
   MPS_POLYNOMIAL (poly)->structure = MPS_STRUCTURE_UNKNOWN;
 
   /* Setup the overloaded methods for our matrix polynomial */
   MPS_POLYNOMIAL (poly)->free = mps_monomial_matrix_poly_free;
   MPS_POLYNOMIAL (poly)->raise_data = mps_monomial_matrix_poly_raise_data;
+  MPS_POLYNOMIAL (poly)->feval = mps_monomial_matrix_poly_feval;
+  MPS_POLYNOMIAL (poly)->deval = mps_monomial_matrix_poly_deval;
   MPS_POLYNOMIAL (poly)->meval = mps_monomial_matrix_poly_meval;
+  MPS_POLYNOMIAL (poly)->fnewton = mps_monomial_matrix_poly_fnewton;
+  MPS_POLYNOMIAL (poly)->dnewton = mps_monomial_matrix_poly_dnewton;
+  MPS_POLYNOMIAL (poly)->mnewton = mps_monomial_matrix_poly_mnewton;
 
   return poly;
 }
@@ -51,18 +82,32 @@ void
 mps_monomial_matrix_poly_free (mps_context * ctx, mps_polynomial * poly)
 {
   mps_monomial_matrix_poly * mpoly = MPS_MONOMIAL_MATRIX_POLY (poly);
+  size_t n_elems = mpoly->m * mpoly->m * (mpoly->degree + 1);
+  size_t n = poly->degree;
 
   free (mpoly->P);
 
-  mpc_vclear (mpoly->mP, mpoly->m * (poly->degree + mpoly->m));
+  mpc_vclear (mpoly->mP, n_elems);
   free (mpoly->mP);
 
-  mpq_vclear (mpoly->mpqPr, mpoly->m * (poly->degree + mpoly->m));
+  mpq_vclear (mpoly->mpqPr, n_elems);
   free (mpoly->mpqPr);
 
-  mpq_vclear (mpoly->mpqPi, mpoly->m * (poly->degree + mpoly->m));
+  mpq_vclear (mpoly->mpqPi, n_elems);
   free (mpoly->mpqPi);
 
+  if (mpoly->db.mH1)
+    {
+      mpc_vclear (mpoly->db.mH1, n * n);
+      mpc_vclear (mpoly->db.mH2, n * n);
+      mpc_vfree (mpoly->db.mH1);
+      mpc_vfree (mpoly->db.mH2);
+      free (mpoly->fH);
+      free (mpoly->dH);
+    }
+
+  pthread_mutex_destroy (&mpoly->regenerating);
+
   free (poly);
 }
 
@@ -89,10 +134,9 @@ mps_monomial_matrix_poly_set_coefficient_d (mps_context * ctx,
                                             cplx_t * matrix)
 {
   mps_polynomial *poly = MPS_POLYNOMIAL (mpoly);
-  int degree = poly->degree;
   int j;
 
-  if (i < 0 || i > degree)
+  if (i < 0 || i > mpoly->degree)
     {
       mps_error (ctx, "Degree of the coefficient is out of bounds");
       return;
@@ -111,6 +155,7 @@ mps_monomial_matrix_poly_set_coefficient_d (mps_context * ctx,
   /* Copy the data in the coefficients. Please note that we are assuming
    * row-major order in here. */
   cplx_t *ptr = mpoly->P + (mpoly->m * mpoly->m) * i;
+  mpc_t *mptr = mpoly->mP + (mpoly->m * mpoly->m) * i;
   memmove (ptr, matrix, sizeof(cplx_t) * (mpoly->m * mpoly->m));
 
   for (j = 0; j < mpoly->m * mpoly->m; j++)
@@ -119,8 +164,12 @@ mps_monomial_matrix_poly_set_coefficient_d (mps_context * ctx,
       if (cplx_Im (matrix[j]) != 0.0)
         poly->structure = MPS_STRUCTURE_COMPLEX_FP;
 
-      mpc_set_cplx (mpoly->mP[j], mpoly->P[j]);
+      mpc_set_cplx (mptr[j], ptr[j]);
     }
+
+  /* The Hessenberg form has to be computed again */
+  mpoly->prec = 0;
+  mpoly->singular = false;
 }
 
 void
@@ -131,10 +180,9 @@ mps_monomial_matrix_poly_set_coefficient_q (mps_context * ctx,
                                             mpq_t * matrix_i)
 {
   mps_polynomial *poly = MPS_POLYNOMIAL (mpoly);
-  int degree = poly->degree;
-  int j;
+  int j, offset = (mpoly->m * mpoly->m) * i;
 
-  if (i < 0 || i > degree)
+  if (i < 0 || i > mpoly->degree)
     {
       mps_error (ctx, "Degree of the coefficient is out of bounds");
       return;
@@ -151,12 +199,211 @@ mps_monomial_matrix_poly_set_coefficient_q (mps_context * ctx,
 
   for (j = 0; j < mpoly->m * mpoly->m; j++)
     {
-      mpq_set (mpoly->mpqPr[i], matrix_r[i]);
-      mpq_set (mpoly->mpqPi[i], matrix_i[i]);
+      mpq_set (mpoly->mpqPr[offset + j], matrix_r[j]);
+      mpq_set (mpoly->mpqPi[offset + j], matrix_i[j]);
+
+      mpc_set_q (mpoly->mP[offset + j], matrix_r[j], matrix_i[j]);
+      mpc_get_cplx (mpoly->P[offset + j], mpoly->mP[offset + j]);
 
-      if (mpq_cmp_ui (matrix_i[i], 0U, 1U) != 0)
+      if (mpq_cmp_ui (matrix_i[j], 0U, 1U) != 0)
         poly->structure = MPS_STRUCTURE_COMPLEX_RATIONAL;
     }
+
+  /* The Hessenberg form has to be computed again */
+  mpoly->prec = 0;
+  mpoly->singular = false;
+}
+
+/**
+ * @brief Store in C the block companion matrix of \f$P_n^{-1} P(x)\f$, computed
+ * with the precision of its entries.
+ *
+ * The product by \f$P_n^{-1}\f$ is obtained with Gaussian elimination with
+ * partial pivoting on \f$P_n\f$, unless the polynomial is monic.
+ *
+ * @return false if the leading coefficient is singular.
+ */
+static mps_boolean
+mps_monomial_matrix_poly_linearize (mps_context * ctx, mps_monomial_matrix_poly * mpoly,
+                                    mpc_t * C)
+{
+  int m = mpoly->m, d = mpoly->degree, n = d * m;
+  long int wp = mpc_get_prec (C[0]);
+  mpc_t * Pn = mpoly->mP + (m * m) * d;
+  mpc_t * LU = NULL;
+  int * perm = NULL;
+  int i, j, k, l, r;
+  mpc_t t, s;
+
+  for (i = 0; i < n * n; i++)
+    mpc_set_ui (C[i], 0U, 0U);
+
+  /* The first block rows contain the identity on the superdiagonal block */
+  for (i = 0; i < n - m; i++)
+    mpc_set_ui (MPS_MATRIX_ELEM (C, i, i + m, n), 1U, 0U);
+
+  /* Linear polynomials with the Hessenberg flag are of the form P_0 + xI */
+  if (mpoly->monic || (d == 1 && (mpoly->flags & MPS_MONOMIAL_MATRIX_POLY_HESSENBERG)))
+    {
+      for (k = 0; k < d; k++)
+        for (i = 0; i < m; i++)
+          for (j = 0; j < m; j++)
+            mpc_neg (MPS_MATRIX_ELEM (C, n - m + i, k * m + j, n),
+                     mpoly->mP[(m * m) * k + i * m + j]);
+      return true;
+    }
+
+  mpc_init2 (t, wp);
+  mpc_init2 (s, wp);
+  LU = mpc_valloc (m * m);
+  mpc_vinit2 (LU, m * m, wp);
+  perm = mps_newv (int, m);
+
+  /* Factor P_n = PLU, with partial pivoting */
+  for (i = 0; i < m * m; i++)
+    mpc_set (LU[i], Pn[i]);
+  for (i = 0; i < m; i++)
+    perm[i] = i;
+
+  for (k = 0; k < m; k++)
+    {
+      rdpe_t max, mod;
+
+      r = k;
+      mpc_rmod (max, MPS_MATRIX_ELEM (LU, k, k, m));
+      for (i = k + 1; i < m; i++)
+        {
+          mpc_rmod (mod, MPS_MATRIX_ELEM (LU, i, k, m));
+          if (rdpe_gt (mod, max))
+            {
+              rdpe_set (max, mod);
+              r = i;
+            }
+        }
+
+      if (rdpe_eq (max, rdpe_zero))
+        {
+          mpc_vclear (LU, m * m);
+          mpc_vfree (LU);
+          mpc_clear (t);
+          mpc_clear (s);
+          free (perm);
+          return false;
+        }
+
+      if (r != k)
+        {
+          for (j = 0; j < m; j++)
+            mpc_swap (MPS_MATRIX_ELEM (LU, r, j, m), MPS_MATRIX_ELEM (LU, k, j, m));
+          l = perm[r];
+          perm[r] = perm[k];
+          perm[k] = l;
+        }
+
+      for (i = k + 1; i < m; i++)
+        {
+          mpc_div_eq (MPS_MATRIX_ELEM (LU, i, k, m), MPS_MATRIX_ELEM (LU, k, k, m));
+          for (j = k + 1; j < m; j++)
+            {
+              mpc_mul (t, MPS_MATRIX_ELEM (LU, i, k, m), MPS_MATRIX_ELEM (LU, k, j, m));
+              mpc_sub_eq (MPS_MATRIX_ELEM (LU, i, j, m), t);
+            }
+        }
+    }
+
+  /* Solve P_n X = P_k column by column, and store -X in the last block row */
+  for (k = 0; k < d; k++)
+    {
+      mpc_t * Pk = mpoly->mP + (m * m) * k;
+
+      for (j = 0; j < m; j++)
+        {
+          /* The solution is computed directly in the j-th column of the block */
+          for (i = 0; i < m; i++)
+            {
+              mpc_ptr x = MPS_MATRIX_ELEM (C, n - m + i, k * m + j, n);
+
+              mpc_set (x, MPS_MATRIX_ELEM (Pk, perm[i], j, m));
+              for (l = 0; l < i; l++)
+                {
+                  mpc_mul (t, MPS_MATRIX_ELEM (LU, i, l, m), MPS_MATRIX_ELEM (C, n - m + l, k * m + j, n));
+                  mpc_sub_eq (x, t);
+                }
+            }
+
+          for (i = m - 1; i >= 0; i--)
+            {
+              mpc_ptr x = MPS_MATRIX_ELEM (C, n - m + i, k * m + j, n);
+
+              for (l = i + 1; l < m; l++)
+                {
+                  mpc_mul (t, MPS_MATRIX_ELEM (LU, i, l, m), MPS_MATRIX_ELEM (C, n - m + l, k * m + j, n));
+                  mpc_sub_eq (x, t);
+                }
+              mpc_div (s, x, MPS_MATRIX_ELEM (LU, i, i, m));
+              mpc_set (x, s);
+            }
+
+          for (i = 0; i < m; i++)
+            mpc_neg_eq (MPS_MATRIX_ELEM (C, n - m + i, k * m + j, n));
+        }
+    }
+
+  mpc_vclear (LU, m * m);
+  mpc_vfree (LU);
+  mpc_clear (t);
+  mpc_clear (s);
+  free (perm);
+
+  return true;
+}
+
+/**
+ * @brief Make sure that the Hessenberg matrix has been computed.
+ */
+static void
+mps_monomial_matrix_poly_ensure_hessenberg (mps_context * ctx, mps_monomial_matrix_poly * mpoly)
+{
+  if (mpoly->prec == 0)
+    mps_monomial_matrix_poly_raise_data (ctx, MPS_POLYNOMIAL (mpoly),
+                                         MPS_MONOMIAL_MATRIX_POLY_INITIAL_PREC);
+}
+
+mps_boolean
+mps_monomial_matrix_poly_feval (mps_context * ctx, mps_polynomial * poly,
+                                cplx_t x, cplx_t value, double * error)
+{
+  mps_monomial_matrix_poly *mpoly = MPS_MONOMIAL_MATRIX_POLY (poly);
+  long int exponent;
+
+  mps_monomial_matrix_poly_ensure_hessenberg (ctx, mpoly);
+
+  /* det(H - xI) = (-1)^n det(xI - H) */
+  mps_fhessenberg_shifted_newton (ctx, mpoly->fH, x, poly->degree, value, NULL, error, &exponent);
+
+  if (poly->degree % 2)
+    cplx_neg (value, value);
+
+  cplx_set_d (value, ldexp (cplx_Re (value), exponent), ldexp (cplx_Im (value), exponent));
+  *error = ldexp (*error, exponent);
+
+  return isfinite (cplx_Re (value)) && isfinite (cplx_Im (value)) && isfinite (*error);
+}
+
+mps_boolean
+mps_monomial_matrix_poly_deval (mps_context * ctx, mps_polynomial * poly,
+                                cdpe_t x, cdpe_t value, rdpe_t error)
+{
+  mps_monomial_matrix_poly *mpoly = MPS_MONOMIAL_MATRIX_POLY (poly);
+
+  mps_monomial_matrix_poly_ensure_hessenberg (ctx, mpoly);
+
+  mps_dhessenberg_shifted_newton (ctx, mpoly->dH, x, poly->degree, value, NULL, error);
+
+  if (poly->degree % 2)
+    cdpe_neg (value, value);
+
+  return true;
 }
 
 mps_boolean
@@ -165,22 +412,112 @@ mps_monomial_matrix_poly_meval (mps_context * ctx, mps_polynomial * poly,
 {
   mps_monomial_matrix_poly *mpoly = MPS_MONOMIAL_MATRIX_POLY (poly);
 
-  if (!mpoly->flags & MPS_MONOMIAL_MATRIX_POLY_HESSENBERG)
+  if (mpoly->prec < mpc_get_prec (value))
+    mps_monomial_matrix_poly_raise_data (ctx, poly, mpc_get_prec (value));
+
+  mps_mhessenberg_shifted_newton (ctx, mpoly->mH, x, poly->degree, value, NULL, error);
+
+  if (poly->degree % 2)
+    mpc_neg_eq (value);
+
+  return true;
+}
+
+void
+mps_monomial_matrix_poly_fnewton (mps_context * ctx, mps_polynomial * poly,
+                                  mps_approximation * root, cplx_t corr)
+{
+  mps_monomial_matrix_poly *mpoly = MPS_MONOMIAL_MATRIX_POLY (poly);
+  cplx_t p, p1;
+  double absp, error;
+  long int exponent;
+
+  mps_monomial_matrix_poly_ensure_hessenberg (ctx, mpoly);
+
+  /* The sign and the scaling of the determinant do not change the correction */
+  mps_fhessenberg_shifted_newton (ctx, mpoly->fH, root->fvalue, poly->degree, p, p1,
+                                  &error, &exponent);
+
+  absp = cplx_mod (p);
+  root->again = absp > error;
+
+  if (cplx_eq_zero (p1))
     {
-      /* TODO: Insert the necessary steps to make a Hessenberg matrix
-       * available in place of this non-Hessenberg matrix polynomial. */
+      cplx_set (corr, cplx_zero);
+      root->again = false;
+      return;
     }
 
-  /* TODO: This is not thread safe - at all! Insert a double buffer strategy
-   * in here, as for the case of mps_monomial_poly. */
-  if (mpc_get_prec (mpoly->mP[0]) < mpc_get_prec (value))
-    mps_monomial_matrix_poly_raise_data (ctx, poly, mpc_get_prec (value));
+  cplx_div (corr, p, p1);
+  root->frad = poly->degree * (absp + error) / cplx_mod (p1) + DBL_MIN;
+}
+
+void
+mps_monomial_matrix_poly_dnewton (mps_context * ctx, mps_polynomial * poly,
+                                  mps_approximation * root, cdpe_t corr)
+{
+  mps_monomial_matrix_poly *mpoly = MPS_MONOMIAL_MATRIX_POLY (poly);
+  cdpe_t p, p1;
+  rdpe_t absp, error, rtmp;
 
-  /* Otherwise just proceed with Horner and our recursive implementation. */
-  /* TODO: We are performing a floating point evaluation here, just for simplicity. */
-  mps_mhessenberg_shifted_determinant (ctx, mpoly->mP, x, mpoly->m, value, error);
+  mps_monomial_matrix_poly_ensure_hessenberg (ctx, mpoly);
 
-  return true;
+  mps_dhessenberg_shifted_newton (ctx, mpoly->dH, root->dvalue, poly->degree, p, p1, error);
+
+  cdpe_mod (absp, p);
+  root->again = rdpe_gt (absp, error);
+
+  if (cdpe_eq_zero (p1))
+    {
+      cdpe_set (corr, cdpe_zero);
+      root->again = false;
+      return;
+    }
+
+  cdpe_div (corr, p, p1);
+
+  rdpe_add (root->drad, absp, error);
+  rdpe_mul_eq_d (root->drad, (double) poly->degree);
+  cdpe_mod (rtmp, p1);
+  rdpe_div_eq (root->drad, rtmp);
+}
+
+void
+mps_monomial_matrix_poly_mnewton (mps_context * ctx, mps_polynomial * poly,
+                                  mps_approximation * root, mpc_t corr, long int wp)
+{
+  mps_monomial_matrix_poly *mpoly = MPS_MONOMIAL_MATRIX_POLY (poly);
+  mpc_scratch * sc = mpc_scratch_get ();
+  mpc_ptr p, p1;
+  rdpe_t absp, error, rtmp;
+
+  if (mpoly->prec < wp)
+    mps_monomial_matrix_poly_raise_data (ctx, poly, wp);
+
+  p = mpc_scratch_push (sc, wp);
+  p1 = mpc_scratch_push (sc, wp);
+
+  mps_mhessenberg_shifted_newton (ctx, mpoly->mH, root->mvalue, poly->degree, p, p1, error);
+
+  mpc_rmod (absp, p);
+  root->again = rdpe_gt (absp, error);
+
+  if (mpc_eq_zero (p1))
+    {
+      mpc_set_ui (corr, 0U, 0U);
+      root->again = false;
+    }
+  else
+    {
+      mpc_div_scratch (sc, corr, p, p1);
+
+      rdpe_add (root->drad, absp, error);
+      rdpe_mul_eq_d (root->drad, (double) poly->degree);
+      mpc_rmod (rtmp, p1);
+      rdpe_div_eq (root->drad, rtmp);
+    }
+
+  mpc_scratch_pop (sc, 2);
 }
 
 long int
@@ -191,6 +528,16 @@ mps_monomial_matrix_poly_raise_data (mps_context * ctx,
   int i;
   mps_monomial_matrix_poly *mpoly = MPS_MONOMIAL_MATRIX_POLY (p);
   size_t n_elems = (mpoly->degree + 1) * (mpoly->m * mpoly->m);
+  size_t n = p->degree;
+  mpc_t * raising_mH;
+
+  pthread_mutex_lock (&mpoly->regenerating);
+
+  if (mpoly->singular || (mpoly->prec != 0 && wp <= mpoly->prec))
+    {
+      pthread_mutex_unlock (&mpoly->regenerating);
+      return mpoly->prec;
+    }
 
   for (i = 0; i < n_elems; i++)
     {
@@ -200,8 +547,59 @@ mps_monomial_matrix_poly_raise_data (mps_context * ctx,
   if (MPS_STRUCTURE_IS_INTEGER (p->structure) ||
       MPS_STRUCTURE_IS_RATIONAL (p->structure))
     {
-      mpc_set_q (mpoly->mP[i], mpoly->mpqPr[i], mpoly->mpqPi[i]);
+      for (i = 0; i < n_elems; i++)
+        mpc_set_q (mpoly->mP[i], mpoly->mpqPr[i], mpoly->mpqPi[i]);
+    }
+  else
+    {
+      for (i = 0; i < n_elems; i++)
+        mpc_set_cplx (mpoly->mP[i], mpoly->P[i]);
+    }
+
+  if (mpoly->db.mH1 == NULL)
+    {
+      mpoly->db.mH1 = mpc_valloc (n * n);
+      mpoly->db.mH2 = mpc_valloc (n * n);
+      mpc_vinit2 (mpoly->db.mH1, n * n, wp);
+      mpc_vinit2 (mpoly->db.mH2, n * n, wp);
+      mpoly->fH = cplx_valloc (n * n);
+      mpoly->dH = cdpe_valloc (n * n);
     }
 
-  return mpc_get_prec (mpoly->mP[0]);
+  /* Compute the new matrix in the buffer that is not in use, so that
+   * the other threads can keep using the active one in the meantime. */
+  raising_mH = (mpoly->db.active == 1) ? mpoly->db.mH2 : mpoly->db.mH1;
+
+  for (i = 0; i < n * n; i++)
+    mpc_set_prec (raising_mH[i], wp);
+
+  if (!mps_monomial_matrix_poly_linearize (ctx, mpoly, raising_mH))
+    {
+      /* Report the error only once, and leave a zero matrix so that the
+       * evaluations are still well defined. */
+      mps_error (ctx, "The leading coefficient of the matrix polynomial is singular");
+      mpoly->singular = true;
+
+      for (i = 0; i < n * n; i++)
+        mpc_set_ui (raising_mH[i], 0U, 0U);
+    }
+  else if (!(mpoly->degree == 1 && (mpoly->flags & MPS_MONOMIAL_MATRIX_POLY_HESSENBERG)))
+    mps_mhessenberg_reduce (ctx, raising_mH, n);
+
+  if (mpoly->prec == 0 || mpoly->singular)
+    {
+      for (i = 0; i < n * n; i++)
+        {
+          mpc_get_cplx (mpoly->fH[i], raising_mH[i]);
+          mpc_get_cdpe (mpoly->dH[i], raising_mH[i]);
+        }
+    }
+
+  mpoly->mH = raising_mH;
+  mpoly->db.active = (mpoly->db.active % 2) + 1;
+  mpoly->prec = mpc_get_prec (raising_mH[0]);
+
+  pthread_mutex_unlock (&mpoly->regenerating);
+
+  return mpoly->prec;
 }
@@ -222,9 +222,6 @@ mps_monomial_poly_read_from_stream (mps_context * s,
           /* Compute modules of coefficients */
           cdpe_mod (poly->dap[i], poly->dpc[i]);
           poly->fap[i] = rdpe_get_d (poly->dap[i]);
-
-          if (i > 0)
-            mpc_mul_ui (poly->mfppc[i - 1], poly->mfppc[i], i);
         }
       else
         {
@@ -837,12 +834,6 @@ mps_monomial_poly_read_from_stream_v2 (mps_context * s, mps_input_buffer * buffe
           cdpe_mod (poly->dap[i], poly->dpc[i]);
           poly->fap[i] = rdpe_get_d (poly->dap[i]);
 
-          if (MPS_STRUCTURE_IS_FP (structure))
-            mpf_set (poly->mfpr[i], mpc_Re (poly->mfpc[i]));
-
-          if (i > 0)
-            mpc_mul_ui (poly->mfppc[i - 1], poly->mfppc[i], i);
-
           if (s->debug_level & MPS_DEBUG_IO)
             {
               MPS_DEBUG_MPC (s, 15, poly->mfpc[i], "Coefficient of degree %d", i);
@@ -855,9 +846,6 @@ mps_monomial_poly_read_from_stream_v2 (mps_context * s, mps_input_buffer * buffe
 
           rdpe_set (poly->dap[i], rdpe_zero);
           poly->fap[i] = 0.0f;
-
-          if (MPS_STRUCTURE_IS_FP (structure))
-            mpf_set (poly->mfpr[i], mpc_Re (poly->mfpc[i]));
         }
     }
 
@@ -13,9 +13,36 @@
 #include <mps/mps.h>
 #include <string.h>
 #include <assert.h>
+#include <float.h>
+#include <math.h>
+
+/*
+ * Number of bytes used by a vector of n multiprecision numbers with the
+ * same precision of x.
+ */
+static long int
+mps_mpc_vsize (mpc_t x, long int n)
+{
+  long int limbs = mpc_get_prec (x) / GMP_NUMB_BITS + 2;
+
+  return n * (sizeof(mpc_t) + 2 * limbs * sizeof(mp_limb_t));
+}
+
+static void
+mps_monomial_poly_account (mps_context * s, mps_monomial_poly * mp, long int bytes)
+{
+  mp->memory_usage += bytes;
+  mps_context_account_memory (s, bytes);
+}
 
 /**
  * @brief Return a newly allocated mps_monomial_poly of the given degree.
+ *
+ * Only the representations of the coefficients that are needed to set
+ * them and to choose the starting phase are allocated here. The other
+ * ones are allocated when a phase first needs them, and the
+ * multiprecision coefficients have the current working precision of the
+ * context.
  */
 mps_monomial_poly *
 mps_monomial_poly_new (mps_context * s, long int degree)
@@ -31,6 +58,7 @@ mps_monomial_poly_new (mps_context * s, long int degree)
   poly->feval = mps_monomial_poly_feval;
   poly->deval = mps_monomial_poly_deval;
   poly->meval = mps_monomial_poly_meval;
+  poly->ddeval = mps_monomial_poly_ddeval;
   poly->fstart = mps_monomial_poly_fstart;
   poly->dstart = mps_monomial_poly_dstart;
   poly->mstart = mps_monomial_poly_mstart;
@@ -39,6 +67,9 @@ mps_monomial_poly_new (mps_context * s, long int degree)
   poly->fnewton = mps_monomial_poly_fnewton;
   poly->dnewton = mps_monomial_poly_dnewton;
   poly->mnewton = mps_monomial_poly_mnewton;
+  poly->ddnewton = mps_monomial_poly_ddnewton;
+  poly->fnewton_block = mps_monomial_poly_fnewton_block;
+  poly->dnewton_block = mps_monomial_poly_dnewton_block;
   poly->get_leading_coefficient = mps_monomial_poly_get_leading_coefficient;
 
   /* Set the degree of the polynomial */
@@ -48,27 +79,27 @@ mps_monomial_poly_new (mps_context * s, long int degree)
    * the floating point versions. */
   mp->spar = mps_boolean_valloc (degree + 2);
   mp->fpc = cplx_valloc (degree + 1);
-  mp->fpr = double_valloc (degree + 1);
-  mp->dpr = rdpe_valloc (degree + 1);
   mp->dpc = cdpe_valloc (degree + 1);
   mp->db.mfpc1 = mpc_valloc (degree + 1);
-  mp->db.mfpc2 = mpc_valloc (degree + 1);
   mp->mfpc = mp->db.mfpc1;
   mp->db.active = 1;
-  mp->mfpr = mpf_valloc (degree + 1);
 
-  mpf_vinit2 (mp->mfpr, degree + 1, s->mpwp);
   mpc_vinit2 (mp->db.mfpc1, degree + 1, s->mpwp);
-  mpc_vinit2 (mp->db.mfpc2, degree + 1, s->mpwp);
+
+  /* The second buffer is allocated when the precision is raised */
+  mp->db.mfpc2 = NULL;
 
   /* Allocate space for the moduli of the coefficients */
   mp->fap = double_valloc (degree + 1);
   mp->dap = rdpe_valloc (degree + 1);
+  mp->dpc_exact = false;
 
-  /* Allocate space for the coefficients of the derivative */
-  mp->fppc = cplx_valloc (degree + 1);
-  mp->mfppc = mpc_valloc (degree + 1);
-  mpc_vinit2 (mp->mfppc, degree + 1, s->mpwp);
+  /* The coefficients of the derivatives are needed only by the float
+   * phase to restart from a cluster, and the double-double coefficients
+   * only by the MP phase. */
+  mp->fppc = NULL;
+  mp->ddpc = NULL;
+  mp->ddpc_valid = false;
 
   /* Allocate space for the coefficients initially parsed as
    * exact */
@@ -93,6 +124,13 @@ mps_monomial_poly_new (mps_context * s, long int degree)
   MPS_POLYNOMIAL (mp)->structure = MPS_STRUCTURE_UNKNOWN;
   mp->prec = s->mpwp;
 
+  mp->memory_usage = 0;
+  mps_monomial_poly_account (s, mp, (degree + 1) *
+                             (sizeof(mps_boolean) + sizeof(cplx_t) + sizeof(cdpe_t) +
+                              sizeof(double) + sizeof(rdpe_t) + 2 * sizeof(mpq_t) +
+                              sizeof(pthread_mutex_t)));
+  mps_monomial_poly_account (s, mp, mps_mpc_vsize (mp->mfpc[0], degree + 1));
+
   return mp;
 }
 
@@ -106,21 +144,20 @@ mps_monomial_poly_free (mps_context * s, mps_polynomial * p)
   mps_monomial_poly *mp = MPS_MONOMIAL_POLY (p);
 
   mps_boolean_vfree (mp->spar);
-  double_vfree (mp->fpr);
   cplx_vfree (mp->fpc);
-  rdpe_vfree (mp->dpr);
   cdpe_vfree (mp->dpc);
 
   double_vfree (mp->fap);
   rdpe_vfree (mp->dap);
 
-  mpf_vclear (mp->mfpr, MPS_POLYNOMIAL (mp)->degree + 1);
   mpc_vclear (mp->db.mfpc1, MPS_POLYNOMIAL (mp)->degree + 1);
-  mpc_vclear (mp->db.mfpc2, MPS_POLYNOMIAL (mp)->degree + 1);
-
-  mpf_vfree (mp->mfpr);
   mpc_vfree (mp->db.mfpc1);
-  mpc_vfree (mp->db.mfpc2);
+
+  if (mp->db.mfpc2)
+    {
+      mpc_vclear (mp->db.mfpc2, MPS_POLYNOMIAL (mp)->degree + 1);
+      mpc_vfree (mp->db.mfpc2);
+    }
 
   mpq_vclear (mp->initial_mqp_r, MPS_POLYNOMIAL (mp)->degree + 1);
   mpq_vclear (mp->initial_mqp_i, MPS_POLYNOMIAL (mp)->degree + 1);
@@ -128,12 +165,16 @@ mps_monomial_poly_free (mps_context * s, mps_polynomial * p)
   mpq_vfree (mp->initial_mqp_r);
   mpq_vfree (mp->initial_mqp_i);
 
-  cplx_vfree (mp->fppc);
-  mpc_vclear (mp->mfppc, MPS_POLYNOMIAL (mp)->degree + 1);
-  mpc_vfree (mp->mfppc);
+  if (mp->fppc)
+    cplx_vfree (mp->fppc);
+
+  if (mp->ddpc)
+    cdd_vfree (mp->ddpc);
 
   free (mp->mfpc_mutex);
 
+  mps_context_account_memory (s, -mp->memory_usage);
+
   free (mp);
 }
 
@@ -165,26 +206,31 @@ mps_monomial_poly_raise_precision (mps_context * s, mps_polynomial * p, long int
     }
 
   if (mp->db.active == 1)
-    raising_mfpc = mp->db.mfpc2;
+    {
+      if (!mp->db.mfpc2)
+        {
+          mp->db.mfpc2 = mpc_valloc (p->degree + 1);
+          mpc_vinit2 (mp->db.mfpc2, p->degree + 1, prec);
+          mps_monomial_poly_account (s, mp, mps_mpc_vsize (mp->db.mfpc2[0], p->degree + 1));
+        }
+      raising_mfpc = mp->db.mfpc2;
+    }
   else
     raising_mfpc = mp->db.mfpc1;
 
   /* raise the precision of  mfpc */
   if (MPS_IS_MONOMIAL_POLY (p))
-    for (k = 0; k < MPS_POLYNOMIAL (mp)->degree + 1; k++)
-      {
-        mpc_set_prec (raising_mfpc[k], prec);
-      }
-
-  /* Raise the precision of p' */
-  if (MPS_DENSITY_IS_SPARSE (p->density))
-    for (k = 0; k < MPS_POLYNOMIAL (mp)->degree; k++)
-      if (mp->spar[k + 1])
+    {
+      long int old_size = mps_mpc_vsize (raising_mfpc[0], p->degree + 1);
+
+      for (k = 0; k < MPS_POLYNOMIAL (mp)->degree + 1; k++)
         {
-          mpc_set_prec (mp->mfppc[k], prec);
-          mpc_mul_ui (mp->mfppc[k], mp->mfpc[k + 1], k + 1);
+          mpc_set_prec (raising_mfpc[k], prec);
         }
 
+      mps_monomial_poly_account (s, mp, mps_mpc_vsize (raising_mfpc[0], p->degree + 1) - old_size);
+    }
+
   if (MPS_STRUCTURE_IS_INTEGER (p->structure)
       || MPS_STRUCTURE_IS_RATIONAL (p->structure))
     {
@@ -274,9 +320,6 @@ mps_monomial_poly_set_coefficient_q (mps_context * s, mps_monomial_poly * mp, lo
       /* Compute modules of coefficients */
       cdpe_mod (mp->dap[i], mp->dpc[i]);
       mp->fap[i] = rdpe_get_d (mp->dap[i]);
-
-      if (i > 0)
-        mpc_mul_ui (mp->mfppc[i - 1], mp->mfppc[i], i);
     }
   else
     {
@@ -313,7 +356,6 @@ mps_monomial_poly_set_coefficient_d (mps_context * s, mps_monomial_poly * mp, lo
           MPS_POLYNOMIAL (mp)->structure == MPS_STRUCTURE_COMPLEX_FP);
 
   /* Set the coefficients */
-  mpf_set_d (mp->mfpr[i], real_part);
   mpc_set_d (mp->mfpc[i], real_part, imag_part);
 
   /* Update spar */
@@ -327,9 +369,6 @@ mps_monomial_poly_set_coefficient_d (mps_context * s, mps_monomial_poly * mp, lo
       /* Compute modules of coefficients */
       cdpe_mod (mp->dap[i], mp->dpc[i]);
       mp->fap[i] = rdpe_get_d (mp->dap[i]);
-
-      if (i > 0)
-        mpc_mul_ui (mp->mfppc[i - 1], mp->mfppc[i], i);
     }
   else
     {
@@ -381,9 +420,6 @@ mps_monomial_poly_set_coefficient_int (mps_context * s, mps_monomial_poly * mp,
       /* Compute modules of coefficients */
       cdpe_mod (mp->dap[i], mp->dpc[i]);
       mp->fap[i] = rdpe_get_d (mp->dap[i]);
-
-      if (i > 0)
-        mpc_mul_ui (mp->mfppc[i - 1], mp->mfppc[i], i);
     }
   else
     {
@@ -411,9 +447,6 @@ mps_monomial_poly_set_coefficient_f (mps_context * s, mps_monomial_poly * p, lon
   p->fap[i] = rdpe_get_d (p->dap[i]);
 
   p->spar[i] = !mpc_eq_zero (coeff);
-
-  if (i > 0)
-    mpc_mul_ui (p->mfppc[i - 1], p->mfppc[i], i);
 }
 
 /**
@@ -588,10 +621,6 @@ mps_monomial_poly_derive (mps_context * s, mps_monomial_poly * p, int k, long in
     break;
     }
 
-  if (MPS_DENSITY_IS_SPARSE (MPS_POLYNOMIAL (d)->density))
-    for (i = 0; i < MPS_POLYNOMIAL (d)->degree; i++)
-      mpc_mul_ui (d->mfppc[i], d->mfpc[i + 1], i + 1);
-
   return d;
 }
 
@@ -616,6 +645,19 @@ mps_monomial_poly_meval (mps_context * ctx, mps_polynomial *p, mpc_t x, mpc_t va
   return true;
 }
 
+mps_boolean
+mps_monomial_poly_ddeval (mps_context * ctx, mps_polynomial *p, cdd_t x, cdd_t value, double * error)
+{
+  mps_monomial_poly *mp = MPS_MONOMIAL_POLY (p);
+
+  if (!mp->ddpc_valid)
+    return false;
+
+  mps_ddhorner_with_error (ctx, mp, x, value, error);
+
+  return isfinite (*error);
+}
+
 void
 mps_monomial_poly_fstart (mps_context * ctx, mps_polynomial * p, mps_approximation ** approximations)
 {
@@ -661,6 +703,20 @@ mps_monomial_poly_dnewton (mps_context * ctx, mps_polynomial * p,
   mps_dnewton (ctx, p, root, corr);
 }
 
+void
+mps_monomial_poly_fnewton_block (mps_context * ctx, mps_polynomial * p,
+                                 mps_approximation ** roots, int n, cplx_t * corr)
+{
+  mps_fnewton_block (ctx, p, roots, n, corr);
+}
+
+void
+mps_monomial_poly_dnewton_block (mps_context * ctx, mps_polynomial * p,
+                                 mps_approximation ** roots, int n, cdpe_t * corr)
+{
+  mps_dnewton_block (ctx, p, roots, n, corr);
+}
+
 void
 mps_monomial_poly_mnewton (mps_context * ctx, mps_polynomial * p,
                            mps_approximation * root, mpc_t corr, long int wp)
@@ -668,6 +724,86 @@ mps_monomial_poly_mnewton (mps_context * ctx, mps_polynomial * p,
   mps_mnewton (ctx, p, root, corr, wp);
 }
 
+mps_boolean
+mps_monomial_poly_ddnewton (mps_context * ctx, mps_polynomial * p,
+                            mps_approximation * root, cdd_t corr)
+{
+  return mps_ddnewton (ctx, p, root, corr);
+}
+
+/**
+ * @brief Compute the double-double version of the coefficients of the
+ * polynomial.
+ *
+ * The coefficients are obtained from the exact rational ones, when they are
+ * available, or from the multiprecision ones otherwise. If some of them is
+ * out of the range where double-double arithmetic keeps its full accuracy
+ * the methods that work in double-double arithmetic will report a failure,
+ * and the multiprecision ones will be used instead.
+ *
+ * @param ctx The current <code>mps_context</code>.
+ * @param mp The polynomial whose coefficients should be converted.
+ */
+void
+mps_monomial_poly_update_dd_coefficients (mps_context * ctx, mps_monomial_poly * mp)
+{
+  mps_polynomial *p = MPS_POLYNOMIAL (mp);
+  int i, exponent, max_exponent = DBL_MIN_EXP;
+  mpc_t coeff;
+
+  mpc_init2 (coeff, 2 * DBL_MANT_DIG + 2);
+
+  if (!mp->ddpc)
+    {
+      mp->ddpc = cdd_valloc (p->degree + 1);
+      mps_monomial_poly_account (ctx, mp, (p->degree + 1) * sizeof(cdd_t));
+    }
+
+  mp->ddpc_valid = true;
+  for (i = 0; i <= p->degree && mp->ddpc_valid; i++)
+    {
+      if (!mp->spar[i])
+        {
+          cdd_set_d (mp->ddpc[i], 0.0, 0.0);
+          continue;
+        }
+
+      if (MPS_STRUCTURE_IS_INTEGER (p->structure) ||
+          MPS_STRUCTURE_IS_RATIONAL (p->structure))
+        mpc_set_q (coeff, mp->initial_mqp_r[i], mp->initial_mqp_i[i]);
+      else
+        mpc_set (coeff, mp->mfpc[i]);
+
+      mp->ddpc_valid = mpc_get_cdd (mp->ddpc[i], coeff);
+
+      frexp (cdd_mod (mp->ddpc[i]), &exponent);
+      max_exponent = MAX (max_exponent, exponent);
+    }
+
+  /* Leave room to evaluate the polynomial in the unit disc without overflow */
+  if (max_exponent + log2 (p->degree + 1.0) + 2 >= DBL_MAX_EXP)
+    mp->ddpc_valid = false;
+
+  mpc_clear (coeff);
+}
+
+/**
+ * @brief Allocate the space for the floating point coefficients of the
+ * derivatives of the polynomial, if this has not been done already.
+ *
+ * @param ctx The current <code>mps_context</code>.
+ * @param mp The polynomial that needs <code>fppc</code>.
+ */
+void
+mps_monomial_poly_ensure_fppc (mps_context * ctx, mps_monomial_poly * mp)
+{
+  if (mp->fppc)
+    return;
+
+  mp->fppc = cplx_valloc (MPS_POLYNOMIAL (mp)->degree + 1);
+  mps_monomial_poly_account (ctx, mp, (MPS_POLYNOMIAL (mp)->degree + 1) * sizeof(cplx_t));
+}
+
 void
 mps_monomial_poly_get_leading_coefficient (mps_context * ctx, mps_polynomial * p,
                                            mpc_t leading_coefficient)
@@ -693,14 +829,11 @@ void mps_monomial_poly_deflate (mps_context * ctx, mps_polynomial * poly)
         {
           rdpe_set (p->dap[i], p->dap[i + zero_roots]);
           p->fap[i] = p->fap[i + zero_roots];
-          p->fpr[i] = p->fpr[i + zero_roots];
           cplx_set (p->fpc[i], p->fpc[i + zero_roots]);
-          rdpe_set (p->dpr[i], p->dpr[i + zero_roots]);
           cdpe_set (p->dpc[i], p->dpc[i + zero_roots]);
-          mpf_set (p->mfpr[i], p->mfpr[i + zero_roots]);
           mpc_set (p->mfpc[i], p->mfpc[i + zero_roots]);
-          if (i < poly->degree - zero_roots)
-            mpc_set (p->mfppc[i], p->mfppc[i + zero_roots]);
+          if (p->ddpc)
+            cdd_set (p->ddpc[i], p->ddpc[i + zero_roots]);
           mpq_set (p->initial_mqp_r[i], p->initial_mqp_r[i + zero_roots]);
           mpq_set (p->initial_mqp_i[i], p->initial_mqp_i[i + zero_roots]);
           p->spar[i] = p->spar[i + zero_roots];
@@ -21,8 +21,8 @@ mps_thread_fpolzer_worker (void *data_ptr)
   mps_thread_worker_data *data = (mps_thread_worker_data*)data_ptr;
   mps_context *s = data->s;
   mps_polynomial *p = s->active_poly;
-  int i, iter;
-  cplx_t corr, abcorr, froot;
+  int i, iter, mirror;
+  cplx_t corr, abcorr, froot, old_froot;
   double rad1, modcorr;
   mps_thread_job job;
 
@@ -42,6 +42,16 @@ mps_thread_fpolzer_worker (void *data_ptr)
       /* Lock this roots to make sure that we are the only one working on it */
       pthread_mutex_lock (&data->roots_mutex[i]);
 
+      /* The conjugates are updated together with the approximations
+       * they are paired with */
+      if (mps_conjugate_skip (data->pairs, i, data->roots_mutex))
+        {
+          pthread_mutex_unlock (&data->roots_mutex[i]);
+          continue;
+        }
+
+      mirror = -1;
+
       if (s->root[i]->again)
         {
           /* Check if, while we were waiting, excep condition has been reached */
@@ -56,9 +66,8 @@ mps_thread_fpolzer_worker (void *data_ptr)
           rad1 = s->root[i]->frad;
 
           /* Make a local copy of the root */
-          pthread_mutex_lock (&data->aberth_mutex[i]);
           cplx_set (froot, s->root[i]->fvalue);
-          pthread_mutex_unlock (&data->aberth_mutex[i]);
+          cplx_set (old_froot, froot);
 
           mps_polynomial_fnewton (s, p, s->root[i], corr);
 
@@ -87,7 +96,9 @@ mps_thread_fpolzer_worker (void *data_ptr)
               /* the correction is performed only if iter!=1 or rad(i)!=rad1 */
               || iter != 0 || s->root[i]->frad != rad1)
             {
-              mps_faberth (s, s->root[i], abcorr);
+              mps_faberth_snapshot (s, i, froot,
+                                    mps_thread_root_snapshot_fget (data->snapshot, iter, data->fvalues),
+                                    abcorr);
 
               cplx_mul_eq (abcorr, corr);
               cplx_sub (abcorr, cplx_one, abcorr);
@@ -103,15 +114,16 @@ mps_thread_fpolzer_worker (void *data_ptr)
               modcorr = cplx_mod (abcorr);
               s->root[i]->frad += modcorr;
 
-              pthread_mutex_lock (&data->aberth_mutex[i]);
               cplx_set (s->root[i]->fvalue, froot);
-              pthread_mutex_unlock (&data->aberth_mutex[i]);
             }
 
+          if (data->pairs)
+            mirror = mps_conjugate_fupdate (s, data->pairs, i, old_froot, corr);
+
           /* check for new approximated roots */
           if (!s->root[i]->again)
             {
-              (*data->nzeros)++;
+              (*data->nzeros) += (mirror >= 0) ? 2 : 1;
               if (*data->nzeros >= data->required_zeros)
                 {
                   pthread_mutex_unlock (&data->roots_mutex[i]);
@@ -120,6 +132,10 @@ mps_thread_fpolzer_worker (void *data_ptr)
             }
         }
 
+      mps_thread_root_snapshot_fpublish (data->snapshot, iter, i, s->root[i]->fvalue);
+      if (mirror >= 0)
+        mps_thread_root_snapshot_fpublish (data->snapshot, iter, mirror, s->root[mirror]->fvalue);
+
       pthread_mutex_unlock (&data->roots_mutex[i]);
     }
 
@@ -134,18 +150,16 @@ MPS_PRIVATE void
 mps_thread_fpolzer (mps_context * s, int *it, mps_boolean * excep, int required_zeros)
 {
   int i, nzeros = 0, n_threads = s->n_threads;
+  mps_conjugate_pairs *pairs;
 
   mps_thread_worker_data *data;
-  pthread_mutex_t *aberth_mutex =
-    (pthread_mutex_t*)mps_malloc (sizeof(pthread_mutex_t) * s->n);
+  mps_thread_root_snapshot *snapshot;
+  cplx_t *fvalues;
   pthread_mutex_t *roots_mutex =
     (pthread_mutex_t*)mps_malloc (sizeof(pthread_mutex_t) * s->n);
 
   for (i = 0; i < s->n; i++)
-    {
-      pthread_mutex_init (roots_mutex + i, NULL);
-      pthread_mutex_init (aberth_mutex + i, NULL);
-    }
+    pthread_mutex_init (roots_mutex + i, NULL);
 
   /* Create a new job queue */
   mps_thread_job_queue *queue = mps_thread_job_queue_new (s);
@@ -153,18 +167,27 @@ mps_thread_fpolzer (mps_context * s, int *it, mps_boolean * excep, int required_
   *it = 0;
   *excep = false;
 
+  /* Iterate only on one approximation of every conjugate pair, if possible.
+   * The pairs are made exactly conjugate, and their states are merged, so
+   * this must be done before anything else looks at the approximations. */
+  pairs = mps_conjugate_fpairs (s);
+
   /* count the number of approximations in the root neighbourhood */
   for (i = 0; i < s->n; i++)
     if (!s->root[i]->again)
       nzeros++;
   if (nzeros == s->n)
     {
+      if (pairs)
+        mps_conjugate_packet_done (s, pairs, nzeros);
       free (roots_mutex);
-      free (aberth_mutex);
       mps_thread_job_queue_free (queue);
       return;
     }
 
+  snapshot = mps_thread_root_snapshot_new (s, float_phase);
+  fvalues = cplx_valloc (n_threads * s->n);
+
   data = (mps_thread_worker_data*)mps_malloc (sizeof(mps_thread_worker_data)
                                               * n_threads);
 
@@ -176,10 +199,13 @@ mps_thread_fpolzer (mps_context * s, int *it, mps_boolean * excep, int required_
       data[i].excep = excep;
       data[i].thread = i;
       data[i].n_threads = n_threads;
-      data[i].aberth_mutex = aberth_mutex;
+      data[i].aberth_mutex = NULL;
       data[i].roots_mutex = roots_mutex;
       data[i].queue = queue;
+      data[i].snapshot = snapshot;
+      data[i].fvalues = fvalues + i * s->n;
       data[i].required_zeros = required_zeros;
+      data[i].pairs = pairs;
       /* pthread_create (&threads[i], NULL, &mps_thread_fpolzer_worker, */
       /* data + i); */
       mps_thread_pool_assign (s, s->pool, mps_thread_fpolzer_worker, data + i);
@@ -187,9 +213,13 @@ mps_thread_fpolzer (mps_context * s, int *it, mps_boolean * excep, int required_
 
   mps_thread_pool_wait (s, s->pool);
 
+  if (pairs)
+    mps_conjugate_packet_done (s, pairs, nzeros);
+
   free (data);
   free (roots_mutex);
-  free (aberth_mutex);
+  cplx_vfree (fvalues);
+  mps_thread_root_snapshot_free (snapshot);
   mps_thread_job_queue_free (queue);
 }
 
@@ -199,9 +229,9 @@ mps_thread_fpolzer (mps_context * s, int *it, mps_boolean * excep, int required_
 static void *
 mps_thread_dpolzer_worker (void *data_ptr)
 {
-  int iter, i;
+  int iter, i, mirror;
   rdpe_t rad1, rtmp;
-  cdpe_t corr, abcorr;
+  cdpe_t corr, abcorr, old_droot;
 
   /* Parse input data */
   mps_thread_worker_data *data = (mps_thread_worker_data*)data_ptr;
@@ -226,6 +256,17 @@ mps_thread_dpolzer_worker (void *data_ptr)
       if (s->pool->n > 1)
 	pthread_mutex_lock (&data->roots_mutex[i]);
 
+      /* The conjugates are updated together with the approximations
+       * they are paired with */
+      if (mps_conjugate_skip (data->pairs, i, (s->pool->n > 1) ? data->roots_mutex : NULL))
+        {
+          if (s->pool->n > 1)
+            pthread_mutex_unlock (&data->roots_mutex[i]);
+          continue;
+        }
+
+      mirror = -1;
+
       if (s->root[i]->again)
         {
           /* Check if, while we were waiting, excep condition has been reached */
@@ -238,6 +279,7 @@ mps_thread_dpolzer_worker (void *data_ptr)
 
           (*data->it)++;
           rdpe_set (rad1, s->root[i]->drad);
+          cdpe_set (old_droot, s->root[i]->dvalue);
 
           mps_polynomial_dnewton (s, p, s->root[i], corr);
           if (iter == 0 && !s->root[i]->again && rdpe_gt (s->root[i]->drad, rad1)
@@ -257,7 +299,9 @@ mps_thread_dpolzer_worker (void *data_ptr)
               || iter != 0
               || rdpe_ne (s->root[i]->drad, rad1))
             {
-              mps_daberth (s, s->root[i], abcorr);
+              mps_daberth_snapshot (s, i, s->root[i]->dvalue,
+                                    mps_thread_root_snapshot_dget (data->snapshot, iter, data->dvalues),
+                                    abcorr);
               cdpe_mul_eq (abcorr, corr);
               cdpe_sub (abcorr, cdpe_one, abcorr);
               if (cdpe_eq_zero (abcorr))
@@ -273,10 +317,13 @@ mps_thread_dpolzer_worker (void *data_ptr)
               rdpe_add_eq (s->root[i]->drad, rtmp);
             }
 
+          if (data->pairs)
+            mirror = mps_conjugate_dupdate (s, data->pairs, i, old_droot, corr);
+
           /* check for new approximated roots */
           if (!s->root[i]->again)
             {
-              (*data->nzeros)++;
+              (*data->nzeros) += (mirror >= 0) ? 2 : 1;
               if ((*data->nzeros) >= data->required_zeros)
                 {
 		  if (s->pool->n > 1)
@@ -286,6 +333,10 @@ mps_thread_dpolzer_worker (void *data_ptr)
             }
         }
 
+      mps_thread_root_snapshot_dpublish (data->snapshot, iter, i, s->root[i]->dvalue);
+      if (mirror >= 0)
+        mps_thread_root_snapshot_dpublish (data->snapshot, iter, mirror, s->root[mirror]->dvalue);
+
       if (s->pool->n > 1)
 	pthread_mutex_unlock (&data->roots_mutex[i]);
     }
@@ -300,61 +351,78 @@ MPS_PRIVATE void
 mps_thread_dpolzer (mps_context * s, int *it, mps_boolean * excep, int required_zeros)
 {
   mps_thread_worker_data *data;
-  pthread_mutex_t *aberth_mutex, *roots_mutex;
+  mps_thread_root_snapshot *snapshot;
+  mps_conjugate_pairs *pairs;
+  pthread_mutex_t *roots_mutex;
+  cdpe_t *dvalues;
   int i, nzeros = 0;
 
   /* initialize the iteration counter */
   *it = 0;
   *excep = false;
 
+  /* Iterate only on one approximation of every conjugate pair, if possible.
+   * The states of the pairs are merged, so this must be done before
+   * counting the approximations in the root neighbourhood. */
+  pairs = mps_conjugate_dpairs (s);
+
   /* count the number of approximations in the root neighbourhood */
   for (i = 0; i < s->n; i++)
     if (!s->root[i]->again)
       nzeros++;
   if (nzeros == s->n)
-    return;
+    {
+      if (pairs)
+        mps_conjugate_packet_done (s, pairs, nzeros);
+      return;
+    }
 
   /* Prepare queue */
   mps_thread_job_queue *queue = mps_thread_job_queue_new (s);
+  snapshot = mps_thread_root_snapshot_new (s, dpe_phase);
+  dvalues = cdpe_valloc (s->n_threads * s->n);
 
   /* Allocate space for thread data */
   data = (mps_thread_worker_data*)mps_malloc (sizeof(mps_thread_worker_data)
                                               * s->n_threads);
 
   /* Allocate mutexes and init them */
-  aberth_mutex = (pthread_mutex_t*)mps_malloc (sizeof(pthread_mutex_t) * s->n);
   roots_mutex = (pthread_mutex_t*)mps_malloc (sizeof(pthread_mutex_t) * s->n);
   for (i = 0; i < s->n; i++)
     {
       if (s->pool->n > 1)
-	{
-	  pthread_mutex_init (&aberth_mutex[i], NULL);
-	  pthread_mutex_init (&roots_mutex[i], NULL);
-	}
+	pthread_mutex_init (&roots_mutex[i], NULL);
     }
 
   /* Start spawning thread */
   for (i = 0; i < s->n_threads; i++)
     {
-      data[i].aberth_mutex = aberth_mutex;
+      data[i].aberth_mutex = NULL;
       data[i].excep = excep;
       data[i].it = it;
       data[i].n_threads = s->n_threads;
       data[i].nzeros = &nzeros;
       data[i].queue = queue;
+      data[i].snapshot = snapshot;
+      data[i].dvalues = dvalues + i * s->n;
       data[i].roots_mutex = roots_mutex;
       data[i].s = s;
       data[i].thread = i;
       data[i].required_zeros = required_zeros;
+      data[i].pairs = pairs;
       mps_thread_pool_assign (s, s->pool, mps_thread_dpolzer_worker, data + i);
     }
 
   /* Wait for the thread to complete */
   mps_thread_pool_wait (s, s->pool);
 
-  free (aberth_mutex);
+  if (pairs)
+    mps_conjugate_packet_done (s, pairs, nzeros);
+
   free (roots_mutex);
   free (data);
+  cdpe_vfree (dvalues);
+  mps_thread_root_snapshot_free (snapshot);
   mps_thread_job_queue_free (queue);
 }
 
@@ -368,14 +436,15 @@ mps_thread_mpolzer_worker (void *data_ptr)
   mps_context *s = data->s;
   mps_polynomial *p = s->active_poly;
   mps_thread_job job;
-  int iter, l;
-  mpc_t corr, abcorr, mroot, diff;
+  int iter, l, mirror;
+  mpc_t corr, abcorr, mroot, old_mroot, diff;
   rdpe_t eps, rad1, rtmp;
   cdpe_t ctmp;
 
   mpc_init2 (abcorr, s->mpwp);
   mpc_init2 (corr, s->mpwp);
   mpc_init2 (mroot, s->mpwp);
+  mpc_init2 (old_mroot, s->mpwp);
   mpc_init2 (diff, s->mpwp);
 
   rdpe_mul_d (eps, s->mp_epsilon, (double)4 * s->n);
@@ -406,6 +475,15 @@ mps_thread_mpolzer_worker (void *data_ptr)
       if (s->pool->n > 1)
 	pthread_mutex_lock (&data->roots_mutex[l]);
 
+      /* The conjugates are updated together with the approximations
+       * they are paired with */
+      if (mps_conjugate_skip (data->pairs, l, (s->pool->n > 1) ? data->roots_mutex : NULL))
+        {
+          if (s->pool->n > 1)
+            pthread_mutex_unlock (&data->roots_mutex[l]);
+          continue;
+        }
+
       /* MPS_DEBUG (s, "Iterating on root %d, iter %d", l, job.iter); */
 
       if (s->root[l]->again)
@@ -428,6 +506,7 @@ mps_thread_mpolzer_worker (void *data_ptr)
           mpc_set (mroot, s->root[l]->mvalue);
 	  if (s->pool->n > 1)
 	    pthread_mutex_unlock (&data->aberth_mutex[l]);
+          mpc_set (old_mroot, mroot);
 
           /* sparse/dense polynomial */
           rdpe_set (rad1, s->root[l]->drad);
@@ -485,10 +564,15 @@ mps_thread_mpolzer_worker (void *data_ptr)
 		pthread_mutex_unlock (data->global_aberth_mutex);
             }
 
+          mirror = -1;
+          if (data->pairs)
+            mirror = mps_conjugate_mupdate (s, data->pairs, l, old_mroot, corr,
+                                            (s->pool->n > 1) ? data->aberth_mutex : NULL);
+
           /* check for new approximated roots */
           if (!s->root[l]->again)
             {
-              (*data->nzeros)++;
+              (*data->nzeros) += (mirror >= 0) ? 2 : 1;
               if ((*data->nzeros) >= data->required_zeros)
                 {
 		  if (s->pool->n > 1)
@@ -514,28 +598,350 @@ endfun:                        /* free local MP variables */
   mpc_clear (corr);
   mpc_clear (abcorr);
   mpc_clear (mroot);
+  mpc_clear (old_mroot);
   mpc_clear (diff);
 
   return NULL;
 }
 
+/*
+ * Keep the double-double approximations in the conjugate pairs found by
+ * mps_conjugate_mpairs(). The pairs are not split here, this is left to
+ * the multiprecision packet that follows.
+ */
+static int
+mps_thread_ddconjugate (mps_context * s, mps_conjugate_pairs * pairs, int l, mps_boolean real)
+{
+  mps_approximation *root = s->root[l], *mirror;
+  int j = pairs->conjugate[l];
+
+  if (j == l)
+    {
+      if (real)
+        rdd_set_d (cdd_Im (root->ddvalue), 0.0);
+      return -1;
+    }
+
+  mirror = s->root[j];
+  rdd_set (cdd_Re (mirror->ddvalue), cdd_Re (root->ddvalue));
+  rdd_neg (cdd_Im (mirror->ddvalue), cdd_Im (root->ddvalue));
+  rdpe_set (mirror->drad, root->drad);
+  mirror->again = root->again;
+
+  return j;
+}
+
+/**
+ * @brief Worker for the ddpolzer routine.
+ */
+static void *
+mps_thread_ddpolzer_worker (void *data_ptr)
+{
+  mps_thread_worker_data *data = (mps_thread_worker_data*)data_ptr;
+  mps_context *s = data->s;
+  mps_polynomial *p = s->active_poly;
+  mps_thread_job job;
+  int iter, l, mirror;
+  cdd_t corr, abcorr;
+  cplx_t ab, den;
+  rdpe_t rad1, rtmp;
+  double modcorr;
+  mps_boolean real;
+
+  /* Continue to iterate while exception condition has not
+   * been reached and there more roots to approximate   */
+  while ((*data->nzeros) < data->required_zeros && !(*data->dd_failed))
+    {
+      /* Get next job for this thread */
+      job = mps_thread_job_queue_next (s, data->queue);
+
+      /* Set variables to be used in the rest of the code */
+      iter = job.iter;
+
+      /* Check if we exceeded the maximum number of iterations */
+      if (job.iter == MPS_THREAD_JOB_EXCEP)
+        {
+          (*data->excep) = true;
+          return NULL;
+        }
+
+      l = job.i;
+
+      if (s->pool->n > 1)
+        pthread_mutex_lock (&data->roots_mutex[l]);
+
+      /* The conjugates are updated together with the approximations
+       * they are paired with */
+      if (data->pairs && data->pairs->conjugate[l] < 0)
+        {
+          if (s->pool->n > 1)
+            pthread_mutex_unlock (&data->roots_mutex[l]);
+          continue;
+        }
+
+      if (s->root[l]->again)
+        {
+          /* Check if, while we were waiting, excep condition has been reached,
+           * or all the zeros has been approximated.                         */
+          if (*data->excep || *data->dd_failed || (*data->nzeros) >= data->required_zeros)
+            {
+              if (s->pool->n > 1)
+                pthread_mutex_unlock (&data->roots_mutex[l]);
+              return NULL;
+            }
+
+          /* Increment total iteration counter */
+          (*data->it)++;
+
+          rdpe_set (rad1, s->root[l]->drad);
+          real = (cdd_Im (s->root[l]->ddvalue)->hi == 0.0);
+
+          if (!mps_polynomial_ddnewton (s, p, s->root[l], corr))
+            {
+              *data->dd_failed = true;
+              if (s->pool->n > 1)
+                pthread_mutex_unlock (&data->roots_mutex[l]);
+              return NULL;
+            }
+
+          if (iter == 0 && !s->root[l]->again && rdpe_gt (s->root[l]->drad, rad1)
+              && rdpe_ne (rad1, rdpe_zero))
+            rdpe_set (s->root[l]->drad, rad1);
+
+          /* See the comment in mps_thread_mpolzer_worker () */
+          if (s->root[l]->again
+              || iter != 0
+              || rdpe_ne (s->root[l]->drad, rad1))
+            {
+              /* Global lock to aberth step to reach a real Gauss-Seidel iteration.
+               * The double-double values of the approximations are only accessed
+               * while holding it, so they need no further locking. */
+              if (s->pool->n > 1)
+                pthread_mutex_lock (data->global_aberth_mutex);
+
+              /* Compute the Aberth correction corr / (1 - corr * ab). The
+               * denominator is only needed in floating point. */
+              if (mps_ddaberth_s (s, l, job.cluster_item->cluster, ab))
+                {
+                  cdd_get_cplx (den, corr);
+                  cplx_mul_eq (den, ab);
+                  cplx_sub (den, cplx_one, den);
+                  cdd_set_cplx (abcorr, den);
+                  cdd_div (abcorr, corr, abcorr);
+                  modcorr = cdd_mod (abcorr);
+                }
+              else
+                modcorr = HUGE_VAL;
+
+              if (!isfinite (modcorr))
+                {
+                  *data->dd_failed = true;
+                  if (s->pool->n > 1)
+                    {
+                      pthread_mutex_unlock (data->global_aberth_mutex);
+                      pthread_mutex_unlock (&data->roots_mutex[l]);
+                    }
+                  return NULL;
+                }
+
+              cdd_sub (s->root[l]->ddvalue, s->root[l]->ddvalue, abcorr);
+              rdpe_set_d (rtmp, modcorr);
+              rdpe_add_eq (s->root[l]->drad, rtmp);
+
+              if (s->pool->n > 1)
+                pthread_mutex_unlock (data->global_aberth_mutex);
+            }
+
+          mirror = -1;
+          if (data->pairs)
+            {
+              if (s->pool->n > 1)
+                pthread_mutex_lock (data->global_aberth_mutex);
+              mirror = mps_thread_ddconjugate (s, data->pairs, l, real);
+              if (s->pool->n > 1)
+                pthread_mutex_unlock (data->global_aberth_mutex);
+            }
+
+          /* check for new approximated roots */
+          if (!s->root[l]->again)
+            {
+              (*data->nzeros) += (mirror >= 0) ? 2 : 1;
+              if ((*data->nzeros) >= data->required_zeros)
+                {
+                  if (s->pool->n > 1)
+                    pthread_mutex_unlock (&data->roots_mutex[l]);
+                  return NULL;
+                }
+            }
+        }
+
+      if (s->pool->n > 1)
+        pthread_mutex_unlock (&data->roots_mutex[l]);
+
+      if ((*data->nzeros) == s->n)
+        return NULL;
+    }
+
+  return NULL;
+}
+
+/**
+ * @brief Double-double version of mps_thread_mpolzer().
+ *
+ * The approximations are converted to double-double, iterated with
+ * the ddnewton method of the polynomial, and then copied back in the
+ * multiprecision approximations. This is much faster than the GMP
+ * arithmetic at the first precision level of the MP phase, and brings
+ * the approximations close enough to the roots that the multiprecision
+ * packet that follows only needs one or two iterations per root.
+ *
+ * The vector <code>again</code> is restored on exit, so that the
+ * multiprecision packet iterates on the same approximations and computes
+ * their inclusion radii at the current working precision.
+ *
+ * @return false if the packet could not be carried out in double-double
+ * arithmetic, either because some approximation or Newton correction
+ * cannot be represented, or because the polynomial does not provide
+ * the ddnewton method. The approximations computed until then
+ * are copied back anyway.
+ */
+MPS_PRIVATE mps_boolean
+mps_thread_ddpolzer (mps_context * s, int *it, mps_boolean * excep, int required_zeros)
+{
+  int i, nzeros = 0, n_threads = s->n_threads;
+  mps_boolean dd_failed = false;
+  mps_boolean *again;
+  mps_conjugate_pairs *pairs;
+
+  *it = 0;
+  *excep = false;
+
+  if (s->active_poly->ddnewton == NULL)
+    return false;
+
+  for (i = 0; i < s->n; i++)
+    if (!mpc_get_cdd (s->root[i]->ddvalue, s->root[i]->mvalue))
+      return false;
+
+  /* Iterate only on one approximation of every conjugate pair, if possible */
+  pairs = mps_conjugate_mpairs (s);
+
+  /* Check if we have already approxmiated roots */
+  for (i = 0; i < s->n; i++)
+    if (!s->root[i]->again)
+      nzeros++;
+  if (nzeros == s->n)
+    {
+      if (pairs)
+        mps_conjugate_packet_done (s, pairs, nzeros);
+      return true;
+    }
+
+  again = (mps_boolean*)mps_malloc (sizeof(mps_boolean) * s->n);
+  for (i = 0; i < s->n; i++)
+    again[i] = s->root[i]->again;
+
+  /* Lower the number of threads if there are a lot of approximated roots */
+  if (s->n_threads > (s->n - nzeros))
+    n_threads = s->n - nzeros;
+
+  MPS_DEBUG_WITH_INFO (s, "Spawning %d double-double worker", n_threads);
+
+  mps_thread_worker_data *data;
+
+  pthread_mutex_t *roots_mutex =
+    (pthread_mutex_t*)mps_malloc (sizeof(pthread_mutex_t) * s->n);
+  pthread_mutex_t global_aberth_mutex = PTHREAD_MUTEX_INITIALIZER;
+
+  for (i = 0; i < s->n; i++)
+    pthread_mutex_init (&roots_mutex[i], NULL);
+
+  mps_thread_job_queue *queue = mps_thread_job_queue_new (s);
+
+  data = (mps_thread_worker_data*)mps_malloc (sizeof(mps_thread_worker_data)
+                                              * n_threads);
+
+  for (i = 0; i < n_threads; i++)
+    {
+      data[i].it = it;
+      data[i].nzeros = &nzeros;
+      data[i].s = s;
+      data[i].excep = excep;
+      data[i].dd_failed = &dd_failed;
+      data[i].thread = i;
+      data[i].n_threads = n_threads;
+      data[i].global_aberth_mutex = &global_aberth_mutex;
+      data[i].queue = queue;
+      data[i].roots_mutex = roots_mutex;
+      data[i].required_zeros = required_zeros;
+      data[i].pairs = pairs;
+      mps_thread_pool_assign (s, s->pool, mps_thread_ddpolzer_worker, data + i);
+    }
+
+  mps_thread_pool_wait (s, s->pool);
+
+  if (pairs)
+    mps_conjugate_packet_done (s, pairs, nzeros);
+
+  /* Copy back the approximations that have been iterated; the other ones
+   * may be more accurate than their double-double version. */
+  for (i = 0; i < s->n; i++)
+    if (again[i])
+      {
+        mpc_set_cdd (s->root[i]->mvalue, s->root[i]->ddvalue);
+        s->root[i]->again = true;
+      }
+
+  free (again);
+  free (data);
+  for (i = 0; i < s->n; i++)
+    pthread_mutex_destroy (&roots_mutex[i]);
+  free (roots_mutex);
+  mps_thread_job_queue_free (queue);
+
+  /* The multiprecision packet decides if the iterations have been successful */
+  *excep = false;
+
+  if (dd_failed)
+    {
+      MPS_DEBUG (s, "Double-double iterations failed, switching to multiprecision");
+      return false;
+    }
+
+  return true;
+}
+
 /**
  * @brief Drop-in threaded replacement for the stock mpolzer.
  */
 MPS_PRIVATE void
 mps_thread_mpolzer (mps_context * s, int *it, mps_boolean * excep, int required_zeros)
 {
-  int i, nzeros = 0, n_threads = s->n_threads;
+  int i, nzeros = 0, n_threads = s->n_threads, dd_it = 0;
+  mps_conjugate_pairs *pairs;
 
-  *it = 0;
+  /* At the first precision level refine the approximations in
+   * double-double arithmetic, if possible, before iterating in
+   * multiprecision. */
+  if (s->mpwp <= MPS_THREAD_DDPOLZER_MAX_PRECISION)
+    mps_thread_ddpolzer (s, &dd_it, excep, required_zeros);
+
+  *it = dd_it;
   *excep = false;
 
+  /* Iterate only on one approximation of every conjugate pair, if possible.
+   * The states of the pairs are merged, so this must be done before
+   * counting the approximations in the root neighbourhood. */
+  pairs = mps_conjugate_mpairs (s);
+
   /* Check if we have already approxmiated roots */
   for (i = 0; i < s->n; i++)
     if (!s->root[i]->again)
       nzeros++;
   if (nzeros == s->n)
     {
+      if (pairs)
+        mps_conjugate_packet_done (s, pairs, nzeros);
       return;
     }
 
@@ -582,12 +988,16 @@ mps_thread_mpolzer (mps_context * s, int *it, mps_boolean * excep, int required_
       data[i].queue = queue;
       data[i].roots_mutex = roots_mutex;
       data[i].required_zeros = required_zeros;
+      data[i].pairs = pairs;
       mps_thread_pool_assign (s, s->pool, mps_thread_mpolzer_worker, data + i);
     }
 
   /* Wait for the threads to complete */
   mps_thread_pool_wait (s, s->pool);
 
+  if (pairs)
+    mps_conjugate_packet_done (s, pairs, nzeros);
+
   /* Free data and exit */
   free (data);
   for (i = 0; i < s->n; i++)
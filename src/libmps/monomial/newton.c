@@ -36,95 +36,184 @@ MPS_PRIVATE void
 mps_fnewton (mps_context * s, mps_polynomial * poly, mps_approximation * root,
              cplx_t corr)
 {
-  int i;
-  double ap, az, absp, azi, eps;
-  cplx_t p, p1, zi, den, ppsp, tmp;
+  mps_fnewton_block (s, poly, &root, 1, (cplx_t *) corr);
+}
 
-  mps_monomial_poly *mp = MPS_MONOMIAL_POLY (poly);
-  cplx_t *fpc = mp->fpc;
-  double *fap = mp->fap;
-  int n = poly->degree;
+/*
+ * Complete the computation of mps_fnewton() for a point z with |z| <= 1,
+ * given the values p and p1 computed by mps_fhorner_block().
+ *
+ * If the value of p is below the bound to the rounding errors of the
+ * Horner scheme, it is computed again with mps_fhorner_compensated(),
+ * whose error bound is much smaller. In this way the iterations can
+ * go on, and the inclusion radii shrink, as if they were carried out in
+ * twice the working precision, which is usually enough to separate the
+ * ill-conditioned roots without switching to multiprecision.
+ */
+static void
+mps_fnewton_inside (mps_context * s, mps_monomial_poly * mp, mps_approximation * root,
+                    cplx_t p, cplx_t p1, double ap, cplx_t corr)
+{
+  int n = MPS_POLYNOMIAL (mp)->degree;
+  double absp, error, eps = 4 * n * DBL_EPSILON;
 
-  cplx_t z;
+  absp = cplx_mod (p);
+  root->again = (absp > ap * eps);
 
-  cplx_set (z, root->fvalue);
-  double * radius = &root->frad;
-  mps_boolean * cont = &root->again;
+  if (root->again || cplx_mod (p1) == 0)
+    {
+      root->frad = n * (absp + eps * ap) / cplx_mod (p1) + DBL_MIN;
+      cplx_div (corr, p, p1);
+      return;
+    }
+
+  mps_fhorner_compensated (s, mp, root->fvalue, false, p, &error);
+  absp = cplx_mod (p);
+  cplx_div (corr, p, p1);
+
+  /* Stop when the correction cannot move the approximation anymore */
+  root->again = (absp > error) && (cplx_mod (corr) > DBL_EPSILON * cplx_mod (root->fvalue));
+  root->frad = n * (absp + error) / cplx_mod (p1) + DBL_MIN;
+}
+
+/*
+ * Complete the computation of mps_fnewton() for a point z with |z| > 1,
+ * given the values p and p1 of the reversed polynomial at zi = 1 / z
+ * computed by mps_fhorner_block().
+ *
+ * As in mps_fnewton_inside(), the value of the reversed polynomial is
+ * computed again with the compensated Horner scheme when it is below the
+ * rounding errors. Since zi is only an approximation of 1 / z, the
+ * inclusion radius is then enlarged by the distance between z and 1 / zi.
+ */
+static void
+mps_fnewton_outside (mps_context * s, mps_monomial_poly * mp, mps_approximation * root,
+                     cplx_t z, double az, cplx_t zi, cplx_t p, cplx_t p1, double ap, cplx_t corr)
+{
+  int n = MPS_POLYNOMIAL (mp)->degree;
+  double absp, error, eps = 4 * n * DBL_EPSILON;
+  cplx_t den, ppsp;
+
+  absp = cplx_mod (p);
+  root->again = (absp > ap * eps);
 
-  eps = 4 * n * DBL_EPSILON;
-  az = cplx_mod (z);
+  cplx_mul_d (den, p, (double)n);
+  cplx_mul (ppsp, p1, zi);
+  cplx_sub_eq (den, ppsp);
+  cplx_mul_eq (den, zi);
 
-  /* distinguish the cases |z|<=1, |z|>1 */
-  if (az <= 1)
+  if (!root->again && cplx_mod (den) != 0)
     {
-      /*  case |z|<=1 */
-      cplx_set (p, fpc[n]);
-      cplx_set (p1, p);
-      for (i = n - 1; i > 0; i--)
-        {
-          cplx_mul (tmp, p, z);
-          cplx_add (p, tmp, fpc[i]);
-          cplx_mul (tmp, p1, z);
-          cplx_add (p1, tmp, p);
-        }
-      cplx_mul (tmp, p, z);
-      cplx_add (p, tmp, fpc[0]);
-      ap = fap[n];
-      for (i = n - 1; i >= 0; i--)
-        ap = ap * az + fap[i];
+      mps_fhorner_compensated (s, mp, zi, true, p, &error);
       absp = cplx_mod (p);
-      *cont = (absp > ap * eps);
-      *radius = n * (absp + eps * ap) / cplx_mod (p1) + DBL_MIN;
-      cplx_div (corr, p, p1);
+      cplx_div (corr, p, den);
+
+      root->again = (absp > error) && (cplx_mod (corr) > DBL_EPSILON * az);
+      root->frad = n * (absp + error) / cplx_mod (den) + 2 * DBL_EPSILON * az;
+      return;
+    }
+
+  if (cplx_mod (den) != 0)
+    {
+      cplx_div (corr, p, den);
+      ap = (ap * eps + absp) * n;
+      ap = ap / cplx_mod (den);
+      root->frad = ap;
     }
   else
-    {                           /* case |z|>1 */
-      cplx_set (zi, z);
-      cplx_inv_eq (zi);
-      azi = 1.0 / az;
-      cplx_set (p, fpc[0]);
-      cplx_set (p1, p);
-      for (i = n - 1; i > 0; i--)
+    {
+      cplx_mul (ppsp, p, z);
+      cplx_div_eq (ppsp, p1);
+      cplx_mul_d (den, ppsp, (double)n);
+      cplx_sub_eq (den, cplx_one);
+      cplx_div (corr, ppsp, den);
+      cplx_mul_eq (corr, z);
+      absp = cplx_mod (p);
+      root->again = (absp > ap * eps);
+
+      root->frad = cplx_mod (ppsp) + (eps * ap * az) / cplx_mod (p1);
+      root->frad *= n / cplx_mod (den);
+      root->frad *= az;
+    }
+}
+
+/**
+ * @brief Compute the Newton corrections of mps_fnewton() for m
+ * approximations at once.
+ *
+ * The approximations are split in blocks of <code>MPS_HORNER_BLOCK_SIZE</code>
+ * points, and the polynomial is evaluated on every block with
+ * mps_fhorner_block(), so that the coefficients are read from memory once
+ * per block instead of once per point. The results are the same that would
+ * be obtained by calling mps_fnewton() on every approximation.
+ *
+ * @param s The mps_context struct pointer.
+ * @param poly The polynomial to evaluate, casted to a mps_polynomial.
+ * @param roots The approximations where the Newton correction should be evaluated.
+ * @param m The number of approximations.
+ * @param corr The array where the Newton corrections will be stored.
+ */
+MPS_PRIVATE void
+mps_fnewton_block (mps_context * s, mps_polynomial * poly, mps_approximation ** roots,
+                   int m, cplx_t * corr)
+{
+  mps_monomial_poly *mp = MPS_MONOMIAL_POLY (poly);
+
+  cplx_t x[MPS_HORNER_BLOCK_SIZE], p[MPS_HORNER_BLOCK_SIZE], p1[MPS_HORNER_BLOCK_SIZE];
+  double ax[MPS_HORNER_BLOCK_SIZE], ap[MPS_HORNER_BLOCK_SIZE];
+  int index[MPS_HORNER_BLOCK_SIZE];
+  int start, end, i, k;
+
+  for (start = 0; start < m; start = end)
+    {
+      end = MIN (m, start + MPS_HORNER_BLOCK_SIZE);
+
+      /* Points in the unit disc, where p is evaluated directly */
+      for (i = start, k = 0; i < end; i++)
         {
-          cplx_mul (tmp, p, zi);
-          cplx_add (p, tmp, fpc[n - i]);
-          cplx_mul (tmp, p1, zi);
-          cplx_add (p1, tmp, p);
+          double az = cplx_mod (roots[i]->fvalue);
+
+          if (az <= 1)
+            {
+              index[k] = i;
+              cplx_set (x[k], roots[i]->fvalue);
+              ax[k++] = az;
+            }
         }
-      cplx_mul (tmp, p, zi);
-      cplx_add (p, tmp, fpc[n]);
 
-      ap = fap[0];
-      for (i = 1; i <= n; i++)
-        ap = ap * azi + fap[i];
-      absp = cplx_mod (p);
-      *cont = (absp > ap * eps);
+      if (k > 0)
+        {
+          mps_fhorner_block (s, mp, k, x, ax, false, p, p1, ap);
+
+          for (i = 0; i < k; i++)
+            mps_fnewton_inside (s, mp, roots[index[i]], p[i], p1[i], ap[i], corr[index[i]]);
+        }
 
-      cplx_mul_d (den, p, (double)n);
-      cplx_mul (ppsp, p1, zi);
-      cplx_sub_eq (den, ppsp);
-      cplx_mul_eq (den, zi);
-      if (cplx_mod (den) != 0)
+      /* Points outside the unit disc, where the reversed polynomial is
+       * evaluated at 1 / z */
+      for (i = start, k = 0; i < end; i++)
         {
-          cplx_div (corr, p, den);
-          ap = (ap * eps + absp) * n;
-          ap = ap / cplx_mod (den);
-          *radius = ap;
+          double az = cplx_mod (roots[i]->fvalue);
+
+          if (!(az <= 1))
+            {
+              index[k] = i;
+              cplx_set (x[k], roots[i]->fvalue);
+              cplx_inv_eq (x[k]);
+              ax[k++] = 1.0 / az;
+            }
         }
-      else
+
+      if (k > 0)
         {
-          cplx_mul (ppsp, p, z);
-          cplx_div_eq (ppsp, p1);
-          cplx_mul_d (den, ppsp, (double)n);
-          cplx_sub_eq (den, cplx_one);
-          cplx_div (corr, ppsp, den);
-          cplx_mul_eq (corr, z);
-          absp = cplx_mod (p);
-          *cont = (absp > ap * eps);
-
-          *radius = cplx_mod (ppsp) + (eps * ap * az) / cplx_mod (p1);
-          *radius *= n / cplx_mod (den);
-          *radius *= az;
+          mps_fhorner_block (s, mp, k, x, ax, true, p, p1, ap);
+
+          for (i = 0; i < k; i++)
+            {
+              mps_approximation * root = roots[index[i]];
+              mps_fnewton_outside (s, mp, root, root->fvalue, cplx_mod (root->fvalue), x[i],
+                                   p[i], p1[i], ap[i], corr[index[i]]);
+            }
         }
     }
 }
@@ -156,31 +245,27 @@ MPS_PRIVATE void
 mps_dnewton (mps_context * s, mps_polynomial * poly, mps_approximation * root,
              cdpe_t corr)
 {
-  int i;
-  rdpe_t ap, az, absp, rnew, apeps, rtmp;
-  cdpe_t p, p1, tmp, z;
-  double eps;
-
-  mps_monomial_poly *mp = MPS_MONOMIAL_POLY (poly);
-  cdpe_t * dpc = mp->dpc;
-  rdpe_t * dap = mp->dap;
-  int n = poly->degree;
+  mps_dnewton_block (s, poly, &root, 1, (cdpe_t *) corr);
+}
 
-  cdpe_set (z, root->dvalue);
+/*
+ * Complete the computation of mps_dnewton() given the values p, p1 and ap
+ * computed by mps_dhorner_block().
+ *
+ * As in the floating point case, the value of the polynomial is computed
+ * again with mps_dhorner_compensated() when it is below the rounding
+ * errors of the Horner scheme, and the iterations stop only when the
+ * compensated value is not reliable anymore either.
+ */
+static void
+mps_dnewton_finish (mps_context * s, mps_monomial_poly * mp, mps_approximation * root,
+                    rdpe_t az, cdpe_t p, cdpe_t p1, rdpe_t ap, cdpe_t corr)
+{
+  rdpe_t absp, rnew, apeps, rtmp;
   mps_boolean * cont = &root->again;
+  int n = MPS_POLYNOMIAL (mp)->degree;
+  double eps = DBL_EPSILON * n * 4;
 
-  eps = DBL_EPSILON * n * 4;
-  cdpe_set (p, dpc[n]);
-  cdpe_set (p1, p);
-  for (i = n - 1; i > 0; i--)
-    {
-      cdpe_mul (tmp, p, z);
-      cdpe_add (p, tmp, dpc[i]);
-      cdpe_mul (tmp, p1, z);
-      cdpe_add (p1, tmp, p);
-    }
-  cdpe_mul (tmp, p, z);
-  cdpe_add (p, tmp, dpc[0]);
   if (cdpe_ne (p, cdpe_zero))
     if (cdpe_eq (p1, cdpe_zero))
       {
@@ -197,17 +282,23 @@ mps_dnewton (mps_context * s, mps_polynomial * poly, mps_approximation * root,
       cdpe_set (corr, cdpe_zero);
       *cont = false;
     }
-  cdpe_mod (az, z);
-  rdpe_set (ap, dap[n]);
-  for (i = n - 1; i >= 0; i--)
-    {
-      rdpe_mul (rtmp, ap, az);
-      rdpe_add (ap, rtmp, dap[i]);
-    }
+
   cdpe_mod (absp, p);
   rdpe_mul_d (apeps, ap, eps);
   *cont = rdpe_gt (absp, apeps);
 
+  if (!*cont && cdpe_ne (p1, cdpe_zero))
+    {
+      mps_dhorner_compensated (s, mp, root->dvalue, p, apeps);
+      cdpe_mod (absp, p);
+      cdpe_div (corr, p, p1);
+
+      /* Stop when the correction cannot move the approximation anymore */
+      cdpe_mod (rnew, corr);
+      rdpe_mul_d (rtmp, az, DBL_EPSILON);
+      *cont = rdpe_gt (absp, apeps) && rdpe_gt (rnew, rtmp);
+    }
+
   rdpe_add (rnew, absp, apeps);
   cdpe_mod (rtmp, p1);
 
@@ -225,6 +316,47 @@ mps_dnewton (mps_context * s, mps_polynomial * poly, mps_approximation * root,
   rdpe_add_eq (root->drad, rtmp);
 }
 
+/**
+ * @brief Compute the Newton corrections of mps_dnewton() for m
+ * approximations at once.
+ *
+ * This is the DPE version of mps_fnewton_block(), which evaluates the
+ * polynomial with mps_dhorner_block().
+ *
+ * @param s The mps_context struct pointer.
+ * @param poly The polynomial to evaluate, casted to a mps_polynomial.
+ * @param roots The approximations where the Newton correction should be evaluated.
+ * @param m The number of approximations.
+ * @param corr The array where the Newton corrections will be stored.
+ */
+MPS_PRIVATE void
+mps_dnewton_block (mps_context * s, mps_polynomial * poly, mps_approximation ** roots,
+                   int m, cdpe_t * corr)
+{
+  mps_monomial_poly *mp = MPS_MONOMIAL_POLY (poly);
+
+  cdpe_t x[MPS_HORNER_BLOCK_SIZE], p[MPS_HORNER_BLOCK_SIZE], p1[MPS_HORNER_BLOCK_SIZE];
+  rdpe_t ax[MPS_HORNER_BLOCK_SIZE], ap[MPS_HORNER_BLOCK_SIZE];
+  int start, end, i;
+
+  for (start = 0; start < m; start = end)
+    {
+      end = MIN (m, start + MPS_HORNER_BLOCK_SIZE);
+
+      for (i = start; i < end; i++)
+        {
+          cdpe_set (x[i - start], roots[i]->dvalue);
+          cdpe_mod (ax[i - start], x[i - start]);
+        }
+
+      mps_dhorner_block (s, mp, end - start, x, ax, p, p1, ap);
+
+      for (i = start; i < end; i++)
+        mps_dnewton_finish (s, mp, roots[i], ax[i - start], p[i - start], p1[i - start],
+                            ap[i - start], corr[i]);
+    }
+}
+
 /**
  * @brief Logarithm in base 2 of n.
  *
@@ -276,15 +408,16 @@ mps_mnewton (mps_context * s, mps_polynomial * poly,
   int i;
   rdpe_t ap, az, absp, temp, rnew, ep, apeps;
   cdpe_t temp1;
-  mpc_t p, p1;
+  mpc_scratch * sc = mpc_scratch_get ();
+  mpc_ptr p, p1;
 
   mps_monomial_poly * mp = MPS_MONOMIAL_POLY (poly);
   mpc_t * mfpc = mp->mfpc;
   rdpe_t * dap = mp->dap;
   int n = poly->degree;
 
-  mpc_init2 (p, wp);
-  mpc_init2 (p1, wp);
+  p = mpc_scratch_push (sc, wp);
+  p1 = mpc_scratch_push (sc, wp);
 
   rdpe_set_2dl (ep, 1.0, 2 - wp);
   rdpe_mul_eq_d (ep, n);
@@ -323,13 +456,10 @@ mps_mnewton (mps_context * s, mps_polynomial * poly,
       mpc_set (p1, p);
       for (i = n - 1; i > 0; i--)
         {
-          mpc_mul (p, p, root->mvalue);
-          mpc_add (p, p, mfpc[i]);
-          mpc_mul (p1, p1, root->mvalue);
-          mpc_add (p1, p1, p);
+          mpc_horner_step_scratch (sc, p, root->mvalue, mfpc[i]);
+          mpc_horner_step_scratch (sc, p1, root->mvalue, p);
         }
-      mpc_mul (p, p, root->mvalue);
-      mpc_add (p, p, mfpc[0]);
+      mpc_horner_step_scratch (sc, p, root->mvalue, mfpc[0]);
 
       /* compute bound to the error */
       rdpe_set (ap, dap[n]);
@@ -353,7 +483,7 @@ mps_mnewton (mps_context * s, mps_polynomial * poly,
         goto exit_sub;
       }
     else
-      mpc_div (corr, p, p1);
+      mpc_div_scratch (sc, corr, p, p1);
   else
     {
       mpc_set_ui (corr, 0U, 0U);
@@ -393,6 +523,125 @@ mps_mnewton (mps_context * s, mps_polynomial * poly,
   rdpe_add_eq (root->drad, az);
 
 exit_sub:
-  mpc_clear (p1);
-  mpc_clear (p);
+  mpc_scratch_pop (sc, 2);
+}
+
+/*
+ * Evaluate in double-double arithmetic the polynomial, or its reversal
+ * x^n p(1/x) if reversed is true, together with its derivative, and
+ * the polynomial with coefficients equal to the moduli of the ones of p at
+ * the modulus ax of x.
+ */
+static void
+mps_ddhorner_newton (mps_monomial_poly * mp, cdd_t x, double ax, mps_boolean reversed,
+                     cdd_t p, cdd_t p1, double * ap)
+{
+  int n = MPS_POLYNOMIAL (mp)->degree;
+  int i, k;
+
+  k = reversed ? 0 : n;
+  cdd_set (p, mp->ddpc[k]);
+  cdd_set (p1, p);
+  *ap = cdd_mod_bound (mp->ddpc[k]);
+
+  for (i = n - 1; i > 0; i--)
+    {
+      k = reversed ? n - i : i;
+      cdd_mul (p, p, x);
+      cdd_add (p, p, mp->ddpc[k]);
+      cdd_mul (p1, p1, x);
+      cdd_add (p1, p1, p);
+      *ap = *ap * ax + cdd_mod_bound (mp->ddpc[k]);
+    }
+
+  k = reversed ? n : 0;
+  cdd_mul (p, p, x);
+  cdd_add (p, p, mp->ddpc[k]);
+  *ap = *ap * ax + cdd_mod_bound (mp->ddpc[k]);
+}
+
+/**
+ * @brief Double-double version of mps_mnewton().
+ *
+ * As in mps_fnewton(), the points out of the unit disc are handled by
+ * evaluating the reversed polynomial at \f$1/z\f$, so that no overflow
+ * can happen with the coefficients accepted by
+ * mps_monomial_poly_update_dd_coefficients().
+ *
+ * @param s The mps_context struct pointer.
+ * @param poly The polynomial to evaluate, casted to a mps_polynomial.
+ * @param root The approximation where the newton correction should be
+ * evaluated; its value is read from the field <code>ddvalue</code>.
+ * @param corr The complex value of the newton correction.
+ * @return false if the correction could not be computed in double-double
+ * arithmetic, in which case mps_mnewton() should be used instead.
+ */
+MPS_PRIVATE mps_boolean
+mps_ddnewton (mps_context * s, mps_polynomial * poly,
+              mps_approximation * root, cdd_t corr)
+{
+  mps_monomial_poly * mp = MPS_MONOMIAL_POLY (poly);
+  int n = poly->degree;
+  cdd_t x, p, p1, den, t;
+  double ax, ap, absp, absd, apeps, rnew, ep;
+  mps_boolean reversed;
+
+  if (!mp->ddpc_valid)
+    return false;
+
+  ep = ldexp ((double)n, 2 - MPS_DD_PRECISION);
+
+  ax = cdd_mod (root->ddvalue);
+  reversed = (ax > 1);
+
+  if (reversed)
+    {
+      cdd_set_d (t, 1.0, 0.0);
+      cdd_div (x, t, root->ddvalue);
+      mps_ddhorner_newton (mp, x, 1 / ax, true, p, p1, &ap);
+
+      /* p(z) / p'(z) = q(x) / ((n q(x) - x q'(x)) x), where x = 1 / z and
+       * q is the reversed polynomial. */
+      cdd_mul_d (den, p, (double)n);
+      cdd_mul (t, p1, x);
+      cdd_sub (den, den, t);
+      cdd_mul (den, den, x);
+    }
+  else
+    {
+      mps_ddhorner_newton (mp, root->ddvalue, ax, false, p, den, &ap);
+    }
+
+  if (!isfinite (ap) || !isfinite (cdd_mod_bound (den)))
+    return false;
+
+  absp = cdd_mod (p);
+  absd = cdd_mod (den);
+  apeps = ap * ep;
+
+  if (absd == 0)
+    {
+      if (s->DOLOG)
+        fprintf (s->logstr, "%s", "NULL DERIVATIVE\n");
+      root->again = false;
+      cdd_set_d (corr, 0.0, 0.0);
+      return true;
+    }
+
+  if (absp == 0)
+    {
+      cdd_set_d (corr, 0.0, 0.0);
+      root->again = false;
+      rdpe_set_d (root->drad, apeps / absd * (n + 1));
+      return true;
+    }
+
+  cdd_div (corr, p, den);
+  root->again = (absp > apeps);
+
+  rnew = (absp + apeps) / absd;
+  rnew *= root->again ? n : n + 1;
+  rdpe_set_d (root->drad, rnew + ax * ep);
+
+  return true;
 }
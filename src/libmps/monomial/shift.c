@@ -47,6 +47,8 @@ mps_fshift (mps_context * s, int m, mps_cluster_item * cluster_item, double clus
   cplx_t t;
   mps_monomial_poly *p = MPS_MONOMIAL_POLY (s->active_poly);
 
+  mps_monomial_poly_ensure_fppc (s, p);
+
   /* Perform divisions */
   ag = cplx_mod (g);
   for (i = 0; i <= s->n; i++)
@@ -0,0 +1,623 @@
+/*
+ * This file is part of MPSolve 3.1.5
+ *
+ * Copyright (C) 2001-2015, Dipartimento di Matematica "L. Tonelli", Pisa.
+ * License: http://www.gnu.org/licenses/gpl.html GPL version 3 or higher
+ *
+ * Authors:
+ *   Leonardo Robol <leonardo.robol@sns.it>
+ */
+
+/*
+ * Evaluation of a sparse polynomial p(x) = c_0 x^{e_0} + ... + c_k x^{e_k}
+ * with the sparse Horner scheme
+ *
+ *   v_k = c_k,   v_j = v_{j+1} x^{g_j} + c_j,   p(x) = v_0 x^{e_0},
+ *
+ * where g_j = e_{j+1} - e_j and the powers are computed by repeated squaring,
+ * so that the cost is O(k log n) instead of O(n). The derivative is obtained
+ * by differentiating the recurrence, i.e.,
+ *
+ *   v'_j = (v'_{j+1} x + g_j v_{j+1}) x^{g_j - 1}.
+ *
+ * A power x^g computed by repeated squaring is affected by a relative error of
+ * at most g + log2(g) times the one of a complex product, since every squaring
+ * doubles the error of its operand, so the error on
+ * p(x) is bounded by m u ap(|x|), where ap has the moduli of the coefficients
+ * of p, and m counts the operations of the longest chain in the recurrence.
+ *
+ * Out of the unit disc the powers of x overflow the doubles long before the
+ * value of p does, so there the floating point version evaluates instead the
+ * reversed polynomial x^n p(1/x), whose terms are visited in the opposite
+ * order with the same gaps.
+ */
+
+#include <mps/mps.h>
+#include <math.h>
+
+#define MPS_STARTING_SIGMA (0.66 * (PI / ctx->n))
+#define pi2 6.283184
+
+/* Number of rounding errors that a power x^g may accumulate */
+static int
+mps_sparse_power_errors (long int g)
+{
+  int bits = 0;
+  long int h = g;
+
+  while (h)
+    {
+      bits++;
+      h >>= 1;
+    }
+
+  /* The relative error of x^(2^k) is 2^k - 1 times the one of a product,
+   * and the result is the product of at most bits of them. Each product
+   * has an error of sqrt(5) u < 3u. */
+  return 3 * (g + bits);
+}
+
+/*
+ * Exponent of the j-th term of the polynomial evaluated by
+ * mps_sparse_fhorner(), i.e., of p(x) or of its reversal x^n p(1/x).
+ */
+static int
+mps_sparse_exponent (mps_sparse_monomial_poly * sp, int j, mps_boolean reversed)
+{
+  if (reversed)
+    return MPS_POLYNOMIAL (sp)->degree - sp->exponents[sp->n_terms - 1 - j];
+  else
+    return sp->exponents[j];
+}
+
+static void
+mps_sparse_fhorner (mps_sparse_monomial_poly * sp, cplx_t x, mps_boolean reversed,
+                    cplx_t p, cplx_t p1, double * error)
+{
+  int j, k, g, m = 3;
+  double ax = cplx_mod (x), ap;
+  cplx_t y, xg, t;
+
+  if (sp->n_terms == 0)
+    {
+      cplx_set (p, cplx_zero);
+      if (p1)
+        cplx_set (p1, cplx_zero);
+      *error = 0.0;
+      return;
+    }
+
+  k = reversed ? 0 : sp->n_terms - 1;
+  cplx_set (p, sp->fpc[k]);
+  if (p1)
+    cplx_set (p1, cplx_zero);
+  ap = sp->fap[k];
+
+  for (j = sp->n_terms - 2; j >= -1; j--)
+    {
+      g = mps_sparse_exponent (sp, j + 1, reversed) -
+          ((j >= 0) ? mps_sparse_exponent (sp, j, reversed) : 0);
+      if (g == 0)
+        break;
+
+      cplx_pow_si (y, x, g - 1);
+      cplx_mul (xg, y, x);
+
+      if (p1)
+        {
+          cplx_mul_eq (p1, x);
+          cplx_mul_d (t, p, (double) g);
+          cplx_add_eq (p1, t);
+          cplx_mul_eq (p1, y);
+        }
+
+      cplx_mul_eq (p, xg);
+      ap *= pow (ax, g);
+      m += mps_sparse_power_errors (g);
+
+      if (j >= 0)
+        {
+          k = reversed ? sp->n_terms - 1 - j : j;
+          cplx_add_eq (p, sp->fpc[k]);
+          ap += sp->fap[k];
+        }
+    }
+
+  /* The products that underflow lose at most DBL_MIN each */
+  *error = m * (ap * DBL_EPSILON + DBL_MIN);
+}
+
+static void
+mps_sparse_dhorner (mps_sparse_monomial_poly * sp, cdpe_t x, cdpe_t p, cdpe_t p1, rdpe_t error)
+{
+  int j, g, m = 3;
+  rdpe_t ax, ap, rtmp;
+  cdpe_t y, xg, t;
+
+  if (sp->n_terms == 0)
+    {
+      cdpe_set (p, cdpe_zero);
+      if (p1)
+        cdpe_set (p1, cdpe_zero);
+      rdpe_set (error, rdpe_zero);
+      return;
+    }
+
+  cdpe_mod (ax, x);
+  cdpe_set (p, sp->dpc[sp->n_terms - 1]);
+  if (p1)
+    cdpe_set (p1, cdpe_zero);
+  rdpe_set (ap, sp->dap[sp->n_terms - 1]);
+
+  for (j = sp->n_terms - 2; j >= -1; j--)
+    {
+      g = sp->exponents[j + 1] - ((j >= 0) ? sp->exponents[j] : 0);
+      if (g == 0)
+        break;
+
+      cdpe_pow_si (y, x, g - 1);
+      cdpe_mul (xg, y, x);
+
+      if (p1)
+        {
+          cdpe_mul_eq (p1, x);
+          cdpe_mul_d (t, p, (double) g);
+          cdpe_add_eq (p1, t);
+          cdpe_mul_eq (p1, y);
+        }
+
+      cdpe_mul_eq (p, xg);
+      rdpe_pow_si (rtmp, ax, g);
+      rdpe_mul_eq (ap, rtmp);
+      m += mps_sparse_power_errors (g);
+
+      if (j >= 0)
+        {
+          cdpe_add_eq (p, sp->dpc[j]);
+          rdpe_add_eq (ap, sp->dap[j]);
+        }
+    }
+
+  rdpe_mul_d (error, ap, m * DBL_EPSILON);
+}
+
+static void
+mps_sparse_mhorner (mps_sparse_monomial_poly * sp, mpc_t x, mpc_t p, mpc_t p1, rdpe_t error, long int wp)
+{
+  mpc_scratch * sc = mpc_scratch_get ();
+  int j, g, m = 3;
+  rdpe_t ax, ap, rtmp;
+  mpc_ptr y, xg, t;
+
+  if (sp->n_terms == 0)
+    {
+      mpc_set_ui (p, 0U, 0U);
+      if (p1)
+        mpc_set_ui (p1, 0U, 0U);
+      rdpe_set (error, rdpe_zero);
+      return;
+    }
+
+  y = mpc_scratch_push (sc, wp);
+  xg = mpc_scratch_push (sc, wp);
+  t = mpc_scratch_push (sc, wp);
+
+  mpc_rmod (ax, x);
+  mpc_set (p, sp->mfpc[sp->n_terms - 1]);
+  if (p1)
+    mpc_set_ui (p1, 0U, 0U);
+  rdpe_set (ap, sp->dap[sp->n_terms - 1]);
+
+  for (j = sp->n_terms - 2; j >= -1; j--)
+    {
+      g = sp->exponents[j + 1] - ((j >= 0) ? sp->exponents[j] : 0);
+      if (g == 0)
+        break;
+
+      mpc_pow_si (y, x, g - 1);
+      mpc_mul_scratch (sc, xg, y, x);
+
+      if (p1)
+        {
+          mpc_mul_scratch (sc, p1, p1, x);
+          mpc_mul_ui (t, p, g);
+          mpc_add_eq (p1, t);
+          mpc_mul_scratch (sc, p1, p1, y);
+        }
+
+      mpc_mul_scratch (sc, p, p, xg);
+      rdpe_pow_si (rtmp, ax, g);
+      rdpe_mul_eq (ap, rtmp);
+      m += mps_sparse_power_errors (g);
+
+      if (j >= 0)
+        {
+          mpc_add (p, p, sp->mfpc[j]);
+          rdpe_add_eq (ap, sp->dap[j]);
+        }
+    }
+
+  rdpe_set_2dl (rtmp, (double) m, 1 - wp);
+  rdpe_mul (error, ap, rtmp);
+
+  mpc_scratch_pop (sc, 3);
+}
+
+mps_boolean
+mps_sparse_monomial_poly_feval (mps_context * ctx, mps_polynomial * p, cplx_t x, cplx_t value, double * error)
+{
+  mps_sparse_fhorner (MPS_SPARSE_MONOMIAL_POLY (p), x, false, value, NULL, error);
+  return isfinite (*error);
+}
+
+mps_boolean
+mps_sparse_monomial_poly_deval (mps_context * ctx, mps_polynomial * p, cdpe_t x, cdpe_t value, rdpe_t error)
+{
+  mps_sparse_dhorner (MPS_SPARSE_MONOMIAL_POLY (p), x, value, NULL, error);
+  return true;
+}
+
+mps_boolean
+mps_sparse_monomial_poly_meval (mps_context * ctx, mps_polynomial * p, mpc_t x, mpc_t value, rdpe_t error)
+{
+  long int wp = mpc_get_prec (x);
+
+  mps_polynomial_raise_data (ctx, p, wp);
+
+  mps_sparse_mhorner (MPS_SPARSE_MONOMIAL_POLY (p), x, value, NULL, error, wp);
+  return true;
+}
+
+void
+mps_sparse_monomial_poly_fnewton (mps_context * ctx, mps_polynomial * poly,
+                                  mps_approximation * root, cplx_t corr)
+{
+  int n = poly->degree;
+  cplx_t x, p, p1, den;
+  double absp, error;
+  mps_boolean reversed = cplx_mod (root->fvalue) > 1;
+
+  /* For |z| > 1 evaluate q(x) = x^n p(1 / x) at x = 1 / z, and use
+   * p(z) / p'(z) = q(x) / ((n q(x) - x q'(x)) x), as mps_fnewton() does. */
+  if (reversed)
+    {
+      cplx_inv (x, root->fvalue);
+      mps_sparse_fhorner (MPS_SPARSE_MONOMIAL_POLY (poly), x, true, p, p1, &error);
+
+      cplx_mul_d (den, p, (double) n);
+      cplx_mul_eq (p1, x);
+      cplx_sub_eq (den, p1);
+      cplx_mul_eq (den, x);
+    }
+  else
+    mps_sparse_fhorner (MPS_SPARSE_MONOMIAL_POLY (poly), root->fvalue, false, p, den, &error);
+
+  if (!isfinite (error) || cplx_check_fpe (p) || cplx_check_fpe (den))
+    {
+      root->status = MPS_ROOT_STATUS_NOT_FLOAT;
+      root->again = false;
+      cplx_set (corr, cplx_zero);
+      return;
+    }
+
+  absp = cplx_mod (p);
+  root->again = absp > error;
+
+  if (cplx_eq_zero (den))
+    {
+      cplx_set (corr, cplx_zero);
+      root->again = false;
+      return;
+    }
+
+  cplx_div (corr, p, den);
+  root->frad = n * (absp + error) / cplx_mod (den) + DBL_MIN;
+}
+
+void
+mps_sparse_monomial_poly_dnewton (mps_context * ctx, mps_polynomial * poly,
+                                  mps_approximation * root, cdpe_t corr)
+{
+  cdpe_t p, p1;
+  rdpe_t absp, error, rtmp;
+
+  mps_sparse_dhorner (MPS_SPARSE_MONOMIAL_POLY (poly), root->dvalue, p, p1, error);
+
+  cdpe_mod (absp, p);
+  root->again = rdpe_gt (absp, error);
+
+  if (cdpe_eq_zero (p1))
+    {
+      cdpe_set (corr, cdpe_zero);
+      root->again = false;
+      return;
+    }
+
+  cdpe_div (corr, p, p1);
+
+  rdpe_add (root->drad, absp, error);
+  rdpe_mul_eq_d (root->drad, (double) poly->degree);
+  cdpe_mod (rtmp, p1);
+  rdpe_div_eq (root->drad, rtmp);
+}
+
+void
+mps_sparse_monomial_poly_mnewton (mps_context * ctx, mps_polynomial * poly,
+                                  mps_approximation * root, mpc_t corr, long int wp)
+{
+  mpc_scratch * sc = mpc_scratch_get ();
+  mpc_ptr p, p1;
+  rdpe_t absp, error, rtmp;
+
+  if (poly->prec > 0 && poly->prec < wp)
+    wp = poly->prec;
+
+  mps_polynomial_raise_data (ctx, poly, wp);
+
+  p = mpc_scratch_push (sc, wp);
+  p1 = mpc_scratch_push (sc, wp);
+
+  mps_sparse_mhorner (MPS_SPARSE_MONOMIAL_POLY (poly), root->mvalue, p, p1, error, wp);
+
+  mpc_rmod (absp, p);
+  root->again = rdpe_gt (absp, error);
+
+  if (mpc_eq_zero (p1))
+    {
+      mpc_set_ui (corr, 0U, 0U);
+      root->again = false;
+    }
+  else
+    {
+      mpc_div_scratch (sc, corr, p, p1);
+
+      rdpe_add (root->drad, absp, error);
+      rdpe_mul_eq_d (root->drad, (double) poly->degree);
+      mpc_rmod (rtmp, p1);
+      rdpe_div_eq (root->drad, rtmp);
+    }
+
+  mpc_scratch_pop (sc, 2);
+}
+
+/*
+ * The starting points are placed on the circles given by the Newton polygon
+ * of the points (e_j, log |c_j|), i.e., by the upper convex hull of these
+ * points, that can be computed directly on the terms without expanding
+ * the coefficients to a dense vector. The indices of the terms on the hull
+ * are stored in h, and their number is returned.
+ */
+static int
+mps_sparse_convex_hull (mps_sparse_monomial_poly * sp, double * la, int * h)
+{
+  int j, m = 0;
+
+  for (j = 0; j < sp->n_terms; j++)
+    {
+      if (la[j] == -HUGE_VAL)
+        continue;
+
+      /* Remove the last vertex while it is not above the segment
+       * connecting the previous one and the j-th term. */
+      while (m >= 2 &&
+             (la[h[m - 1]] - la[h[m - 2]]) * (sp->exponents[j] - sp->exponents[h[m - 2]]) <=
+             (la[j] - la[h[m - 2]]) * (sp->exponents[h[m - 1]] - sp->exponents[h[m - 2]]))
+        m--;
+
+      h[m++] = j;
+    }
+
+  return m;
+}
+
+/*
+ * Compute the logarithms of the radii of the circles, and the corresponding
+ * partitioning of the approximations. The first exponents[0] approximations
+ * are the zero roots, that have radius -HUGE_VAL. Return the number of
+ * circles.
+ */
+static int
+mps_sparse_starting_radii (mps_sparse_monomial_poly * sp, double * la, int * partitioning, double * radii)
+{
+  int * h = mps_newv (int, sp->n_terms);
+  int i, m, n_radii = 0;
+
+  partitioning[0] = 0;
+  if (sp->n_terms > 0 && sp->exponents[0] > 0)
+    {
+      radii[n_radii] = -HUGE_VAL;
+      partitioning[++n_radii] = sp->exponents[0];
+    }
+
+  m = mps_sparse_convex_hull (sp, la, h);
+  for (i = 1; i < m; i++)
+    {
+      radii[n_radii] = (la[h[i - 1]] - la[h[i]]) /
+                       (sp->exponents[h[i]] - sp->exponents[h[i - 1]]);
+      partitioning[n_radii + 1] = sp->exponents[h[i]];
+      n_radii++;
+    }
+
+  free (h);
+
+  return n_radii;
+}
+
+void
+mps_sparse_monomial_poly_fstart (mps_context * ctx, mps_polynomial * p, mps_approximation ** approximations)
+{
+  mps_sparse_monomial_poly * sp = MPS_SPARSE_MONOMIAL_POLY (p);
+  int i, j, n_radii, n = p->degree;
+  double sigma, ang, th, r;
+  double * la = mps_newv (double, sp->n_terms);
+  double * radii = mps_newv (double, sp->n_terms + 1);
+  int * partitioning = mps_newv (int, sp->n_terms + 2);
+
+  if (ctx->random_seed)
+    sigma = drand ();
+  else
+    sigma = ctx->last_sigma = MPS_STARTING_SIGMA;
+
+  for (j = 0; j < sp->n_terms; j++)
+    la[j] = (sp->fap[j] != 0.0) ? log (sp->fap[j]) : -HUGE_VAL;
+
+  n_radii = mps_sparse_starting_radii (sp, la, partitioning, radii);
+
+  th = pi2 / n;
+  for (i = 0; i < n_radii; i++)
+    {
+      ang = pi2 / (partitioning[i + 1] - partitioning[i]);
+
+      if (radii[i] == -HUGE_VAL)
+        r = 0.0;
+      else if (radii[i] < log (DBL_MIN))
+        r = DBL_MIN;
+      else if (radii[i] > log (DBL_MAX))
+        r = DBL_MAX;
+      else
+        r = exp (radii[i]);
+
+      for (j = partitioning[i]; j < partitioning[i + 1]; j++)
+        {
+          cplx_set_d (approximations[j]->fvalue,
+                      r * cos (ang * (j - partitioning[i]) + th * partitioning[i + 1] + sigma),
+                      r * sin (ang * (j - partitioning[i]) + th * partitioning[i + 1] + sigma));
+
+          if (r == DBL_MIN || r == DBL_MAX)
+            approximations[j]->status = MPS_ROOT_STATUS_NOT_FLOAT;
+        }
+    }
+
+  free (partitioning);
+  free (radii);
+  free (la);
+}
+
+/**
+ * @brief Check if the floating point evaluation of the polynomial is
+ * meaningful on the circles where the starting points lie.
+ *
+ * On a circle of radius r the sparse Horner scheme evaluates p(x), or
+ * x^n p(1/x) if r > 1, and the terms of the evaluated polynomial that are
+ * within a factor 2^-DBL_MANT_DIG of the largest one are the only ones
+ * that matter. They are reached through the powers of x, so they are
+ * required to be normalized doubles also after the division by the largest
+ * coefficient. This is what limits the float phase on sparse polynomials,
+ * since the exponents can be much larger than the range of the doubles.
+ *
+ * @param ctx The current mps_context.
+ * @param sp The sparse polynomial.
+ * @return true if the float phase can be used on sp.
+ */
+mps_boolean
+mps_sparse_monomial_poly_check_float_range (mps_context * ctx, mps_sparse_monomial_poly * sp)
+{
+  int i, j, n_radii, n = MPS_POLYNOMIAL (sp)->degree;
+  double rho, t, lmax, lmin, margin;
+  double * la = mps_newv (double, sp->n_terms);
+  double * radii = mps_newv (double, sp->n_terms + 1);
+  int * partitioning = mps_newv (int, sp->n_terms + 2);
+  mps_boolean in_range = true;
+
+  margin = 2 * log ((double) sp->n_terms) + DBL_MANT_DIG * LOG2;
+
+  lmax = -HUGE_VAL;
+  for (j = 0; j < sp->n_terms; j++)
+    {
+      if (!isfinite (sp->fap[j]) || sp->fap[j] < DBL_MIN)
+        in_range = false;
+      la[j] = (sp->fap[j] != 0.0) ? log (sp->fap[j]) : -HUGE_VAL;
+      lmax = MAX (lmax, la[j]);
+    }
+
+  if (!in_range || lmax + margin > log (DBL_MAX))
+    {
+      in_range = false;
+      goto cleanup;
+    }
+
+  n_radii = mps_sparse_starting_radii (sp, la, partitioning, radii);
+
+  for (i = 0; i < n_radii && in_range; i++)
+    {
+      if (radii[i] == -HUGE_VAL)
+        continue;
+
+      /* Logarithm of the largest term on the circle */
+      rho = radii[i];
+      t = -HUGE_VAL;
+      for (j = 0; j < sp->n_terms; j++)
+        t = MAX (t, la[j] + sp->exponents[j] * rho - ((rho > 0) ? n * rho : 0));
+
+      lmin = t - MAX (lmax, 0) - margin;
+      in_range = lmin > log (DBL_MIN);
+    }
+
+cleanup:
+  free (partitioning);
+  free (radii);
+  free (la);
+
+  return in_range;
+}
+
+void
+mps_sparse_monomial_poly_dstart (mps_context * ctx, mps_polynomial * p, mps_approximation ** approximations)
+{
+  mps_sparse_monomial_poly * sp = MPS_SPARSE_MONOMIAL_POLY (p);
+  int i, j, n_radii, n = p->degree;
+  double sigma, ang, th;
+  rdpe_t r;
+  cdpe_t x;
+  double * la = mps_newv (double, sp->n_terms);
+  double * radii = mps_newv (double, sp->n_terms + 1);
+  int * partitioning = mps_newv (int, sp->n_terms + 2);
+
+  if (ctx->random_seed)
+    sigma = drand ();
+  else
+    sigma = ctx->last_sigma = MPS_STARTING_SIGMA;
+
+  for (j = 0; j < sp->n_terms; j++)
+    la[j] = rdpe_ne (sp->dap[j], rdpe_zero) ? rdpe_log (sp->dap[j]) : -HUGE_VAL;
+
+  n_radii = mps_sparse_starting_radii (sp, la, partitioning, radii);
+
+  th = pi2 / n;
+  for (i = 0; i < n_radii; i++)
+    {
+      ang = pi2 / (partitioning[i + 1] - partitioning[i]);
+
+      if (radii[i] == -HUGE_VAL)
+        rdpe_set (r, rdpe_zero);
+      else
+        {
+          rdpe_set_d (r, radii[i]);
+          rdpe_exp_eq (r);
+        }
+
+      for (j = partitioning[i]; j < partitioning[i + 1]; j++)
+        {
+          rdpe_mul_d (cdpe_Re (x), r,
+                      cos (ang * (j - partitioning[i]) + th * partitioning[i + 1] + sigma));
+          rdpe_mul_d (cdpe_Im (x), r,
+                      sin (ang * (j - partitioning[i]) + th * partitioning[i + 1] + sigma));
+          cdpe_set (approximations[j]->dvalue, x);
+        }
+    }
+
+  free (partitioning);
+  free (radii);
+  free (la);
+}
+
+void
+mps_sparse_monomial_poly_mstart (mps_context * ctx, mps_polynomial * p, mps_approximation ** approximations)
+{
+  int i;
+
+  mps_sparse_monomial_poly_dstart (ctx, p, approximations);
+
+  for (i = 0; i < p->degree; i++)
+    mpc_set_cdpe (approximations[i]->mvalue, approximations[i]->dvalue);
+}
@@ -0,0 +1,518 @@
+/*
+ * This file is part of MPSolve 3.1.5
+ *
+ * Copyright (C) 2001-2015, Dipartimento di Matematica "L. Tonelli", Pisa.
+ * License: http://www.gnu.org/licenses/gpl.html GPL version 3 or higher
+ *
+ * Authors:
+ *   Leonardo Robol <leonardo.robol@sns.it>
+ */
+
+#include <mps/mps.h>
+#include <string.h>
+
+/* Number of terms allocated by the first call to a set_coefficient function */
+#define MPS_SPARSE_MONOMIAL_POLY_INITIAL_SIZE 8
+
+mps_sparse_monomial_poly *
+mps_sparse_monomial_poly_new (mps_context * ctx, int degree)
+{
+  mps_sparse_monomial_poly * sp = mps_new (mps_sparse_monomial_poly);
+  mps_polynomial * poly = MPS_POLYNOMIAL (sp);
+
+  mps_polynomial_init (ctx, poly);
+
+  poly->type_name = MPS_SPARSE_MONOMIAL_POLY_TYPE_NAME;
+  poly->degree = degree;
+  poly->structure = MPS_STRUCTURE_UNKNOWN;
+  poly->density = MPS_DENSITY_SPARSE;
+
+  poly->feval = mps_sparse_monomial_poly_feval;
+  poly->deval = mps_sparse_monomial_poly_deval;
+  poly->meval = mps_sparse_monomial_poly_meval;
+  poly->fstart = mps_sparse_monomial_poly_fstart;
+  poly->dstart = mps_sparse_monomial_poly_dstart;
+  poly->mstart = mps_sparse_monomial_poly_mstart;
+  poly->free = mps_sparse_monomial_poly_free;
+  poly->raise_data = mps_sparse_monomial_poly_raise_data;
+  poly->fnewton = mps_sparse_monomial_poly_fnewton;
+  poly->dnewton = mps_sparse_monomial_poly_dnewton;
+  poly->mnewton = mps_sparse_monomial_poly_mnewton;
+  poly->get_leading_coefficient = mps_sparse_monomial_poly_get_leading_coefficient;
+
+  /* The terms are allocated on demand by the set_coefficient functions */
+  sp->n_terms = sp->size = 0;
+  sp->exponents = NULL;
+  sp->fpc = NULL;
+  sp->dpc = NULL;
+  sp->db.mfpc1 = sp->db.mfpc2 = NULL;
+  sp->db.active = 1;
+  sp->mfpc = NULL;
+  sp->fap = NULL;
+  sp->dap = NULL;
+  sp->initial_mqp_r = sp->initial_mqp_i = NULL;
+  sp->prec = ctx->mpwp;
+
+  pthread_mutex_init (&sp->regenerating, NULL);
+
+  return sp;
+}
+
+void
+mps_sparse_monomial_poly_free (mps_context * ctx, mps_polynomial * p)
+{
+  mps_sparse_monomial_poly * sp = MPS_SPARSE_MONOMIAL_POLY (p);
+
+  if (sp->size)
+    {
+      mpc_vclear (sp->db.mfpc1, sp->size);
+      mpc_vclear (sp->db.mfpc2, sp->size);
+      mpq_vclear (sp->initial_mqp_r, sp->size);
+      mpq_vclear (sp->initial_mqp_i, sp->size);
+
+      free (sp->exponents);
+      cplx_vfree (sp->fpc);
+      cdpe_vfree (sp->dpc);
+      mpc_vfree (sp->db.mfpc1);
+      mpc_vfree (sp->db.mfpc2);
+      double_vfree (sp->fap);
+      rdpe_vfree (sp->dap);
+      mpq_vfree (sp->initial_mqp_r);
+      mpq_vfree (sp->initial_mqp_i);
+    }
+
+  pthread_mutex_destroy (&sp->regenerating);
+
+  free (sp);
+}
+
+/*
+ * Make room for at least size terms. The new multiprecision coefficients
+ * are initialized to the current precision of the polynomial.
+ */
+static void
+mps_sparse_monomial_poly_reserve (mps_context * ctx, mps_sparse_monomial_poly * sp, int size)
+{
+  int i, old_size = sp->size;
+
+  if (size <= old_size)
+    return;
+
+  size = MAX (size, MAX (2 * old_size, MPS_SPARSE_MONOMIAL_POLY_INITIAL_SIZE));
+
+  /* mpc_t and mpq_t only hold pointers to their limbs, so they can be
+   * moved around by mps_realloc() without any harm. */
+  sp->exponents = mps_realloc (sp->exponents, sizeof(int) * size);
+  sp->fpc = mps_realloc (sp->fpc, sizeof(cplx_t) * size);
+  sp->dpc = mps_realloc (sp->dpc, sizeof(cdpe_t) * size);
+  sp->db.mfpc1 = mps_realloc (sp->db.mfpc1, sizeof(mpc_t) * size);
+  sp->db.mfpc2 = mps_realloc (sp->db.mfpc2, sizeof(mpc_t) * size);
+  sp->fap = mps_realloc (sp->fap, sizeof(double) * size);
+  sp->dap = mps_realloc (sp->dap, sizeof(rdpe_t) * size);
+  sp->initial_mqp_r = mps_realloc (sp->initial_mqp_r, sizeof(mpq_t) * size);
+  sp->initial_mqp_i = mps_realloc (sp->initial_mqp_i, sizeof(mpq_t) * size);
+
+  for (i = old_size; i < size; i++)
+    {
+      mpc_init2 (sp->db.mfpc1[i], sp->prec);
+      mpc_init2 (sp->db.mfpc2[i], sp->prec);
+      mpq_init (sp->initial_mqp_r[i]);
+      mpq_init (sp->initial_mqp_i[i]);
+    }
+
+  sp->mfpc = (sp->db.active == 1) ? sp->db.mfpc1 : sp->db.mfpc2;
+  sp->size = size;
+}
+
+/*
+ * Return the position of the term of degree i, inserting a new one
+ * with a zero coefficient if it is not present.
+ */
+static int
+mps_sparse_monomial_poly_term (mps_context * ctx, mps_sparse_monomial_poly * sp, int i)
+{
+  int lo = 0, hi = sp->n_terms, mid, j;
+
+  if (i < 0 || i > MPS_POLYNOMIAL (sp)->degree)
+    {
+      mps_error (ctx, "Degree of the coefficient out of bounds");
+      return -1;
+    }
+
+  /* Terms are usually given in increasing order, so check the last
+   * one before doing a binary search. */
+  if (sp->n_terms == 0 || sp->exponents[sp->n_terms - 1] < i)
+    lo = sp->n_terms;
+  else
+    while (lo < hi)
+      {
+        mid = (lo + hi) / 2;
+        if (sp->exponents[mid] < i)
+          lo = mid + 1;
+        else
+          hi = mid;
+      }
+
+  if (lo < sp->n_terms && sp->exponents[lo] == i)
+    return lo;
+
+  mps_sparse_monomial_poly_reserve (ctx, sp, sp->n_terms + 1);
+
+  /* Rotate the unused coefficients at the end of the arrays into position
+   * lo, so that no multiprecision variable is lost. */
+  for (j = sp->n_terms; j > lo; j--)
+    {
+      sp->exponents[j] = sp->exponents[j - 1];
+      mpc_swap (sp->db.mfpc1[j], sp->db.mfpc1[j - 1]);
+      mpc_swap (sp->db.mfpc2[j], sp->db.mfpc2[j - 1]);
+      mpq_swap (sp->initial_mqp_r[j], sp->initial_mqp_r[j - 1]);
+      mpq_swap (sp->initial_mqp_i[j], sp->initial_mqp_i[j - 1]);
+    }
+
+  memmove (sp->fpc + lo + 1, sp->fpc + lo, sizeof(cplx_t) * (sp->n_terms - lo));
+  memmove (sp->dpc + lo + 1, sp->dpc + lo, sizeof(cdpe_t) * (sp->n_terms - lo));
+  memmove (sp->fap + lo + 1, sp->fap + lo, sizeof(double) * (sp->n_terms - lo));
+  memmove (sp->dap + lo + 1, sp->dap + lo, sizeof(rdpe_t) * (sp->n_terms - lo));
+
+  sp->exponents[lo] = i;
+  sp->n_terms++;
+
+  return lo;
+}
+
+/* Update the floating point versions of the k-th coefficient */
+static void
+mps_sparse_monomial_poly_update_term (mps_sparse_monomial_poly * sp, int k)
+{
+  mpc_get_cplx (sp->fpc[k], sp->mfpc[k]);
+  mpc_get_cdpe (sp->dpc[k], sp->mfpc[k]);
+  cdpe_mod (sp->dap[k], sp->dpc[k]);
+  sp->fap[k] = rdpe_get_d (sp->dap[k]);
+}
+
+void
+mps_sparse_monomial_poly_set_coefficient_d (mps_context * ctx, mps_sparse_monomial_poly * sp, int i,
+                                            double real_part, double imag_part)
+{
+  int k;
+
+  if (MPS_POLYNOMIAL (sp)->structure == MPS_STRUCTURE_UNKNOWN)
+    MPS_POLYNOMIAL (sp)->structure = (imag_part == 0) ?
+                                     MPS_STRUCTURE_REAL_FP : MPS_STRUCTURE_COMPLEX_FP;
+
+  if (imag_part != 0 && MPS_POLYNOMIAL (sp)->structure == MPS_STRUCTURE_REAL_FP)
+    MPS_POLYNOMIAL (sp)->structure = MPS_STRUCTURE_COMPLEX_FP;
+
+  if ((k = mps_sparse_monomial_poly_term (ctx, sp, i)) < 0)
+    return;
+
+  mpc_set_d (sp->mfpc[k], real_part, imag_part);
+  mps_sparse_monomial_poly_update_term (sp, k);
+}
+
+void
+mps_sparse_monomial_poly_set_coefficient_q (mps_context * ctx, mps_sparse_monomial_poly * sp, int i,
+                                            mpq_t real_part, mpq_t imag_part)
+{
+  int k;
+
+  if (MPS_POLYNOMIAL (sp)->structure == MPS_STRUCTURE_UNKNOWN)
+    MPS_POLYNOMIAL (sp)->structure = (mpq_sgn (imag_part) != 0) ?
+                                     MPS_STRUCTURE_COMPLEX_RATIONAL : MPS_STRUCTURE_REAL_RATIONAL;
+
+  if (MPS_POLYNOMIAL (sp)->structure == MPS_STRUCTURE_REAL_RATIONAL &&
+      mpq_sgn (imag_part) != 0)
+    MPS_POLYNOMIAL (sp)->structure = MPS_STRUCTURE_COMPLEX_RATIONAL;
+
+  if ((k = mps_sparse_monomial_poly_term (ctx, sp, i)) < 0)
+    return;
+
+  mpq_set (sp->initial_mqp_r[k], real_part);
+  mpq_set (sp->initial_mqp_i[k], imag_part);
+
+  mpf_set_q (mpc_Re (sp->mfpc[k]), real_part);
+  mpf_set_q (mpc_Im (sp->mfpc[k]), imag_part);
+  mps_sparse_monomial_poly_update_term (sp, k);
+}
+
+void
+mps_sparse_monomial_poly_set_coefficient_f (mps_context * ctx, mps_sparse_monomial_poly * sp, int i,
+                                            mpc_t coeff)
+{
+  int k;
+
+  if (MPS_POLYNOMIAL (sp)->structure == MPS_STRUCTURE_UNKNOWN)
+    MPS_POLYNOMIAL (sp)->structure = MPS_STRUCTURE_COMPLEX_FP;
+
+  if ((k = mps_sparse_monomial_poly_term (ctx, sp, i)) < 0)
+    return;
+
+  mpc_set (sp->mfpc[k], coeff);
+  mps_sparse_monomial_poly_update_term (sp, k);
+}
+
+void
+mps_sparse_monomial_poly_set_coefficient_int (mps_context * ctx, mps_sparse_monomial_poly * sp, int i,
+                                              long long real_part, long long imag_part)
+{
+  int k;
+
+  if (MPS_POLYNOMIAL (sp)->structure == MPS_STRUCTURE_UNKNOWN)
+    MPS_POLYNOMIAL (sp)->structure = (imag_part) != 0 ?
+                                     MPS_STRUCTURE_COMPLEX_INTEGER : MPS_STRUCTURE_REAL_INTEGER;
+
+  if (MPS_POLYNOMIAL (sp)->structure == MPS_STRUCTURE_REAL_INTEGER &&
+      imag_part != 0)
+    MPS_POLYNOMIAL (sp)->structure = MPS_STRUCTURE_COMPLEX_INTEGER;
+
+  if ((k = mps_sparse_monomial_poly_term (ctx, sp, i)) < 0)
+    return;
+
+  mpq_set_si (sp->initial_mqp_r[k], real_part, 1);
+  mpq_set_si (sp->initial_mqp_i[k], imag_part, 1);
+
+  mpf_set_q (mpc_Re (sp->mfpc[k]), sp->initial_mqp_r[k]);
+  mpf_set_q (mpc_Im (sp->mfpc[k]), sp->initial_mqp_i[k]);
+  mps_sparse_monomial_poly_update_term (sp, k);
+}
+
+long int
+mps_sparse_monomial_poly_raise_data (mps_context * ctx, mps_polynomial * p, long int wp)
+{
+  mps_sparse_monomial_poly * sp = MPS_SPARSE_MONOMIAL_POLY (p);
+  mpc_t * raising_mfpc;
+  int k;
+
+  pthread_mutex_lock (&sp->regenerating);
+
+  if (wp <= sp->prec)
+    {
+      pthread_mutex_unlock (&sp->regenerating);
+      return sp->prec;
+    }
+
+  raising_mfpc = (sp->db.active == 1) ? sp->db.mfpc2 : sp->db.mfpc1;
+
+  for (k = 0; k < sp->size; k++)
+    mpc_set_prec (raising_mfpc[k], wp);
+
+  if (MPS_STRUCTURE_IS_INTEGER (p->structure) ||
+      MPS_STRUCTURE_IS_RATIONAL (p->structure))
+    {
+      for (k = 0; k < sp->n_terms; k++)
+        {
+          mpf_set_q (mpc_Re (raising_mfpc[k]), sp->initial_mqp_r[k]);
+          mpf_set_q (mpc_Im (raising_mfpc[k]), sp->initial_mqp_i[k]);
+        }
+    }
+  else
+    {
+      for (k = 0; k < sp->n_terms; k++)
+        mpc_set (raising_mfpc[k], sp->mfpc[k]);
+    }
+
+  sp->db.active = (sp->db.active % 2) + 1;
+  sp->mfpc = raising_mfpc;
+  sp->prec = wp;
+
+  pthread_mutex_unlock (&sp->regenerating);
+
+  return sp->prec;
+}
+
+void
+mps_sparse_monomial_poly_get_leading_coefficient (mps_context * ctx, mps_polynomial * p,
+                                                  mpc_t leading_coefficient)
+{
+  mps_sparse_monomial_poly * sp = MPS_SPARSE_MONOMIAL_POLY (p);
+
+  if (sp->n_terms > 0 && sp->exponents[sp->n_terms - 1] == p->degree)
+    mpc_set (leading_coefficient, sp->mfpc[sp->n_terms - 1]);
+  else
+    mpc_set_ui (leading_coefficient, 0U, 0U);
+}
+
+/**
+ * @brief Remove the terms with a zero coefficient and the factor
+ * \f$x^k\f$ from the polynomial.
+ *
+ * @return The number of zero roots that have been removed, i.e., \f$k\f$.
+ */
+int
+mps_sparse_monomial_poly_deflate (mps_context * ctx, mps_polynomial * p)
+{
+  mps_sparse_monomial_poly * sp = MPS_SPARSE_MONOMIAL_POLY (p);
+  int j, k, zero_roots;
+
+  for (j = 0, k = 0; j < sp->n_terms; j++)
+    {
+      if (rdpe_eq (sp->dap[j], rdpe_zero) && mpc_eq_zero (sp->mfpc[j]))
+        continue;
+
+      if (j != k)
+        {
+          sp->exponents[k] = sp->exponents[j];
+          cplx_set (sp->fpc[k], sp->fpc[j]);
+          cdpe_set (sp->dpc[k], sp->dpc[j]);
+          sp->fap[k] = sp->fap[j];
+          rdpe_set (sp->dap[k], sp->dap[j]);
+          mpc_swap (sp->db.mfpc1[k], sp->db.mfpc1[j]);
+          mpc_swap (sp->db.mfpc2[k], sp->db.mfpc2[j]);
+          mpq_swap (sp->initial_mqp_r[k], sp->initial_mqp_r[j]);
+          mpq_swap (sp->initial_mqp_i[k], sp->initial_mqp_i[j]);
+        }
+      k++;
+    }
+  sp->n_terms = k;
+
+  if (sp->n_terms == 0 || sp->exponents[0] == 0)
+    return 0;
+
+  zero_roots = MIN (sp->exponents[0], p->degree);
+  for (j = 0; j < sp->n_terms; j++)
+    sp->exponents[j] -= zero_roots;
+  p->degree -= zero_roots;
+
+  return zero_roots;
+}
+
+/**
+ * @brief Parse the stream that has been loaded into buffer and that
+ * describes a mps_sparse_monomial_poly.
+ *
+ * The coefficients are given as in the sparse format of the monomial
+ * polynomials, i.e., as a list of exponents each one followed by the
+ * corresponding coefficient.
+ *
+ * @param ctx The current mps_context
+ * @param buffer The buffer that needs to be parsed
+ * @param structure The structure of the polynomial
+ * @param precision The input precision of the coefficients, if specified, 0 otherwise
+ *
+ * @return A newly allocated mps_sparse_monomial_poly, or NULL if the parsing fails.
+ */
+mps_sparse_monomial_poly *
+mps_sparse_monomial_poly_read_from_stream (mps_context * ctx, mps_input_buffer * buffer,
+                                           mps_structure structure, long int precision)
+{
+  mps_sparse_monomial_poly * sp = mps_sparse_monomial_poly_new (ctx, ctx->n);
+  char * token;
+  int i, k, n_terms;
+  mpc_t fcoeff;
+  mpq_t qre, qim;
+
+  if (MPS_STRUCTURE_IS_FP (structure))
+    mpc_init2 (fcoeff, MAX (precision, ctx->mpwp));
+  else
+    {
+      mpq_init (qre);
+      mpq_init (qim);
+    }
+
+  while ((token = mps_input_buffer_next_token (buffer)))
+    {
+      if (!sscanf (token, "%d", &i))
+        {
+          mps_raise_parsing_error (ctx, buffer, token, "Error while parsing the degree of a monomial");
+          goto error;
+        }
+
+      if (i < 0 || i > ctx->n)
+        {
+          mps_raise_parsing_error (ctx, buffer, token, "Degree of coefficient out of bounds");
+          goto error;
+        }
+
+      n_terms = sp->n_terms;
+      k = mps_sparse_monomial_poly_term (ctx, sp, i);
+      if (sp->n_terms == n_terms)
+        {
+          mps_raise_parsing_error (ctx, buffer, token, "A monomial of the same degree has been inserted twice");
+          goto error;
+        }
+      free (token);
+
+      if (MPS_STRUCTURE_IS_FP (structure))
+        {
+          token = mps_input_buffer_next_token (buffer);
+          if (!token || (mpf_set_str (mpc_Re (fcoeff), token, 10) != 0))
+            {
+              mps_raise_parsing_error (ctx, buffer, token, "Error parsing coefficients of the polynomial");
+              goto error;
+            }
+          free (token);
+
+          mpf_set_ui (mpc_Im (fcoeff), 0U);
+          if (MPS_STRUCTURE_IS_COMPLEX (structure))
+            {
+              token = mps_input_buffer_next_token (buffer);
+              if (!token || (mpf_set_str (mpc_Im (fcoeff), token, 10) != 0))
+                {
+                  mps_raise_parsing_error (ctx, buffer, token, "Error parsing coefficients of the polynomial");
+                  goto error;
+                }
+              free (token);
+            }
+
+          mpc_set (sp->mfpc[k], fcoeff);
+        }
+      else
+        {
+          token = mps_input_buffer_next_token (buffer);
+          if (!token || (mpq_set_str (qre, token, 10) != 0))
+            {
+              mps_raise_parsing_error (ctx, buffer, token, "Error parsing coefficients of the polynomial");
+              goto error;
+            }
+          mpq_canonicalize (qre);
+          free (token);
+
+          mpq_set_ui (qim, 0U, 1U);
+          if (MPS_STRUCTURE_IS_COMPLEX (structure))
+            {
+              token = mps_input_buffer_next_token (buffer);
+              if (!token || (mpq_set_str (qim, token, 10) != 0))
+                {
+                  mps_raise_parsing_error (ctx, buffer, token, "Error parsing coefficients of the polynomial");
+                  goto error;
+                }
+              mpq_canonicalize (qim);
+              free (token);
+            }
+
+          mpq_set (sp->initial_mqp_r[k], qre);
+          mpq_set (sp->initial_mqp_i[k], qim);
+          mpf_set_q (mpc_Re (sp->mfpc[k]), qre);
+          mpf_set_q (mpc_Im (sp->mfpc[k]), qim);
+        }
+
+      mps_sparse_monomial_poly_update_term (sp, k);
+    }
+
+  MPS_POLYNOMIAL (sp)->structure = structure;
+
+  if (MPS_STRUCTURE_IS_FP (structure))
+    mpc_clear (fcoeff);
+  else
+    {
+      mpq_clear (qre);
+      mpq_clear (qim);
+    }
+
+  return sp;
+
+error:
+  free (token);
+
+  if (MPS_STRUCTURE_IS_FP (structure))
+    mpc_clear (fcoeff);
+  else
+    {
+      mpq_clear (qre);
+      mpq_clear (qim);
+    }
+
+  mps_sparse_monomial_poly_free (ctx, MPS_POLYNOMIAL (sp));
+
+  return NULL;
+}
@@ -80,6 +80,10 @@ mps_secular_ga_check_stop (mps_context * s)
 
   for (i = 0; i < s->n; i++)
     {
+      /* Roots out of the search set are not refined anymore */
+      if (s->root[i]->inclusion == MPS_ROOT_INCLUSION_OUT)
+        continue;
+
       switch (s->lastphase)
         {
         /* Float case */
@@ -122,6 +126,19 @@ mps_secular_ga_check_stop (mps_context * s)
 
 #define EXIT_ON_ERRORS(ctx) if (mps_context_has_errors (ctx)) { goto cleanup; }
 
+/*
+ * Check if the precision budget allows to switch to the multiprecision
+ * phase, or to double the working precision if we are already there.
+ */
+static mps_boolean
+mps_secular_ga_allows_raise (mps_context * s)
+{
+  if (s->lastphase != mp_phase)
+    return mps_budget_allows_precision (s, MPS_SECULAR_STARTING_MP_PRECISION);
+  else
+    return mps_budget_allows_precision (s, 2 * s->mpwp);
+}
+
 /**
  * @brief MPSolve main function for the secular equation solving
  * using Gemignani's approach.
@@ -136,6 +153,7 @@ mps_secular_ga_mpsolve (mps_context * s)
   int i;
   mps_boolean skip_check_stop = false;
   mps_boolean just_regenerated = false;
+  mps_boolean paired;
   mps_secular_equation *sec = mps_secular_equation_from_status (s);
 
   /* Deflate polynomial before starting, in case it's possible */
@@ -237,6 +255,8 @@ mps_secular_ga_mpsolve (mps_context * s)
 
       MPS_DEBUG_WITH_INFO (s, "Computing starting points and performing first Aberth packet");
 
+      paired = mps_conjugate_symmetry_enabled (s);
+
       /* Perform a packet of Aberth iterations */
       switch (s->lastphase)
         {
@@ -293,6 +313,24 @@ mps_secular_ga_mpsolve (mps_context * s)
       if (mps_secular_ga_check_stop (s))
         goto cleanup;
 
+      /* The conjugate pairs may keep some approximations far from the
+       * roots, and the regenerations of the secular equation needed to
+       * bring them there cost more than a first packet on all the
+       * approximations. */
+      if (paired && s->lastphase == float_phase)
+        {
+          MPS_DEBUG_WITH_INFO (s, "Repeating the first packet without the conjugate pairs");
+          mps_conjugate_abandon (s);
+          mps_cluster_reset (s);
+          for (i = 0; i < s->n; i++)
+            {
+              s->root[i]->again = true;
+              s->root[i]->approximated = false;
+              s->root[i]->frad = DBL_MAX;
+            }
+          goto preliminary_aberth_packet;
+        }
+
       /* In the case where we started in DPE but the initial approximation are
        * representable as standard floating point numbers, go back to float_phase. */
       if (s->lastphase == dpe_phase)
@@ -379,15 +417,24 @@ mps_secular_ga_mpsolve (mps_context * s)
       switch (s->lastphase)
         {
         case  float_phase:
-          mps_secular_fstart (s, sec, s->root);
+          if (s->starting_strategy == MPS_STARTING_STRATEGY_USER)
+            mps_polynomial_fstart (s, MPS_POLYNOMIAL (sec), s->root);
+          else
+            mps_secular_fstart (s, sec, s->root);
           break;
 
         case dpe_phase:
-          mps_secular_dstart (s, sec, s->root);
+          if (s->starting_strategy == MPS_STARTING_STRATEGY_USER)
+            mps_polynomial_dstart (s, MPS_POLYNOMIAL (sec), s->root);
+          else
+            mps_secular_dstart (s, sec, s->root);
           break;
 
         case mp_phase:
-          mps_secular_mstart (s, sec, s->root);
+          if (s->starting_strategy == MPS_STARTING_STRATEGY_USER)
+            mps_polynomial_mstart (s, MPS_POLYNOMIAL (sec), s->root);
+          else
+            mps_secular_mstart (s, sec, s->root);
           break;
 
         default:
@@ -466,6 +513,10 @@ mps_secular_ga_mpsolve (mps_context * s)
           return;
         }
 
+      /* Return the current approximations if the time budget is over */
+      if (mps_budget_time_over (s))
+        goto cleanup;
+
       /* Check that we haven't passed the maximum number of allowed iterations */
       if (packet > s->max_pack)
         {
@@ -500,6 +551,11 @@ mps_secular_ga_mpsolve (mps_context * s)
 	      goto cleanup;
 	    }
 
+          /* Return the current approximations if the precision
+           * budget does not allow to go on */
+          if (!mps_secular_ga_allows_raise (s))
+            goto cleanup;
+
           /* Going to multiprecision if we're not there yet */
           if (s->lastphase != mp_phase)
             mps_secular_switch_phase (s, mp_phase);
@@ -550,6 +606,10 @@ mps_secular_ga_mpsolve (mps_context * s)
           return;
         }
 
+      /* Return the current approximations if the time budget is over */
+      if (mps_budget_time_over (s))
+        goto cleanup;
+
       /* If we can't stop recompute coefficients in higher precision and
        * continue to iterate, unless the best approximation possible in
        * this precision has been reached. In that case increase the precision
@@ -570,6 +630,9 @@ mps_secular_ga_mpsolve (mps_context * s)
 
             skip_check_stop = false;
 
+            if (!mps_secular_ga_allows_raise (s))
+              goto cleanup;
+
             /* Going to multiprecision if we're not there yet */
             if (s->lastphase != mp_phase)
               {
@@ -595,6 +658,11 @@ mps_secular_ga_mpsolve (mps_context * s)
             mps_error (s, "Exit forced by the caller");
             return;
           }
+
+        /* The regeneration may take long at high precision, so check
+         * the time budget again before the next packet */
+        if (mps_budget_time_over (s))
+          goto cleanup;
       }
     } while (skip_check_stop || !mps_secular_ga_check_stop (s));
 
@@ -626,8 +694,9 @@ cleanup:
       return;
     }
 
-  /* Eventually improve the roots if approximation is required */
-  if (s->output_config->goal == MPS_OUTPUT_GOAL_APPROXIMATE)
+  /* Eventually improve the roots if approximation is required, and
+   * there is time left */
+  if (s->output_config->goal == MPS_OUTPUT_GOAL_APPROXIMATE && !mps_budget_time_over (s))
     {
 #ifdef NICE_DEBUG
       clock_t *my_timer = mps_start_timer ();
@@ -656,6 +725,8 @@ cleanup:
                  s->mp_iteration_time);
       MPS_DEBUG (s, "Total time using MPSolve: %ld ms",
                  mps_stop_timer (total_clock));
+      MPS_DEBUG (s, "Memory high-water of the coefficients: %ld KiB",
+                 mps_context_get_memory_high_water (s) / 1024);
     }
 #endif
 }
@@ -21,8 +21,8 @@ __mps_secular_ga_fiterate_worker (void* data_ptr)
 {
   mps_thread_worker_data *data = (mps_thread_worker_data*)data_ptr;
   mps_context *s = data->s;
-  int i;
-  cplx_t corr, abcorr;
+  int i, mirror;
+  cplx_t corr, abcorr, old_froot;
   double modcorr;
   mps_thread_job job;
 
@@ -42,6 +42,16 @@ __mps_secular_ga_fiterate_worker (void* data_ptr)
           goto cleanup;
         }
 
+      /* The conjugates are updated together with the approximations
+       * they are paired with */
+      if (mps_conjugate_skip (data->pairs, i, data->roots_mutex))
+        {
+          pthread_mutex_unlock (&data->roots_mutex[i]);
+          continue;
+        }
+
+      mirror = -1;
+
       if (s->root[i]->again && !s->root[i]->approximated)
         {
           /* Increment the number of performed iterations */
@@ -53,8 +63,10 @@ __mps_secular_ga_fiterate_worker (void* data_ptr)
           pthread_mutex_unlock (data->gs_mutex);
 #endif
           cdpe_set_x (s->root[i]->dvalue, s->root[i]->fvalue);
+          cplx_set (old_froot, s->root[i]->fvalue);
 
           mps_secular_fnewton (s, MPS_POLYNOMIAL (s->secular_equation), s->root[i], corr);
+          __sync_add_and_fetch (&s->newton_corrections, 1);
 
           if (s->root[i]->status == MPS_ROOT_STATUS_NOT_FLOAT)
             {
@@ -64,13 +76,14 @@ __mps_secular_ga_fiterate_worker (void* data_ptr)
             }
 
           /* Apply Aberth correction */
-          mps_faberth_wl (s, i, abcorr, data->aberth_mutex);
+          mps_faberth_snapshot (s, i, s->root[i]->fvalue,
+                                mps_thread_root_snapshot_fget (data->snapshot, job.iter, data->fvalues),
+                                abcorr);
 
           if (isnan (cplx_Re (abcorr)) || isnan (cplx_Im (abcorr)))
             {
               s->root[i]->again = false;
-              pthread_mutex_unlock (&data->roots_mutex[i]);
-              continue;
+              goto conjugate;
             }
 
           cplx_mul_eq (abcorr, corr);
@@ -80,8 +93,7 @@ __mps_secular_ga_fiterate_worker (void* data_ptr)
           if (cplx_check_fpe (abcorr))
             {
               s->root[i]->again = false;
-              pthread_mutex_unlock (&data->roots_mutex[i]);
-              continue;
+              goto conjugate;
             }
 
           if (!s->root[i]->again || s->root[i]->approximated)
@@ -89,26 +101,39 @@ __mps_secular_ga_fiterate_worker (void* data_ptr)
               if (s->debug_level & MPS_DEBUG_APPROXIMATIONS)
                 MPS_DEBUG (s, "Root %d again was set to false on iteration %d by thread %d", i, *data->it, data->thread);
 
+              if (data->pairs)
+                mirror = mps_conjugate_fupdate (s, data->pairs, i, old_froot, corr);
+
 #if defined(__GCC__)
-              __sync_add_and_fetch (data->nzeros, 1);
+              __sync_add_and_fetch (data->nzeros, (mirror >= 0) ? 2 : 1);
 #else
               pthread_mutex_lock (data->gs_mutex);
-              (*data->nzeros)++;
+              (*data->nzeros) += (mirror >= 0) ? 2 : 1;
               pthread_mutex_unlock (data->gs_mutex);
 #endif
+              goto publish;
             }
           else
             {
-              pthread_mutex_lock (&data->aberth_mutex[i]);
               cplx_sub_eq (s->root[i]->fvalue, abcorr);
-              pthread_mutex_unlock (&data->aberth_mutex[i]);
 
               /* Correct the radius */
               modcorr = cplx_mod (abcorr);
               s->root[i]->frad += modcorr;
             }
+
+        conjugate:
+          if (data->pairs)
+            mirror = mps_conjugate_fupdate (s, data->pairs, i, old_froot, corr);
         }
 
+    publish:
+      /* Make the new position visible to the other threads. This is done also
+       * for the roots that have not been moved to keep the snapshot valid. */
+      mps_thread_root_snapshot_fpublish (data->snapshot, job.iter, i, s->root[i]->fvalue);
+      if (mirror >= 0)
+        mps_thread_root_snapshot_fpublish (data->snapshot, job.iter, mirror, s->root[mirror]->fvalue);
+
       pthread_mutex_unlock (&data->roots_mutex[i]);
     }
 
@@ -138,6 +163,7 @@ mps_secular_ga_fiterate (mps_context * s, int maxit, mps_boolean just_regenerate
   int i;
   int nit = 0;
   int it_threshold = 0;
+  mps_conjugate_pairs *pairs;
   mps_boolean excep = false;
 
 #ifndef DISABLE_DEBUG
@@ -147,23 +173,23 @@ mps_secular_ga_fiterate (mps_context * s, int maxit, mps_boolean just_regenerate
   s->operation = MPS_OPERATION_ABERTH_FP_ITERATIONS;
 
   mps_thread_worker_data *data;
-  pthread_mutex_t *aberth_mutex =
-    (pthread_mutex_t*)mps_malloc (sizeof(pthread_mutex_t) * s->n);
+  mps_thread_root_snapshot *snapshot;
+  cplx_t *fvalues;
   pthread_mutex_t *roots_mutex =
     (pthread_mutex_t*)mps_malloc (sizeof(pthread_mutex_t) * s->n);
 
   pthread_mutex_t gs_mutex = PTHREAD_MUTEX_INITIALIZER;
 
   for (i = 0; i < s->n; i++)
-    {
-      pthread_mutex_init (roots_mutex + i, NULL);
-      pthread_mutex_init (aberth_mutex + i, NULL);
-    }
+    pthread_mutex_init (roots_mutex + i, NULL);
 
   data = mps_newv (mps_thread_worker_data, s->n_threads);
 
   MPS_DEBUG_THIS_CALL (s);
 
+  /* Stop refining the approximations out of the search region */
+  mps_search_region_freeze (s);
+
   /* Mark the approximated roots as ready for output */
   for (i = 0; i < s->n; i++)
     {
@@ -181,11 +207,17 @@ mps_secular_ga_fiterate (mps_context * s, int maxit, mps_boolean just_regenerate
           if (s->root[i]->status == MPS_ROOT_STATUS_APPROXIMATED)
             s->root[i]->approximated = true;
         }
-
-      if (!s->root[i]->again || s->root[i]->approximated)
-        computed_roots++;
     }
 
+  /* Iterate only on one approximation of every conjugate pair, if possible.
+   * The pairs are made exactly conjugate, and their states are merged, so
+   * this must be done before anything else looks at the approximations. */
+  pairs = mps_conjugate_fpairs (s);
+
+  for (i = 0; i < s->n; i++)
+    if (!s->root[i]->again || s->root[i]->approximated)
+      computed_roots++;
+
   MPS_DEBUG_WITH_INFO (s, "%d roots %s already approximated at the start of the packet", 
 		       computed_roots,
 		       (computed_roots == 1) ? "is" : "are");
@@ -193,6 +225,8 @@ mps_secular_ga_fiterate (mps_context * s, int maxit, mps_boolean just_regenerate
   it_threshold = s->n - computed_roots;
 
   mps_thread_job_queue *queue = mps_thread_job_queue_new (s);
+  snapshot = mps_thread_root_snapshot_new (s, float_phase);
+  fvalues = cplx_valloc (s->n_threads * s->n);
 
   for (i = 0; i < s->n_threads; i++)
     {
@@ -201,11 +235,14 @@ mps_secular_ga_fiterate (mps_context * s, int maxit, mps_boolean just_regenerate
       data[i].s = s;
       data[i].thread = i;
       data[i].n_threads = s->n_threads;
-      data[i].aberth_mutex = aberth_mutex;
+      data[i].aberth_mutex = NULL;
       data[i].roots_mutex = roots_mutex;
       data[i].queue = queue;
+      data[i].snapshot = snapshot;
+      data[i].fvalues = fvalues + i * s->n;
       data[i].gs_mutex = &gs_mutex;
       data[i].excep = &excep;
+      data[i].pairs = pairs;
 
       mps_thread_pool_assign (s, s->pool,
                               __mps_secular_ga_fiterate_worker, data + i);
@@ -213,6 +250,9 @@ mps_secular_ga_fiterate (mps_context * s, int maxit, mps_boolean just_regenerate
 
   mps_thread_pool_wait (s, s->pool);
 
+  if (pairs)
+    mps_conjugate_packet_done (s, pairs, computed_roots);
+
   /* Check if the roots are improvable in floating point */
   MPS_DEBUG_WITH_INFO (s, "Performed %d iterations with floating point arithmetic",
                        nit);
@@ -278,9 +318,10 @@ mps_secular_ga_fiterate (mps_context * s, int maxit, mps_boolean just_regenerate
 #endif
 
   mps_thread_job_queue_free (queue);
+  mps_thread_root_snapshot_free (snapshot);
+  cplx_vfree (fvalues);
   free (data);
   free (roots_mutex);
-  free (aberth_mutex);
 
   /* Return the number of approximated roots */
   return computed_roots;
@@ -292,8 +333,8 @@ __mps_secular_ga_diterate_worker (void* data_ptr)
 {
   mps_thread_worker_data *data = (mps_thread_worker_data*)data_ptr;
   mps_context *s = data->s;
-  int i;
-  cdpe_t corr, abcorr, droot;
+  int i, mirror;
+  cdpe_t corr, abcorr, droot, old_droot;
   rdpe_t modcorr;
   mps_thread_job job;
 
@@ -309,17 +350,31 @@ __mps_secular_ga_diterate_worker (void* data_ptr)
 
       pthread_mutex_lock (&data->roots_mutex[i]);
 
+      /* The conjugates are updated together with the approximations
+       * they are paired with */
+      if (mps_conjugate_skip (data->pairs, i, data->roots_mutex))
+        {
+          pthread_mutex_unlock (&data->roots_mutex[i]);
+          continue;
+        }
+
+      mirror = -1;
+
       if (s->root[i]->again && !s->root[i]->approximated)
         {
           /* Lock this roots to make sure that we are the only one working on it */
           cdpe_set (droot, s->root[i]->dvalue);
+          cdpe_set (old_droot, droot);
 
           (*data->it)++;
 
           mps_secular_dnewton (s, MPS_POLYNOMIAL (s->secular_equation), s->root[i], corr);
+          __sync_add_and_fetch (&s->newton_corrections, 1);
 
           /* Apply Aberth correction */
-          mps_daberth_wl (s, i, abcorr, data->aberth_mutex);
+          mps_daberth_snapshot (s, i, droot,
+                                mps_thread_root_snapshot_dget (data->snapshot, job.iter, data->dvalues),
+                                abcorr);
           cdpe_mul_eq (abcorr, corr);
           cdpe_sub (abcorr, cdpe_one, abcorr);
           cdpe_div (abcorr, corr, abcorr);
@@ -337,12 +392,21 @@ __mps_secular_ga_diterate_worker (void* data_ptr)
             {
               if (s->debug_level & MPS_DEBUG_APPROXIMATIONS)
                 MPS_DEBUG (s, "Root %d again was set to false on iteration %d by thread %d", i, *data->it, data->thread);
-              (*data->nzeros)++;
             }
           else
             cdpe_set (s->root[i]->dvalue, droot);
+
+          if (data->pairs)
+            mirror = mps_conjugate_dupdate (s, data->pairs, i, old_droot, corr);
+
+          if (!s->root[i]->again || s->root[i]->approximated)
+            (*data->nzeros) += (mirror >= 0) ? 2 : 1;
         }
 
+      mps_thread_root_snapshot_dpublish (data->snapshot, job.iter, i, s->root[i]->dvalue);
+      if (mirror >= 0)
+        mps_thread_root_snapshot_dpublish (data->snapshot, job.iter, mirror, s->root[mirror]->dvalue);
+
       pthread_mutex_unlock (&data->roots_mutex[i]);
     }
 
@@ -371,6 +435,7 @@ mps_secular_ga_diterate (mps_context * s, int maxit, mps_boolean just_regenerate
   int i;
   int nit = 0;
   int it_threshold = 0;
+  mps_conjugate_pairs *pairs;
 
   s->operation = MPS_OPERATION_ABERTH_DPE_ITERATIONS;
 
@@ -379,16 +444,13 @@ mps_secular_ga_diterate (mps_context * s, int maxit, mps_boolean just_regenerate
 #endif
 
   mps_thread_worker_data *data;
-  pthread_mutex_t *aberth_mutex =
-    (pthread_mutex_t*)mps_malloc (sizeof(pthread_mutex_t) * s->n);
+  mps_thread_root_snapshot *snapshot;
+  cdpe_t *dvalues;
   pthread_mutex_t *roots_mutex =
     (pthread_mutex_t*)mps_malloc (sizeof(pthread_mutex_t) * s->n);
 
   for (i = 0; i < s->n; i++)
-    {
-      pthread_mutex_init (roots_mutex + i, NULL);
-      pthread_mutex_init (aberth_mutex + i, NULL);
-    }
+    pthread_mutex_init (roots_mutex + i, NULL);
 
   data = mps_newv (mps_thread_worker_data, s->n_threads);
 
@@ -396,6 +458,9 @@ mps_secular_ga_diterate (mps_context * s, int maxit, mps_boolean just_regenerate
 
   s->best_approx = false;
 
+  /* Stop refining the approximations out of the search region */
+  mps_search_region_freeze (s);
+
   /* Mark the approximated roots as ready for output */
   for (i = 0; i < s->n; i++)
     {
@@ -411,11 +476,17 @@ mps_secular_ga_diterate (mps_context * s, int maxit, mps_boolean just_regenerate
           s->root[i]->again = false;
           s->root[i]->approximated = true;
         }
-
-      if (!s->root[i]->again || s->root[i]->approximated)
-        computed_roots++;
     }
 
+  /* Iterate only on one approximation of every conjugate pair, if possible.
+   * The states of the pairs are merged, so this must be done before
+   * counting the approximated roots. */
+  pairs = mps_conjugate_dpairs (s);
+
+  for (i = 0; i < s->n; i++)
+    if (!s->root[i]->again || s->root[i]->approximated)
+      computed_roots++;
+
   it_threshold = (s->n - computed_roots);
 
   MPS_DEBUG_WITH_INFO (s, "%d roots %s already approximated at the start of the packet", 
@@ -423,6 +494,8 @@ mps_secular_ga_diterate (mps_context * s, int maxit, mps_boolean just_regenerate
 		       (computed_roots == 1) ? "is" : "are");
 
   mps_thread_job_queue *queue = mps_thread_job_queue_new (s);
+  snapshot = mps_thread_root_snapshot_new (s, dpe_phase);
+  dvalues = cdpe_valloc (s->n_threads * s->n);
 
   for (i = 0; i < s->n_threads; i++)
     {
@@ -431,15 +504,21 @@ mps_secular_ga_diterate (mps_context * s, int maxit, mps_boolean just_regenerate
       data[i].s = s;
       data[i].thread = i;
       data[i].n_threads = s->n_threads;
-      data[i].aberth_mutex = aberth_mutex;
+      data[i].aberth_mutex = NULL;
       data[i].roots_mutex = roots_mutex;
       data[i].queue = queue;
+      data[i].snapshot = snapshot;
+      data[i].dvalues = dvalues + i * s->n;
+      data[i].pairs = pairs;
 
       mps_thread_pool_assign (s, s->pool, __mps_secular_ga_diterate_worker, data + i);
     }
 
   mps_thread_pool_wait (s, s->pool);
 
+  if (pairs)
+    mps_conjugate_packet_done (s, pairs, computed_roots);
+
   /* Check if the roots are improvable in floating point */
   MPS_DEBUG_WITH_INFO (s, "Performed %d iterations with CDPE arithmetic",
                        nit);
@@ -472,7 +551,8 @@ mps_secular_ga_diterate (mps_context * s, int maxit, mps_boolean just_regenerate
 #endif
 
   mps_thread_job_queue_free (queue);
-  free (aberth_mutex);
+  mps_thread_root_snapshot_free (snapshot);
+  cdpe_vfree (dvalues);
   free (roots_mutex);
 
   free (data);
@@ -488,9 +568,9 @@ __mps_secular_ga_miterate_worker (void* data_ptr)
   mps_thread_worker_data *data = (mps_thread_worker_data*)data_ptr;
   mps_context *s = data->s;
   /* mps_secular_equation *sec = s->secular_equation; */
-  int i;
+  int i, mirror;
   mpc_t corr, abcorr;
-  mpc_t mroot;
+  mpc_t mroot, old_mroot;
   rdpe_t modcorr;
   mps_thread_job job;
 
@@ -499,6 +579,7 @@ __mps_secular_ga_miterate_worker (void* data_ptr)
   mpc_init2 (corr, s->mpwp);
   mpc_init2 (abcorr, s->mpwp);
   mpc_init2 (mroot, s->mpwp);
+  mpc_init2 (old_mroot, s->mpwp);
 
   /* Get a copy of the MP coefficients that is local to this thread */
   while (true && !s->exit_required)
@@ -517,9 +598,18 @@ __mps_secular_ga_miterate_worker (void* data_ptr)
           goto cleanup;
         }
 
+      /* The conjugates are updated together with the approximations
+       * they are paired with */
+      if (mps_conjugate_skip (data->pairs, i, data->roots_mutex))
+        {
+          pthread_mutex_unlock (&data->roots_mutex[i]);
+          continue;
+        }
+
       /* printf ("Thread %d iterating on root %d\n", data->thread, i); */
 
       cluster = job.cluster_item->cluster;
+      mirror = -1;
 
       if (s->root[i]->again && !s->root[i]->approximated)
         {
@@ -527,6 +617,7 @@ __mps_secular_ga_miterate_worker (void* data_ptr)
           pthread_mutex_lock (&data->aberth_mutex[i]);
           mpc_set (mroot, s->root[i]->mvalue);
           pthread_mutex_unlock (&data->aberth_mutex[i]);
+          mpc_set (old_mroot, mroot);
 
           /* Check if, while we were waiting, excep condition has been reached,
            * or all the zeros has been approximated.                         */
@@ -542,6 +633,7 @@ __mps_secular_ga_miterate_worker (void* data_ptr)
 
           mps_secular_mnewton (s, MPS_POLYNOMIAL (s->secular_equation), s->root[i],
                                corr, mpc_get_prec (s->root[i]->mvalue));
+          __sync_add_and_fetch (&s->newton_corrections, 1);
 
           /* Apply Aberth correction */
           mps_maberth_s_wl (s, i, cluster, abcorr, data->aberth_mutex);
@@ -564,8 +656,6 @@ __mps_secular_ga_miterate_worker (void* data_ptr)
             {
               if (s->debug_level & MPS_DEBUG_APPROXIMATIONS)
                 MPS_DEBUG (s, "Root %d again was set to false on iteration %d by thread %d", i, *data->it, data->thread);
-
-              (*data->nzeros)++;
             }
           else
             {
@@ -581,6 +671,12 @@ __mps_secular_ga_miterate_worker (void* data_ptr)
               rdpe_mul_eq (modcorr, s->mp_epsilon);
               rdpe_add_eq (s->root[i]->drad, modcorr);
             }
+
+          if (data->pairs)
+            mirror = mps_conjugate_mupdate (s, data->pairs, i, old_mroot, corr, data->aberth_mutex);
+
+          if (!s->root[i]->again || s->root[i]->approximated)
+            (*data->nzeros) += (mirror >= 0) ? 2 : 1;
         }
 
       pthread_mutex_unlock (&data->roots_mutex[i]);
@@ -588,6 +684,7 @@ __mps_secular_ga_miterate_worker (void* data_ptr)
 
 cleanup:
   mpc_clear (mroot);
+  mpc_clear (old_mroot);
   mpc_clear (abcorr);
   mpc_clear (corr);
 
@@ -616,6 +713,7 @@ mps_secular_ga_miterate (mps_context * s, int maxit, mps_boolean just_regenerate
   int i;
   int nit = 0;
   int it_threshold = 0;
+  mps_conjugate_pairs *pairs;
 
   s->operation = MPS_OPERATION_ABERTH_MP_ITERATIONS;
 
@@ -645,6 +743,9 @@ mps_secular_ga_miterate (mps_context * s, int maxit, mps_boolean just_regenerate
 
   it_threshold = s->n - computed_roots;
 
+  /* Stop refining the approximations out of the search region */
+  mps_search_region_freeze (s);
+
   /* Mark the approximated roots as ready for output */
   for (i = 0; i < s->n; i++)
     {
@@ -660,11 +761,17 @@ mps_secular_ga_miterate (mps_context * s, int maxit, mps_boolean just_regenerate
           s->root[i]->again = false;
           s->root[i]->approximated = true;
         }
-
-      if (!s->root[i]->again || s->root[i]->approximated)
-        computed_roots++;
     }
 
+  /* Iterate only on one approximation of every conjugate pair, if possible.
+   * The states of the pairs are merged, so this must be done before
+   * counting the approximated roots. */
+  pairs = mps_conjugate_mpairs (s);
+
+  for (i = 0; i < s->n; i++)
+    if (!s->root[i]->again || s->root[i]->approximated)
+      computed_roots++;
+
   mps_thread_job_queue *queue = mps_thread_job_queue_new (s);
 
   for (i = 0; i < s->n_threads; i++)
@@ -678,12 +785,16 @@ mps_secular_ga_miterate (mps_context * s, int maxit, mps_boolean just_regenerate
       data[i].roots_mutex = roots_mutex;
       data[i].queue = queue;
       data[i].gs_mutex = &gs_mutex;
+      data[i].pairs = pairs;
 
       mps_thread_pool_assign (s, s->pool, __mps_secular_ga_miterate_worker, data + i);
     }
 
   mps_thread_pool_wait (s, s->pool);
 
+  if (pairs)
+    mps_conjugate_packet_done (s, pairs, computed_roots);
+
   /* Check if the roots are improvable in floating point */
   MPS_DEBUG_WITH_INFO (s, "Performed %d iterations with MP arithmetic",
                        nit);
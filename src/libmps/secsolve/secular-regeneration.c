@@ -147,8 +147,10 @@ __mps_secular_ga_regenerate_coefficients_monomial_worker (void * data_ptr)
   mps_polynomial * restrict p = s->active_poly;
   int i = data->i, j;
 
-  /* Multiprecision variables */
-  mpc_t mprod_b, ctmp, mdiff, lc, my_b;
+  /* Multiprecision variables, taken from the scratch arena of the thread */
+  mpc_scratch * sc;
+  mpc_ptr mprod_b, ctmp, mdiff, lc, my_b;
+  int scratch_used = 0;
 
   /* Floating point temporary variables */
   rdpe_t root_epsilon;
@@ -185,15 +187,11 @@ __mps_secular_ga_regenerate_coefficients_monomial_worker (void * data_ptr)
     }
 
   /* Init multiprecision values */
-  mpc_init2 (mprod_b, coeff_wp);
-  mpc_init2 (ctmp, coeff_wp);
-  mpc_init2 (mdiff, coeff_wp);
-  mpc_init2 (lc, coeff_wp);
-  mpc_init2 (my_b, coeff_wp);
-
-  mpc_set_si (lc, -1, 0);
-  mps_polynomial_get_leading_coefficient (s, p, ctmp);
-  mpc_div_eq (lc, ctmp);
+  sc = mpc_scratch_get ();
+  ctmp = mpc_scratch_push (sc, coeff_wp);
+  mdiff = mpc_scratch_push (sc, coeff_wp);
+  my_b = mpc_scratch_push (sc, coeff_wp);
+  scratch_used += 3;
 
   /*
    * The new coefficients of the secular equation can be computed
@@ -208,12 +206,16 @@ __mps_secular_ga_regenerate_coefficients_monomial_worker (void * data_ptr)
     {
       rdpe_t relative_error, rtmp;
       cdpe_t cpol, cdiff, cprod_b;
-      mpc_t tx;
+      mpc_ptr tx, etx;
 
       /* Set up a temporary memory location to hold the value of b_i, since we need
        * to play with its precision. This is not doable directly because it will
        * disturb other threads at work. */
-      mpc_init2 (tx, s->root[i]->wp);
+      tx = mpc_scratch_push (sc, s->root[i]->wp);
+      scratch_used++;
+
+      lc = mpc_scratch_push (sc, coeff_wp);
+      scratch_used++;
 
       /* Give a sensible minimum bound to the necessary precision */
       s->root[i]->wp = MAX (s->mpwp + log2 (s->n), s->root[i]->wp);
@@ -228,9 +230,9 @@ __mps_secular_ga_regenerate_coefficients_monomial_worker (void * data_ptr)
 
       mpc_set_si (lc, -1, 0);
       mps_polynomial_get_leading_coefficient (s, p, ctmp);
-      mpc_div_eq (lc, ctmp);
+      mpc_div_scratch (sc, lc, lc, ctmp);
 
-      mpc_mul_eq (sec->ampc[i], lc);
+      mpc_mul_scratch (sc, sec->ampc[i], sec->ampc[i], lc);
 
       if (s->debug_level & MPS_DEBUG_REGENERATION)
         MPS_DEBUG_MPC (s, mpc_get_prec (sec->ampc[i]), sec->ampc[i], "p(b_%d)", i);
@@ -248,8 +250,12 @@ __mps_secular_ga_regenerate_coefficients_monomial_worker (void * data_ptr)
            * required precision to get a result exact to machine precision */
           mps_secular_ga_update_root_wp (s, i, required_precision, bmpc);
 
-          /* Try to recompute the polynomial with the augmented precision and see if now relative_error matches */
-          mpc_set_prec (tx, s->root[i]->wp);
+          /* Try to recompute the polynomial with the augmented precision and see if now relative_error matches.
+           * The precision of the temporaries of the arena cannot be raised, so tx is copied in a new one. */
+          etx = mpc_scratch_push (sc, s->root[i]->wp);
+          scratch_used++;
+          mpc_set (etx, tx);
+          tx = etx;
           mps_polynomial_meval (s, p, tx, sec->ampc[i], relative_error);
 
           mpc_get_cdpe (cpol, sec->ampc[i]);
@@ -258,9 +264,9 @@ __mps_secular_ga_regenerate_coefficients_monomial_worker (void * data_ptr)
 
           mpc_set_si (lc, -1, 0);
           mps_polynomial_get_leading_coefficient (s, p, ctmp);
-          mpc_div_eq (lc, ctmp);
+          mpc_div_scratch (sc, lc, lc, ctmp);
 
-          mpc_mul_eq (sec->ampc[i], lc);
+          mpc_mul_scratch (sc, sec->ampc[i], sec->ampc[i], lc);
 
           if (s->debug_level & MPS_DEBUG_REGENERATION)
             MPS_DEBUG_MPC (s, mpc_get_prec (sec->ampc[i]), sec->ampc[i], "p(b_%d)", i);
@@ -271,14 +277,8 @@ __mps_secular_ga_regenerate_coefficients_monomial_worker (void * data_ptr)
             }
         }
 
-      if (mpc_get_prec (mprod_b) < s->root[i]->wp)
-        {
-          mpc_set_prec (mprod_b, s->root[i]->wp);
-          mpc_set_prec (lc, s->root[i]->wp);
-          mpc_set_si (lc, -1, 0);
-          mps_polynomial_get_leading_coefficient (s, p, ctmp);
-          mpc_div_eq (lc, ctmp);
-        }
+      mprod_b = mpc_scratch_push (sc, MAX (coeff_wp, s->root[i]->wp));
+      scratch_used++;
 
       pthread_mutex_lock (&sec->bmpc_mutex[i]);
       mpc_set (my_b, bmpc[i]);
@@ -315,7 +315,7 @@ __mps_secular_ga_regenerate_coefficients_monomial_worker (void * data_ptr)
           if (s->lastphase != mp_phase)
             cdpe_mul_eq (cprod_b, cdiff);
           else
-            mpc_mul_eq (mprod_b, mdiff);
+            mpc_mul_scratch (sc, mprod_b, mprod_b, mdiff);
         }
 
       if (s->lastphase != mp_phase)
@@ -323,7 +323,7 @@ __mps_secular_ga_regenerate_coefficients_monomial_worker (void * data_ptr)
 
       /* Actually divide the result and store it in
        * a_i, as requested. */
-      mpc_div_eq (sec->ampc[i], mprod_b);
+      mpc_div_scratch (sc, sec->ampc[i], sec->ampc[i], mprod_b);
 
       /* Debug computed coefficients */
       if (s->debug_level & MPS_DEBUG_REGENERATION)
@@ -331,11 +331,12 @@ __mps_secular_ga_regenerate_coefficients_monomial_worker (void * data_ptr)
           MPS_DEBUG_MPC (s, s->mpwp, sec->ampc[i], "a_%d", i);
           MPS_DEBUG_MPC (s, s->mpwp, sec->bmpc[i], "b_%d", i);
         }
-
-      mpc_clear (tx);
     } /* Close the case where the coefficient are not approximated or isolated */
   else
     {
+      mprod_b = mpc_scratch_push (sc, coeff_wp);
+      scratch_used++;
+
       mpc_set_ui (mprod_b, 1U, 0U);
 
       for (j = 0; j < MPS_POLYNOMIAL (sec)->degree; j++)
@@ -344,24 +345,20 @@ __mps_secular_ga_regenerate_coefficients_monomial_worker (void * data_ptr)
             {
               mpc_sub (mdiff, bmpc[i], old_mb[j]);
 
-              mpc_mul_eq (mprod_b, mdiff);
+              mpc_mul_scratch (sc, mprod_b, mprod_b, mdiff);
 
               mpc_sub (mdiff, bmpc[i], bmpc[j]);
 
-              mpc_div_eq (mprod_b, mdiff);
+              mpc_div_scratch (sc, mprod_b, mprod_b, mdiff);
             }
         }
 
-      mpc_mul_eq (sec->ampc[i], mprod_b);
+      mpc_mul_scratch (sc, sec->ampc[i], sec->ampc[i], mprod_b);
     }
 
 monomial_regenerate_exit:
-  /* Clear requested storage */
-  mpc_clear (mdiff);
-  mpc_clear (mprod_b);
-  mpc_clear (ctmp);
-  mpc_clear (lc);
-  mpc_clear (my_b);
+  /* Give back the temporaries to the arena */
+  mpc_scratch_pop (sc, scratch_used);
   /* mps_boolean_vfree (root_changed); */
 
   if (!success)
@@ -369,6 +366,160 @@ monomial_regenerate_exit:
   return NULL;
 }
 
+/*! @cond PRIVATE */
+struct __mps_secular_ga_multipoint_data {
+  mps_context * s;
+  mpc_t * p;
+  long int prec;
+  mpc_t * pvalues;
+  mpc_t * dvalues;
+};
+/*! @endcond */
+
+static void *
+__mps_secular_ga_multipoint_worker (void * data_ptr)
+{
+  struct __mps_secular_ga_multipoint_data * data = data_ptr;
+  mps_context * s = data->s;
+  mps_multipoint_tree * tree;
+  mpc_t * dm = mpc_valloc (s->n);
+  mpc_t * polys[2], * values[2];
+  int lengths[2];
+
+  tree = mps_multipoint_tree_new (s, s->secular_equation->bmpc, s->n, data->prec);
+
+  mpc_vinit2 (dm, s->n, data->prec);
+  mps_multipoint_tree_derivative (tree, dm);
+
+  polys[0] = data->p;
+  lengths[0] = s->n + 1;
+  values[0] = data->pvalues;
+  polys[1] = dm;
+  lengths[1] = s->n;
+  values[1] = data->dvalues;
+
+  mps_multipoint_tree_eval (s, tree, 2, polys, lengths, values);
+
+  mpc_vclear (dm, s->n);
+  free (dm);
+  mps_multipoint_tree_free (tree);
+
+  return NULL;
+}
+
+/**
+ * @brief Compute the coefficients \f$a_i = -p(b_i) / (p_n \prod_{j \neq i} (b_i - b_j))\f$
+ * of the changed roots with a multipoint evaluation of the monomial polynomial.
+ *
+ * The values of \f$p(b_i)\f$ and of the products are computed twice with a
+ * <code>mps_multipoint_tree</code>, with guard bits and with some more bits.
+ * The difference of the two results bounds the error of the first one, and is
+ * used to accept only the coefficients whose relative error is below the
+ * accuracy of the current phase. The other ones, and those of the roots that
+ * need a precision larger than the one used here, are left to
+ * __mps_secular_ga_regenerate_coefficients_monomial_worker().
+ *
+ * @param s The <code>mps_context</code> of the computation.
+ * @param root_changed The roots whose coefficients must be recomputed.
+ * @param regenerated On output, true for the coefficients that have been
+ * computed.
+ */
+static void
+mps_secular_ga_regenerate_coefficients_multipoint (mps_context * s, mps_boolean * root_changed,
+                                                   mps_boolean * regenerated)
+{
+  MPS_DEBUG_THIS_CALL (s);
+
+  mps_secular_equation * sec = s->secular_equation;
+  mps_polynomial * p = s->active_poly;
+  mps_monomial_poly * mp = MPS_MONOMIAL_POLY (p);
+  long int min_prec = mps_context_get_minimum_precision (s);
+  long int wp, guard, log_n = (long int) ceil (log2 (s->n));
+  struct __mps_secular_ga_multipoint_data data[2];
+  mpc_t lc, ctmp, diff;
+  rdpe_t root_epsilon, rtmp, rdiff;
+  int i, k, regenerated_roots = 0;
+
+  if (s->lastphase == mp_phase)
+    rdpe_set (root_epsilon, s->mp_epsilon);
+  else
+    rdpe_set_d (root_epsilon, DBL_EPSILON);
+
+  /* The same working precision set by the Horner based regeneration. The
+   * guard bits compensate for the cancellation in the remainders. */
+  wp = ((s->mpwp + log_n - 1) / min_prec + 1) * min_prec;
+  guard = ((2 * log_n + 64 - 1) / min_prec + 1) * min_prec;
+
+  mps_polynomial_raise_data (s, p, wp + guard + 2 * min_prec);
+
+  for (k = 0; k < 2; k++)
+    {
+      data[k].s = s;
+      data[k].p = mp->mfpc;
+      data[k].prec = wp + guard + 2 * k * min_prec;
+      data[k].pvalues = mpc_valloc (s->n);
+      data[k].dvalues = mpc_valloc (s->n);
+      mpc_vinit2 (data[k].pvalues, s->n, data[k].prec);
+      mpc_vinit2 (data[k].dvalues, s->n, data[k].prec);
+      mps_thread_pool_assign (s, s->pool, __mps_secular_ga_multipoint_worker, data + k);
+    }
+
+  mps_thread_pool_wait (s, s->pool);
+
+  mpc_init2 (lc, wp);
+  mpc_init2 (ctmp, wp);
+  mpc_init2 (diff, data[1].prec);
+
+  mpc_set_si (lc, -1, 0);
+  mps_polynomial_get_leading_coefficient (s, p, ctmp);
+  mpc_div_eq (lc, ctmp);
+
+  for (i = 0; i < s->n; i++)
+    {
+      regenerated[i] = false;
+
+      if (!root_changed[i] || s->root[i]->wp > wp)
+        continue;
+
+      mpc_sub (diff, data[0].pvalues[i], data[1].pvalues[i]);
+      mpc_rmod (rdiff, diff);
+      mpc_rmod (rtmp, data[1].pvalues[i]);
+      rdpe_mul_eq (rtmp, root_epsilon);
+      if (rdpe_eq_zero (rtmp) || rdpe_gt (rdiff, rtmp))
+        continue;
+
+      mpc_sub (diff, data[0].dvalues[i], data[1].dvalues[i]);
+      mpc_rmod (rdiff, diff);
+      mpc_rmod (rtmp, data[1].dvalues[i]);
+      rdpe_mul_eq (rtmp, root_epsilon);
+      if (rdpe_eq_zero (rtmp) || rdpe_gt (rdiff, rtmp))
+        continue;
+
+      mps_secular_ga_update_root_wp (s, i, wp, sec->bmpc);
+
+      mpc_mul (sec->ampc[i], data[1].pvalues[i], lc);
+      mpc_div_eq (sec->ampc[i], data[1].dvalues[i]);
+
+      regenerated[i] = true;
+      regenerated_roots++;
+    }
+
+  MPS_DEBUG (s, "%d of %d coefficients regenerated with the multipoint evaluation",
+             regenerated_roots, s->n);
+
+  mpc_clear (lc);
+  mpc_clear (ctmp);
+  mpc_clear (diff);
+
+  for (k = 0; k < 2; k++)
+    {
+      mpc_vclear (data[k].pvalues, s->n);
+      mpc_vclear (data[k].dvalues, s->n);
+      free (data[k].pvalues);
+      free (data[k].dvalues);
+    }
+}
+
 /**
  * @brief Compute the new secular equation coefficients based on the monomial input
  * in <code>s->monomial_poly</code>.
@@ -388,17 +539,50 @@ mps_secular_ga_regenerate_coefficients_monomial (mps_context * s, cdpe_t * old_b
 {
   MPS_DEBUG_THIS_CALL (s);
 
-  int i;
+  int i, j, changed_roots = 0;
   mps_secular_equation * sec = s->secular_equation;
   mps_boolean success = true;
+  mps_boolean * regenerated = mps_boolean_valloc (s->n);
+  int * conjugate;
 
   struct __mps_secular_ga_regenerate_coefficients_monomial_data * data =
     mps_newv (struct __mps_secular_ga_regenerate_coefficients_monomial_data, s->n);
 
   MPS_DEBUG (s, "Regenerating coefficients from monomial input");
 
+  /* If the nodes are exactly symmetric with respect to the real axis, the
+   * coefficients of conjugate nodes are conjugate, so only one of them is
+   * computed. Both are recomputed if one of the nodes has changed. */
+  conjugate = mps_conjugate_mnodes (s, sec->bmpc);
+  if (conjugate)
+    for (i = 0; i < s->n; i++)
+      if (conjugate[i] < 0)
+        {
+          j = -1 - conjugate[i];
+          root_changed[i] = root_changed[j] = root_changed[i] || root_changed[j];
+        }
+
+  for (i = 0; i < s->n; i++)
+    {
+      regenerated[i] = false;
+      if (root_changed[i])
+        changed_roots++;
+    }
+
+  /* The multipoint evaluation needs all the b_i, so it pays off only if a
+   * good share of them has changed. */
+  if (s->multipoint_regeneration_degree > 0 && s->n >= s->multipoint_regeneration_degree &&
+      MPS_IS_MONOMIAL_POLY (s->active_poly) && changed_roots >= s->n / 4)
+    mps_secular_ga_regenerate_coefficients_multipoint (s, root_changed, regenerated);
+
   for (i = s->n - 1; i >= 0; i--)
     {
+      if (regenerated[i])
+        continue;
+
+      if (conjugate && conjugate[i] < 0 && root_changed[i] && !regenerated[-1 - conjugate[i]])
+        continue;
+
       data[i].i = i;
       data[i].old_b = old_b;
       data[i].old_mb = old_mb;
@@ -412,7 +596,25 @@ mps_secular_ga_regenerate_coefficients_monomial (mps_context * s, cdpe_t * old_b
 
   mps_thread_pool_wait (s, s->pool);
 
+  if (conjugate)
+    {
+      for (i = 0; i < s->n; i++)
+        {
+          j = -1 - conjugate[i];
+
+          if (conjugate[i] >= 0 || !root_changed[i] || regenerated[i] || regenerated[j])
+            continue;
+
+          mps_secular_ga_update_root_wp (s, i, s->root[j]->wp, sec->bmpc);
+          mpc_set_prec (sec->ampc[i], mpc_get_prec (sec->ampc[j]));
+          mpc_con (sec->ampc[i], sec->ampc[j]);
+        }
+
+      free (conjugate);
+    }
+
   free (data);
+  mps_boolean_vfree (regenerated);
 
   return success;
 }
@@ -231,36 +231,40 @@ mps_boolean
 mps_secular_meval (mps_context * s, mps_polynomial * p, mpc_t x, mpc_t value)
 {
   mps_secular_equation * sec = MPS_SECULAR_EQUATION (p);
-  mps_boolean success = true;
-  mpc_t ctmp;
+  mpc_scratch * sc;
+  mpc_ptr sum;
   unsigned int wp = mpc_get_prec (x);
-  int i;
+  mps_boolean success;
 
   /* Lower the working precision in case of limited precision coefficients
    * in the input polynomial. */
   if (p->prec > 0 && p->prec < wp)
     wp = p->prec;
 
-  mpc_init2 (ctmp, wp);
-  mpc_set_ui (value, 0U, 0U);
-
-  for (i = 0; i < s->n; ++i)
+  /* The sum is computed at the precision of its destination, so a
+   * temporary is needed if the value has more bits than necessary. */
+  if (mpc_get_prec (value) <= wp)
     {
-      mpc_sub (ctmp, x, sec->bmpc[i]);
-      if (mpc_eq_zero (ctmp))
-        {
-          success = false;
-          goto cleanup;
-        }
+      if (mpc_sum_inv_diff (value, x, sec->bmpc, sec->ampc, s->n) >= 0)
+        return false;
 
-      mpc_div (ctmp, sec->ampc[i], ctmp);
-      mpc_add_eq (value, ctmp);
+      mpc_sub_eq_ui (value, 1U, 0U);
+
+      return true;
     }
 
-  mpc_sub_eq_ui (value, 1U, 0U);
+  sc = mpc_scratch_get ();
+  sum = mpc_scratch_push (sc, wp);
+
+  success = mpc_sum_inv_diff (sum, x, sec->bmpc, sec->ampc, s->n) < 0;
+  if (success)
+    {
+      mpc_set (value, sum);
+      mpc_sub_eq_ui (value, 1U, 0U);
+    }
+
+  mpc_scratch_pop (sc, 1);
 
-cleanup:
-  mpc_clear (ctmp);
   return success;
 }
 
@@ -12,6 +12,7 @@
 
 
 #include <mps/mps.h>
+#include <mps/private/mpcn.h>
 #include <limits.h>
 #include <math.h>
 
@@ -466,10 +467,9 @@ mps_secular_mparallel_sum (mps_context * s, mps_approximation * root, int n, mpc
   if (n <= 2)
     {
       int i;
-      mpc_t ctmp, ctmp2;
-
-      mpc_init2 (ctmp, wp);
-      mpc_init2 (ctmp2, wp);
+      mpc_scratch * sc = mpc_scratch_get ();
+      mpc_ptr ctmp = mpc_scratch_push (sc, wp);
+      mpc_ptr ctmp2 = mpc_scratch_push (sc, wp);
 
       for (i = 0; i < n; i++)
         {
@@ -482,17 +482,18 @@ mps_secular_mparallel_sum (mps_context * s, mps_approximation * root, int n, mpc
            * without doing any further iteration */
           if (mpc_eq_zero (ctmp))
             {
+              mpc_scratch_pop (sc, 2);
               return i;
             }
 
           /* Compute (z-b_i)^{-1} */
-          mpc_inv_eq (ctmp);
+          mpc_inv_scratch (sc, ctmp, ctmp);
 
           /* Compute sum of (z-b_i)^{-1} */
           mpc_add_eq (sumb, ctmp);
 
           /* Compute a_i / (z - b_i) */
-          mpc_mul (ctmp2, ampc[i], ctmp);
+          mpc_mul_scratch (sc, ctmp2, ampc[i], ctmp);
 
           /* Compute the sum of module of (a_i/(z-b_i)) */
           mpc_rmod (rtmp, ctmp2);
@@ -502,14 +503,13 @@ mps_secular_mparallel_sum (mps_context * s, mps_approximation * root, int n, mpc
           mpc_add_eq (pol, ctmp2);
 
           /* Compute a_i / (z - b_i)^2a */
-          mpc_mul_eq (ctmp2, ctmp);
+          mpc_mul_scratch (sc, ctmp2, ctmp2, ctmp);
 
           /* Add it to fp */
           mpc_sub_eq (fp, ctmp2);
         }
 
-      mpc_clear (ctmp);
-      mpc_clear (ctmp2);
+      mpc_scratch_pop (sc, 2);
 
       return MPS_PARALLEL_SUM_SUCCESS;
     }
@@ -529,22 +529,71 @@ mps_secular_mparallel_sum (mps_context * s, mps_approximation * root, int n, mpc
     }
 }
 
+/*
+ * Version of mps_secular_mparallel_sum() that uses the kernels with n limbs
+ * of mpcn.h. The terms are accumulated in the same order.
+ */
+MPS_MPCN_INLINE int
+mps_secular_mparallel_sum_n (const int n, mps_approximation * root, int m, mpc_t * ampc, mpc_t * bmpc,
+                             mpc_t pol, mpc_t fp, mpc_t sumb, rdpe_t asum)
+{
+  int i;
+  mps_mpcn_t x, npol, nfp, nsumb, t, u, v;
+  cdpe_t ctmp;
+  rdpe_t rtmp;
+
+  mps_mpcn_set_mpc (n, x, root->mvalue);
+  mps_mpcn_set_mpc (n, npol, pol);
+  mps_mpcn_set_mpc (n, nfp, fp);
+  mps_mpcn_set_mpc (n, nsumb, sumb);
+
+  for (i = 0; i < m; i++)
+    {
+      /* Compute (z - b_i)^{-1}, and check if z == b_i */
+      mps_mpcn_set_mpc (n, t, bmpc[i]);
+      mps_mpcn_sub (n, t, x, t);
+      if (mps_mpcn_eq_zero (t))
+        return i;
+      mps_mpcn_inv (n, u, t);
+      mps_mpcn_add (n, nsumb, nsumb, u);
+
+      /* Compute a_i / (z - b_i), and its modulus */
+      mps_mpcn_set_mpc (n, t, ampc[i]);
+      mps_mpcn_mul (n, v, t, u);
+      mps_mpcn_get_cdpe (n, ctmp, v);
+      cdpe_mod (rtmp, ctmp);
+      rdpe_add_eq (asum, rtmp);
+      mps_mpcn_add (n, npol, npol, v);
+
+      /* Compute a_i / (z - b_i)^2 */
+      mps_mpcn_mul (n, t, v, u);
+      mps_mpcn_sub (n, nfp, nfp, t);
+    }
+
+  mps_mpcn_get_mpc (n, pol, npol);
+  mps_mpcn_get_mpc (n, fp, nfp);
+  mps_mpcn_get_mpc (n, sumb, nsumb);
+
+  return MPS_PARALLEL_SUM_SUCCESS;
+}
+
 void
 mps_secular_mnewton (mps_context * s, mps_polynomial * p, mps_approximation * root, mpc_t corr, long int wp)
 {
   int i;
-  mpc_t ctmp, ctmp2, pol, fp, sumb, x;
+  mpc_scratch * sc = mpc_scratch_get ();
+  mpc_ptr ctmp, ctmp2, pol, fp, sumb, x;
   rdpe_t apol, acorr, rtmp, epsilon;
   rdpe_t asum, asum_on_apol, ax, axeps;
   mps_secular_equation *sec = MPS_SECULAR_EQUATION (p);
 
-  /* Init MP variables */
-  mpc_init2 (x, wp);
-  mpc_init2 (ctmp, wp);
-  mpc_init2 (ctmp2, wp);
-  mpc_init2 (pol, wp);
-  mpc_init2 (fp, wp);
-  mpc_init2 (sumb, wp);
+  /* Get the MP variables from the scratch arena */
+  x = mpc_scratch_push (sc, wp);
+  ctmp = mpc_scratch_push (sc, wp);
+  ctmp2 = mpc_scratch_push (sc, wp);
+  pol = mpc_scratch_push (sc, wp);
+  fp = mpc_scratch_push (sc, wp);
+  sumb = mpc_scratch_push (sc, wp);
 
   mpc_set (x, root->mvalue);
 
@@ -569,9 +618,32 @@ mps_secular_mnewton (mps_context * s, mps_polynomial * p, mps_approximation * ro
   mpc_set_ui (sumb, 0U, 0U);
   mpc_set_ui (corr, 0U, 0U);
 
-  if ((i = mps_secular_mparallel_sum (s, root, MPS_POLYNOMIAL (sec)->degree, sec->ampc,
-                                      sec->bmpc, pol,
-                                      fp, sumb, asum)) >= 0)
+  /* Use the kernels with a fixed number of limbs if the precision
+   * is small enough. */
+  switch (mps_mpcn_limbs (wp))
+    {
+    case 2:
+      i = mps_secular_mparallel_sum_n (2, root, MPS_POLYNOMIAL (sec)->degree, sec->ampc,
+                                       sec->bmpc, pol, fp, sumb, asum);
+      break;
+
+    case 4:
+      i = mps_secular_mparallel_sum_n (4, root, MPS_POLYNOMIAL (sec)->degree, sec->ampc,
+                                       sec->bmpc, pol, fp, sumb, asum);
+      break;
+
+    case 8:
+      i = mps_secular_mparallel_sum_n (8, root, MPS_POLYNOMIAL (sec)->degree, sec->ampc,
+                                       sec->bmpc, pol, fp, sumb, asum);
+      break;
+
+    default:
+      i = mps_secular_mparallel_sum (s, root, MPS_POLYNOMIAL (sec)->degree, sec->ampc,
+                                     sec->bmpc, pol, fp, sumb, asum);
+      break;
+    }
+
+  if (i >= 0)
     {
       int k;
 
@@ -594,8 +666,8 @@ mps_secular_mnewton (mps_context * s, mps_polynomial * p, mps_approximation * ro
 
               mpc_sub (ctmp, bmpc[i], bmpc[k]);
               mpc_add (ctmp2, ampc[i], ampc[k]);
-              mpc_inv_eq (ctmp);
-              mpc_mul_eq (ctmp2, ctmp);
+              mpc_inv_scratch (sc, ctmp, ctmp);
+              mpc_mul_scratch (sc, ctmp2, ctmp2, ctmp);
               mpc_add_eq (corr, ctmp2);
 
               mpc_rmod (rtmp, ctmp2);
@@ -607,7 +679,7 @@ mps_secular_mnewton (mps_context * s, mps_polynomial * p, mps_approximation * ro
 
       if (!mpc_eq_zero (corr))
         {
-          mpc_div (corr, ampc[i], corr);
+          mpc_div_scratch (sc, corr, ampc[i], corr);
           mpc_rmod (acorr, corr);
 
           if (rdpe_lt (acorr, axeps))
@@ -629,8 +701,7 @@ mps_secular_mnewton (mps_context * s, mps_polynomial * p, mps_approximation * ro
   mpc_rmod (apol, pol);
 
   /* Compute newton correction */
-  mpc_mul (corr, pol, sumb);
-  mpc_add_eq (corr, fp);
+  mpc_fma_scratch (sc, corr, pol, sumb, fp);
   if (mpc_eq_zero (corr))
     {
       mpc_set (corr, pol);
@@ -638,7 +709,7 @@ mps_secular_mnewton (mps_context * s, mps_polynomial * p, mps_approximation * ro
       goto mnewton_cleanup;
     }
   else
-    mpc_div (corr, pol, corr);
+    mpc_div_scratch (sc, corr, pol, corr);
 
   rdpe_div (asum_on_apol, asum, apol);
   mpc_rmod (acorr, corr);
@@ -680,10 +751,5 @@ mps_secular_mnewton (mps_context * s, mps_polynomial * p, mps_approximation * ro
 
 mnewton_cleanup:
 
-  mpc_clear (ctmp);
-  mpc_clear (ctmp2);
-  mpc_clear (pol);
-  mpc_clear (fp);
-  mpc_clear (sumb);
-  mpc_clear (x);
+  mpc_scratch_pop (sc, 6);
 }
@@ -39,6 +39,15 @@ mps_mp_set_prec (mps_context * s, long int prec)
  *
  * @param s The <code>mps_context</code> of the computation.
  */
+static void
+mps_allocate_roots (mps_context * s, int begin, int end, void * user_data)
+{
+  int i;
+
+  for (i = begin; i < end; i++)
+    s->root[i] = mps_approximation_new (s);
+}
+
 MPS_PRIVATE void
 mps_allocate_data (mps_context * s)
 {
@@ -49,8 +58,13 @@ mps_allocate_data (mps_context * s)
     return;
 
   s->root = mps_newv (mps_approximation *, s->n);
-  for (i = 0; i < s->n; i++)
-    s->root[i] = mps_approximation_new (s);
+
+  /* If the threads are bound to the CPUs let them allocate the roots,
+   * so that the memory is local to the thread that will use them. */
+  if (s->thread_affinity != MPS_THREAD_AFFINITY_NONE)
+    mps_thread_pool_parallel_for (s, s->pool, 0, s->n, 0, mps_allocate_roots, NULL);
+  else
+    mps_allocate_roots (s, 0, s->n, NULL);
 
   /* Reset the cluster structure, so we can start without assumption
    * on the location of the roots. */
@@ -147,12 +161,6 @@ mps_raise_data_raw (mps_context * s, long int prec)
     for (k = 0; k < s->n + 1; k++)
       mpc_set_prec_raw (p->mfpc[k], prec);
 
-  /* Raise the precision of sparse vectors */
-  if (MPS_DENSITY_IS_SPARSE (s->active_poly->density))
-    for (k = 0; k < s->n; k++)
-      if (p->spar[k + 1])
-        mpc_set_prec_raw (p->mfppc[k], prec);
-
   /* raise the precision of auxiliary variables */
   for (k = 0; k < s->n + 1; k++)
     {
@@ -58,6 +58,29 @@ mps_readroots (mps_context * s)
     mpc_inp_str_u (s->root[i]->mvalue, s->rtstr, 10);
 }
 
+/*
+ * Check if the roots equal to zero belong to the search set.
+ */
+static mps_boolean
+mps_zero_roots_in_search_set (mps_context * s)
+{
+  cplx_t zero;
+
+  switch (s->output_config->search_set)
+    {
+    case MPS_SEARCH_SET_UNITARY_DISC_COMPL:
+      return false;
+
+    case MPS_SEARCH_SET_CUSTOM:
+      cplx_set (zero, cplx_zero);
+      return mps_search_region_fclassify (s->output_config->search_region,
+                                          zero, 0.0) != MPS_ROOT_INCLUSION_OUT;
+
+    default:
+      return true;
+    }
+}
+
 /**
  * @brief Count the roots that are included in the search set, excluded
  * form it, or have an undetermined inclusion state.
@@ -90,10 +113,10 @@ mps_countroots (mps_context * s)
         break;
       }
 
-  if (s->output_config->search_set == MPS_SEARCH_SET_UNITARY_DISC_COMPL)
-    s->count[1] += s->zero_roots;
-  else
+  if (mps_zero_roots_in_search_set (s))
     s->count[0] += s->zero_roots;
+  else
+    s->count[1] += s->zero_roots;
 }
 
 /**
@@ -355,7 +378,7 @@ mps_output (mps_context * s)
     mps_outcount (s);
   else
     {
-      if (s->output_config->search_set != MPS_SEARCH_SET_UNITARY_DISC_COMPL)
+      if (mps_zero_roots_in_search_set (s))
         for (i = 0; i < s->zero_roots; i++)
           mps_outroot (s, ISZERO, num++);
       for (ind = 0; ind < s->n; ind++)
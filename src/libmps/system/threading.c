@@ -11,9 +11,12 @@
  */
 
 
+#define _GNU_SOURCE
+
 #include <float.h>
 #include <mps/mps.h>
 #include <pthread.h>
+#include <sched.h>
 #include <stdio.h>
 
 #ifdef HAVE_CONFIG_H
@@ -102,17 +105,34 @@ mps_thread_job_queue_new (mps_context * s)
 {
   /* Space allocation and related jobs */
   mps_thread_job_queue *q;
+  mps_cluster_item * c_item;
+  mps_root * root;
+  int k = 0;
 
   q = (mps_thread_job_queue*)mps_malloc (sizeof(mps_thread_job_queue));
 
-  pthread_mutex_init (&q->mutex, NULL);
+  q->roots = mps_newv (int, s->n);
+  q->cluster_items = mps_newv (mps_cluster_item*, s->n);
+
+  /* Flatten the clusterization, so that the next job can be found
+   * without walking the lists. */
+  for (c_item = s->clusterization->first; c_item != NULL; c_item = c_item->next)
+    for (root = c_item->cluster->first; root != NULL; root = root->next)
+      {
+        q->roots[k] = root->k;
+        q->cluster_items[k] = c_item;
+        k++;
+      }
 
   /* Set initial data */
-  q->iter = 0;
-  q->n_roots = s->n;
+  q->n_roots = k;
   q->max_iter = s->max_it;
-  q->cluster_item = s->clusterization->first;
-  q->root = q->cluster_item->cluster->first;
+  q->cursor = 0;
+
+  /* The exception is raised at the end of the first cluster of the last
+   * iteration */
+  q->excep_job = (long) q->max_iter * q->n_roots +
+                 s->clusterization->first->cluster->n - 1;
   return q;
 }
 
@@ -123,66 +143,464 @@ mps_thread_job_queue_new (mps_context * s)
 void
 mps_thread_job_queue_free (mps_thread_job_queue * q)
 {
-  pthread_mutex_destroy (&q->mutex);
+  free (q->roots);
+  free (q->cluster_items);
   free (q);
 }
 
 /**
  * @brief Obtain iter and i for the next available job.
+ *
+ * The roots are handed out following the order of the clusterization,
+ * and the iteration counter is increased every time all of them have been
+ * assigned. The job that would complete the iteration <code>max_iter</code>
+ * and all the following ones have <code>iter</code> set to
+ * <code>MPS_THREAD_JOB_EXCEP</code>.
  */
 mps_thread_job
 mps_thread_job_queue_next (mps_context * s, mps_thread_job_queue * q)
 {
   mps_thread_job j;
+  long k = __sync_fetch_and_add (&q->cursor, 1);
 
-  pthread_mutex_lock (&q->mutex);
-
-  j.i = 0;
-  j.cluster_item = NULL;
-
-  if (q->iter == MPS_THREAD_JOB_EXCEP)
+  if (k >= q->excep_job)
     {
+      j.i = 0;
+      j.cluster_item = NULL;
       j.iter = MPS_THREAD_JOB_EXCEP;
     }
   else
     {
-      /* Assigning the root */
-      j.i = q->root->k;
-      j.cluster_item = q->cluster_item;
-      j.iter = q->iter;
+      j.i = q->roots[k % q->n_roots];
+      j.cluster_item = q->cluster_items[k % q->n_roots];
+      j.iter = k / q->n_roots;
+    }
+
+  return j;
+}
+
+/**
+ * @brief Create a new mps_thread_root_snapshot holding the current
+ * approximations of the given phase.
+ *
+ * The snapshot is double buffered unless Gauss-Seidel freshness has
+ * been requested with mps_context_set_aberth_snapshot().
+ *
+ * @param s The mps_context of the computation.
+ * @param phase Either <code>float_phase</code> or <code>dpe_phase</code>.
+ */
+mps_thread_root_snapshot *
+mps_thread_root_snapshot_new (mps_context * s, mps_phase phase)
+{
+  mps_thread_root_snapshot * snapshot = mps_new (mps_thread_root_snapshot);
+  int i, k, buffers;
+
+  snapshot->n = s->n;
+  snapshot->phase = phase;
+  snapshot->gauss_seidel = !s->aberth_snapshot;
+  snapshot->fvalues[0] = snapshot->fvalues[1] = NULL;
+  snapshot->dvalues[0] = snapshot->dvalues[1] = NULL;
+
+  buffers = snapshot->gauss_seidel ? 1 : 2;
 
-      /* Get the next element of the cluster, incrementing the queue */
-      q->root = q->root->next;
+  for (k = 0; k < buffers; k++)
+    {
+      snapshot->seq[k] = mps_newv (unsigned int, s->n);
+      for (i = 0; i < s->n; i++)
+        snapshot->seq[k][i] = 0;
 
-      /* Check if the previous one was the last element in the
-       * cluster, and if that's the case pass to the next one. */
-      if (q->root == NULL)
+      switch (phase)
         {
-          q->cluster_item = q->cluster_item->next;
+        case float_phase:
+          snapshot->fvalues[k] = mps_newv (cplx_t, s->n);
+          for (i = 0; i < s->n; i++)
+            cplx_set (snapshot->fvalues[k][i], s->root[i]->fvalue);
+          break;
+
+        case dpe_phase:
+          snapshot->dvalues[k] = mps_newv (cdpe_t, s->n);
+          for (i = 0; i < s->n; i++)
+            cdpe_set (snapshot->dvalues[k][i], s->root[i]->dvalue);
+          break;
+
+        default:
+          break;
+        }
+    }
 
-          /* If we got to the end of the clusterization restart from
-           * the first cluster and dump the iteration counter. */
-          if (q->cluster_item == NULL)
-            {
-              q->cluster_item = s->clusterization->first;
-              q->iter++;
-            }
+  if (snapshot->gauss_seidel)
+    {
+      snapshot->fvalues[1] = snapshot->fvalues[0];
+      snapshot->dvalues[1] = snapshot->dvalues[0];
+      snapshot->seq[1] = snapshot->seq[0];
+    }
 
-          q->root = q->cluster_item->cluster->first;
+  return snapshot;
+}
 
+/**
+ * @brief Free a mps_thread_root_snapshot previously allocated
+ * with mps_thread_root_snapshot_new().
+ */
+void
+mps_thread_root_snapshot_free (mps_thread_root_snapshot * snapshot)
+{
+  free (snapshot->fvalues[0]);
+  free (snapshot->dvalues[0]);
+  free (snapshot->seq[0]);
 
-          /* Check if maximum number of iteration was reached and
-           * if that was the case set j->iter to MPS_THREAD_JOB_EXCEP.  */
-          if (j.iter == q->max_iter)
-            {
-              j.iter = MPS_THREAD_JOB_EXCEP;
-              q->iter = MPS_THREAD_JOB_EXCEP;
-            }
+  if (!snapshot->gauss_seidel)
+    {
+      free (snapshot->fvalues[1]);
+      free (snapshot->dvalues[1]);
+      free (snapshot->seq[1]);
+    }
+
+  free (snapshot);
+}
+
+/*
+ * The positions are read and written one double at a time with relaxed
+ * atomic operations, and the sequence counter of every position tells the
+ * readers if the double they have read belong to the same position. The
+ * complex numbers are accessed as arrays of two doubles.
+ */
+static inline double
+mps_thread_root_snapshot_load (double * src)
+{
+  double v;
+  __atomic_load (src, &v, __ATOMIC_RELAXED);
+  return v;
+}
+
+static inline void
+mps_thread_root_snapshot_store (double * dst, double v)
+{
+  __atomic_store (dst, &v, __ATOMIC_RELAXED);
+}
+
+static inline void
+mps_thread_root_snapshot_write_begin (unsigned int * seq)
+{
+  __atomic_store_n (seq, __atomic_load_n (seq, __ATOMIC_RELAXED) + 1, __ATOMIC_RELAXED);
+  __atomic_thread_fence (__ATOMIC_RELEASE);
+}
+
+static inline void
+mps_thread_root_snapshot_write_end (unsigned int * seq)
+{
+  __atomic_store_n (seq, __atomic_load_n (seq, __ATOMIC_RELAXED) + 1, __ATOMIC_RELEASE);
+}
+
+/**
+ * @brief Copy the floating point positions of the roots that the
+ * jobs of the iteration <code>iter</code> should use to compute the
+ * Aberth sums in <code>values</code>.
+ *
+ * Every position is copied while it is not being written, so it is one
+ * that has been published, but different positions may have been
+ * published in different sweeps.
+ *
+ * @return The array <code>values</code>.
+ */
+cplx_t *
+mps_thread_root_snapshot_fget (mps_thread_root_snapshot * snapshot, int iter, cplx_t * values)
+{
+  cplx_t * buffer = snapshot->fvalues[iter & 1];
+  unsigned int * seq = snapshot->seq[iter & 1];
+  unsigned int s1, s2;
+  double re, im;
+  int i;
+
+  for (i = 0; i < snapshot->n; i++)
+    {
+      do
+        {
+          s1 = __atomic_load_n (seq + i, __ATOMIC_ACQUIRE);
+          re = mps_thread_root_snapshot_load ((double *) buffer[i]);
+          im = mps_thread_root_snapshot_load ((double *) buffer[i] + 1);
+          __atomic_thread_fence (__ATOMIC_ACQUIRE);
+          s2 = __atomic_load_n (seq + i, __ATOMIC_RELAXED);
         }
+      while ((s1 & 1) || s1 != s2);
+
+      cplx_set_d (values[i], re, im);
+    }
+
+  return values;
+}
+
+/**
+ * @brief DPE version of mps_thread_root_snapshot_fget().
+ */
+cdpe_t *
+mps_thread_root_snapshot_dget (mps_thread_root_snapshot * snapshot, int iter, cdpe_t * values)
+{
+  cdpe_t * buffer = snapshot->dvalues[iter & 1];
+  unsigned int * seq = snapshot->seq[iter & 1];
+  unsigned int s1, s2;
+  int i;
+
+  for (i = 0; i < snapshot->n; i++)
+    {
+      do
+        {
+          s1 = __atomic_load_n (seq + i, __ATOMIC_ACQUIRE);
+          rdpe_Mnt (cdpe_Re (values[i])) = mps_thread_root_snapshot_load (&rdpe_Mnt (cdpe_Re (buffer[i])));
+          rdpe_Esp (cdpe_Re (values[i])) = __atomic_load_n (&rdpe_Esp (cdpe_Re (buffer[i])), __ATOMIC_RELAXED);
+          rdpe_Mnt (cdpe_Im (values[i])) = mps_thread_root_snapshot_load (&rdpe_Mnt (cdpe_Im (buffer[i])));
+          rdpe_Esp (cdpe_Im (values[i])) = __atomic_load_n (&rdpe_Esp (cdpe_Im (buffer[i])), __ATOMIC_RELAXED);
+          __atomic_thread_fence (__ATOMIC_ACQUIRE);
+          s2 = __atomic_load_n (seq + i, __ATOMIC_RELAXED);
+        }
+      while ((s1 & 1) || s1 != s2);
+    }
+
+  return values;
+}
+
+/**
+ * @brief Publish the position of the i-th root computed in the iteration
+ * <code>iter</code>.
+ *
+ * This must be called for every job handed out by the job queue, even if
+ * the root has not been moved, so that the next buffer is kept up to date.
+ * The caller must hold the <code>roots_mutex</code> of the i-th root, or
+ * of the root it is paired with if it is not iterated on its own.
+ */
+void
+mps_thread_root_snapshot_fpublish (mps_thread_root_snapshot * snapshot, int iter,
+                                   int i, cplx_t value)
+{
+  double * dst = (double *) snapshot->fvalues[(iter + 1) & 1][i];
+  unsigned int * seq = snapshot->seq[(iter + 1) & 1] + i;
+
+  mps_thread_root_snapshot_write_begin (seq);
+  mps_thread_root_snapshot_store (dst, cplx_Re (value));
+  mps_thread_root_snapshot_store (dst + 1, cplx_Im (value));
+  mps_thread_root_snapshot_write_end (seq);
+}
+
+/**
+ * @brief DPE version of mps_thread_root_snapshot_fpublish().
+ */
+void
+mps_thread_root_snapshot_dpublish (mps_thread_root_snapshot * snapshot, int iter,
+                                   int i, cdpe_t value)
+{
+  __cdpe_struct * dst = snapshot->dvalues[(iter + 1) & 1][i];
+  unsigned int * seq = snapshot->seq[(iter + 1) & 1] + i;
+
+  mps_thread_root_snapshot_write_begin (seq);
+  mps_thread_root_snapshot_store (&rdpe_Mnt (cdpe_Re (dst)), rdpe_Mnt (cdpe_Re (value)));
+  __atomic_store_n (&rdpe_Esp (cdpe_Re (dst)), rdpe_Esp (cdpe_Re (value)), __ATOMIC_RELAXED);
+  mps_thread_root_snapshot_store (&rdpe_Mnt (cdpe_Im (dst)), rdpe_Mnt (cdpe_Im (value)));
+  __atomic_store_n (&rdpe_Esp (cdpe_Im (dst)), rdpe_Esp (cdpe_Im (value)), __ATOMIC_RELAXED);
+  mps_thread_root_snapshot_write_end (seq);
+}
+
+/**
+ * @brief Key used to retrieve the mps_thread that is running the current
+ * code, if any. It is used to push the jobs submitted by a worker in its
+ * own queue.
+ */
+static pthread_key_t mps_thread_self_key;
+static pthread_once_t mps_thread_self_key_once = PTHREAD_ONCE_INIT;
+
+static void
+mps_thread_self_key_init (void)
+{
+  pthread_key_create (&mps_thread_self_key, NULL);
+}
+
+/**
+ * @brief Allocate a new empty mps_thread_pool_queue.
+ */
+static mps_thread_pool_queue *
+mps_thread_pool_queue_new (void)
+{
+  mps_thread_pool_queue * q = mps_new (mps_thread_pool_queue);
+
+  q->capacity = 64;
+  q->items = mps_newv (mps_thread_pool_queue_item, q->capacity);
+  q->front = 0;
+  q->size = 0;
+  pthread_mutex_init (&q->mutex, NULL);
+
+  return q;
+}
+
+static void
+mps_thread_pool_queue_free (mps_thread_pool_queue * q)
+{
+  pthread_mutex_destroy (&q->mutex);
+  free (q->items);
+  free (q);
+}
+
+/**
+ * @brief Push n jobs at the back of the queue. The queue is enlarged
+ * only if it cannot hold all of them.
+ *
+ * The job <code>i</code> is called with argument <code>args + i * size</code>.
+ */
+static void
+mps_thread_pool_queue_push (mps_thread_pool_queue * q, mps_thread_work work,
+                            char * args, size_t size, int n, volatile int * pending)
+{
+  int i;
+
+  pthread_mutex_lock (&q->mutex);
+
+  if (q->size + n > q->capacity)
+    {
+      int capacity = q->capacity;
+      mps_thread_pool_queue_item * items;
+
+      while (capacity < q->size + n)
+        capacity *= 2;
+
+      items = mps_newv (mps_thread_pool_queue_item, capacity);
+      for (i = 0; i < q->size; i++)
+        items[i] = q->items[(q->front + i) % q->capacity];
+
+      free (q->items);
+      q->items = items;
+      q->capacity = capacity;
+      q->front = 0;
+    }
+
+  for (i = 0; i < n; i++)
+    {
+      mps_thread_pool_queue_item * item = q->items + (q->front + q->size) % q->capacity;
+      item->work = work;
+      item->args = args + i * size;
+      item->pending = pending;
+      q->size++;
     }
 
   pthread_mutex_unlock (&q->mutex);
-  return j;
+}
+
+/**
+ * @brief Pop a job from the queue, from the back if <code>steal</code> is false
+ * (as done by the owner of the queue), or from the front otherwise.
+ *
+ * @return true if a job has been found and copied in item.
+ */
+static mps_boolean
+mps_thread_pool_queue_pop (mps_thread_pool_queue * q, mps_thread_pool_queue_item * item,
+                           mps_boolean steal)
+{
+  /* Avoid taking the lock on queues that are (likely) empty */
+  if (q->size == 0)
+    return false;
+
+  pthread_mutex_lock (&q->mutex);
+
+  if (q->size == 0)
+    {
+      pthread_mutex_unlock (&q->mutex);
+      return false;
+    }
+
+  if (steal)
+    {
+      *item = q->items[q->front];
+      q->front = (q->front + 1) % q->capacity;
+    }
+  else
+    *item = q->items[(q->front + q->size - 1) % q->capacity];
+
+  q->size--;
+
+  pthread_mutex_unlock (&q->mutex);
+
+  return true;
+}
+
+/**
+ * @brief Find the next job for thread, looking first in its own queue and
+ * then trying to steal it from the other threads of the pool.
+ */
+static mps_boolean
+mps_thread_pool_next_item (mps_thread_pool * pool, mps_thread * thread,
+                           mps_thread_pool_queue_item * item)
+{
+  int i, n;
+
+  if (pool->queued == 0)
+    return false;
+
+  /* Shared pools are consumed in FIFO order, to be fair with the contexts */
+  if (mps_thread_pool_queue_pop (thread->queue, item, pool->ref_count > 1))
+    goto found;
+
+  pthread_rwlock_rdlock (&pool->threads_lock);
+  n = pool->n;
+  for (i = 1; i <= n; i++)
+    {
+      mps_thread * victim = pool->threads[(thread->index + i) % n];
+      if (mps_thread_pool_queue_pop (victim->queue, item, true))
+        {
+          pthread_rwlock_unlock (&pool->threads_lock);
+          goto found;
+        }
+    }
+  pthread_rwlock_unlock (&pool->threads_lock);
+
+  return false;
+
+found:
+  __sync_sub_and_fetch (&pool->queued, 1);
+  return true;
+}
+
+/**
+ * @brief Wake up to n parked threads, if there are any.
+ */
+static void
+mps_thread_pool_wake (mps_thread_pool * pool, int n)
+{
+  if (pool->sleeping == 0)
+    return;
+
+  pthread_mutex_lock (&pool->park_mutex);
+  if (n == 1)
+    pthread_cond_signal (&pool->park_cond);
+  else
+    pthread_cond_broadcast (&pool->park_cond);
+  pthread_mutex_unlock (&pool->park_mutex);
+}
+
+/**
+ * @brief Counter of the pending jobs that s has submitted to pool.
+ *
+ * The jobs that a context submits to its own pool are counted separately,
+ * so that waiting for them is not affected by the other contexts that
+ * may share the pool. All the other jobs are only counted by the pool.
+ */
+static volatile int *
+mps_thread_pool_pending_counter (mps_context * s, mps_thread_pool * pool)
+{
+  if (s && pool == s->pool)
+    return &s->pool_pending;
+  else
+    return &pool->pending;
+}
+
+/**
+ * @brief Wait until the counter of pending jobs of the pool drops to zero.
+ */
+static void
+mps_thread_pool_wait_counter (mps_thread_pool * pool, volatile int * pending)
+{
+  pthread_mutex_lock (&pool->work_completed_mutex);
+
+  while (*pending != 0)
+    pthread_cond_wait (&pool->work_completed_cond, &pool->work_completed_mutex);
+
+  pthread_mutex_unlock (&pool->work_completed_mutex);
 }
 
 MPS_PRIVATE void *
@@ -190,54 +608,56 @@ mps_thread_mainloop (void * thread_ptr)
 {
   mps_thread * thread = (mps_thread*)thread_ptr;
   mps_thread_pool * pool = thread->pool;
+  mps_thread_pool_queue_item item;
+  int spin = 0;
+
+  pthread_once (&mps_thread_self_key_once, mps_thread_self_key_init);
+  pthread_setspecific (mps_thread_self_key, thread);
 
   while (thread->alive)
     {
-      /* Try to pop a work item from the queue, if available. */
-      pthread_mutex_lock (&pool->work_completed_mutex);
-      pthread_mutex_lock (&pool->queue_changed_mutex);
-
-      if (pool->queue->first != NULL)
+      if (mps_thread_pool_next_item (pool, thread, &item))
         {
-          mps_thread_pool_queue_item * item = pool->queue->first;
-
-          if (!thread->busy)
-            {
-              pool->busy_counter++;
-              thread->busy = true;
-            }
+          mps_boolean completed = false;
 
-          /* Pop item from the queue and release the lock on it */
-          pool->queue->first = item->next;
-          if (item->next == NULL)
-            pool->queue->last = item;
+          item.work (item.args);
 
-          pthread_mutex_unlock (&pool->queue_changed_mutex);
-          pthread_mutex_unlock (&pool->work_completed_mutex);
+          /* Notify the threads waiting in mps_thread_pool_wait() if this
+           * was the last job of the pool or of its submitter. */
+          if (item.pending != &pool->pending && __sync_sub_and_fetch (item.pending, 1) == 0)
+            completed = true;
+          if (__sync_sub_and_fetch (&pool->pending, 1) == 0)
+            completed = true;
 
-          item->work (item->args);
-          free (item);
-        }
-      else
-        {
-          /* Check if other threads are sleeping */
-          if (thread->busy)
+          if (completed)
             {
-              pool->busy_counter--;
-              thread->busy = false;
+              pthread_mutex_lock (&pool->work_completed_mutex);
+              pthread_cond_broadcast (&pool->work_completed_cond);
+              pthread_mutex_unlock (&pool->work_completed_mutex);
             }
-          pthread_cond_signal (&pool->work_completed_cond);
-          pthread_mutex_unlock (&pool->work_completed_mutex);
 
-          if (!thread->alive)
-            {
-              pthread_mutex_unlock (&pool->queue_changed_mutex);
-              pthread_exit (NULL);
-            }
+          spin = 0;
+          continue;
+        }
 
-          pthread_cond_wait (&pool->queue_changed, &pool->queue_changed_mutex);
-          pthread_mutex_unlock (&pool->queue_changed_mutex);
+      /* Spin for a while before parking, since in the iteration packets
+       * new jobs usually arrive shortly. */
+      if (spin++ < MPS_THREAD_SPIN_COUNT)
+        {
+          sched_yield ();
+          continue;
         }
+
+      /* The sleeping counter is increased before checking for new jobs,
+       * so the submitters either see us sleeping or we see their jobs. */
+      pthread_mutex_lock (&pool->park_mutex);
+      __sync_add_and_fetch (&pool->sleeping, 1);
+      while (pool->queued == 0 && thread->alive)
+        pthread_cond_wait (&pool->park_cond, &pool->park_mutex);
+      __sync_sub_and_fetch (&pool->sleeping, 1);
+      pthread_mutex_unlock (&pool->park_mutex);
+
+      spin = 0;
     }
 
   pthread_exit (NULL);
@@ -253,6 +673,213 @@ mps_thread_start_mainloop (mps_context * s, mps_thread * thread)
   pthread_create (thread->thread, NULL, &mps_thread_mainloop, thread);
 }
 
+#ifdef HAVE_PTHREAD_SETAFFINITY_NP
+
+/*! @cond PRIVATE */
+struct mps_thread_topology {
+  /* Online CPUs of the system, sorted by NUMA node */
+  int n_cpus;
+  int * cpus;
+
+  /* The CPUs of node k are cpus[node_start[k]] ... cpus[node_start[k + 1] - 1] */
+  int n_nodes;
+  int * node_start;
+};
+/*! @endcond */
+
+static struct mps_thread_topology mps_thread_topology;
+static pthread_once_t mps_thread_topology_once = PTHREAD_ONCE_INIT;
+
+/**
+ * @brief Parse a list of CPUs in the format used by the kernel (e.g. "0-3,8-11")
+ * appending them to <code>mps_thread_topology.cpus</code>.
+ */
+static void
+mps_thread_topology_parse_cpulist (FILE * f)
+{
+  int first, last, k;
+  char sep;
+
+  while (fscanf (f, "%d", &first) == 1)
+    {
+      last = first;
+      sep = fgetc (f);
+
+      if (sep == '-')
+        {
+          if (fscanf (f, "%d", &last) != 1)
+            break;
+          sep = fgetc (f);
+        }
+
+      for (k = first; k <= last && k < CPU_SETSIZE; k++)
+        {
+          mps_thread_topology.cpus = mps_realloc (mps_thread_topology.cpus,
+                                                  sizeof(int) * (mps_thread_topology.n_cpus + 1));
+          mps_thread_topology.cpus[mps_thread_topology.n_cpus++] = k;
+        }
+
+      if (sep != ',')
+        break;
+    }
+}
+
+/**
+ * @brief Read the NUMA nodes and their CPUs from sysfs. If the information
+ * is not available all the CPUs are assumed to belong to a single node.
+ */
+static void
+mps_thread_topology_init (void)
+{
+  char path[64];
+  int node, missing = 0;
+  FILE * f;
+
+  mps_thread_topology.n_cpus = 0;
+  mps_thread_topology.cpus = NULL;
+  mps_thread_topology.n_nodes = 0;
+  mps_thread_topology.node_start = mps_newv (int, 1);
+  mps_thread_topology.node_start[0] = 0;
+
+  /* Node numbers may not be contiguous, so give up only after a
+   * few missing ones. */
+  for (node = 0; missing < 64; node++)
+    {
+      sprintf (path, "/sys/devices/system/node/node%d/cpulist", node);
+
+      if ((f = fopen (path, "r")) == NULL)
+        {
+          missing++;
+          continue;
+        }
+
+      mps_thread_topology_parse_cpulist (f);
+      fclose (f);
+
+      mps_thread_topology.n_nodes++;
+      mps_thread_topology.node_start = mps_realloc (mps_thread_topology.node_start,
+                                                    sizeof(int) * (mps_thread_topology.n_nodes + 1));
+      mps_thread_topology.node_start[mps_thread_topology.n_nodes] = mps_thread_topology.n_cpus;
+    }
+
+  if (mps_thread_topology.n_cpus == 0)
+    {
+      int k, cores = 1;
+
+#ifdef HAVE_SYSCONF
+      cores = MAX (1, MIN (CPU_SETSIZE, sysconf (_SC_NPROCESSORS_ONLN)));
+#endif
+
+      mps_thread_topology.cpus = mps_newv (int, cores);
+      for (k = 0; k < cores; k++)
+        mps_thread_topology.cpus[k] = k;
+
+      mps_thread_topology.n_cpus = cores;
+      mps_thread_topology.n_nodes = 1;
+      mps_thread_topology.node_start = mps_realloc (mps_thread_topology.node_start, sizeof(int) * 2);
+      mps_thread_topology.node_start[1] = cores;
+    }
+}
+#endif
+
+/**
+ * @brief Bind the thread to the CPUs selected by the affinity of its pool,
+ * according to its index.
+ */
+static void
+mps_thread_apply_affinity (mps_thread_pool * pool, mps_thread * thread)
+{
+#ifdef HAVE_PTHREAD_SETAFFINITY_NP
+  cpu_set_t set;
+  int k, node;
+
+  CPU_ZERO (&set);
+
+  switch (pool->affinity)
+    {
+    case MPS_THREAD_AFFINITY_CORE:
+      CPU_SET (mps_thread_topology.cpus[thread->index % mps_thread_topology.n_cpus], &set);
+      break;
+
+    case MPS_THREAD_AFFINITY_NODE:
+      node = thread->index % mps_thread_topology.n_nodes;
+      for (k = mps_thread_topology.node_start[node]; k < mps_thread_topology.node_start[node + 1]; k++)
+        CPU_SET (mps_thread_topology.cpus[k], &set);
+      break;
+
+    default:
+      for (k = 0; k < mps_thread_topology.n_cpus; k++)
+        CPU_SET (mps_thread_topology.cpus[k], &set);
+      break;
+    }
+
+  pthread_setaffinity_np (*thread->thread, sizeof(cpu_set_t), &set);
+#endif
+}
+
+/**
+ * @brief Select how the threads of the pool are placed on the CPUs of the
+ * system.
+ *
+ * The threads are bound immediately, and the ones that are added later
+ * to the pool are bound as soon as they are created. If the system does
+ * not support setting the affinity of the threads this function does nothing.
+ */
+void
+mps_thread_pool_set_affinity (mps_context * s, mps_thread_pool * pool,
+                              mps_thread_affinity affinity)
+{
+  unsigned int i;
+
+  if (!pool)
+    pool = s->pool;
+
+#ifdef HAVE_PTHREAD_SETAFFINITY_NP
+  pthread_once (&mps_thread_topology_once, mps_thread_topology_init);
+
+  MPS_DEBUG_WITH_INFO (s, "Placing threads on %d CPUs in %d NUMA nodes",
+                       mps_thread_topology.n_cpus, mps_thread_topology.n_nodes);
+#else
+  if (affinity != MPS_THREAD_AFFINITY_NONE)
+    MPS_DEBUG_WITH_INFO (s, "Setting the thread affinity is not supported on this system");
+#endif
+
+  pthread_rwlock_wrlock (&pool->threads_lock);
+
+  if (pool->affinity != affinity)
+    {
+      pool->affinity = affinity;
+      for (i = 0; i < pool->n; i++)
+        mps_thread_apply_affinity (pool, pool->threads[i]);
+    }
+
+  pthread_rwlock_unlock (&pool->threads_lock);
+}
+
+/**
+ * @brief Rebuild the threads array of the pool starting from the
+ * linked list of its threads. Must be called with the threads_lock
+ * held for writing.
+ */
+static void
+mps_thread_pool_update_threads (mps_thread_pool * pool)
+{
+  mps_thread * thread;
+  int i = 0;
+
+  pool->threads = mps_realloc (pool->threads, sizeof(mps_thread*) * MAX (1, pool->n));
+
+  for (thread = pool->first; thread != NULL; thread = thread->next)
+    {
+      thread->index = i;
+      pool->threads[i++] = thread;
+
+      /* The placement depends on the index, that may have changed */
+      if (pool->affinity != MPS_THREAD_AFFINITY_NONE)
+        mps_thread_apply_affinity (pool, thread);
+    }
+}
+
 /**
  * @brief Limit the maximum number of threads that can be used in the thread pool.
  */
@@ -271,11 +898,20 @@ void mps_thread_pool_set_concurrency_limit (mps_context * s, mps_thread_pool * p
       mps_thread * thread;
       int i = 0;
 
+      /* Make sure that the queues of the threads that will be removed
+       * are empty. */
+      mps_thread_pool_wait_counter (pool, &pool->pending);
+
+      pthread_rwlock_wrlock (&pool->threads_lock);
+
       for (thread = pool->first; i < (pool->concurrency_limit - concurrency_limit); thread = thread->next, i++)
         ;
 
       pool->first = thread;
       pool->n = concurrency_limit;
+      mps_thread_pool_update_threads (pool);
+
+      pthread_rwlock_unlock (&pool->threads_lock);
 
       i = 0;
       for (thread = old_first; i < (pool->concurrency_limit - concurrency_limit); i++)
@@ -289,69 +925,240 @@ void mps_thread_pool_set_concurrency_limit (mps_context * s, mps_thread_pool * p
     {
       int i = 0;
       for (i = 0; i < concurrency_limit - pool->concurrency_limit; i++)
-        mps_thread_pool_insert_new_thread (s, s->pool);
+        mps_thread_pool_insert_new_thread (s, pool);
     }
 
   pool->concurrency_limit = concurrency_limit;
 }
 
+/**
+ * @brief Submit n jobs to the pool. The i-th job calls work with
+ * argument <code>args + i * size</code>.
+ *
+ * If this is called from a thread of the pool the jobs are pushed in its
+ * own queue, and the other threads will steal them. Otherwise they are
+ * split among the queues of all the threads. In both cases each queue is
+ * locked only once, and no allocation is performed for the single jobs.
+ */
 void
-mps_thread_pool_assign (mps_context * s, mps_thread_pool * pool,
-                        mps_thread_work work, void * args)
+mps_thread_pool_assign_bulk (mps_context * s, mps_thread_pool * pool, mps_thread_work work,
+                             void * args, size_t size, int n)
 {
+  mps_thread * self;
+  char * base = (char*)args;
+  volatile int * pending;
+  int i;
+
   if (!pool)
     pool = s->pool;
 
+  if (n <= 0)
+    return;
+
   if (pool->n == 1 && !pool->strict_async)
     {
-      (*work)(args);
+      for (i = 0; i < n; i++)
+        (*work)(base + i * size);
       return;
     }
 
-  /* Insert the job in the queue */
-  pthread_mutex_lock (&pool->queue_changed_mutex);
+  pending = mps_thread_pool_pending_counter (s, pool);
 
-  mps_thread_pool_queue_item * item = mps_new (mps_thread_pool_queue_item);
+  if (pending != &pool->pending)
+    __sync_add_and_fetch (pending, n);
+  __sync_add_and_fetch (&pool->pending, n);
 
-  item->work = work;
-  item->args = args;
+  self = (mps_thread*)pthread_getspecific (mps_thread_self_key);
 
-  if (pool->queue->first == NULL)
-    {
-      pool->queue->first = pool->queue->last = item;
-      item->next = NULL;
-    }
+  if (self && self->pool == pool)
+    mps_thread_pool_queue_push (self->queue, work, base, size, n, pending);
   else
     {
-      pool->queue->last->next = item;
-      pool->queue->last = item;
-      item->next = NULL;
+      int n_queues, chunk, start = 0;
+
+      pthread_rwlock_rdlock (&pool->threads_lock);
+
+      n_queues = MIN (pool->n, n);
+      chunk = (n + n_queues - 1) / n_queues;
+
+      for (i = 0; i < n_queues && start < n; i++)
+        {
+          unsigned int next = __sync_fetch_and_add (&pool->next_queue, 1);
+          int len = MIN (chunk, n - start);
+
+          mps_thread_pool_queue_push (pool->threads[next % pool->n]->queue, work,
+                                      base + start * size, size, len, pending);
+          start += len;
+        }
+
+      pthread_rwlock_unlock (&pool->threads_lock);
     }
 
-  pthread_cond_signal (&pool->queue_changed);
-  pthread_mutex_unlock (&pool->queue_changed_mutex);
+  __sync_add_and_fetch (&pool->queued, n);
+  mps_thread_pool_wake (pool, n);
+}
+
+void
+mps_thread_pool_assign (mps_context * s, mps_thread_pool * pool,
+                        mps_thread_work work, void * args)
+{
+  mps_thread_pool_assign_bulk (s, pool, work, args, 0, 1);
+}
+
+/*! @cond PRIVATE */
+struct mps_thread_parallel_for_data {
+  mps_context * s;
+  mps_thread_range_work work;
+  void * user;
+  int end;
+  int grain;
+
+  /* First index not yet assigned, used for dynamic chunking */
+  volatile int cursor;
+
+  /* Number of jobs not yet completed, protected by mutex */
+  int remaining;
+  pthread_mutex_t mutex;
+  pthread_cond_t done;
+};
+
+struct mps_thread_parallel_for_chunk {
+  struct mps_thread_parallel_for_data * data;
+  int begin;
+  int end;
+};
+/*! @endcond */
+
+static void
+mps_thread_parallel_for_complete (struct mps_thread_parallel_for_data * data)
+{
+  pthread_mutex_lock (&data->mutex);
+  if (--data->remaining == 0)
+    pthread_cond_signal (&data->done);
+  pthread_mutex_unlock (&data->mutex);
+}
+
+static void *
+mps_thread_parallel_for_static_worker (void * chunk_ptr)
+{
+  struct mps_thread_parallel_for_chunk * chunk = (struct mps_thread_parallel_for_chunk*)chunk_ptr;
+  struct mps_thread_parallel_for_data * data = chunk->data;
+
+  (*data->work)(data->s, chunk->begin, chunk->end, data->user);
+
+  mps_thread_parallel_for_complete (data);
+  return NULL;
+}
+
+static void *
+mps_thread_parallel_for_dynamic_worker (void * data_ptr)
+{
+  struct mps_thread_parallel_for_data * data = (struct mps_thread_parallel_for_data*)data_ptr;
+  int begin;
+
+  while ((begin = __sync_fetch_and_add (&data->cursor, data->grain)) < data->end)
+    (*data->work)(data->s, begin, MIN (begin + data->grain, data->end), data->user);
+
+  mps_thread_parallel_for_complete (data);
+  return NULL;
 }
 
 /**
- * @brief Wait for a thread pool to complete its jobs.
+ * @brief Run <code>work</code> on the indices in <code>[begin, end)</code>
+ * using the threads of the pool, and wait for it to complete.
+ *
+ * The range is split in chunks and <code>work</code> is called once for
+ * each of them, so that per-index data does not need to be allocated.
+ *
+ * @param s The current mps_context.
+ * @param pool The pool that should run the loop, or NULL for the pool of s.
+ * @param begin The first index of the loop.
+ * @param end The index following the last one of the loop.
+ * @param grain If it is 0 the range is split statically in one contiguous
+ * chunk per thread. Otherwise the threads pick chunks of <code>grain</code>
+ * indices dynamically from a shared cursor, which balances the load when
+ * the cost of the iterations is not uniform.
+ * @param work The routine that processes a chunk.
+ * @param user Pointer passed unchanged to <code>work</code>.
+ *
+ * This function must not be called from a job running in the same pool.
  */
 void
-mps_thread_pool_wait (mps_context * s, mps_thread_pool * pool)
+mps_thread_pool_parallel_for (mps_context * s, mps_thread_pool * pool, int begin, int end,
+                              int grain, mps_thread_range_work work, void * user)
 {
-  pthread_mutex_lock (&pool->work_completed_mutex);
+  struct mps_thread_parallel_for_data data;
+  struct mps_thread_parallel_for_chunk * chunks = NULL;
+  int i, n_jobs, length = end - begin;
+
+  if (!pool)
+    pool = s->pool;
 
-  while (true)
+  if (length <= 0)
+    return;
+
+  if ((pool->n == 1 && !pool->strict_async) || (grain > 0 && grain >= length))
     {
-      if (pool->busy_counter == 0 && pool->queue->first == NULL)
-        {
-          pthread_mutex_unlock (&pool->work_completed_mutex);
-          return;
-        }
-      else
+      (*work)(s, begin, end, user);
+      return;
+    }
+
+  data.s = s;
+  data.work = work;
+  data.user = user;
+  data.end = end;
+  data.grain = grain;
+  data.cursor = begin;
+  pthread_mutex_init (&data.mutex, NULL);
+  pthread_cond_init (&data.done, NULL);
+
+  if (grain > 0)
+    {
+      n_jobs = MIN ((int) pool->n, (length + grain - 1) / grain);
+      data.remaining = n_jobs;
+
+      /* All the jobs share the same data, and pick their chunks from the cursor */
+      mps_thread_pool_assign_bulk (s, pool, mps_thread_parallel_for_dynamic_worker,
+                                   &data, 0, n_jobs);
+    }
+  else
+    {
+      n_jobs = MIN ((int) pool->n, length);
+      data.remaining = n_jobs;
+
+      chunks = mps_newv (struct mps_thread_parallel_for_chunk, n_jobs);
+      for (i = 0; i < n_jobs; i++)
         {
-          pthread_cond_wait (&pool->work_completed_cond, &pool->work_completed_mutex);
+          chunks[i].data = &data;
+          chunks[i].begin = begin + (int)(((long) length * i) / n_jobs);
+          chunks[i].end = begin + (int)(((long) length * (i + 1)) / n_jobs);
         }
+
+      mps_thread_pool_assign_bulk (s, pool, mps_thread_parallel_for_static_worker,
+                                   chunks, sizeof(struct mps_thread_parallel_for_chunk), n_jobs);
     }
+
+  pthread_mutex_lock (&data.mutex);
+  while (data.remaining > 0)
+    pthread_cond_wait (&data.done, &data.mutex);
+  pthread_mutex_unlock (&data.mutex);
+
+  pthread_mutex_destroy (&data.mutex);
+  pthread_cond_destroy (&data.done);
+  free (chunks);
+}
+
+/**
+ * @brief Wait for a thread pool to complete the jobs submitted
+ * by the context s.
+ *
+ * If pool is the pool of s, only the jobs submitted by s are waited
+ * for, even if the pool is shared with other contexts.
+ */
+void
+mps_thread_pool_wait (mps_context * s, mps_thread_pool * pool)
+{
+  mps_thread_pool_wait_counter (pool, mps_thread_pool_pending_counter (s, pool));
 }
 
 /**
@@ -366,14 +1173,14 @@ mps_thread_new (mps_context * s, mps_thread_pool * pool)
 
   /* Set the initial values in the thread */
   thread->data = NULL;
-  pthread_mutex_init (&thread->busy_mutex, NULL);
-  pthread_cond_init (&thread->start_condition, NULL);
   thread->thread = mps_new (pthread_t);
+  thread->queue = mps_thread_pool_queue_new ();
+  thread->index = 0;
+  thread->next = NULL;
   thread->work = NULL;
   thread->args = NULL;
   thread->alive = true;
   thread->pool = pool;
-  thread->busy = false;
 
   /* Start the thread mainloop */
   mps_thread_start_mainloop (s, thread);
@@ -383,22 +1190,25 @@ mps_thread_new (mps_context * s, mps_thread_pool * pool)
 
 /**
  * @brief Free a thread asking it to stop.
+ *
+ * The thread must have already been removed from its pool, and its
+ * queue must be empty.
  */
 void
 mps_thread_free (mps_context * s, mps_thread * thread)
 {
-  /* Wait for the thread to finish its work, if it is doing something */
-  /* pthread_mutex_lock (&thread->busy_mutex); */
-  /* pthread_mutex_unlock (&thread->busy_mutex); */
-  pthread_mutex_lock (&thread->pool->queue_changed_mutex);
+  mps_thread_pool * pool = thread->pool;
+
+  pthread_mutex_lock (&pool->park_mutex);
   thread->alive = false;
 
-  /* Start the thread, if it is not running */
-  pthread_cond_broadcast (&thread->pool->queue_changed);
-  pthread_mutex_unlock (&thread->pool->queue_changed_mutex);
+  /* Wake the thread, if it is parked */
+  pthread_cond_broadcast (&pool->park_cond);
+  pthread_mutex_unlock (&pool->park_mutex);
 
   pthread_join (*thread->thread, NULL);
 
+  mps_thread_pool_queue_free (thread->queue);
   free (thread->thread);
   free (thread);
 }
@@ -414,14 +1224,22 @@ mps_thread_pool_insert_new_thread (mps_context * s, mps_thread_pool * pool)
 
   mps_thread * thread = mps_thread_new (s, pool);
 
+  pthread_rwlock_wrlock (&pool->threads_lock);
+
   thread->next = pool->first;
   pool->first = thread;
   pool->n++;
+  mps_thread_pool_update_threads (pool);
+
+  pthread_rwlock_unlock (&pool->threads_lock);
 }
 
 /**
  * @brief Obtain a pointer to the default shared thread pool on
  * this system. 
+ *
+ * The pool keeps a reference to itself for the whole life of the
+ * process, so it is never freed by mps_thread_pool_unref().
  */
 mps_thread_pool * 
 mps_thread_pool_get_system_pool (mps_context * s)
@@ -458,34 +1276,40 @@ mps_thread_pool *
 mps_thread_pool_new (mps_context * s, int n_threads)
 {
   mps_thread_pool * pool = mps_new (mps_thread_pool);
-  int threads = mps_thread_get_core_number (s);
+  int threads = n_threads;
   int i;
 
-  if (n_threads != 0)
-    threads = n_threads;
+  if (threads == 0)
+    threads = mps_thread_get_core_number (s);
+
+  pthread_once (&mps_thread_self_key_once, mps_thread_self_key_init);
 
   pool->n = 0;
   pool->first = NULL;
+  pool->threads = NULL;
+
+  pthread_rwlock_init (&pool->threads_lock, NULL);
 
-  pool->queue = mps_new (mps_thread_pool_queue);
-  pool->queue->first = pool->queue->last = NULL;
+  pool->queued = 0;
+  pool->pending = 0;
+  pool->ref_count = 1;
+  pool->sleeping = 0;
+  pool->next_queue = 0;
 
-  pthread_mutex_init (&pool->queue_changed_mutex, NULL);
-  pthread_cond_init (&pool->queue_changed, NULL);
+  pthread_mutex_init (&pool->park_mutex, NULL);
+  pthread_cond_init (&pool->park_cond, NULL);
 
   pthread_mutex_init (&pool->work_completed_mutex, NULL);
   pthread_cond_init (&pool->work_completed_cond, NULL);
 
-  pool->busy_counter = 0;
   pool->strict_async = false;
+  pool->affinity = MPS_THREAD_AFFINITY_NONE;
 
   for (i = 0; i < threads; i++)
     mps_thread_pool_insert_new_thread (s, pool);
 
   pool->concurrency_limit = threads;
 
-  mps_thread_pool_wait (s, pool);
-
   return pool;
 }
 
@@ -502,7 +1326,7 @@ mps_thread_pool_free (mps_context * s, mps_thread_pool * pool)
   mps_thread * thread = pool->first;
   mps_thread * next_thread;
 
-  mps_thread_pool_wait (s, pool);
+  mps_thread_pool_wait_counter (pool, &pool->pending);
 
   while (thread)
     {
@@ -511,20 +1335,56 @@ mps_thread_pool_free (mps_context * s, mps_thread_pool * pool)
       thread = next_thread;
     }
 
-  free (pool->queue);
+  pthread_rwlock_destroy (&pool->threads_lock);
+  pthread_mutex_destroy (&pool->park_mutex);
+  pthread_cond_destroy (&pool->park_cond);
+  pthread_mutex_destroy (&pool->work_completed_mutex);
+  pthread_cond_destroy (&pool->work_completed_cond);
+
+  free (pool->threads);
   free (pool);
 }
 
+/**
+ * @brief Obtain a new reference to the pool.
+ */
+mps_thread_pool *
+mps_thread_pool_ref (mps_thread_pool * pool)
+{
+  __sync_add_and_fetch (&pool->ref_count, 1);
+  return pool;
+}
+
+/**
+ * @brief Drop a reference to the pool, freeing it if it was the last one.
+ */
+void
+mps_thread_pool_unref (mps_context * s, mps_thread_pool * pool)
+{
+  if (__sync_sub_and_fetch (&pool->ref_count, 1) == 0)
+    mps_thread_pool_free (s, pool);
+}
+
+/**
+ * @brief Check if the pool is used by more than one owner, in which
+ * case it should not be resized.
+ */
+mps_boolean
+mps_thread_pool_is_shared (mps_thread_pool * pool)
+{
+  return pool->ref_count > 1;
+}
+
 int mps_thread_get_id (mps_context * s, mps_thread_pool * pool)
 {
-  pthread_t self = pthread_self ();
+  mps_thread * self = (mps_thread*)pthread_getspecific (mps_thread_self_key);
   int i = 0;
 
   mps_thread * thread = pool->first;
 
   while (thread)
     {
-      if (pthread_equal (*thread->thread, self))
+      if (thread == self)
         {
           return i;
         }
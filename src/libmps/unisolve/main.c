@@ -114,6 +114,11 @@ mps_standard_mpsolve (mps_context * s)
       if (computed && s->output_config->goal != MPS_OUTPUT_GOAL_APPROXIMATE)
         goto exit_sub;
       /* stop for COUNT and ISOLATE goals */
+
+      /* The approximations that are not representable as floating point
+       * numbers need the DPE phase, even when the time is over. */
+      if (!d_after_f && mps_budget_time_over (s))
+        goto exit_sub;
     }
 
   /* == 5 ==  DPE phase */
@@ -138,6 +143,9 @@ mps_standard_mpsolve (mps_context * s)
       computed = mps_check_stop (s);
       if (computed && s->output_config->goal != MPS_OUTPUT_GOAL_APPROXIMATE)
         goto exit_sub;
+
+      if (mps_budget_time_over (s))
+        goto exit_sub;
     }
 
   /* == 6 ==   Allocate MP variables mfpc, mroot, drad, mfppc, mfppc1
@@ -169,6 +177,10 @@ mps_standard_mpsolve (mps_context * s)
       goto exit_sub;
     }
 
+  /* Prepare the coefficients for the double-double iterations of the MP phase */
+  if (MPS_IS_MONOMIAL_POLY (s->active_poly))
+    mps_monomial_poly_update_dd_coefficients (s, MPS_MONOMIAL_POLY (s->active_poly));
+
   MPS_DEBUG (s, "s->mpwp = %ld, s->mpwp_max = %ld", s->mpwp, s->mpwp_max);
   MPS_DEBUG (s, "s->input_config->prec = %ld", s->active_poly->prec);
 
@@ -185,6 +197,10 @@ mps_standard_mpsolve (mps_context * s)
 
   while (!computed && s->mpwp < s->mpwp_max)
     {
+      /* Keep the current approximations if the budget is over */
+      if (mps_budget_time_over (s) || !mps_budget_allows_precision (s, 2 * s->mpwp))
+        break;
+
       s->mpwp *= 2;
 
       if (s->mpwp > s->mpwp_max)
@@ -234,7 +250,12 @@ mps_standard_mpsolve (mps_context * s)
   /* == 8 ==  Check for termination */
   if (!computed)
     {
-      if (s->over_max)
+      if (s->budget_exhausted)
+        {
+          MPS_DEBUG (s, "Returning the current approximations since the budget is exhausted");
+          goto exit_sub;
+        }
+      else if (s->over_max)
         {
           s->over_max = true;
           /* mps_error (s, "Reached the maximum working precision"); */
@@ -259,8 +280,9 @@ exit_sub:
         return;
       }
 
-  /* == 10 ==  Refine roots */
-  if (computed && !s->over_max && s->output_config->goal == MPS_OUTPUT_GOAL_APPROXIMATE)
+  /* == 10 ==  Refine roots, if there is time left */
+  if (computed && !s->over_max && !mps_budget_time_over (s) &&
+      s->output_config->goal == MPS_OUTPUT_GOAL_APPROXIMATE)
     {
       s->lastphase = mp_phase;
       mps_improve (s);
@@ -282,6 +304,8 @@ exit_sub:
   {
     unsigned long time = mps_stop_timer (my_timer);
     MPS_DEBUG (s, "Total time using MPSolve: %lu ms", time);
+    MPS_DEBUG (s, "Memory high-water of the coefficients: %ld KiB",
+               mps_context_get_memory_high_water (s) / 1024);
   }
 #endif
 
@@ -289,6 +313,50 @@ exit_sub:
   mps_copy_roots (s);
 }
 
+/*
+ * Check if the DPE number e is exactly equal to the rational q.
+ */
+static mps_boolean
+mps_rdpe_eq_q (rdpe_t e, mpq_t q)
+{
+  mpq_t t;
+  mps_boolean eq;
+
+  mpq_init (t);
+  mpq_set_d (t, rdpe_Mnt (e));
+  if (rdpe_Esp (e) >= 0)
+    mpq_mul_2exp (t, t, rdpe_Esp (e));
+  else
+    mpq_div_2exp (t, t, -rdpe_Esp (e));
+
+  eq = mpq_equal (t, q);
+  mpq_clear (t);
+
+  return eq;
+}
+
+/*
+ * Check if the DPE number e is exactly equal to the floating point number f.
+ */
+static mps_boolean
+mps_rdpe_eq_f (rdpe_t e, mpf_t f)
+{
+  mpf_t t;
+  mps_boolean eq;
+
+  mpf_init2 (t, DBL_MANT_DIG);
+  mpf_set_d (t, rdpe_Mnt (e));
+  if (rdpe_Esp (e) >= 0)
+    mpf_mul_2exp (t, t, rdpe_Esp (e));
+  else
+    mpf_div_2exp (t, t, -rdpe_Esp (e));
+
+  eq = (mpf_cmp (t, f) == 0);
+  mpf_clear (t);
+
+  return eq;
+}
+
 /**
  * @brief Setup vectors and variables
  */
@@ -319,10 +387,8 @@ mps_setup (mps_context * s)
       for (i = 0; i <= p->degree; i++)
         {
           mp->fap[i] = 0.0;
-          mp->fpr[i] = 0.0;
           rdpe_set (mp->dap[i], rdpe_zero);
           cplx_set (mp->fpc[i], cplx_zero);
-          rdpe_set (mp->dpr[i], rdpe_zero);
           cdpe_set (mp->dpc[i], cdpe_zero);
         }
     }
@@ -350,6 +416,7 @@ mps_setup (mps_context * s)
   if (MPS_IS_MONOMIAL_POLY (p))
     {
       mps_monomial_poly *mp = MPS_MONOMIAL_POLY (p);
+      rdpe_t dpr;
 
       /* init temporary mp variables */
       mpf_init2 (mptemp, DBL_MANT_DIG);
@@ -357,6 +424,7 @@ mps_setup (mps_context * s)
 
       /* main loop */
       s->skip_float = false;
+      mp->dpc_exact = true;
       for (i = 0; i <= s->n; i++)
         {
           if (MPS_DENSITY_IS_SPARSE (s->active_poly->density) && !mp->spar[i])
@@ -368,21 +436,26 @@ mps_setup (mps_context * s)
                   MPS_STRUCTURE_IS_INTEGER (s->active_poly->structure))
                 {
                   mpf_set_q (mptemp, mp->initial_mqp_r[i]);
-                  mpf_get_rdpe (mp->dpr[i], mptemp);
+                  mpf_get_rdpe (dpr, mptemp);
                   /*#G GMP 2.0.2 bug begin */
-                  if (rdpe_sgn (mp->dpr[i]) != mpq_sgn (mp->initial_mqp_r[i]))
-                    rdpe_neg_eq (mp->dpr[i]);
+                  if (rdpe_sgn (dpr) != mpq_sgn (mp->initial_mqp_r[i]))
+                    rdpe_neg_eq (dpr);
                   /*#G GMP bug end */
                 }
 
               if (MPS_STRUCTURE_IS_FP (s->active_poly->structure))
-                mpf_get_rdpe (mp->dpr[i], mpc_Re (mp->mfpc[i]));
+                mpf_get_rdpe (dpr, mpc_Re (mp->mfpc[i]));
+
+              if (mp->dpc_exact)
+                mp->dpc_exact = MPS_STRUCTURE_IS_FP (s->active_poly->structure) ?
+                                mps_rdpe_eq_f (dpr, mpc_Re (mp->mfpc[i])) :
+                                mps_rdpe_eq_q (dpr, mp->initial_mqp_r[i]);
 
-              cdpe_set_e (mp->dpc[i], mp->dpr[i], rdpe_zero);
+              cdpe_set_e (mp->dpc[i], dpr, rdpe_zero);
 
               /* compute dap[i] and check for float phase */
-              rdpe_abs (mp->dap[i], mp->dpr[i]);
-              rdpe_abs (mp->dap[i], mp->dpr[i]);
+              rdpe_abs (mp->dap[i], dpr);
+              rdpe_abs (mp->dap[i], dpr);
               if (rdpe_gt (mp->dap[i], rdpe_maxd)
                   || rdpe_lt (mp->dap[i], rdpe_mind))
                 s->skip_float = true;
@@ -404,6 +477,13 @@ mps_setup (mps_context * s)
               else if (MPS_STRUCTURE_IS_FP (s->active_poly->structure))
                 mpc_get_cdpe (mp->dpc[i], mp->mfpc[i]);
 
+              if (mp->dpc_exact)
+                mp->dpc_exact = MPS_STRUCTURE_IS_FP (s->active_poly->structure) ?
+                                mps_rdpe_eq_f (cdpe_Re (mp->dpc[i]), mpc_Re (mp->mfpc[i])) &&
+                                mps_rdpe_eq_f (cdpe_Im (mp->dpc[i]), mpc_Im (mp->mfpc[i])) :
+                                mps_rdpe_eq_q (cdpe_Re (mp->dpc[i]), mp->initial_mqp_r[i]) &&
+                                mps_rdpe_eq_q (cdpe_Im (mp->dpc[i]), mp->initial_mqp_i[i]);
+
               /* compute dap[i] */
               cdpe_mod (mp->dap[i], mp->dpc[i]);
               if (rdpe_gt (mp->dap[i], rdpe_maxd)
@@ -429,9 +509,8 @@ mps_setup (mps_context * s)
               continue;
             if (MPS_STRUCTURE_IS_REAL (s->active_poly->structure))
               {
-                mp->fpr[i] = rdpe_get_d (mp->dpr[i]);
-                mp->fap[i] = fabs (mp->fpr[i]);
-                cplx_set_d (mp->fpc[i], mp->fpr[i], 0.0);
+                cplx_set_d (mp->fpc[i], rdpe_get_d (cdpe_Re (mp->dpc[i])), 0.0);
+                mp->fap[i] = fabs (cplx_Re (mp->fpc[i]));
               }
             else
               {
@@ -463,6 +542,72 @@ mps_check_data (mps_context * s, char *which_case)
   mps_monomial_poly *p = NULL;
   int i;
 
+  /* Polynomials in the Chebyshev basis have floating point evaluation and
+   * Newton correction, so we can start in floating point if the moduli of
+   * the coefficients are in the range of the doubles. */
+  if (MPS_IS_CHEBYSHEV_POLY (s->active_poly))
+    {
+      mps_chebyshev_poly *cpoly = MPS_CHEBYSHEV_POLY (s->active_poly);
+
+      if (s->output_config->multiplicity)
+        mps_error (s,
+                   "Multiplicity detection not yet implemented for Chebyshev polynomials");
+      if (s->output_config->root_properties)
+        mps_error (s,
+                   "Real/imaginary detection not yet implemented for Chebyshev polynomials");
+
+      rdpe_set (min_coeff, RDPE_MAX);
+      rdpe_set (max_coeff, rdpe_zero);
+      for (i = 0; i <= s->n; i++)
+        {
+          cdpe_mod (tmp, cpoly->dpc[i]);
+          if (rdpe_eq (tmp, rdpe_zero))
+            continue;
+          if (rdpe_lt (tmp, min_coeff))
+            rdpe_set (min_coeff, tmp);
+          if (rdpe_gt (tmp, max_coeff))
+            rdpe_set (max_coeff, tmp);
+        }
+
+      *which_case = 'd';
+      if (rdpe_ne (max_coeff, rdpe_zero))
+        {
+          rdpe_div (tmp, max_coeff, min_coeff);
+          rdpe_mul_eq_d (tmp, (double)(s->n + 1));
+          rdpe_mul_eq (tmp, rdpe_mind);
+          rdpe_div_eq (tmp, rdpe_maxd);
+
+          if (rdpe_lt (tmp, rdpe_one))
+            *which_case = 'f';
+        }
+      return;
+    }
+
+  /* Sparse polynomials are evaluated with powers of x computed by repeated
+   * squaring, so the exponents matter as much as the coefficients: the
+   * float phase is used only if the relevant terms stay in the range of the
+   * doubles on the circles given by the Newton polygon. */
+  if (MPS_IS_SPARSE_MONOMIAL_POLY (s->active_poly))
+    {
+      mps_sparse_monomial_poly *sp = MPS_SPARSE_MONOMIAL_POLY (s->active_poly);
+
+      if (s->output_config->multiplicity)
+        mps_error (s,
+                   "Multiplicity detection not yet implemented for sparse polynomials");
+      if (s->output_config->root_properties)
+        mps_error (s,
+                   "Real/imaginary detection not yet implemented for sparse polynomials");
+
+      if (sp->n_terms == 0 || sp->exponents[sp->n_terms - 1] != s->n)
+        {
+          mps_error (s, "The leading coefficient is zero");
+          return;
+        }
+
+      *which_case = mps_sparse_monomial_poly_check_float_range (s, sp) ? 'f' : 'd';
+      return;
+    }
+
   /* case of user-defined polynomial */
   if (!MPS_IS_MONOMIAL_POLY (s->active_poly))
     {
@@ -564,6 +709,10 @@ mps_check_data (mps_context * s, char *which_case)
       rdpe_div (min_coeff, tmp, min_coeff);
       rdpe_sqrt_eq (min_coeff);
 
+      /* Scale by a power of two, so that the coefficients which are exactly
+       * representable stay exact, see mps_fhorner_compensated(). */
+      rdpe_set_2dl (min_coeff, 1.0, rdpe_Esp (min_coeff));
+
       rdpe_set (cdpe_Re (c_min_coeff), min_coeff);
       rdpe_set (cdpe_Im (c_min_coeff), rdpe_zero);
 
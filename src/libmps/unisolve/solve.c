@@ -456,6 +456,10 @@ mps_fsolve (mps_context * s, mps_boolean * d_after_f)
     fprintf (s->logstr, "   FSOLVE:  call fpolzer\n");
   for (iter = 0; iter < s->max_pack; iter++)
     {                           /* floop: */
+      /* Stop between two packets if the time budget is over */
+      if (iter > 0 && mps_budget_time_over (s))
+        break;
+
       /* mps_fpolzer(s, &nit, &excep);   */
       mps_thread_fpolzer (s, &nit, &excep, required_zeros--);
       it_pack += nit;
@@ -829,6 +833,10 @@ mps_dsolve (mps_context * s, mps_boolean d_after_f)
 
   for (iter = 0; iter < s->max_pack; iter++)
     {                           /* dloop : DO iter=1,s->max_pack */
+      /* Stop between two packets if the time budget is over */
+      if (iter > 0 && mps_budget_time_over (s))
+        break;
+
       /* mps_dpolzer(s, &nit, &excep);  */
       mps_thread_dpolzer (s, &nit, &excep, required_zeros--);
       it_pack += nit;
@@ -1013,6 +1021,10 @@ mps_msolve (mps_context * s)
 
   for (iter = 0; iter < s->max_pack; iter++)
     {                           /* mloop : DO iter=1,s->max_pack */
+      /* Stop between two packets if the time budget is over */
+      if (iter > 0 && mps_budget_time_over (s))
+        break;
+
       if (s->DOLOG)
         {
           fprintf (s->logstr, "  MSOLVE: packet= %d\n", iter);
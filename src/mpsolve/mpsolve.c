@@ -11,15 +11,16 @@
 #define _MPS_PRIVATE
 #include <mps/mps.h>
 #include <string.h>
+#include <float.h>
 
 #ifdef HAVE_CONFIG_H
 #include <config.h>
 #endif
 
 #if HAVE_GRAPHICAL_DEBUGGER
-#define MPSOLVE_GETOPT_STRING "a:G:D:d::xt:o:O:j:S:O:i:vl:bp:rs:c"
+#define MPSOLVE_GETOPT_STRING "a:G:D:d::xt:o:O:j:A:S:O:i:vl:bByp:rs:c"
 #else
-#define MPSOLVE_GETOPT_STRING "a:G:D:d::t:o:O:j:S:O:i:vl:bp:rs:c"
+#define MPSOLVE_GETOPT_STRING "a:G:D:d::t:o:O:j:A:S:O:i:vl:bByp:rs:c"
 #endif
 
 #if HAVE_GRAPHICAL_DEBUGGER
@@ -113,8 +114,9 @@ void
 usage (mps_context * s, const char *program)
 {
   fprintf (stdout,
-           "%s [-a alg] [-b] -c [-G goal] [-o digits] [-i digits] [-j n] [-t type] [-S set] \n"
-"  [-D detect] [-O format] [-l] [-r] [filename | -p poly] "
+           "%s [-a alg] [-b] [-B] [-y] -c [-G goal] [-o digits] [-i digits] [-j n] [-A affinity] [-t type] [-S set] \n"
+"  [-D detect] [-O format] [-l] [-r] [--disk re,im,r] [--rect re0,im0,re1,im1]\n"
+"  [--sweep qfile:t0:t1:steps] [filename | -p poly] "
 #if HAVE_GRAPHICAL_DEBUGGER
           "[-x] "           
 #endif
@@ -126,6 +128,10 @@ usage (mps_context * s, const char *program)
            "              s: Secular algorithm, using regeneration of increasingly better-conditioned\n"
            "                 secular equations with the same roots of the polynomial\n"
            " -b          Perform Aberth iterations in Jacobi-style instead of Gauss-Seidel\n"
+           " -B          Let the threads compute the Aberth corrections on a snapshot of the\n"
+           "             roots taken at every sweep, instead of the most recent approximations\n"
+           " -y          Iterate only on one root of every conjugate pair in floating point,\n"
+           "             if the coefficients of the polynomial are real\n"
 	   " -c          Enable crude approximation mode. Fast but not always effective\n"
            " -G goal     Select the goal to reach. Possible values are:\n"
            "              a: Approximate the roots\n"
@@ -134,6 +140,9 @@ usage (mps_context * s, const char *program)
            " -o digits   Number of guaranteed digits of the roots\n"
            " -i digits   Digits of precision of the input coefficients\n"
            " -j n        Number of threads to spawn as workers\n"
+           " -A affinity Bind the worker threads to the CPUs of the system:\n"
+           "               c: every thread runs on its own core\n"
+           "               n: threads are distributed among the NUMA nodes\n"
            " -t type     Type can be 'f' for floating point or 'd' for DPE\n"
            " -S set      Restrict the search set for the roots \n"
            "             set can be one of:\n"
@@ -145,6 +154,13 @@ usage (mps_context * s, const char *program)
            "               o: outside the unit circle { x | |x| > 1 } \n"
 	   "               R: real axis { x | Im(x) = 0 } \n"
 	   "               I: imaginary axis { x | Re(x) = 0 }\n"
+           " --disk re,im,r\n"
+           "             Search the roots in the closed disk of center re + i im and radius r\n"
+           " --rect re0,im0,re1,im1\n"
+           "             Search the roots in the closed rectangle with opposite vertices\n"
+           "             re0 + i im0 and re1 + i im1. The options --disk and --rect can be\n"
+           "             repeated to search in the union of several disks and rectangles.\n"
+           "             The roots certified to be out of it are not refined anymore.\n"
            " -D detect   Detect properties of the roots:\n"
            "               r: real roots\n"
            "               i: imaginary roots\n"
@@ -185,9 +201,16 @@ usage (mps_context * s, const char *program)
 	   "             Note: this option is considered experimental.\n"
 	   " -s file     Read the starting approximations from the given file, instead\n"
 	   "             of relying on the internal algorithm of MPSolve.\n"
+           " --sweep qfile:t0:t1:steps\n"
+           "             Solve p(x) + t q(x), where p is the input polynomial and q is read\n"
+           "             from qfile, for steps + 1 equispaced values of t from t0 to t1.\n"
+           "             Every point of the grid starts from the roots of the previous one,\n"
+           "             and the grid is split among the threads. The roots are printed in\n"
+           "             double precision.\n"
+           "               Example: %s --sweep q.pol:0:1:100 p.pol\n"
            " -v          Print the version and exit\n"
            "\n",
-           program, program, program);
+           program, program, program, program);
 
   exit (EXIT_FAILURE);
 }
@@ -232,6 +255,290 @@ cleanup_context (mps_context * ctx, void * user_data)
   return NULL;
 }
 
+/*
+ * Build the polynomial p(x) + t q(x). The coefficients are combined in
+ * rational arithmetic if both polynomials are exact, and in floating
+ * point otherwise.
+ */
+static mps_polynomial *
+sweep_build_step (mps_context * ctx, mps_monomial_poly * p, mps_monomial_poly * q, mpq_t t)
+{
+  int i, degree = MAX (MPS_POLYNOMIAL (p)->degree, MPS_POLYNOMIAL (q)->degree);
+  mps_monomial_poly * mp = mps_monomial_poly_new (ctx, degree);
+  mps_boolean exact = !MPS_STRUCTURE_IS_FP (MPS_POLYNOMIAL (p)->structure) &&
+                      !MPS_STRUCTURE_IS_FP (MPS_POLYNOMIAL (q)->structure);
+  mpq_t re, im, tmp;
+  mpc_t coeff, qcoeff;
+  mpf_t ft;
+
+  mpq_init (re);
+  mpq_init (im);
+  mpq_init (tmp);
+  mpc_init2 (coeff, mp->prec);
+  mpc_init2 (qcoeff, mp->prec);
+  mpf_init2 (ft, mp->prec);
+  mpf_set_q (ft, t);
+
+  for (i = 0; i <= degree; i++)
+    {
+      if (exact)
+        {
+          mpq_set_ui (re, 0U, 1U);
+          mpq_set_ui (im, 0U, 1U);
+
+          if (i <= MPS_POLYNOMIAL (p)->degree)
+            {
+              mpq_set (re, p->initial_mqp_r[i]);
+              mpq_set (im, p->initial_mqp_i[i]);
+            }
+
+          if (i <= MPS_POLYNOMIAL (q)->degree)
+            {
+              mpq_mul (tmp, t, q->initial_mqp_r[i]);
+              mpq_add (re, re, tmp);
+              mpq_mul (tmp, t, q->initial_mqp_i[i]);
+              mpq_add (im, im, tmp);
+            }
+
+          mps_monomial_poly_set_coefficient_q (ctx, mp, i, re, im);
+        }
+      else
+        {
+          mpc_set_ui (coeff, 0U, 0U);
+
+          if (i <= MPS_POLYNOMIAL (p)->degree)
+            mpc_set (coeff, p->mfpc[i]);
+
+          if (i <= MPS_POLYNOMIAL (q)->degree)
+            {
+              mpc_mul_f (qcoeff, q->mfpc[i], ft);
+              mpc_add (coeff, coeff, qcoeff);
+            }
+
+          mps_monomial_poly_set_coefficient_f (ctx, mp, i, coeff);
+        }
+    }
+
+  if (!exact)
+    MPS_POLYNOMIAL (mp)->structure =
+      (MPS_STRUCTURE_IS_REAL (MPS_POLYNOMIAL (p)->structure) &&
+       MPS_STRUCTURE_IS_REAL (MPS_POLYNOMIAL (q)->structure)) ?
+      MPS_STRUCTURE_REAL_FP : MPS_STRUCTURE_COMPLEX_FP;
+
+  mps_polynomial_set_input_prec (ctx, MPS_POLYNOMIAL (mp),
+                                 MAX (MPS_POLYNOMIAL (p)->prec, MPS_POLYNOMIAL (q)->prec));
+
+  mpq_clear (re);
+  mpq_clear (im);
+  mpq_clear (tmp);
+  mpc_clear (coeff);
+  mpc_clear (qcoeff);
+  mpf_clear (ft);
+
+  return MPS_POLYNOMIAL (mp);
+}
+
+/*
+ * Solve p(x) + t q(x) for t on an uniform grid, where spec has the form
+ * qfile:t0:t1:steps. The grid is followed by mps_solve_sweep(), so that every
+ * point starts from the roots of the previous one.
+ */
+static int
+sweep (mps_context * s, mps_polynomial * base, const char * spec,
+       mps_boolean explicit_algorithm_selection)
+{
+  char * qfile = strdup (spec), * t0_string, * t1_string, * steps_string;
+  char * eq_t0 = NULL, * eq_t1 = NULL;
+  mps_context * qctx = NULL;
+  mps_polynomial * qpoly = NULL, ** polys = NULL;
+  mps_batch_options options;
+  mps_batch_result * results = NULL;
+  mpq_t t, t0, dt;
+  FILE * qstream;
+  int i, j, k, steps = 0, failures = -1;
+
+  /* The parameters are the last three fields, so that the file name
+   * can contain colons */
+  if ((steps_string = strrchr (qfile, ':')) != NULL)
+    {
+      *steps_string++ = '\0';
+      if ((t1_string = strrchr (qfile, ':')) != NULL)
+        {
+          *t1_string++ = '\0';
+          if ((t0_string = strrchr (qfile, ':')) != NULL)
+            {
+              *t0_string++ = '\0';
+              steps = atoi (steps_string);
+              eq_t0 = mps_utils_build_equivalent_rational_string (s, t0_string);
+              eq_t1 = mps_utils_build_equivalent_rational_string (s, t1_string);
+            }
+        }
+    }
+
+  if (steps <= 0 || !eq_t0 || !eq_t1)
+    {
+      mps_error (s, "The argument of --sweep must have the form qfile:t0:t1:steps");
+      goto cleanup;
+    }
+
+  if (!(qstream = fopen (qfile, "r")))
+    {
+      mps_error (s, "Cannot open the perturbation file: %s", qfile);
+      goto cleanup;
+    }
+
+  /* The perturbation is parsed in its own context, since the parser sets
+   * the degree of the context it is given */
+  qctx = mps_context_new ();
+  qpoly = mps_parse_stream (qctx, qstream);
+  fclose (qstream);
+
+  if (!qpoly || mps_context_has_errors (qctx))
+    {
+      mps_error (s, "Error while parsing the perturbation %s", qfile);
+      goto cleanup;
+    }
+
+  if (!MPS_IS_MONOMIAL_POLY (base) || !MPS_IS_MONOMIAL_POLY (qpoly))
+    {
+      mps_error (s, "Only dense polynomials in the monomial basis can be used with --sweep");
+      goto cleanup;
+    }
+
+  mpq_init (t);
+  mpq_init (t0);
+  mpq_init (dt);
+  mpq_set_str (t0, eq_t0, 10);
+  mpq_set_str (dt, eq_t1, 10);
+  mpq_canonicalize (t0);
+  mpq_canonicalize (dt);
+
+  /* dt = (t1 - t0) / steps */
+  mpq_sub (dt, dt, t0);
+  mpq_set_ui (t, (unsigned long) steps, 1U);
+  mpq_div (dt, dt, t);
+
+  polys = mps_newv (mps_polynomial*, steps + 1);
+  results = mps_newv (mps_batch_result, steps + 1);
+  for (i = 0; i <= steps; i++)
+    {
+      mpq_set_ui (t, (unsigned long) i, 1U);
+      mpq_mul (t, t, dt);
+      mpq_add (t, t, t0);
+      polys[i] = sweep_build_step (s, MPS_MONOMIAL_POLY (base), MPS_MONOMIAL_POLY (qpoly), t);
+
+      results[i].roots = NULL;
+      results[i].radii = NULL;
+    }
+
+  mps_batch_options_init (&options);
+  options.goal = s->output_config->goal;
+  options.output_prec = s->output_config->prec;
+
+  /* Use the same heuristic of a single solve, on the first point of the
+   * grid. The polynomial is not set in s, since that would deflate its zero
+   * roots before the workers can count them. */
+  if (explicit_algorithm_selection)
+    options.algorithm = s->algorithm;
+  else
+    {
+      mps_monomial_poly * first = MPS_MONOMIAL_POLY (polys[0]);
+      mps_boolean sparse = false;
+
+      for (j = 0; j < polys[0]->degree && !first->spar[j]; j++)
+        ;
+      for (; j <= polys[0]->degree; j++)
+        if (!first->spar[j])
+          sparse = true;
+
+      options.algorithm = sparse ? MPS_ALGORITHM_STANDARD_MPSOLVE : MPS_ALGORITHM_SECULAR_GA;
+    }
+
+  failures = mps_solve_sweep (polys, steps + 1, &options, results);
+  mps_batch_release ();
+
+  for (i = 0; i <= steps; i++)
+    {
+      mpq_set_ui (t, (unsigned long) i, 1U);
+      mpq_mul (t, t, dt);
+      mpq_add (t, t, t0);
+
+      if (results[i].error)
+        {
+          fprintf (stdout, "; t = %.*e: the polynomial could not be solved\n",
+                   DBL_DIG, mpq_get_d (t));
+          continue;
+        }
+
+      fprintf (stdout, "; t = %.*e, Newton corrections = %ld, saved = %ld\n",
+               DBL_DIG, mpq_get_d (t), results[i].iterations, results[i].iterations_saved);
+
+      for (j = 0; j < polys[i]->degree; j++)
+        fprintf (stdout, "(%.*e, %.*e)\n", DBL_DIG, cplx_Re (results[i].roots[j]),
+                 DBL_DIG, cplx_Im (results[i].roots[j]));
+
+      /* The zero roots have been deflated from the polynomial, while the
+       * vanishing leading coefficients have lowered its degree. */
+      for (j = 0; j < results[i].zero_roots; j++)
+        fprintf (stdout, "(0, 0)\n");
+
+      k = MAX (MPS_POLYNOMIAL (base)->degree, MPS_POLYNOMIAL (qpoly)->degree) -
+          polys[i]->degree - results[i].zero_roots;
+      if (k > 0)
+        fprintf (stdout, "; %d roots at infinity, since the leading coefficients vanish\n", k);
+    }
+
+  for (i = 0; i <= steps; i++)
+    {
+      cplx_vfree (results[i].roots);
+      mps_polynomial_free (s, polys[i]);
+    }
+
+  free (polys);
+  free (results);
+
+  mpq_clear (t);
+  mpq_clear (t0);
+  mpq_clear (dt);
+
+cleanup:
+  if (qpoly)
+    mps_polynomial_free (qctx, qpoly);
+  if (qctx)
+    mps_context_free (qctx);
+
+  free (qfile);
+  free (eq_t0);
+  free (eq_t1);
+
+  return failures;
+}
+
+/*
+ * Add to the search region the disk re,im,radius given with --disk, or the
+ * rectangle re0,im0,re1,im1 given with --rect.
+ */
+static void
+add_search_region (mps_context * s, const char * option, const char * spec)
+{
+  double a, b, c, d;
+
+  if (strcmp (option, "disk") == 0)
+    {
+      if (sscanf (spec, "%lf,%lf,%lf", &a, &b, &c) != 3 || !(c >= 0))
+        mps_error (s, "The argument of --disk must have the form re,im,radius");
+      else
+        mps_context_add_search_disk (s, a, b, c);
+    }
+  else
+    {
+      if (sscanf (spec, "%lf,%lf,%lf,%lf", &a, &b, &c, &d) != 4)
+        mps_error (s, "The argument of --rect must have the form re0,im0,re1,im1");
+      else
+        mps_context_add_search_rectangle (s, a, b, c, d);
+    }
+}
+
 #ifdef HAVE_GRAPHICAL_DEBUGGER
 static void on_iteration_logger_destroy (MpsIterationLogger * logger, GdkEvent * event, gpointer user_data)
 {
@@ -263,6 +570,8 @@ main (int argc, char **argv)
    * precision. */
   long int input_precision = -1;
   char * inline_poly = NULL;
+  char * sweep_spec = NULL;
+  int i, j;
 
   FILE *infile;
 
@@ -274,6 +583,30 @@ main (int argc, char **argv)
      otherwise we will be using our own heuristic. */
   mps_boolean explicit_algorithm_selection = false;
 
+  /* mps_getopts() only knows about single letter options, so the long
+   * options --sweep, --disk and --rect are taken away from argv before
+   * calling it. */
+  for (i = 1, j = 1; i < argc; i++)
+    {
+      if (strcmp (argv[i], "--sweep") == 0 && i + 1 < argc)
+        sweep_spec = argv[++i];
+      else if (strncmp (argv[i], "--sweep=", 8) == 0)
+        sweep_spec = argv[i] + 8;
+      else if ((strcmp (argv[i], "--disk") == 0 || strcmp (argv[i], "--rect") == 0) && i + 1 < argc)
+        {
+          add_search_region (s, argv[i] + 2, argv[i + 1]);
+          i++;
+        }
+      else if (strncmp (argv[i], "--disk=", 7) == 0 || strncmp (argv[i], "--rect=", 7) == 0)
+        {
+          argv[i][6] = '\0';
+          add_search_region (s, argv[i] + 2, argv[i] + 7);
+        }
+      else
+        argv[j++] = argv[i];
+    }
+  argc = j;
+
   opt = NULL;
   while ((mps_getopts (&opt, &argc, &argv, MPSOLVE_GETOPT_STRING)))
     {
@@ -475,6 +808,12 @@ main (int argc, char **argv)
         case 'b':
           mps_context_set_jacobi_iterations (s, true);
           break;
+        case 'B':
+          mps_context_set_aberth_snapshot (s, true);
+          break;
+        case 'y':
+          mps_context_set_conjugate_symmetry (s, true);
+          break;
 	case 'c':
 	  mps_context_set_crude_approximation_mode (s, true);
 	  break;
@@ -603,6 +942,19 @@ main (int argc, char **argv)
           mps_thread_pool_set_concurrency_limit (s, NULL, atoi (opt->optvalue));
           s->n_threads = atoi (opt->optvalue);
           break;
+        case 'A':
+          switch (*opt->optvalue)
+            {
+            case 'c':
+              mps_context_set_thread_affinity (s, MPS_THREAD_AFFINITY_CORE);
+              break;
+            case 'n':
+              mps_context_set_thread_affinity (s, MPS_THREAD_AFFINITY_NODE);
+              break;
+            default:
+              mps_error (s, "Bad affinity switch: ", opt->optvalue, ", use c|n");
+            }
+          break;
         default:
           usage (s, argv[0]);
           break;
@@ -676,6 +1028,25 @@ main (int argc, char **argv)
       mps_print_errors (s);
       return EXIT_FAILURE;
     }
+  else if (sweep_spec)
+    {
+      if (input_precision >= 0)
+        mps_polynomial_set_input_prec (s, poly, input_precision);
+
+      if (argc == 2 && ! inline_poly)
+        fclose (infile);
+
+      if (sweep (s, poly, sweep_spec, explicit_algorithm_selection) < 0)
+        {
+          mps_print_errors (s);
+          return EXIT_FAILURE;
+        }
+
+      mps_polynomial_free (s, poly);
+      mps_context_free (s);
+
+      return EXIT_SUCCESS;
+    }
   else
     mps_context_set_input_poly (s, poly);
 
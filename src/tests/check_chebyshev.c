@@ -139,6 +139,112 @@ START_TEST (test_chebyshev_poly_20)
 }
 END_TEST
 
+START_TEST (test_chebyshev_poly_eval)
+{
+  int i, n = 15;
+  mps_context * ctx = mps_context_new ();
+  mps_chebyshev_poly *cp = mps_chebyshev_poly_new (ctx, n, MPS_STRUCTURE_REAL_INTEGER);
+  cplx_t x, fvalue;
+  cdpe_t dx, dvalue, cdiff;
+  mpc_t mx, mvalue, mdiff;
+  rdpe_t merror, derror, diff, bound;
+  double ferror;
+
+  for (i = 0; i <= n; i++)
+    mps_chebyshev_poly_set_coefficient_i (ctx, cp, i, (i % 3) ? i : -7 * i - 1, 0);
+
+  mps_context_set_input_poly (ctx, MPS_POLYNOMIAL (cp));
+  mps_polynomial_raise_data (ctx, MPS_POLYNOMIAL (cp), 256);
+
+  mpc_init2 (mx, 256);
+  mpc_init2 (mvalue, 256);
+  mpc_init2 (mdiff, 256);
+
+  cplx_set_d (x, 0.4, 0.9);
+  mpc_set_cplx (mx, x);
+  mpc_get_cdpe (dx, mx);
+
+  mps_polynomial_meval (ctx, MPS_POLYNOMIAL (cp), mx, mvalue, merror);
+
+  /* The Clenshaw recurrence in floating point must agree with the multiprecision
+   * one up to the sum of the error bounds. */
+  fail_unless (mps_polynomial_feval (ctx, MPS_POLYNOMIAL (cp), x, fvalue, &ferror),
+               "Floating point evaluation of the Chebyshev polynomial failed");
+  mpc_set_cplx (mdiff, fvalue);
+  mpc_sub (mdiff, mdiff, mvalue);
+  mpc_get_cdpe (cdiff, mdiff);
+  cdpe_mod (diff, cdiff);
+  rdpe_set_d (bound, ferror);
+  rdpe_add_eq (bound, merror);
+  fail_unless (rdpe_le (diff, bound),
+               "The error bound of the floating point Clenshaw recurrence is not satisfied");
+
+  fail_unless (mps_polynomial_deval (ctx, MPS_POLYNOMIAL (cp), dx, dvalue, derror),
+               "DPE evaluation of the Chebyshev polynomial failed");
+  mpc_set_cdpe (mdiff, dvalue);
+  mpc_sub (mdiff, mdiff, mvalue);
+  mpc_get_cdpe (cdiff, mdiff);
+  cdpe_mod (diff, cdiff);
+  rdpe_add (bound, derror, merror);
+  fail_unless (rdpe_le (diff, bound),
+               "The error bound of the DPE Clenshaw recurrence is not satisfied");
+
+  mpc_clear (mx);
+  mpc_clear (mvalue);
+  mpc_clear (mdiff);
+  mps_polynomial_free (ctx, MPS_POLYNOMIAL (cp));
+  mps_context_free (ctx);
+}
+END_TEST
+
+START_TEST (test_chebyshev_poly_unisolve)
+{
+  int i, j, n = 40;
+  mps_context * ctx = mps_context_new ();
+  mps_chebyshev_poly *cp = mps_chebyshev_poly_new (ctx, n, MPS_STRUCTURE_REAL_INTEGER);
+  cplx_t *froots = NULL;
+  double *radii = NULL;
+
+  for (i = 0; i < n; i++)
+    mps_chebyshev_poly_set_coefficient_i (ctx, cp, i, 0, 0);
+  mps_chebyshev_poly_set_coefficient_i (ctx, cp, n, 1, 0);
+
+  mps_context_set_input_poly (ctx, MPS_POLYNOMIAL (cp));
+  mps_context_select_algorithm (ctx, MPS_ALGORITHM_STANDARD_MPSOLVE);
+  mps_thread_pool_set_concurrency_limit (ctx, NULL, 1);
+  mps_mpsolve (ctx);
+
+  fail_unless (!mps_context_has_errors (ctx),
+               "Solving a Chebyshev polynomial with the standard algorithm failed");
+
+  /* Every root cos((2i + 1) pi / 2n) must be found within the inclusion radius */
+  mps_context_get_roots_d (ctx, &froots, &radii);
+  for (i = 0; i < n; i++)
+    {
+      double expected_root = cos ((2.0 * i + 1) / (2 * n) * PI);
+      double epsilon = DBL_MAX;
+      int found_root = -1;
+
+      for (j = 0; j < n; j++)
+        {
+          double residue = hypot (cplx_Re (froots[j]) - expected_root, cplx_Im (froots[j]));
+          if (residue < epsilon)
+            {
+              epsilon = residue;
+              found_root = j;
+            }
+        }
+
+      fail_unless (epsilon < 4.0 * DBL_EPSILON + radii[found_root]);
+    }
+
+  free (froots);
+  free (radii);
+  mps_polynomial_free (ctx, MPS_POLYNOMIAL (cp));
+  mps_context_free (ctx);
+}
+END_TEST
+
 Suite*
 chebyshev_suite (void)
 {
@@ -148,6 +254,8 @@ chebyshev_suite (void)
 
   tcase_add_test (tcase_t, test_chebyshev_poly_20);
   tcase_add_test (tcase_t, test_chebyshev_poly_80);
+  tcase_add_test (tcase_t, test_chebyshev_poly_eval);
+  tcase_add_test (tcase_t, test_chebyshev_poly_unisolve);
 
   suite_add_tcase (s, tcase_t);
   return s;
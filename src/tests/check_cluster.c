@@ -95,6 +95,61 @@ START_TEST (cluster_isolation)
 }
 END_TEST
 
+/* Verify that the job queue raises the exception at the same job as the
+ * original list based queue, i.e., at the end of the first cluster of the
+ * last iteration, even if the clusterization contains more clusters. */
+START_TEST (cluster_job_queue_exception)
+{
+  mps_context *s = mps_context_new ();
+  mps_clusterization *c = mps_clusterization_empty (s);
+  mps_thread_job_queue *q;
+  mps_thread_job job;
+  int sizes[] = { 4, 2, 3 };
+  int i, k, n = 0, first_size, max_it = 5, old_n = s->n;
+  long j, excep_job = -1;
+
+  /* The last cluster inserted is the first one of the clusterization */
+  for (i = 0; i < 3; i++)
+    {
+      mps_cluster *cluster = mps_cluster_empty (s);
+      for (k = 0; k < sizes[i]; k++)
+        mps_cluster_insert_root (s, cluster, n++);
+      mps_clusterization_insert_cluster (s, c, cluster);
+    }
+  first_size = sizes[2];
+
+  s->clusterization = c;
+  s->n = n;
+  s->max_it = max_it;
+  q = mps_thread_job_queue_new (s);
+
+  for (j = 0; j < (max_it + 2) * n; j++)
+    {
+      job = mps_thread_job_queue_next (s, q);
+
+      if (job.iter == MPS_THREAD_JOB_EXCEP)
+        {
+          if (excep_job < 0)
+            excep_job = j;
+        }
+      else
+        {
+          fail_unless (excep_job < 0, "A job has been handed out after the exception");
+          fail_unless (job.iter == j / n, "Wrong iteration counter in the job queue");
+        }
+    }
+
+  fail_unless (excep_job == (long) max_it * n + first_size - 1,
+               "The job queue has raised the exception at the wrong job");
+
+  mps_thread_job_queue_free (q);
+  mps_clusterization_free (s, c);
+  s->clusterization = NULL;
+  s->n = old_n;
+  mps_context_free (s);
+}
+END_TEST
+
 
 int
 main (void)
@@ -109,6 +164,7 @@ main (void)
   // Add tests of the Cluster management test case
   tcase_add_test (tc_management, cluster_create);
   tcase_add_test (tc_management, cluster_isolation);
+  tcase_add_test (tc_management, cluster_job_queue_exception);
 
   suite_add_tcase (s, tc_management);
 
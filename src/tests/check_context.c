@@ -84,6 +84,715 @@ START_TEST (basics_context_reuse_shrink)
 }
 END_TEST
 
+#define SHARED_POOL_CONTEXTS 4
+
+static void *
+solve_unity_roots (void * ctx_ptr)
+{
+  mps_context * ctx = (mps_context*) ctx_ptr;
+  mps_monomial_poly *poly = mps_monomial_poly_new (ctx, 10);
+
+  mps_monomial_poly_set_coefficient_d (ctx, poly, 0, -1, 0.0);
+  mps_monomial_poly_set_coefficient_d (ctx, poly, 10, 1, 0.0);
+
+  mps_context_set_input_poly (ctx, MPS_POLYNOMIAL (poly));
+  mps_mpsolve (ctx);
+
+  return poly;
+}
+
+START_TEST (basics_shared_thread_pool)
+{
+  mps_context * ctx[SHARED_POOL_CONTEXTS];
+  pthread_t threads[SHARED_POOL_CONTEXTS];
+  void * polys[SHARED_POOL_CONTEXTS];
+  int i, j;
+
+  /* Solve with many contexts at the same time on a single pool */
+  ctx[0] = mps_context_new ();
+  for (i = 1; i < SHARED_POOL_CONTEXTS; i++)
+    {
+      ctx[i] = mps_context_new ();
+      mps_context_set_thread_pool (ctx[i], mps_context_get_thread_pool (ctx[0]));
+      fail_unless (mps_context_get_thread_pool (ctx[i]) == mps_context_get_thread_pool (ctx[0]),
+                   "The thread pool has not been shared");
+    }
+
+  for (i = 0; i < SHARED_POOL_CONTEXTS; i++)
+    pthread_create (&threads[i], NULL, solve_unity_roots, ctx[i]);
+
+  for (i = 0; i < SHARED_POOL_CONTEXTS; i++)
+    {
+      cplx_t * roots = NULL;
+      double * radii = NULL;
+
+      pthread_join (threads[i], &polys[i]);
+      mps_context_get_roots_d (ctx[i], &roots, &radii);
+
+      for (j = 0; j < 10; j++)
+        fail_unless (fabs (cplx_mod (roots[j]) - 1.0) < 1e-12,
+                     "Wrong root computed on the shared thread pool");
+
+      cplx_vfree (roots);
+      free (radii);
+    }
+
+  /* The pool must outlive the context that created it */
+  for (i = 0; i < SHARED_POOL_CONTEXTS; i++)
+    {
+      mps_monomial_poly_free (ctx[i], MPS_POLYNOMIAL (polys[i]));
+      mps_context_free (ctx[i]);
+    }
+}
+END_TEST
+
+#define BATCH_SIZE 24
+
+START_TEST (basics_solve_batch)
+{
+  mps_context * ctx = mps_context_new ();
+  mps_polynomial * polys[BATCH_SIZE];
+  mps_batch_result results[BATCH_SIZE];
+  int i, j;
+
+  /* Polynomials x^n - 1 of a few different degrees */
+  for (i = 0; i < BATCH_SIZE; i++)
+    {
+      int n = 5 + 3 * (i % 4);
+      mps_monomial_poly *poly = mps_monomial_poly_new (ctx, n);
+
+      mps_monomial_poly_set_coefficient_d (ctx, poly, 0, -1, 0.0);
+      mps_monomial_poly_set_coefficient_d (ctx, poly, n, 1, 0.0);
+
+      polys[i] = MPS_POLYNOMIAL (poly);
+      results[i].roots = cplx_valloc (n);
+      results[i].radii = double_valloc (n);
+    }
+
+  fail_unless (mps_solve_batch (polys, BATCH_SIZE, NULL, results) == 0,
+               "Some polynomials of the batch could not be solved");
+
+  for (i = 0; i < BATCH_SIZE; i++)
+    {
+      fail_unless (!results[i].error, "Error reported on polynomial %d of the batch", i);
+
+      for (j = 0; j < polys[i]->degree; j++)
+        {
+          fail_unless (fabs (cplx_mod (results[i].roots[j]) - 1.0) < 1e-12,
+                       "Wrong root computed in the batch");
+          fail_unless (results[i].radii[j] < 1e-12,
+                       "Inclusion radius too large in the batch");
+        }
+
+      cplx_vfree (results[i].roots);
+      free (results[i].radii);
+      mps_monomial_poly_free (ctx, polys[i]);
+    }
+
+  mps_batch_release ();
+  mps_context_free (ctx);
+}
+END_TEST
+
+#define CONTINUATION_STEPS 8
+#define CONTINUATION_DEGREE 30
+
+START_TEST (basics_solve_continuation)
+{
+  mps_context * ctx = mps_context_new ();
+  mps_algorithm algorithms[] = { MPS_ALGORITHM_STANDARD_MPSOLVE, MPS_ALGORITHM_SECULAR_GA };
+  mps_polynomial * polys[CONTINUATION_STEPS];
+  mps_batch_result results[CONTINUATION_STEPS];
+  mps_batch_options options;
+  int (*solvers[]) (mps_polynomial **, int, mps_batch_options *, mps_batch_result *) =
+    { mps_solve_continuation, mps_solve_sweep };
+  int a, f, i, j;
+
+  /* x^n + t x^7 - 1 for a few close values of t */
+  for (i = 0; i < CONTINUATION_STEPS; i++)
+    {
+      mps_monomial_poly *poly = mps_monomial_poly_new (ctx, CONTINUATION_DEGREE);
+
+      mps_monomial_poly_set_coefficient_d (ctx, poly, 0, -1, 0.0);
+      mps_monomial_poly_set_coefficient_d (ctx, poly, 7, 0.5 + 0.01 * i, 0.0);
+      mps_monomial_poly_set_coefficient_d (ctx, poly, CONTINUATION_DEGREE, 1, 0.0);
+
+      polys[i] = MPS_POLYNOMIAL (poly);
+    }
+
+  /* The sweep splits the steps among the threads, so it saves iterations
+   * only on the sections with more than one step. */
+  for (f = 0; f < 2; f++)
+    for (a = 0; a < 2; a++)
+      {
+        long int saved = 0;
+
+        mps_batch_options_init (&options);
+        options.algorithm = algorithms[a];
+
+        for (i = 0; i < CONTINUATION_STEPS; i++)
+          {
+            results[i].roots = NULL;
+            results[i].radii = NULL;
+          }
+
+        fail_unless ((*solvers[f]) (polys, CONTINUATION_STEPS, &options, results) == 0,
+                     "Some steps of the continuation could not be solved");
+
+        for (i = 0; i < CONTINUATION_STEPS; i++)
+          {
+            double t = 0.5 + 0.01 * i;
+
+            fail_unless (!results[i].error, "Error reported on step %d of the continuation", i);
+            fail_unless (results[i].iterations > 0, "No iterations reported on step %d", i);
+
+            for (j = 0; j < CONTINUATION_DEGREE; j++)
+              {
+                cplx_t z, v;
+
+                /* Evaluate the polynomial at the approximation */
+                cplx_pow_si (v, results[i].roots[j], CONTINUATION_DEGREE);
+                cplx_pow_si (z, results[i].roots[j], 7);
+                cplx_mul_eq_d (z, t);
+                cplx_add_eq (z, v);
+
+                fail_unless (hypot (cplx_Re (z) - 1.0, cplx_Im (z)) < 1e-12,
+                             "Wrong root computed at step %d of the continuation", i);
+              }
+
+            if (i > 0)
+              saved += results[i].iterations_saved;
+
+            cplx_vfree (results[i].roots);
+          }
+
+        if (solvers[f] == mps_solve_continuation)
+          fail_unless (saved > 0, "Starting from the previous roots did not save any iteration");
+
+        /* The next solver has to allocate its workers again */
+        mps_batch_release ();
+      }
+
+  for (i = 0; i < CONTINUATION_STEPS; i++)
+    mps_monomial_poly_free (ctx, polys[i]);
+
+  mps_context_free (ctx);
+}
+END_TEST
+
+#define FMM_DEGREE 400
+
+START_TEST (basics_aberth_fmm)
+{
+  mps_context * ctx = mps_context_new ();
+  mps_monomial_poly * poly = mps_monomial_poly_new (ctx, FMM_DEGREE);
+  cplx_t * roots = cplx_valloc (FMM_DEGREE);
+  double * radii = double_valloc (FMM_DEGREE);
+  int i;
+
+  mps_monomial_poly_set_coefficient_d (ctx, poly, 0, -1, 0.0);
+  mps_monomial_poly_set_coefficient_d (ctx, poly, FMM_DEGREE, 1, 0.0);
+
+  /* Use the tree for the Aberth sums also at this small degree */
+  mps_context_set_aberth_fmm (ctx, FMM_DEGREE / 4, 1e-10);
+  mps_context_set_jacobi_iterations (ctx, true);
+  mps_context_select_algorithm (ctx, MPS_ALGORITHM_SECULAR_GA);
+  mps_context_set_input_poly (ctx, MPS_POLYNOMIAL (poly));
+  mps_mpsolve (ctx);
+
+  fail_unless (!mps_context_has_errors (ctx), "Error while solving with the fast Aberth sums");
+
+  mps_context_get_roots_d (ctx, &roots, &radii);
+
+  for (i = 0; i < FMM_DEGREE; i++)
+    {
+      fail_unless (fabs (cplx_mod (roots[i]) - 1.0) < 1e-12,
+                   "Wrong root computed with the fast Aberth sums");
+      fail_unless (radii[i] < 1e-12,
+                   "Inclusion radius too large with the fast Aberth sums");
+    }
+
+  cplx_vfree (roots);
+  free (radii);
+  mps_monomial_poly_free (ctx, MPS_POLYNOMIAL (poly));
+  mps_context_free (ctx);
+}
+END_TEST
+
+#define SIMD_DEGREE 101
+
+START_TEST (basics_aberth_simd)
+{
+  const char * kernels[] = { "scalar", "avx2", "avx512" };
+  mps_context * ctx = mps_context_new ();
+  mps_monomial_poly * poly = mps_monomial_poly_new (ctx, SIMD_DEGREE);
+  mps_froot_array * froots;
+  cplx_t abcorr, ref, z;
+  double bound;
+  int i, j, k;
+
+  /* Solve once to have the approximations allocated in the context */
+  mps_monomial_poly_set_coefficient_d (ctx, poly, 0, -1, 0.0);
+  mps_monomial_poly_set_coefficient_d (ctx, poly, SIMD_DEGREE, 1, 0.0);
+  mps_context_set_input_poly (ctx, MPS_POLYNOMIAL (poly));
+  mps_context_set_output_goal (ctx, MPS_OUTPUT_GOAL_ISOLATE);
+  mps_mpsolve (ctx);
+
+  fail_unless (!mps_context_has_errors (ctx), "Error while solving x^n - 1");
+
+  /* Random approximations spread over a few orders of magnitude, and a
+   * tight cluster to exercise the scaling of the differences */
+  srand (1);
+  for (i = 0; i < SIMD_DEGREE; i++)
+    {
+      cplx_set_d (ctx->root[i]->fvalue,
+                  ldexp (2.0 * rand () / RAND_MAX - 1.0, rand () % 40 - 20),
+                  ldexp (2.0 * rand () / RAND_MAX - 1.0, rand () % 40 - 20));
+      if (i % 10 == 0)
+        cplx_set_d (ctx->root[i]->fvalue, 1.0 + 1e-9 * i, 1e-9 * i);
+    }
+
+  for (k = 0; k < 3; k++)
+    {
+      setenv ("MPS_SIMD", kernels[k], 1);
+      froots = mps_froot_array_new (ctx, SIMD_DEGREE);
+
+      /* Skip the instruction sets not supported by the CPU */
+      if (strcmp (froots->kernel_name, kernels[k]) != 0)
+        {
+          mps_froot_array_free (froots);
+          continue;
+        }
+
+      mps_froot_array_load (ctx, froots);
+
+      /* Start from odd positions as well, to check the unaligned heads */
+      for (j = 0; j < SIMD_DEGREE; j++)
+        {
+          mps_froot_array_aberth (froots, j, abcorr);
+          mps_faberth (ctx, ctx->root[j], ref);
+
+          bound = 0.0;
+          for (i = 0; i < SIMD_DEGREE; i++)
+            if (i != j)
+              {
+                cplx_sub (z, ctx->root[j]->fvalue, ctx->root[i]->fvalue);
+                bound += 1.0 / cplx_mod (z);
+              }
+
+          cplx_sub_eq (abcorr, ref);
+          fail_unless (cplx_mod (abcorr) <= 4 * SIMD_DEGREE * DBL_EPSILON * bound,
+                       "The SIMD Aberth sum differs from mps_faberth");
+        }
+
+      mps_froot_array_free (froots);
+    }
+
+  unsetenv ("MPS_SIMD");
+
+  mps_monomial_poly_free (ctx, MPS_POLYNOMIAL (poly));
+  mps_context_free (ctx);
+}
+END_TEST
+
+#define MULTIPOINT_DEGREE 200
+
+static mps_context *
+multipoint_solve (long int multipoint_degree)
+{
+  mps_context * ctx = mps_context_new ();
+  mps_monomial_poly * poly = mps_monomial_poly_new (ctx, MULTIPOINT_DEGREE);
+
+  /* Mignotte-like polynomial x^n - 2 (10x - 1)^2, that needs some
+   * regenerations in multiprecision to separate the two roots close
+   * to 1/10. */
+  mps_monomial_poly_set_coefficient_int (ctx, poly, 0, -2, 0);
+  mps_monomial_poly_set_coefficient_int (ctx, poly, 1, 40, 0);
+  mps_monomial_poly_set_coefficient_int (ctx, poly, 2, -200, 0);
+  mps_monomial_poly_set_coefficient_int (ctx, poly, MULTIPOINT_DEGREE, 1, 0);
+
+  mps_context_set_multipoint_regeneration (ctx, multipoint_degree);
+  mps_context_select_algorithm (ctx, MPS_ALGORITHM_SECULAR_GA);
+  mps_context_set_output_goal (ctx, MPS_OUTPUT_GOAL_APPROXIMATE);
+  mps_context_set_output_prec (ctx, 100);
+  mps_context_set_input_poly (ctx, MPS_POLYNOMIAL (poly));
+  mps_mpsolve (ctx);
+
+  return ctx;
+}
+
+START_TEST (basics_multipoint_regeneration)
+{
+  mps_context * ctx = multipoint_solve (0);
+  mps_context * fast_ctx = multipoint_solve (MULTIPOINT_DEGREE / 4);
+  mpc_t * roots = NULL, * fast_roots = NULL;
+  rdpe_t * radii = NULL, * fast_radii = NULL;
+  rdpe_t dist, min_dist, eps;
+  mpc_t diff;
+  int i, j;
+
+  fail_unless (!mps_context_has_errors (fast_ctx),
+               "Error while solving with the multipoint regeneration");
+
+  mps_context_get_roots_m (ctx, &roots, &radii);
+  mps_context_get_roots_m (fast_ctx, &fast_roots, &fast_radii);
+
+  rdpe_set_2dl (eps, 1.0, -90);
+  mpc_init2 (diff, 256);
+
+  for (i = 0; i < MULTIPOINT_DEGREE; i++)
+    {
+      rdpe_set (min_dist, RDPE_MAX);
+      for (j = 0; j < MULTIPOINT_DEGREE; j++)
+        {
+          mpc_sub (diff, fast_roots[i], roots[j]);
+          mpc_rmod (dist, diff);
+          if (rdpe_lt (dist, min_dist))
+            rdpe_set (min_dist, dist);
+        }
+
+      fail_unless (rdpe_lt (min_dist, eps),
+                   "Wrong root computed with the multipoint regeneration");
+    }
+
+  mpc_clear (diff);
+  mpc_vclear (roots, MULTIPOINT_DEGREE);
+  mpc_vclear (fast_roots, MULTIPOINT_DEGREE);
+  free (roots);
+  free (fast_roots);
+  free (radii);
+  free (fast_radii);
+
+  mps_context_free (ctx);
+  mps_context_free (fast_ctx);
+}
+END_TEST
+
+#define CONJUGATE_DEGREE 61
+
+static long int
+conjugate_solve (mps_algorithm algorithm, mps_boolean jacobi_iterations,
+                 mps_boolean symmetry, long int prec)
+{
+  mps_context * ctx = mps_context_new ();
+  mps_monomial_poly * poly = mps_monomial_poly_new (ctx, CONJUGATE_DEGREE);
+  cplx_t * roots = cplx_valloc (CONJUGATE_DEGREE);
+  double * radii = double_valloc (CONJUGATE_DEGREE);
+  double dist, min_dist;
+  long int corrections;
+  int i, j;
+
+  /* x^n + x + 1 has real coefficients and an odd degree, so there is a
+   * real root together with the conjugate pairs. */
+  mps_monomial_poly_set_coefficient_int (ctx, poly, 0, 1, 0);
+  mps_monomial_poly_set_coefficient_int (ctx, poly, 1, 1, 0);
+  mps_monomial_poly_set_coefficient_int (ctx, poly, CONJUGATE_DEGREE, 1, 0);
+
+  mps_context_set_conjugate_symmetry (ctx, symmetry);
+  mps_context_set_jacobi_iterations (ctx, jacobi_iterations);
+  mps_context_select_algorithm (ctx, algorithm);
+  mps_context_set_output_goal (ctx, MPS_OUTPUT_GOAL_APPROXIMATE);
+  mps_context_set_output_prec (ctx, prec);
+  mps_context_set_input_poly (ctx, MPS_POLYNOMIAL (poly));
+  mps_mpsolve (ctx);
+
+  fail_unless (!mps_context_has_errors (ctx), "Error while solving on conjugate pairs");
+
+  corrections = mps_context_get_newton_corrections (ctx);
+
+  mps_context_get_roots_d (ctx, &roots, &radii);
+
+  for (i = 0; i < CONJUGATE_DEGREE; i++)
+    {
+      cplx_t value;
+      double re = cplx_Re (roots[i]), im = cplx_Im (roots[i]);
+
+      /* The residual of z^n + z + 1, where |z| is close to 1 */
+      cplx_pow_si (value, roots[i], CONJUGATE_DEGREE);
+      cplx_add_eq (value, roots[i]);
+      cplx_Re (value) += 1.0;
+      fail_unless (cplx_mod (value) < 1e-12,
+                   "Wrong root computed on conjugate pairs");
+
+      /* Every root must have its conjugate among the others */
+      min_dist = DBL_MAX;
+      for (j = 0; j < CONJUGATE_DEGREE; j++)
+        {
+          dist = hypot (cplx_Re (roots[j]) - re, cplx_Im (roots[j]) + im);
+          if (dist < min_dist)
+            min_dist = dist;
+        }
+
+      fail_unless (min_dist < 1e-12,
+                   "Roots computed on conjugate pairs are not symmetric");
+    }
+
+  cplx_vfree (roots);
+  free (radii);
+  mps_monomial_poly_free (ctx, MPS_POLYNOMIAL (poly));
+  mps_context_free (ctx);
+
+  return corrections;
+}
+
+static void
+conjugate_check (mps_algorithm algorithm, mps_boolean jacobi_iterations, long int prec)
+{
+  long int paired = conjugate_solve (algorithm, jacobi_iterations, true, prec);
+  long int unpaired = conjugate_solve (algorithm, jacobi_iterations, false, prec);
+
+  /* Only one approximation of every pair is iterated, so the Newton
+   * corrections must be close to half of the ones of the plain run. */
+  fail_unless (4 * paired < 3 * unpaired,
+               "The iterations on conjugate pairs have not been used (%ld Newton corrections, %ld without them)",
+               paired, unpaired);
+}
+
+#define LAGUERRE_DEGREE 80
+
+/*
+ * Solve the Laguerre polynomial of degree LAGUERRE_DEGREE, whose roots are
+ * all real and positive, and check that none of them is lost in a pair of
+ * conjugate approximations.
+ */
+static void
+conjugate_real_solve (mps_algorithm algorithm, mps_boolean jacobi_iterations)
+{
+  mps_context * ctx = mps_context_new ();
+  mps_monomial_poly * poly = mps_monomial_poly_new (ctx, LAGUERRE_DEGREE);
+  cplx_t * roots = cplx_valloc (LAGUERRE_DEGREE);
+  double * radii = double_valloc (LAGUERRE_DEGREE);
+  mpq_t c, zero;
+  int i;
+
+  mpq_init (c);
+  mpq_init (zero);
+
+  /* L_n(x) = sum_k (-1)^k binomial(n, k) x^k / k! */
+  for (i = 0; i <= LAGUERRE_DEGREE; i++)
+    {
+      mpz_bin_uiui (mpq_numref (c), LAGUERRE_DEGREE, i);
+      mpz_fac_ui (mpq_denref (c), i);
+      if (i % 2)
+        mpz_neg (mpq_numref (c), mpq_numref (c));
+      mpq_canonicalize (c);
+      mps_monomial_poly_set_coefficient_q (ctx, poly, i, c, zero);
+    }
+
+  mps_context_set_conjugate_symmetry (ctx, true);
+  mps_context_set_jacobi_iterations (ctx, jacobi_iterations);
+  mps_context_select_algorithm (ctx, algorithm);
+  mps_context_set_output_goal (ctx, MPS_OUTPUT_GOAL_APPROXIMATE);
+  mps_context_set_output_prec (ctx, 53);
+  mps_context_set_input_poly (ctx, MPS_POLYNOMIAL (poly));
+  mps_mpsolve (ctx);
+
+  fail_unless (!mps_context_has_errors (ctx), "Error while solving a real rooted polynomial on conjugate pairs");
+
+  mps_context_get_roots_d (ctx, &roots, &radii);
+
+  for (i = 0; i < LAGUERRE_DEGREE; i++)
+    fail_unless (fabs (cplx_Im (roots[i])) <= radii[i] && cplx_Re (roots[i]) > 0,
+                 "Root %d of the Laguerre polynomial is not real and positive", i);
+
+  mpq_clear (zero);
+  mpq_clear (c);
+  cplx_vfree (roots);
+  free (radii);
+  mps_monomial_poly_free (ctx, MPS_POLYNOMIAL (poly));
+  mps_context_free (ctx);
+}
+
+START_TEST (basics_conjugate_symmetry)
+{
+  conjugate_check (MPS_ALGORITHM_STANDARD_MPSOLVE, false, 53);
+  conjugate_check (MPS_ALGORITHM_STANDARD_MPSOLVE, true, 53);
+  conjugate_check (MPS_ALGORITHM_SECULAR_GA, false, 53);
+  conjugate_check (MPS_ALGORITHM_SECULAR_GA, true, 53);
+
+  /* The symmetry is also used in the multiprecision phase */
+  conjugate_check (MPS_ALGORITHM_STANDARD_MPSOLVE, false, 1024);
+  conjugate_check (MPS_ALGORITHM_SECULAR_GA, false, 1024);
+  conjugate_check (MPS_ALGORITHM_SECULAR_GA, true, 1024);
+
+  /* Pairs that close in on real roots must be split also in the DPE and
+   * multiprecision phases */
+  conjugate_real_solve (MPS_ALGORITHM_STANDARD_MPSOLVE, false);
+  conjugate_real_solve (MPS_ALGORITHM_STANDARD_MPSOLVE, true);
+  conjugate_real_solve (MPS_ALGORITHM_SECULAR_GA, false);
+  conjugate_real_solve (MPS_ALGORITHM_SECULAR_GA, true);
+}
+END_TEST
+
+#define REGION_DEGREE 61
+
+/*
+ * Solve x^n + x + 1 looking only for the roots in the union of a disk and
+ * a rectangle, and check that only these are refined to the output precision.
+ */
+static void
+region_solve (mps_algorithm algorithm)
+{
+  mps_context * ctx = mps_context_new ();
+  mps_monomial_poly * poly = mps_monomial_poly_new (ctx, REGION_DEGREE);
+  cplx_t * roots = cplx_valloc (REGION_DEGREE);
+  double * radii = double_valloc (REGION_DEGREE);
+  double re, im, dist;
+  int i, in_roots = 0, out_roots = 0;
+
+  mps_monomial_poly_set_coefficient_int (ctx, poly, 0, 1, 0);
+  mps_monomial_poly_set_coefficient_int (ctx, poly, 1, 1, 0);
+  mps_monomial_poly_set_coefficient_int (ctx, poly, REGION_DEGREE, 1, 0);
+
+  mps_context_add_search_disk (ctx, -1.0, 0.0, 0.3);
+  mps_context_add_search_rectangle (ctx, 0.5, 0.5, 1.5, 1.5);
+  mps_context_select_algorithm (ctx, algorithm);
+  mps_context_set_output_goal (ctx, MPS_OUTPUT_GOAL_APPROXIMATE);
+  mps_context_set_output_prec (ctx, 1024);
+  mps_context_set_input_poly (ctx, MPS_POLYNOMIAL (poly));
+  mps_mpsolve (ctx);
+
+  fail_unless (!mps_context_has_errors (ctx), "Error while solving in a search region");
+
+  mps_context_get_roots_d (ctx, &roots, &radii);
+
+  for (i = 0; i < REGION_DEGREE; i++)
+    {
+      re = cplx_Re (roots[i]);
+      im = cplx_Im (roots[i]);
+
+      /* Signed distance from the boundary of the region, negative inside */
+      dist = MIN (hypot (re + 1.0, im) - 0.3,
+                  MAX (MAX (0.5 - re, re - 1.5), MAX (0.5 - im, im - 1.5)));
+
+      if (dist < -1e-6)
+        {
+          fail_unless (radii[i] < 1e-250,
+                       "A root in the search region has not been refined");
+          in_roots++;
+        }
+      else if (dist > 1e-6)
+        {
+          fail_unless (radii[i] > 1e-100,
+                       "A root out of the search region has been refined");
+          out_roots++;
+        }
+    }
+
+  fail_unless (in_roots > 0 && out_roots > 0,
+               "The search region does not split the roots");
+
+  cplx_vfree (roots);
+  free (radii);
+  mps_monomial_poly_free (ctx, MPS_POLYNOMIAL (poly));
+  mps_context_free (ctx);
+}
+
+START_TEST (basics_search_region)
+{
+  region_solve (MPS_ALGORITHM_STANDARD_MPSOLVE);
+  region_solve (MPS_ALGORITHM_SECULAR_GA);
+}
+END_TEST
+
+#define BUDGET_DEGREE 61
+
+static double
+budget_clock (void)
+{
+  struct timespec now;
+
+  clock_gettime (CLOCK_MONOTONIC, &now);
+
+  return now.tv_sec + 1e-9 * now.tv_nsec;
+}
+
+/* Solve x^n + x + 1 with the given budgets, and return the time spent */
+static double
+budget_solve (mps_algorithm algorithm, long int output_prec,
+              long int precision_budget, double time_budget)
+{
+  mps_context * ctx = mps_context_new ();
+  mps_monomial_poly * poly = mps_monomial_poly_new (ctx, BUDGET_DEGREE);
+  cplx_t * roots = cplx_valloc (BUDGET_DEGREE);
+  double * radii = double_valloc (BUDGET_DEGREE);
+  double elapsed;
+  int i, accurate = 0;
+
+  mps_monomial_poly_set_coefficient_int (ctx, poly, 0, 1, 0);
+  mps_monomial_poly_set_coefficient_int (ctx, poly, 1, 1, 0);
+  mps_monomial_poly_set_coefficient_int (ctx, poly, BUDGET_DEGREE, 1, 0);
+
+  mps_context_select_algorithm (ctx, algorithm);
+  mps_context_set_output_goal (ctx, MPS_OUTPUT_GOAL_APPROXIMATE);
+  mps_context_set_output_prec (ctx, output_prec);
+  mps_context_set_precision_budget (ctx, precision_budget);
+  mps_context_set_time_budget (ctx, time_budget);
+  mps_context_set_input_poly (ctx, MPS_POLYNOMIAL (poly));
+
+  elapsed = budget_clock ();
+  mps_mpsolve (ctx);
+  elapsed = budget_clock () - elapsed;
+
+  fail_unless (!mps_context_has_errors (ctx), "Error while solving with a budget");
+
+  mps_context_get_roots_d (ctx, &roots, &radii);
+
+  for (i = 0; i < BUDGET_DEGREE; i++)
+    {
+      fail_unless (isfinite (cplx_Re (roots[i])) && isfinite (cplx_Im (roots[i])) &&
+                   radii[i] < 1.0, "The budget has left an invalid approximation");
+      fail_unless (mps_context_get_root_status (ctx, i) == MPS_ROOT_STATUS_ISOLATED ||
+                   MPS_ROOT_STATUS_IS_APPROXIMATED (mps_context_get_root_status (ctx, i)),
+                   "The budget has stopped the computation before isolating the roots");
+
+      if (mps_context_get_root_accurate (ctx, i))
+        accurate++;
+    }
+
+  if (precision_budget > 0 || time_budget > 0)
+    {
+      fail_unless (mps_context_get_budget_exhausted (ctx),
+                   "The budget has not been reported as exhausted");
+      fail_unless (accurate < BUDGET_DEGREE,
+                   "The roots have been refined over the precision budget");
+    }
+  else
+    {
+      fail_unless (!mps_context_get_budget_exhausted (ctx),
+                   "The budget has been reported as exhausted without a budget");
+      fail_unless (accurate == BUDGET_DEGREE,
+                   "Some roots have not reached the output precision");
+    }
+
+  cplx_vfree (roots);
+  free (radii);
+  mps_monomial_poly_free (ctx, MPS_POLYNOMIAL (poly));
+  mps_context_free (ctx);
+
+  return elapsed;
+}
+
+START_TEST (basics_budget)
+{
+  mps_algorithm algorithms[] = { MPS_ALGORITHM_STANDARD_MPSOLVE, MPS_ALGORITHM_SECULAR_GA };
+  double elapsed;
+  int a;
+
+  for (a = 0; a < 2; a++)
+    {
+      budget_solve (algorithms[a], 1024, 0, 0);
+      budget_solve (algorithms[a], 1024, 128, 0);
+
+      /* A time budget that is over before the first packet, and one that
+       * is over during the multiprecision iterations */
+      elapsed = budget_solve (algorithms[a], 8192, 0, 0);
+      budget_solve (algorithms[a], 8192, 0, 1e-6);
+      budget_solve (algorithms[a], 8192, 0, elapsed / 4);
+    }
+}
+END_TEST
+
 int
 main (void)
 {
@@ -99,6 +808,15 @@ main (void)
   tcase_add_test (tc_basics, basics_context_reuse_without_free);
   tcase_add_test (tc_basics, basics_context_reuse_expand);
   tcase_add_test (tc_basics, basics_context_reuse_shrink);
+  tcase_add_test (tc_basics, basics_shared_thread_pool);
+  tcase_add_test (tc_basics, basics_solve_batch);
+  tcase_add_test (tc_basics, basics_solve_continuation);
+  tcase_add_test (tc_basics, basics_aberth_fmm);
+  tcase_add_test (tc_basics, basics_aberth_simd);
+  tcase_add_test (tc_basics, basics_multipoint_regeneration);
+  tcase_add_test (tc_basics, basics_conjugate_symmetry);
+  tcase_add_test (tc_basics, basics_search_region);
+  tcase_add_test (tc_basics, basics_budget);
 
   suite_add_tcase (s, tc_basics);
 
@@ -242,6 +242,198 @@ START_TEST (rational_matrix_creation)
 }
 END_TEST
 
+/* Build the matrix polynomial S diag((x - a_i)(x - b_i)) S^T, whose eigenvalues
+ * are the a_i and the b_i, and whose leading coefficient S S^T is not the identity. */
+static mps_monomial_matrix_poly *
+matrix_poly_example1 (mps_context * ctx, const double * a, const double * b)
+{
+  const int m = 3;
+  const double S[9] = { 1.0, 0.0, 0.0, 0.5, 1.0, 0.0, 0.25, 0.5, 1.0 };
+  mps_monomial_matrix_poly *mp = mps_monomial_matrix_poly_new (ctx, 2, m, false);
+  cplx_t P[9];
+  double c[3];
+  int i, j, k, l;
+
+  for (k = 0; k <= 2; k++)
+    {
+      for (i = 0; i < m; i++)
+        for (j = 0; j < m; j++)
+          {
+            double v = 0.0;
+
+            for (l = 0; l < m; l++)
+              {
+                c[0] = a[l] * b[l];
+                c[1] = -a[l] - b[l];
+                c[2] = 1.0;
+                v += S[i * m + l] * c[k] * S[j * m + l];
+              }
+
+            cplx_set_d (P[i * m + j], v, 0.0);
+          }
+
+      mps_monomial_matrix_poly_set_coefficient_d (ctx, mp, k, P);
+    }
+
+  return mp;
+}
+
+START_TEST (matrix_poly_evaluation)
+{
+  const double a[3] = { 1.0, 2.0, 3.0 }, b[3] = { -1.0, 0.5, -2.0 };
+  mps_context *ctx = mps_context_new ();
+  mps_monomial_matrix_poly *mp = matrix_poly_example1 (ctx, a, b);
+  mps_polynomial *p = MPS_POLYNOMIAL (mp);
+  cplx_t x, fvalue, expected, t;
+  cdpe_t dx, dvalue, ctmp;
+  mpc_t mx, mvalue;
+  rdpe_t derror, merror, diff, mod;
+  double ferror;
+  int i;
+
+  mps_context_set_input_poly (ctx, p);
+
+  /* The normalized determinant is prod (x - a_i) (x - b_i) */
+  cplx_set_d (x, 0.3, 0.8);
+  cplx_set_d (expected, 1.0, 0.0);
+  for (i = 0; i < 3; i++)
+    {
+      cplx_set_d (t, cplx_Re (x) - a[i], cplx_Im (x));
+      cplx_mul_eq (expected, t);
+      cplx_set_d (t, cplx_Re (x) - b[i], cplx_Im (x));
+      cplx_mul_eq (expected, t);
+    }
+
+  fail_unless (mps_polynomial_feval (ctx, p, x, fvalue, &ferror),
+               "Floating point evaluation of the matrix polynomial failed");
+  cplx_sub (t, fvalue, expected);
+  fail_unless (cplx_mod (t) < 1e3 * DBL_EPSILON * cplx_mod (expected),
+               "The floating point evaluation of the matrix polynomial is not accurate");
+
+  cdpe_set_x (dx, x);
+  mps_polynomial_deval (ctx, p, dx, dvalue, derror);
+  cdpe_set_x (ctmp, expected);
+  cdpe_sub_eq (ctmp, dvalue);
+  cdpe_mod (diff, ctmp);
+  rdpe_set_d (mod, 1e3 * DBL_EPSILON * cplx_mod (expected));
+  fail_unless (rdpe_lt (diff, mod),
+               "The DPE evaluation of the matrix polynomial is not accurate");
+
+  mpc_init2 (mx, 256);
+  mpc_init2 (mvalue, 256);
+  mpc_set_cplx (mx, x);
+  mps_polynomial_meval (ctx, p, mx, mvalue, merror);
+  mpc_get_cdpe (ctmp, mvalue);
+  cdpe_set_x (dvalue, expected);
+  cdpe_sub_eq (ctmp, dvalue);
+  cdpe_mod (diff, ctmp);
+  fail_unless (rdpe_lt (diff, mod),
+               "The multiprecision evaluation of the matrix polynomial is not accurate");
+
+  mpc_clear (mx);
+  mpc_clear (mvalue);
+  mps_monomial_matrix_poly_free (ctx, p);
+  mps_context_free (ctx);
+}
+END_TEST
+
+START_TEST (matrix_poly_singular)
+{
+  const double a[3] = { 1.0, 2.0, 3.0 }, b[3] = { -1.0, 0.5, -2.0 };
+  mps_context *ctx = mps_context_new ();
+  mps_monomial_matrix_poly *mp = matrix_poly_example1 (ctx, a, b);
+  mps_polynomial *p = MPS_POLYNOMIAL (mp);
+  cplx_t P[9], x, fvalue;
+  cdpe_t dx, dvalue;
+  mpc_t mx, mvalue;
+  rdpe_t derror, merror;
+  double ferror;
+  int i;
+
+  /* Make the leading coefficient singular */
+  for (i = 0; i < 9; i++)
+    cplx_set (P[i], cplx_zero);
+  mps_monomial_matrix_poly_set_coefficient_d (ctx, mp, 2, P);
+  mps_context_set_input_poly (ctx, p);
+
+  cplx_set_d (x, 0.3, 0.8);
+  cdpe_set_x (dx, x);
+  mpc_init2 (mx, 256);
+  mpc_init2 (mvalue, 256);
+  mpc_set_cplx (mx, x);
+
+  /* The evaluations must be defined in every precision, and must not
+   * try again to compute the Hessenberg form. */
+  mps_polynomial_feval (ctx, p, x, fvalue, &ferror);
+  fail_unless (mps_context_has_errors (ctx),
+               "A singular leading coefficient has not been reported");
+  fail_unless (mp->singular && mp->prec > 0,
+               "The matrix polynomial has not been marked as singular");
+
+  mps_polynomial_deval (ctx, p, dx, dvalue, derror);
+  mps_polynomial_meval (ctx, p, mx, mvalue, merror);
+  fail_unless (mps_polynomial_raise_data (ctx, p, 1024) == mp->prec,
+               "The Hessenberg form of a singular polynomial has been computed again");
+  fail_unless (isfinite (cplx_Re (fvalue)) && isfinite (cplx_Im (fvalue)),
+               "The evaluation of a singular matrix polynomial is not defined");
+
+  /* Changing the coefficient allows to compute it again */
+  for (i = 0; i < 9; i++)
+    cplx_set_d (P[i], (i % 4 == 0) ? 1.0 : 0.0, 0.0);
+  mps_monomial_matrix_poly_set_coefficient_d (ctx, mp, 2, P);
+  mps_polynomial_feval (ctx, p, x, fvalue, &ferror);
+  fail_unless (!mp->singular && mp->prec > 0,
+               "The Hessenberg form has not been computed after fixing the coefficient");
+
+  mpc_clear (mx);
+  mpc_clear (mvalue);
+  mps_monomial_matrix_poly_free (ctx, p);
+  mps_context_free (ctx);
+}
+END_TEST
+
+START_TEST (matrix_poly_solve)
+{
+  const double a[3] = { 1.0, 2.0, 3.0 }, b[3] = { -1.0, 0.5, -2.0 };
+  mps_algorithm algorithms[2] = { MPS_ALGORITHM_SECULAR_GA, MPS_ALGORITHM_STANDARD_MPSOLVE };
+  int i, j, k;
+
+  for (k = 0; k < 2; k++)
+    {
+      mps_context *ctx = mps_context_new ();
+      mps_monomial_matrix_poly *mp = matrix_poly_example1 (ctx, a, b);
+      cplx_t *roots = NULL;
+      double *radii = NULL;
+
+      mps_context_set_input_poly (ctx, MPS_POLYNOMIAL (mp));
+      mps_context_select_algorithm (ctx, algorithms[k]);
+      mps_mpsolve (ctx);
+
+      fail_unless (!mps_context_has_errors (ctx),
+                   "Solving the matrix polynomial failed");
+
+      mps_context_get_roots_d (ctx, &roots, &radii);
+
+      for (i = 0; i < 6; i++)
+        {
+          double expected = (i < 3) ? a[i] : b[i - 3];
+          double epsilon = DBL_MAX;
+
+          for (j = 0; j < 6; j++)
+            epsilon = MIN (epsilon, hypot (cplx_Re (roots[j]) - expected, cplx_Im (roots[j])));
+
+          fail_unless (epsilon < 1e-12,
+                       "Eigenvalue %f of the matrix polynomial not found", expected);
+        }
+
+      free (roots);
+      free (radii);
+      mps_monomial_matrix_poly_free (ctx, MPS_POLYNOMIAL (mp));
+      mps_context_free (ctx);
+    }
+}
+END_TEST
+
 int
 main (void)
 {
@@ -263,6 +455,11 @@ main (void)
   tcase_add_test (tc_determinant, determinant_mhessenberg_example1);
   tcase_add_test (tc_determinant, determinant_shifted_mhessenberg_example1);
 
+  // Evaluation and solution of matrix polynomials
+  tcase_add_test (tc_determinant, matrix_poly_evaluation);
+  tcase_add_test (tc_determinant, matrix_poly_solve);
+  tcase_add_test (tc_determinant, matrix_poly_singular);
+
   suite_add_tcase (s, tc_basics);
   suite_add_tcase (s, tc_determinant);
 
@@ -75,6 +75,386 @@ START_TEST (set_coefficient_s2)
 }
 END_TEST
 
+START_TEST (ddeval1)
+{
+  int i, n = 10;
+  mps_context * ctx = mps_context_new ();
+  mps_monomial_poly * poly = mps_monomial_poly_new (ctx, n);
+  const char * coeffs[] = { "-7", "3", "1/3", "0", "11", "-5/7", "2", "1", "-13", "4", "1/9" };
+  mpc_t mx, mvalue, mdd;
+  cdd_t x, value;
+  cdpe_t cdiff;
+  rdpe_t merror, diff, mod;
+  double error;
+
+  for (i = 0; i <= n; i++)
+    mps_monomial_poly_set_coefficient_s (ctx, poly, i, coeffs[i], "1/5");
+
+  mps_context_set_input_poly (ctx, MPS_POLYNOMIAL (poly));
+  mps_polynomial_raise_data (ctx, MPS_POLYNOMIAL (poly), 256);
+  mps_monomial_poly_update_dd_coefficients (ctx, poly);
+
+  fail_unless (poly->ddpc_valid, "Failed to convert the coefficients to double-double");
+
+  mpc_init2 (mx, 256);
+  mpc_init2 (mvalue, 256);
+  mpc_init2 (mdd, 256);
+
+  cdd_set_d (x, 0.3, -0.7);
+  mpc_set_cdd (mx, x);
+
+  fail_unless (mps_polynomial_ddeval (ctx, MPS_POLYNOMIAL (poly), x, value, &error),
+               "Failed to evaluate the polynomial in double-double");
+  mps_polynomial_meval (ctx, MPS_POLYNOMIAL (poly), mx, mvalue, merror);
+
+  /* The double-double evaluation must be much more accurate than
+   * a floating point one, and agree with its own error bound. */
+  mpc_set_cdd (mdd, value);
+  mpc_sub (mdd, mdd, mvalue);
+  mpc_get_cdpe (cdiff, mdd);
+  cdpe_mod (diff, cdiff);
+  mpc_get_cdpe (cdiff, mvalue);
+  cdpe_mod (mod, cdiff);
+  rdpe_mul_eq_d (mod, ldexp (1.0, -90));
+
+  fail_unless (rdpe_le (diff, mod),
+               "The double-double evaluation is not accurate enough");
+
+  rdpe_set_d (mod, error);
+  rdpe_add_eq (mod, merror);
+  fail_unless (rdpe_le (diff, mod),
+               "The error bound of the double-double evaluation is not satisfied");
+
+  mpc_clear (mx);
+  mpc_clear (mvalue);
+  mpc_clear (mdd);
+  mps_monomial_poly_free (ctx, MPS_POLYNOMIAL (poly));
+  mps_context_free (ctx);
+}
+END_TEST
+
+START_TEST (compensated1)
+{
+  int i, n = 10;
+  mps_context * ctx = mps_context_new ();
+  mps_monomial_poly * poly = mps_monomial_poly_new (ctx, n);
+  double binomial = 1.0, error;
+  mpc_t mx, mvalue, mf;
+  cplx_t x, value;
+  cdpe_t dx, dvalue, cdiff;
+  rdpe_t merror, derror, diff, mod;
+
+  /* Coefficients of (x - 1)^10, which are exact in floating point */
+  for (i = 0; i <= n; i++)
+    {
+      mps_monomial_poly_set_coefficient_d (ctx, poly, i, ((n - i) % 2) ? -binomial : binomial, 0.0);
+      binomial = binomial * (n - i) / (i + 1);
+    }
+
+  mps_context_set_input_poly (ctx, MPS_POLYNOMIAL (poly));
+  mps_polynomial_raise_data (ctx, MPS_POLYNOMIAL (poly), 256);
+  poly->dpc_exact = true;
+
+  mpc_init2 (mx, 256);
+  mpc_init2 (mvalue, 256);
+  mpc_init2 (mf, 256);
+
+  /* A point close to the multiple root, where the plain Horner scheme
+   * gives no correct digits. */
+  cplx_set_d (x, 1.0 + ldexp (1.0, -6), ldexp (1.0, -7));
+  mpc_set_cplx (mx, x);
+  mps_polynomial_meval (ctx, MPS_POLYNOMIAL (poly), mx, mvalue, merror);
+
+  mps_fhorner_compensated (ctx, poly, x, false, value, &error);
+
+  mpc_set_cplx (mf, value);
+  mpc_sub (mf, mf, mvalue);
+  mpc_get_cdpe (cdiff, mf);
+  cdpe_mod (diff, cdiff);
+
+  rdpe_set_d (mod, error);
+  rdpe_add_eq (mod, merror);
+  fail_unless (rdpe_le (diff, mod),
+               "The error bound of the compensated Horner scheme is not satisfied");
+  fail_unless (error < ldexp (cplx_mod (value), -20),
+               "The compensated Horner scheme is not accurate enough");
+
+  /* Same test for the DPE version */
+  mpc_get_cdpe (dx, mx);
+  mps_dhorner_compensated (ctx, poly, dx, dvalue, derror);
+
+  mpc_set_cdpe (mf, dvalue);
+  mpc_sub (mf, mf, mvalue);
+  mpc_get_cdpe (cdiff, mf);
+  cdpe_mod (diff, cdiff);
+
+  rdpe_add (mod, derror, merror);
+  fail_unless (rdpe_le (diff, mod),
+               "The error bound of the DPE compensated Horner scheme is not satisfied");
+
+  cdpe_mod (mod, dvalue);
+  rdpe_mul_eq_d (mod, ldexp (1.0, -20));
+  fail_unless (rdpe_lt (derror, mod),
+               "The DPE compensated Horner scheme is not accurate enough");
+
+  mpc_clear (mx);
+  mpc_clear (mvalue);
+  mpc_clear (mf);
+  mps_monomial_poly_free (ctx, MPS_POLYNOMIAL (poly));
+  mps_context_free (ctx);
+}
+END_TEST
+
+START_TEST (sparse_eval1)
+{
+  int i, n = 300;
+  int exponents[] = { 300, 0, 121, 7, 122 };
+  double coeffs[][2] = { { 1.0, 0.0 }, { -2.0, 1.0 }, { 0.5, 0.0 }, { 3.0, -1.0 }, { 0.0, 0.25 } };
+  mps_context * ctx = mps_context_new ();
+  mps_sparse_monomial_poly * sp = mps_sparse_monomial_poly_new (ctx, n);
+  mpc_t mx, mvalue, mder, svalue, c, t;
+  cplx_t x, value, corr;
+  cdpe_t dx, dvalue, cdiff;
+  rdpe_t error, serror, diff;
+  double ferror;
+  mps_approximation * root = mps_approximation_new (ctx);
+
+  mpc_init2 (mx, 256);
+  mpc_init2 (mvalue, 256);
+  mpc_init2 (mder, 256);
+  mpc_init2 (svalue, 256);
+  mpc_init2 (c, 256);
+  mpc_init2 (t, 256);
+
+  cplx_set_d (x, 0.3, 1.001);
+  mpc_set_cplx (mx, x);
+  mpc_get_cdpe (dx, mx);
+
+  /* The terms are set in random order, and one of them twice. The value
+   * of the polynomial and of its derivative are computed term by term. */
+  mpc_set_ui (mvalue, 0U, 0U);
+  mpc_set_ui (mder, 0U, 0U);
+  mps_sparse_monomial_poly_set_coefficient_d (ctx, sp, 121, 7.0, 7.0);
+  for (i = 0; i < 5; i++)
+    {
+      mps_sparse_monomial_poly_set_coefficient_d (ctx, sp, exponents[i], coeffs[i][0], coeffs[i][1]);
+
+      mpc_set_d (c, coeffs[i][0], coeffs[i][1]);
+      mpc_pow_si (t, mx, exponents[i]);
+      mpc_mul (t, t, c);
+      mpc_add (mvalue, mvalue, t);
+
+      if (exponents[i] > 0)
+        {
+          mpc_pow_si (t, mx, exponents[i] - 1);
+          mpc_mul (t, t, c);
+          mpc_mul_ui (t, t, exponents[i]);
+          mpc_add (mder, mder, t);
+        }
+    }
+
+  fail_unless (sp->n_terms == 5, "The sparse polynomial should have 5 terms, not %d", sp->n_terms);
+  for (i = 1; i < sp->n_terms; i++)
+    fail_unless (sp->exponents[i - 1] < sp->exponents[i], "The terms are not sorted");
+
+  /* Multiprecision evaluation */
+  mps_polynomial_meval (ctx, MPS_POLYNOMIAL (sp), mx, svalue, error);
+  mpc_sub (svalue, svalue, mvalue);
+  mpc_get_cdpe (cdiff, svalue);
+  cdpe_mod (diff, cdiff);
+  fail_unless (rdpe_le (diff, error), "Multiprecision evaluation of the sparse polynomial is wrong");
+
+  /* Floating point evaluation */
+  mps_polynomial_feval (ctx, MPS_POLYNOMIAL (sp), x, value, &ferror);
+  mpc_set_cplx (svalue, value);
+  mpc_sub (svalue, svalue, mvalue);
+  mpc_get_cdpe (cdiff, svalue);
+  cdpe_mod (diff, cdiff);
+  rdpe_set_d (serror, ferror);
+  fail_unless (rdpe_le (diff, serror), "Floating point evaluation of the sparse polynomial is wrong");
+
+  /* DPE evaluation */
+  mps_polynomial_deval (ctx, MPS_POLYNOMIAL (sp), dx, dvalue, serror);
+  mpc_set_cdpe (svalue, dvalue);
+  mpc_sub (svalue, svalue, mvalue);
+  mpc_get_cdpe (cdiff, svalue);
+  cdpe_mod (diff, cdiff);
+  fail_unless (rdpe_le (diff, serror), "DPE evaluation of the sparse polynomial is wrong");
+
+  /* Newton corrections */
+  mpc_div (t, mvalue, mder);
+  mpc_get_cplx (value, t);
+
+  cplx_set (root->fvalue, x);
+  mps_polynomial_fnewton (ctx, MPS_POLYNOMIAL (sp), root, corr);
+  cplx_sub_eq (corr, value);
+  fail_unless (cplx_mod (corr) < 1e-10 * cplx_mod (value), "Floating point Newton correction is wrong");
+
+  cdpe_set (root->dvalue, dx);
+  mps_polynomial_dnewton (ctx, MPS_POLYNOMIAL (sp), root, dvalue);
+  mpc_set_cdpe (svalue, dvalue);
+  mpc_sub (svalue, svalue, t);
+  mpc_get_cdpe (cdiff, svalue);
+  cdpe_mod (diff, cdiff);
+  mpc_rmod (error, t);
+  rdpe_mul_eq_d (error, 1e-10);
+  fail_unless (rdpe_lt (diff, error), "DPE Newton correction is wrong");
+
+  mpc_set_prec (root->mvalue, 256);
+  mpc_set (root->mvalue, mx);
+  mps_polynomial_mnewton (ctx, MPS_POLYNOMIAL (sp), root, svalue, 256);
+  mpc_sub (svalue, svalue, t);
+  mpc_get_cdpe (cdiff, svalue);
+  cdpe_mod (diff, cdiff);
+  mpc_rmod (error, t);
+  rdpe_mul_eq_d (error, 1e-60);
+  fail_unless (rdpe_lt (diff, error), "Multiprecision Newton correction is wrong");
+
+  mpc_clear (mx);
+  mpc_clear (mvalue);
+  mpc_clear (mder);
+  mpc_clear (svalue);
+  mpc_clear (c);
+  mpc_clear (t);
+  mps_approximation_free (ctx, root);
+  mps_polynomial_free (ctx, MPS_POLYNOMIAL (sp));
+  mps_context_free (ctx);
+}
+END_TEST
+
+START_TEST (sparse_solve1)
+{
+  int i, j, n = 1003;
+  mps_algorithm algorithms[] = { MPS_ALGORITHM_STANDARD_MPSOLVE, MPS_ALGORITHM_SECULAR_GA };
+
+  for (j = 0; j < 2; j++)
+    {
+      mps_context * ctx = mps_context_new ();
+      mps_sparse_monomial_poly * sp = mps_sparse_monomial_poly_new (ctx, n);
+      cplx_t * roots = NULL, t;
+
+      /* x^3 (x^1000 - 2), whose non-zero roots have modulus 2^(1/1000) */
+      mps_sparse_monomial_poly_set_coefficient_int (ctx, sp, n, 1, 0);
+      mps_sparse_monomial_poly_set_coefficient_int (ctx, sp, 3, -2, 0);
+
+      mps_context_set_input_poly (ctx, MPS_POLYNOMIAL (sp));
+      mps_context_select_algorithm (ctx, algorithms[j]);
+      mps_context_set_output_prec (ctx, 53);
+      mps_context_set_output_goal (ctx, MPS_OUTPUT_GOAL_APPROXIMATE);
+      mps_mpsolve (ctx);
+
+      fail_unless (!mps_context_has_errors (ctx), "Errors while solving the sparse polynomial");
+      fail_unless (mps_context_get_degree (ctx) == n - 3, "Zero roots have not been deflated");
+      fail_unless (ctx->zero_roots == 3, "Found %d zero roots instead of 3", ctx->zero_roots);
+
+      mps_context_get_roots_d (ctx, &roots, NULL);
+      for (i = 0; i < n - 3; i++)
+        {
+          cplx_pow_si (t, roots[i], n - 3);
+          fail_unless (fabs (cplx_Re (t) - 2.0) < 1e-11 && fabs (cplx_Im (t)) < 1e-11,
+                       "Root %d of the sparse polynomial is not accurate", i);
+        }
+
+      cplx_vfree (roots);
+      mps_polynomial_free (ctx, MPS_POLYNOMIAL (sp));
+      mps_context_free (ctx);
+    }
+}
+END_TEST
+
+START_TEST (sparse_outside1)
+{
+  int n = 3000;
+  mps_context * ctx = mps_context_new ();
+  mps_sparse_monomial_poly * sp = mps_sparse_monomial_poly_new (ctx, n);
+  mps_approximation * root = mps_approximation_new (ctx);
+  cplx_t corr;
+  cdpe_t dcorr;
+  rdpe_t diff, error;
+  mpc_t mcorr, t;
+
+  /* 1e-200 x^3000 + x^2 + 1: the powers of x overflow the doubles
+   * on the outer roots, that have modulus 10^(200 / 2998) */
+  mps_sparse_monomial_poly_set_coefficient_d (ctx, sp, n, 1e-200, 0.0);
+  mps_sparse_monomial_poly_set_coefficient_d (ctx, sp, 2, 1.0, 0.0);
+  mps_sparse_monomial_poly_set_coefficient_d (ctx, sp, 0, 1.0, 0.0);
+
+  fail_unless (mps_sparse_monomial_poly_check_float_range (ctx, sp),
+               "The float phase should be used on 1e-200 x^3000 + x^2 + 1");
+
+  cplx_set_d (root->fvalue, 1.3, 0.2);
+  mps_polynomial_fnewton (ctx, MPS_POLYNOMIAL (sp), root, corr);
+  fail_unless (root->status != MPS_ROOT_STATUS_NOT_FLOAT && !cplx_check_fpe (corr),
+               "Floating point Newton correction overflows out of the unit disc");
+
+  cdpe_set_d (root->dvalue, 1.3, 0.2);
+  mps_polynomial_dnewton (ctx, MPS_POLYNOMIAL (sp), root, dcorr);
+
+  mpc_init2 (mcorr, 64);
+  mpc_init2 (t, 64);
+  mpc_set_cplx (mcorr, corr);
+  mpc_set_cdpe (t, dcorr);
+  mpc_sub (mcorr, mcorr, t);
+  mpc_rmod (diff, mcorr);
+  mpc_rmod (error, t);
+  rdpe_mul_eq_d (error, 1e-10);
+  fail_unless (rdpe_lt (diff, error), "Floating point Newton correction is wrong out of the unit disc");
+
+  /* With 1e-300 the terms that matter on the outer circle are not
+   * normalized doubles anymore */
+  mps_sparse_monomial_poly_set_coefficient_d (ctx, sp, n, 1e-300, 0.0);
+  fail_unless (!mps_sparse_monomial_poly_check_float_range (ctx, sp),
+               "The float phase should not be used on 1e-300 x^3000 + x^2 + 1");
+
+  mpc_clear (mcorr);
+  mpc_clear (t);
+  mps_approximation_free (ctx, root);
+  mps_polynomial_free (ctx, MPS_POLYNOMIAL (sp));
+  mps_context_free (ctx);
+}
+END_TEST
+
+START_TEST (lazy_allocation1)
+{
+  int i, n = 1000;
+  mps_context * ctx = mps_context_new ();
+  mps_monomial_poly * poly = mps_monomial_poly_new (ctx, n);
+  long int high_water;
+
+  for (i = 0; i <= n; i++)
+    mps_monomial_poly_set_coefficient_int (ctx, poly, i, i + 1, 0);
+
+  fail_unless (poly->db.mfpc2 == NULL && poly->fppc == NULL && poly->ddpc == NULL,
+               "Coefficients have been allocated before they were needed");
+
+  high_water = mps_context_get_memory_high_water (ctx);
+  fail_unless (high_water >= poly->memory_usage && poly->memory_usage > 0,
+               "The memory used by the coefficients has not been accounted");
+
+  /* Raising the precision allocates the second buffer with the new precision */
+  mps_monomial_poly_raise_precision (ctx, MPS_POLYNOMIAL (poly), 1024);
+  fail_unless (poly->db.mfpc2 != NULL && mpc_get_prec (poly->mfpc[0]) >= 1024,
+               "The precision of the coefficients has not been raised");
+  fail_unless (mps_context_get_memory_high_water (ctx) > high_water + n * 2 * 1024 / 8,
+               "The memory high-water does not account for the raised coefficients");
+
+  mps_monomial_poly_update_dd_coefficients (ctx, poly);
+  mps_monomial_poly_ensure_fppc (ctx, poly);
+  fail_unless (poly->ddpc != NULL && poly->ddpc_valid && poly->fppc != NULL,
+               "Coefficients have not been allocated when needed");
+
+  high_water = mps_context_get_memory_high_water (ctx);
+  mps_monomial_poly_free (ctx, MPS_POLYNOMIAL (poly));
+
+  fail_unless (ctx->memory_in_use.value == 0,
+               "%ld bytes are still accounted after freeing the polynomial",
+               ctx->memory_in_use.value);
+  fail_unless (mps_context_get_memory_high_water (ctx) == high_water,
+               "Freeing the polynomial changed the memory high-water");
+
+  mps_context_free (ctx);
+}
+END_TEST
 
 int
 main (void)
@@ -89,8 +469,17 @@ main (void)
   tcase_add_test (tc_coefficients, set_coefficient_d1);
   tcase_add_test (tc_coefficients, set_coefficient_s1);
   tcase_add_test (tc_coefficients, set_coefficient_s2);
+  tcase_add_test (tc_coefficients, lazy_allocation1);
+
+  TCase *tc_evaluation = tcase_create ("Evaluation");
+  tcase_add_test (tc_evaluation, ddeval1);
+  tcase_add_test (tc_evaluation, compensated1);
+  tcase_add_test (tc_evaluation, sparse_eval1);
+  tcase_add_test (tc_evaluation, sparse_solve1);
+  tcase_add_test (tc_evaluation, sparse_outside1);
 
   suite_add_tcase (s, tc_coefficients);
+  suite_add_tcase (s, tc_evaluation);
 
   SRunner *sr = srunner_create (s);
 
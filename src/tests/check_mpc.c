@@ -1,4 +1,5 @@
 #include <mps/mps.h>
+#include <mps/private/mpcn.h>
 #include <check.h>
 #include "check_implementation.h"
 
@@ -81,6 +82,220 @@ START_TEST (basics_multiplication)
 }
 END_TEST
 
+START_TEST (scratch_arena)
+{
+  mpc_scratch * sc = mpc_scratch_get ();
+  mpc_ptr a, b, c, t;
+  mpc_t x, y, z;
+  cplx_t d;
+
+  mpc_init2 (x, 200);
+  mpc_init2 (y, 200);
+  mpc_init2 (z, 200);
+
+  a = mpc_scratch_push (sc, 200);
+  b = mpc_scratch_push (sc, 200);
+  c = mpc_scratch_push (sc, 200);
+
+  fail_unless (mpc_get_prec (a) == mpc_get_prec (x),
+               "The temporaries of the scratch arena have the wrong precision");
+
+  /* The scratch variants must give the same results of the usual ones */
+  mpc_set_d (a, 1.0, 2.0);
+  mpc_set_d (b, -3.0, 0.5);
+  mpc_set (x, a);
+  mpc_set (y, b);
+
+  mpc_div_scratch (sc, c, a, b);
+  mpc_div (z, x, y);
+  mpc_sub (x, z, c);
+  mpc_get_cplx (d, x);
+
+  fail_unless (cplx_Re (d) == 0.0 && cplx_Im (d) == 0.0,
+               "The scratch variant of mpc_div does not agree with mpc_div");
+
+  /* Temporaries are reused in LIFO order, also with a different precision */
+  t = mpc_scratch_push (sc, 1000);
+  mpc_scratch_pop (sc, 1);
+  fail_unless (mpc_scratch_push (sc, 900) == t && mpc_get_prec (t) >= 900,
+               "The scratch arena did not reuse the last temporary");
+
+  mpc_scratch_pop (sc, 4);
+
+  mpc_clear (x);
+  mpc_clear (y);
+  mpc_clear (z);
+}
+END_TEST
+
+/* Check that the distance of a and b is at most 2^e times the modulus of b */
+static int
+mpc_close (mpc_t a, mpc_t b, long int e)
+{
+  mpc_t d;
+  rdpe_t ad, ab;
+  int result;
+
+  mpc_init2 (d, mpc_get_prec (b));
+  mpc_sub (d, a, b);
+  mpc_rmod (ad, d);
+  mpc_rmod (ab, b);
+  rdpe_mul_eq_d (ab, ldexp (1.0, e));
+  result = rdpe_le (ad, ab);
+  mpc_clear (d);
+
+  return result;
+}
+
+START_TEST (fixed_limbs)
+{
+  int k, n, limbs[] = { 2, 4, 8 };
+  long int prec = 1024;
+  mpc_t a, b, c, r, mr;
+  mps_mpcn_t na, nb, nc, nr;
+
+  mpc_init2 (a, prec);
+  mpc_init2 (b, prec);
+  mpc_init2 (c, prec);
+  mpc_init2 (r, prec);
+  mpc_init2 (mr, prec);
+
+  for (k = 0; k < 3; k++)
+    {
+      n = limbs[k];
+
+      /* Operands with many significant digits and different exponents */
+      mpc_set_d (a, 1.0, -3.0);
+      mpc_set_d (b, 7.0, 1.0);
+      mpc_div (a, a, b);
+      mpc_set_d (b, -1e5, 2.0);
+      mpc_div (b, a, b);
+      mpc_sqr (c, a);
+
+      mps_mpcn_set_mpc (n, na, a);
+      mps_mpcn_set_mpc (n, nb, b);
+      mps_mpcn_set_mpc (n, nc, c);
+
+      /* Round trip */
+      mps_mpcn_get_mpc (n, r, na);
+      fail_unless (mpc_close (r, a, 1 - 64 * n),
+                   "Wrong conversion of the fixed limbs numbers");
+
+      mps_mpcn_add (n, nr, na, nb);
+      mps_mpcn_get_mpc (n, r, nr);
+      mpc_add (mr, a, b);
+      fail_unless (mpc_close (r, mr, 3 - 64 * n), "Wrong fixed limbs addition");
+
+      mps_mpcn_mul (n, nr, na, nb);
+      mps_mpcn_get_mpc (n, r, nr);
+      mpc_mul (mr, a, b);
+      fail_unless (mpc_close (r, mr, 4 - 64 * n), "Wrong fixed limbs multiplication");
+
+      mps_mpcn_fma (n, nr, na, nb, nc);
+      mps_mpcn_get_mpc (n, r, nr);
+      mpc_mul (mr, a, b);
+      mpc_add (mr, mr, c);
+      fail_unless (mpc_close (r, mr, 4 - 64 * n), "Wrong fixed limbs fused multiply-add");
+
+      mps_mpcn_inv (n, nr, nb);
+      mps_mpcn_get_mpc (n, r, nr);
+      mpc_inv (mr, b);
+      fail_unless (mpc_close (r, mr, 6 - 64 * n), "Wrong fixed limbs inversion");
+
+      /* Cancellation in the subtraction must be exact */
+      mps_mpcn_sub (n, nr, na, na);
+      fail_unless (mps_mpcn_eq_zero (nr), "Wrong fixed limbs subtraction");
+
+      mps_mpcn_set (n, nr, na);
+      mps_mpcn_horner_step (n, nr, nb, nc);
+      mps_mpcn_get_mpc (n, r, nr);
+      mpc_mul (mr, a, b);
+      mpc_add (mr, mr, c);
+      fail_unless (mpc_close (r, mr, 4 - 64 * n), "Wrong fixed limbs Horner step");
+    }
+
+  mpc_clear (a);
+  mpc_clear (b);
+  mpc_clear (c);
+  mpc_clear (r);
+  mpc_clear (mr);
+}
+END_TEST
+
+START_TEST (fused_operations)
+{
+  int j;
+  long int prec = 256;
+  mpc_t a, b, c, r, mr, y[4], w[4];
+
+  mpc_init2 (a, prec);
+  mpc_init2 (b, prec);
+  mpc_init2 (c, prec);
+  mpc_init2 (r, prec);
+  mpc_init2 (mr, prec);
+  mpc_vinit2 (y, 4, prec);
+  mpc_vinit2 (w, 4, prec);
+
+  mpc_set_d (a, 1.0, -3.0);
+  mpc_set_d (b, 7.0, 1.0);
+  mpc_div (a, a, b);
+  mpc_set_d (c, -2.5, 0.125);
+  mpc_div (c, c, a);
+
+  mpc_mul (mr, a, b);
+  mpc_add (mr, mr, c);
+
+  mpc_fma (r, a, b, c);
+  fail_unless (mpc_close (r, mr, 4 - prec), "Wrong fused multiply-add");
+
+  /* The result may overwrite any of the operands */
+  mpc_set (r, c);
+  mpc_fma (r, a, b, r);
+  fail_unless (mpc_close (r, mr, 4 - prec), "Wrong fused multiply-add on the addend");
+
+  mpc_set (r, a);
+  mpc_horner_step (r, b, c);
+  fail_unless (mpc_close (r, mr, 4 - prec), "Wrong Horner step");
+
+  /* Sum of the inverses of the differences, with and without weights */
+  mpc_set_ui (mr, 0U, 0U);
+  for (j = 0; j < 4; j++)
+    {
+      mpc_set_d (y[j], j - 1.5, j * j / 3.0);
+      mpc_set_d (w[j], 1.0 / (j + 1), j - 2.0);
+      mpc_sub (r, a, y[j]);
+      mpc_div (r, w[j], r);
+      mpc_add_eq (mr, r);
+    }
+
+  fail_unless (mpc_sum_inv_diff (r, a, y, w, 4) == -1,
+               "Unexpected zero difference in the sum of inverses");
+  fail_unless (mpc_close (r, mr, 6 - prec), "Wrong weighted sum of inverses");
+
+  mpc_set_ui (mr, 0U, 0U);
+  for (j = 0; j < 4; j++)
+    {
+      mpc_sub (r, a, y[j]);
+      mpc_inv (r, r);
+      mpc_add_eq (mr, r);
+    }
+
+  mpc_sum_inv_diff (r, a, y, NULL, 4);
+  fail_unless (mpc_close (r, mr, 6 - prec), "Wrong sum of inverses");
+
+  fail_unless (mpc_sum_inv_diff (r, y[2], y, NULL, 4) == 2,
+               "The zero difference in the sum of inverses was not detected");
+
+  mpc_clear (a);
+  mpc_clear (b);
+  mpc_clear (c);
+  mpc_clear (r);
+  mpc_clear (mr);
+  mpc_vclear (y, 4);
+  mpc_vclear (w, 4);
+}
+END_TEST
+
 int
 main (void)
 {
@@ -94,6 +309,9 @@ main (void)
   // Basic operations
   tcase_add_test (tc_basics, basics_addition);
   tcase_add_test (tc_basics, basics_multiplication);
+  tcase_add_test (tc_basics, scratch_arena);
+  tcase_add_test (tc_basics, fixed_limbs);
+  tcase_add_test (tc_basics, fused_operations);
 
   suite_add_tcase (s, tc_basics);
 
@@ -12,6 +12,35 @@ work (int * i)
   return NULL;
 }
 
+void
+count_range (mps_context * s, int begin, int end, long * visits)
+{
+  int k;
+
+  for (k = begin; k < end; k++)
+    visits[k]++;
+}
+
+/* Check that every index of the loop is visited exactly once */
+int
+check_parallel_for (mps_context * s, mps_thread_pool * pool, int n, int grain)
+{
+  long * visits = mps_newv (long, n);
+  int k, failed = 0;
+
+  for (k = 0; k < n; k++)
+    visits[k] = 0;
+
+  mps_thread_pool_parallel_for (s, pool, 0, n, grain, (mps_thread_range_work)count_range, visits);
+
+  for (k = 0; k < n; k++)
+    if (visits[k] != 1)
+      failed = 1;
+
+  free (visits);
+  return failed;
+}
+
 int main (int argc, char ** argv)
 {
   mps_context * s = mps_context_new ();
@@ -40,6 +69,16 @@ int main (int argc, char ** argv)
 
   mps_thread_pool_wait (s, pool);
 
+  printf ("\n => Running parallel loops with static and dynamic chunking...");
+  for (j = 1; j < 1000; j += 97)
+    if (check_parallel_for (s, pool, j, 0) || check_parallel_for (s, pool, j, 1) ||
+        check_parallel_for (s, pool, j, 7))
+      {
+        printf ("failed with %d indices\n", j);
+        return EXIT_FAILURE;
+      }
+  printf ("done");
+
   printf ("\n => Trying to stop all the threads...");
   mps_thread_pool_free (s, pool);
   printf ("done\n");
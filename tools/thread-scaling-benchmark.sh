@@ -0,0 +1,62 @@
+#!/bin/bash
+#
+# Measure how the threaded Aberth iterations of MPSolve scale with the
+# number of threads, comparing the Gauss-Seidel update of the roots with
+# the snapshot mode selected by -B.
+#
+# Usage: thread-scaling-benchmark.sh [mpsolve] [polfile] [options]
+#
+# The remaining options are passed unchanged to mpsolve, so for example
+#
+#   tools/thread-scaling-benchmark.sh src/mpsolve/mpsolve \
+#     src/tests/unisolve/easy3200.pol -as -Ga -o100
+#
+# The thread counts can be overridden with the THREADS environment variable,
+# and the number of runs for each configuration with RUNS. The speedup is
+# computed for the snapshot mode with respect to the first (Gauss-Seidel)
+# timing.
+
+MPSOLVE=${1:-src/mpsolve/mpsolve}
+POLFILE=${2:-src/tests/unisolve/easy3200.pol}
+if [ $# -ge 2 ]; then shift 2; else shift $#; fi
+
+THREADS=${THREADS:-"1 2 4 8 16 32 64"}
+RUNS=${RUNS:-3}
+
+if [ ! -x "$MPSOLVE" ]; then
+  echo "Cannot find the mpsolve executable: $MPSOLVE"
+  exit 1
+fi
+
+if [ ! -r "$POLFILE" ]; then
+  echo "Cannot read the polynomial file: $POLFILE"
+  exit 1
+fi
+
+# Print the best wall clock time in seconds over $RUNS runs.
+best_time () {
+  best=""
+  for run in $(seq 1 $RUNS); do
+    start=$(date +%s.%N)
+    "$MPSOLVE" "$@" > /dev/null 2>&1 || { echo "failed"; return; }
+    end=$(date +%s.%N)
+    best=$(awk -v s=$start -v e=$end -v b="$best" \
+      'BEGIN { t = e - s; if (b == "" || t < b) print t; else print b }')
+  done
+  printf "%.3f" $best
+}
+
+echo "Polynomial: $POLFILE $@"
+printf "%8s %16s %16s %10s\n" "threads" "gauss-seidel (s)" "snapshot (s)" "speedup"
+
+for j in $THREADS; do
+  gs=$(best_time -j$j "$@" "$POLFILE")
+  sn=$(best_time -j$j -B "$@" "$POLFILE")
+
+  if [ -z "$base" ]; then
+    base=$gs
+  fi
+
+  speedup=$(awk -v b=$base -v t=$sn 'BEGIN { if (t > 0) printf "%.2f", b / t }')
+  printf "%8d %16s %16s %10s\n" $j $gs $sn $speedup
+done